@@ -0,0 +1,319 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <DCPS/DdsDcps_pch.h> // Only the _pch include should start with DCPS/
+
+#include "ContentFilterIndex.h"
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+
+#include "Sample.h"
+#include "Util.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class ContentFilterIndex::Data {
+public:
+  explicit Data(bool catch_errors)
+    : catch_errors_(catch_errors)
+  {}
+
+  virtual ~Data() {}
+
+  virtual bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const = 0;
+  virtual Value field_value(const char* field) const = 0;
+
+  const bool catch_errors_;
+};
+
+namespace {
+  class SampleData : public ContentFilterIndex::Data {
+  public:
+    explicit SampleData(const Sample& sample)
+      : Data(false)
+      , sample_(sample)
+    {}
+
+    bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const
+    {
+      return sample_.eval(evaluator, params);
+    }
+
+    Value field_value(const char* field) const
+    {
+      return sample_.get_field_value(field);
+    }
+
+  private:
+    const Sample& sample_;
+  };
+
+  class SerializedData : public ContentFilterIndex::Data {
+  public:
+    SerializedData(ACE_Message_Block* serialized, Encoding encoding,
+                   TypeSupportImpl& type_support)
+      : Data(true)
+      , serialized_(serialized)
+      , encoding_(encoding)
+      , type_support_(type_support)
+    {}
+
+    bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const
+    {
+      return evaluator.eval(serialized_, encoding_, type_support_, params);
+    }
+
+    Value field_value(const char* field) const
+    {
+      return FilterEvaluator::field_value(serialized_, encoding_, type_support_, field);
+    }
+
+  private:
+    ACE_Message_Block* const serialized_;
+    const Encoding encoding_;
+    TypeSupportImpl& type_support_;
+  };
+}
+
+bool
+ContentFilterIndex::ValueLess::operator()(const Value& lhs, const Value& rhs) const
+{
+  if (lhs.type_ == Value::VAL_STRING && rhs.type_ == Value::VAL_STRING) {
+    return std::strcmp(lhs.s_, rhs.s_) < 0;
+  }
+  return lhs < rhs;
+}
+
+ContentFilterIndex::Filter::Filter()
+  : indexed_(false)
+  , param_(0)
+  , op_(FilterEvaluator::Instruction::OP_EQ)
+  , index_type_(Value::VAL_BOOL)
+  , index_valid_(false)
+{
+}
+
+void
+ContentFilterIndex::insert(const GUID_t& reader, const RcHandle<FilterEvaluator>& eval,
+                           const DDS::StringSeq& params)
+{
+  remove(reader);
+
+  Filter& filter = filters_[eval.in()];
+  if (!filter.eval_) {
+    filter.eval_ = eval;
+    filter.indexed_ = eval->single_comparison(filter.field_, filter.param_, filter.op_);
+  }
+
+  ReaderEntry entry;
+  entry.filter_ = eval.in();
+  entry.indexed_ = filter.indexed_ && filter.param_ < params.length();
+  if (entry.indexed_) {
+    entry.key_.push_back(params[static_cast<CORBA::ULong>(filter.param_)].in());
+  } else {
+    for (CORBA::ULong i = 0; i < params.length(); ++i) {
+      entry.key_.push_back(params[i].in());
+    }
+  }
+
+  Group& group = (entry.indexed_ ? filter.indexed_groups_ : filter.groups_)[entry.key_];
+  if (group.readers_.empty()) {
+    group.params_ = params;
+    if (entry.indexed_) {
+      filter.index_valid_ = false;
+    }
+  }
+  group.readers_.push_back(reader);
+  readers_[reader] = entry;
+}
+
+void
+ContentFilterIndex::remove(const GUID_t& reader)
+{
+  const Readers::iterator r = readers_.find(reader);
+  if (r == readers_.end()) {
+    return;
+  }
+  const ReaderEntry& entry = r->second;
+
+  const Filters::iterator f = filters_.find(entry.filter_);
+  if (f != filters_.end()) {
+    Filter& filter = f->second;
+    Groups& groups = entry.indexed_ ? filter.indexed_groups_ : filter.groups_;
+    const Groups::iterator g = groups.find(entry.key_);
+    if (g != groups.end()) {
+      OPENDDS_VECTOR(GUID_t)& readers = g->second.readers_;
+      readers.erase(std::find(readers.begin(), readers.end(), reader));
+      if (readers.empty()) {
+        if (entry.indexed_) {
+          // The index points to the groups
+          filter.index_.clear();
+          filter.unconvertible_.clear();
+          filter.index_valid_ = false;
+        }
+        groups.erase(g);
+      }
+    }
+    if (filter.indexed_groups_.empty() && filter.groups_.empty()) {
+      filters_.erase(f);
+    }
+  }
+
+  readers_.erase(r);
+}
+
+void
+ContentFilterIndex::filter_out(const Sample& sample, GUIDSeq& excluded)
+{
+  filter_out(SampleData(sample), excluded);
+}
+
+void
+ContentFilterIndex::filter_out(ACE_Message_Block* serialized, Encoding encoding,
+                               TypeSupportImpl& type_support, GUIDSeq& excluded)
+{
+  filter_out(SerializedData(serialized, encoding, type_support), excluded);
+}
+
+void
+ContentFilterIndex::filter_out(const Data& data, GUIDSeq& excluded)
+{
+  for (Filters::iterator f = filters_.begin(); f != filters_.end(); ++f) {
+    Filter& filter = f->second;
+    if (!filter.indexed_groups_.empty()) {
+      filter_out_indexed(filter, data, excluded);
+    }
+    for (Groups::const_iterator g = filter.groups_.begin(); g != filter.groups_.end(); ++g) {
+      filter_out_group(filter, g->second, data, excluded);
+    }
+  }
+}
+
+void
+ContentFilterIndex::filter_out_indexed(Filter& filter, const Data& data, GUIDSeq& excluded)
+{
+  Value value(false);
+  try {
+    value = data.field_value(filter.field_.c_str());
+  } catch (const std::runtime_error&) {
+    if (!data.catch_errors_) {
+      throw;
+    }
+    return;
+  }
+
+  if (!filter.index_valid_ || filter.index_type_ != value.type_) {
+    rebuild_index(filter, value.type_);
+  }
+
+  for (OPENDDS_VECTOR(Group*)::const_iterator g = filter.unconvertible_.begin();
+       g != filter.unconvertible_.end(); ++g) {
+    // Throws the same error as a reader would
+    filter_out_group(filter, **g, data, excluded);
+  }
+
+  // The index is ordered by parameter, so the readers that don't want the
+  // sample are one or two ranges of it.
+  typedef Index::const_iterator Iter;
+  Iter first = filter.index_.begin();
+  Iter last = filter.index_.end();
+  Iter first2 = last;
+  switch (filter.op_) {
+  case FilterEvaluator::Instruction::OP_EQ:
+    first2 = filter.index_.upper_bound(value);
+    last = filter.index_.lower_bound(value);
+    break;
+  case FilterEvaluator::Instruction::OP_NEQ:
+    first = filter.index_.lower_bound(value);
+    last = filter.index_.upper_bound(value);
+    break;
+  case FilterEvaluator::Instruction::OP_LT:
+    // value < param
+    last = filter.index_.upper_bound(value);
+    break;
+  case FilterEvaluator::Instruction::OP_GT:
+    // param < value
+    first = filter.index_.lower_bound(value);
+    break;
+  case FilterEvaluator::Instruction::OP_LTEQ:
+    // !(param < value)
+    last = filter.index_.lower_bound(value);
+    break;
+  case FilterEvaluator::Instruction::OP_GTEQ:
+    // !(value < param)
+    first = filter.index_.upper_bound(value);
+    break;
+  default:
+    break;
+  }
+
+  for (Iter i = first; i != last; ++i) {
+    add_readers(*i->second, excluded);
+  }
+  for (Iter i = first2; i != filter.index_.end(); ++i) {
+    add_readers(*i->second, excluded);
+  }
+}
+
+void
+ContentFilterIndex::rebuild_index(Filter& filter, Value::Type type)
+{
+  filter.index_.clear();
+  filter.unconvertible_.clear();
+  for (Groups::iterator g = filter.indexed_groups_.begin(); g != filter.indexed_groups_.end(); ++g) {
+    // Comparing a field with a parameter converts the parameter to the type
+    // of the field.
+    Value param(g->first[0].c_str(), true);
+    if (param.type_ == type || param.convert(type)) {
+      filter.index_.insert(std::make_pair(param, &g->second));
+    } else {
+      filter.unconvertible_.push_back(&g->second);
+    }
+  }
+  filter.index_type_ = type;
+  filter.index_valid_ = true;
+}
+
+void
+ContentFilterIndex::filter_out_group(const Filter& filter, const Group& group,
+                                     const Data& data, GUIDSeq& excluded)
+{
+  bool pass = true;
+  if (data.catch_errors_) {
+    try {
+      pass = data.eval(*filter.eval_, group.params_);
+    } catch (const std::runtime_error&) {
+      // eval logged the error, let the readers filter the sample
+    }
+  } else {
+    pass = data.eval(*filter.eval_, group.params_);
+  }
+  if (!pass) {
+    add_readers(group, excluded);
+  }
+}
+
+void
+ContentFilterIndex::add_readers(const Group& group, GUIDSeq& excluded)
+{
+  for (OPENDDS_VECTOR(GUID_t)::const_iterator i = group.readers_.begin();
+       i != group.readers_.end(); ++i) {
+    push_back(excluded, *i);
+  }
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_CONTENT_FILTERED_TOPIC
@@ -0,0 +1,117 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_CONTENTFILTERINDEX_H
+#define OPENDDS_DCPS_CONTENTFILTERINDEX_H
+
+#include "Definitions.h"
+
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+
+#include "FilterEvaluator.h"
+#include "GuidUtils.h"
+#include "PoolAllocator.h"
+#include "RcHandle_T.h"
+#include "dcps_export.h"
+
+#ifndef ACE_LACKS_PRAGMA_ONCE
+#  pragma once
+#endif
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+class Sample;
+
+/**
+ * The content filters of the readers matched with a DataWriter, arranged so
+ * that each distinct filter and set of parameters is evaluated once per
+ * sample.  Filters that compare one field with a parameter, like
+ * "symbol = %0", are indexed by the parameter so that a sample only visits
+ * the readers it's filtered out for.
+ */
+class OpenDDS_Dcps_Export ContentFilterIndex {
+public:
+  void insert(const GUID_t& reader, const RcHandle<FilterEvaluator>& eval,
+              const DDS::StringSeq& params);
+  void remove(const GUID_t& reader);
+  bool empty() const { return readers_.empty(); }
+
+  /// Add the readers that shouldn't get the sample to excluded.  Errors
+  /// evaluating the filters are thrown.
+  void filter_out(const Sample& sample, GUIDSeq& excluded);
+
+  /// Add the readers that shouldn't get the serialized sample to excluded.
+  /// Readers with filters that can't be evaluated aren't filtered out.
+  void filter_out(ACE_Message_Block* serialized, Encoding encoding,
+                  TypeSupportImpl& type_support, GUIDSeq& excluded);
+
+  /// Either kind of sample
+  class Data;
+
+private:
+  typedef OPENDDS_VECTOR(OPENDDS_STRING) ParamKey;
+
+  /// Readers with the same filter that get the same samples
+  struct Group {
+    DDS::StringSeq params_;
+    OPENDDS_VECTOR(GUID_t) readers_;
+  };
+  typedef OPENDDS_MAP(ParamKey, Group) Groups;
+
+  struct ValueLess {
+    bool operator()(const Value& lhs, const Value& rhs) const;
+  };
+  typedef OPENDDS_MULTIMAP_CMP(Value, Group*, ValueLess) Index;
+
+  struct Filter {
+    Filter();
+
+    RcHandle<FilterEvaluator> eval_;
+    /// Set for a filter like "field op %param"
+    bool indexed_;
+    OPENDDS_STRING field_;
+    size_t param_;
+    FilterEvaluator::Instruction::OpCode op_;
+    /// Keyed by the indexed parameter
+    Groups indexed_groups_;
+    /// Keyed by all the parameters
+    Groups groups_;
+    /// indexed_groups_ by their parameter converted to index_type_, which is
+    /// the type of the field in the last sample
+    Index index_;
+    Value::Type index_type_;
+    bool index_valid_;
+    /// indexed_groups_ with a parameter that can't be converted to index_type_
+    OPENDDS_VECTOR(Group*) unconvertible_;
+  };
+  typedef OPENDDS_MAP(FilterEvaluator*, Filter) Filters;
+  Filters filters_;
+
+  struct ReaderEntry {
+    FilterEvaluator* filter_;
+    bool indexed_;
+    ParamKey key_;
+  };
+  typedef OPENDDS_MAP_CMP(GUID_t, ReaderEntry, GUID_tKeyLessThan) Readers;
+  Readers readers_;
+
+  void filter_out(const Data& data, GUIDSeq& excluded);
+  void filter_out_indexed(Filter& filter, const Data& data, GUIDSeq& excluded);
+  static void rebuild_index(Filter& filter, Value::Type type);
+  static void filter_out_group(const Filter& filter, const Group& group,
+                               const Data& data, GUIDSeq& excluded);
+  static void add_readers(const Group& group, GUIDSeq& excluded);
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_CONTENT_FILTERED_TOPIC
+#endif // OPENDDS_DCPS_CONTENTFILTERINDEX_H
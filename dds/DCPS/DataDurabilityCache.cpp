@@ -21,6 +21,7 @@
 #include "SafetyProfileStreams.h"
 #include "Service_Participant.h"
 #include "RcEventHandler.h"
+#include "JobQueue.h"
 
 #include "ace/Reactor.h"
 #include "ace/Message_Block.h"
@@ -31,9 +32,21 @@
 
 #include <fstream>
 #include <algorithm>
+#include <stdexcept>
 
 namespace {
 
+/// Compact the log on the Service_Participant's job queue so that the
+/// DataWriter or timer that dropped samples doesn't wait for it.
+void compact_log(const OpenDDS::DCPS::DurableDataLog_rch& log)
+{
+  using namespace OpenDDS::DCPS;
+  const JobQueue_rch job_queue = TheServiceParticipant->job_queue();
+  if (job_queue && log->compaction_needed()) {
+    job_queue->enqueue(make_rch<PmfJob<DurableDataLog> >(log, &DurableDataLog::compact));
+  }
+}
+
 void cleanup_directory(const OPENDDS_VECTOR(OPENDDS_STRING) & path,
                        const OpenDDS::DCPS::String& data_dir)
 {
@@ -71,7 +84,8 @@ public:
                   list_index_type index,
                   ACE_Allocator* allocator,
                   const OPENDDS_VECTOR(OpenDDS::DCPS::String)& path,
-                  const OpenDDS::DCPS::String& data_dir)
+                  const OpenDDS::DCPS::String& data_dir,
+                  const OpenDDS::DCPS::DurableDataLog_rch& log)
   : sample_list_(sample_list)
   , index_(index)
   , allocator_(allocator)
@@ -79,6 +93,7 @@ public:
   , timer_ids_(0)
   , path_(path)
   , data_dir_(data_dir)
+  , log_(log)
   {
   }
 
@@ -99,11 +114,17 @@ public:
 
     // Cleanup all data samples corresponding to the cleanup delay.
     data_queue_type *& queue = this->sample_list_[this->index_];
+    const ACE_UINT32 log_id = queue ? queue->log_id_ : 0;
     ACE_DES_FREE(queue,
                  this->allocator_->free,
                  data_queue_type);
     queue = 0;
 
+    if (log_id) {
+      this->log_->drop(log_id);
+      compact_log(this->log_);
+    }
+
     try {
       cleanup_directory(path_, this->data_dir_);
 
@@ -161,6 +182,9 @@ private:
   OPENDDS_VECTOR(OpenDDS::DCPS::String) path_;
 
   OpenDDS::DCPS::String data_dir_;
+
+  /// Log that the samples are in, if they are.
+  OpenDDS::DCPS::DurableDataLog_rch log_;
 };
 
 } // namespace
@@ -295,10 +319,12 @@ OpenDDS::DCPS::DataDurabilityCache::DataDurabilityCache(
 }
 
 OpenDDS::DCPS::DataDurabilityCache::DataDurabilityCache(DDS::DurabilityQosPolicyKind kind,
-                                                        const String& data_dir)
+                                                        const String& data_dir,
+                                                        const DurableDataLog_rch& log)
   : allocator_(new ACE_New_Allocator)
   , kind_(kind)
   , data_dir_(data_dir)
+  , log_(log)
   , samples_(0)
   , cleanup_timer_ids_()
   , lock_()
@@ -318,7 +344,10 @@ void OpenDDS::DCPS::DataDurabilityCache::init()
 
   typedef DurabilityQueue<sample_data_type> data_queue_type;
 
-  if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
+  if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS && this->log_) {
+    load_log();
+
+  } else if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
     // Read data from the filesystem and create the in-memory data structures
     // as if we had called insert() once for each "datawriter" directory.
     using OpenDDS::FileSystemStorage::Directory;
@@ -421,6 +450,55 @@ void OpenDDS::DCPS::DataDurabilityCache::init()
   this->reactor_ = TheServiceParticipant->timer();
 }
 
+void OpenDDS::DCPS::DataDurabilityCache::load_log()
+{
+  DurableDataLog::QueueList queues;
+  if (!this->log_->open(queues)) {
+    throw std::runtime_error("Can't open the PERSISTENT data log");
+  }
+
+  ACE_Allocator * const allocator = this->allocator_.get();
+  typedef DurabilityQueue<sample_data_type> data_queue_type;
+
+  // Each queue in the log was created by a call to insert().
+  for (DurableDataLog::QueueList::const_iterator queue = queues.begin();
+       queue != queues.end(); ++queue) {
+    key_type key(queue->domain_id, queue->topic_name.c_str(),
+                 queue->type_name.c_str(), allocator);
+    sample_list_type * sample_list = 0;
+    if (this->samples_->find(key, sample_list, allocator) != 0) {
+      ACE_NEW_MALLOC(sample_list,
+                     static_cast<sample_list_type *>(
+                       allocator->malloc(sizeof(sample_list_type))),
+                     sample_list_type(0, static_cast<data_queue_type *>(0),
+                                      allocator));
+      this->samples_->bind(key, sample_list, allocator);
+    }
+
+    size_t old_len = sample_list->size();
+    sample_list->size(old_len + 1);
+    data_queue_type *& slot = (*sample_list)[old_len];
+
+    data_queue_type * sample_queue = 0;
+    ACE_NEW_MALLOC(sample_queue,
+                   static_cast<data_queue_type *>(
+                     allocator->malloc(sizeof(data_queue_type))),
+                   data_queue_type(allocator));
+
+    slot = sample_queue;
+    sample_queue->log_id_ = queue->id;
+
+    for (OPENDDS_VECTOR(DurableDataLog::Sample)::const_iterator sample = queue->samples.begin();
+         sample != queue->samples.end(); ++sample) {
+      // Wraps the data in the log, which sample_data_type copies.
+      ACE_Message_Block mb(sample->data, sample->length);
+      mb.wr_ptr(sample->length);
+      sample_queue->enqueue_tail(
+        sample_data_type(sample->timestamp, mb, allocator));
+    }
+  }
+}
+
 OpenDDS::DCPS::DataDurabilityCache::~DataDurabilityCache()
 {
   // Cancel timers that haven't expired yet.
@@ -536,7 +614,7 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
 
     ACE_GUARD_RETURN(ACE_SYNCH_MUTEX, guard, this->lock_, false);
 
-    if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS) {
+    if (this->kind_ == DDS::PERSISTENT_DURABILITY_QOS && !this->log_) {
       try {
         dir = Directory::create(this->data_dir_.c_str());
 
@@ -611,6 +689,22 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
       samples->fs_path_ = path;
     }
 
+    if (this->log_) {
+      size_t count = 0;
+      for (SendStateDataSampleList::iterator i(element); i != the_end; ++i) {
+        if (!DataSampleHeader::test_flag(COHERENT_CHANGE_FLAG, i->get_sample())) {
+          ++count;
+        }
+      }
+      samples->log_id_ = this->log_->begin_queue(domain_id, topic_name, type_name, count);
+      if (!samples->log_id_ && DCPS_debug_level > 0) {
+        ACE_ERROR((LM_ERROR,
+                   ACE_TEXT("(%P|%t) DataDurabilityCache::insert ")
+                   ACE_TEXT("couldn't add samples to the log for PERSISTENT ")
+                   ACE_TEXT("data\n")));
+      }
+    }
+
     for (SendStateDataSampleList::iterator i(element); i != the_end; ++i) {
       DataSampleElement& elem = *i;
 
@@ -631,6 +725,21 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
       if (samples->enqueue_tail(sample) != 0)
         return false;
 
+      if (samples->log_id_) {
+        DDS::Time_t timestamp;
+        const char * data;
+        size_t len;
+        sample.get_sample(data, len, timestamp);
+
+        if (!this->log_->append(samples->log_id_, timestamp, data, len) &&
+            DCPS_debug_level > 0) {
+          ACE_ERROR((LM_ERROR,
+                     ACE_TEXT("(%P|%t) DataDurabilityCache::insert ")
+                     ACE_TEXT("couldn't write sample for PERSISTENT ")
+                     ACE_TEXT("data to the log\n")));
+        }
+      }
+
       if (!dir.is_nil()) {
         try {
           File::Ptr f = dir->create_next_file();
@@ -656,6 +765,11 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
         }
       }
     }
+
+    // All of the samples are flushed together.
+    if (samples->log_id_) {
+      this->log_->commit();
+    }
   }
 
   // -----------
@@ -681,7 +795,8 @@ OpenDDS::DCPS::DataDurabilityCache::insert(
                           static_cast<size_t>(slot - &(*sample_list)[0]),
                           this->allocator_.get(),
                           path,
-                          this->data_dir_);
+                          this->data_dir_,
+                          this->log_);
     ACE_Event_Handler_var safe_cleanup(cleanup);   // Transfer ownership
     long const tid =
       this->reactor_->schedule_timer(cleanup,
@@ -849,6 +964,11 @@ OpenDDS::DCPS::DataDurabilityCache::get_data(
      */
     q->reset();
 
+    if (q->log_id_) {
+      this->log_->drop(q->log_id_);
+      q->log_id_ = 0;
+    }
+
     try {
       cleanup_directory(q->fs_path_, this->data_dir_);
 
@@ -861,6 +981,10 @@ OpenDDS::DCPS::DataDurabilityCache::get_data(
       }
     }
   }
+
+  if (this->log_) {
+    compact_log(this->log_);
+  }
   return true;
 }
 
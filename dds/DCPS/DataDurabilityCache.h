@@ -16,6 +16,7 @@
 
 #include "DurabilityArray.h"
 #include "DurabilityQueue.h"
+#include "DurableDataLog.h"
 #include "FileSystemStorage.h"
 #include "PoolAllocator.h"
 #include "unique_ptr.h"
@@ -187,8 +188,11 @@ public:
 
   DataDurabilityCache(DDS::DurabilityQosPolicyKind kind);
 
+  /// If log isn't nil, PERSISTENT samples are stored in it instead of a file
+  /// per sample in data_dir.
   DataDurabilityCache(DDS::DurabilityQosPolicyKind kind,
-                      const String& data_dir);
+                      const String& data_dir,
+                      const DurableDataLog_rch& log = DurableDataLog_rch());
 
   ~DataDurabilityCache();
 
@@ -219,6 +223,9 @@ private:
 
   void init();
 
+  /// Create the in-memory data structures from the samples in log_.
+  void load_log();
+
 private:
   /// Allocator used to allocate memory for sample map and lists.
   unique_ptr<ACE_Allocator> const allocator_;
@@ -227,6 +234,8 @@ private:
 
   String data_dir_;
 
+  DurableDataLog_rch log_;
+
   /// Map of all data samples.
   sample_map_type * samples_;
 
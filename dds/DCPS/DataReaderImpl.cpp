@@ -85,6 +85,7 @@ DataReaderImpl::DataReaderImpl()
                                                               &DataReaderImpl::lifespan_task)))
   , is_bit_(false)
   , always_get_history_(false)
+  , concurrent_demarshal_(TheServiceParticipant->concurrent_demarshal())
   , statistics_enabled_(false)
   , raw_latency_buffer_size_(0)
   , raw_latency_buffer_type_(DataCollector<double>::KeepOldest)
@@ -1359,6 +1360,32 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
     }
   }
 
+  const MarshalingType marshaling = sample.header_.key_fields_only_ ? KEY_ONLY_MARSHALING : FULL_MARSHALING;
+
+  // With concurrent_demarshal_, samples that are going to be dropped are
+  // dropped before they are deserialized, and deserializing and content
+  // filtering, which don't use the state protected by sample_lock_, are done
+  // before taking it.  Other threads then only wait while the sample is
+  // stored.
+  const bool check_early = concurrent_demarshal_ && !is_bit()
+    && (sample.header_.message_id_ == SAMPLE_DATA || sample.header_.message_id_ == INSTANCE_REGISTRATION);
+  const ReceivedDataSample* sample_for_processing = &sample;
+  ReceivedDataSample sample_with_lifespan;
+  bool expired = false;
+  bool demarshaled = false;
+  DemarshaledSample_ptr demarshaled_data;
+  bool demarshal_filtered = false;
+  if (check_early) {
+    if (get_deleted() || !check_historic(sample)) {
+      return;
+    }
+    sample_for_processing = &with_writer_lifespan(sample, sample_with_lifespan);
+    expired = filter_sample(sample_for_processing->header_);
+    if (!expired) {
+      demarshaled = demarshal(*sample_for_processing, marshaling, demarshaled_data, demarshal_filtered);
+    }
+  }
+
   // ensure some other thread is not changing the sample container
   // or statuses related to samples.
   ACE_GUARD(ACE_Recursive_Thread_Mutex, guard, this->sample_lock_);
@@ -1377,38 +1404,9 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
   case SAMPLE_DATA:
   case INSTANCE_REGISTRATION: {
     SubscriptionInstance_rch instance;
-    if (!check_historic(sample)) break;
-
-    const ReceivedDataSample* sample_for_processing = &sample;
-    ReceivedDataSample sample_with_lifespan;
-
-    // RTPS communicates Lifespan as writer QoS.  It is not required to be
-    // repeated as inline QoS on every DATA submessage, so attach the
-    // discovered writer's policy to the internal per-sample header.
-    if (!is_bit()
-        && sample.header_.message_id_ == SAMPLE_DATA
-        && !sample.header_.lifespan_duration_) {
-      WriterInfo_rch writer;
-      {
-        ACE_READ_GUARD(ACE_RW_Thread_Mutex, read_guard, writers_lock_);
-        const WriterMapType::const_iterator pos =
-          writers_.find(sample.header_.publication_id_);
-        if (pos != writers_.end()) {
-          writer = pos->second;
-        }
-      }
-      if (writer) {
-        const DDS::Duration_t lifespan =
-          writer->writer_qos_lifespan().duration;
-        if (!is_infinite(lifespan)) {
-          sample_with_lifespan = sample;
-          DataSampleHeader& header = sample_with_lifespan.header_;
-          header.lifespan_duration_ = true;
-          header.lifespan_duration_sec_ = lifespan.sec;
-          header.lifespan_duration_nanosec_ = lifespan.nanosec;
-          sample_for_processing = &sample_with_lifespan;
-        }
-      }
+    if (!check_early) {
+      if (!check_historic(sample)) break;
+      sample_for_processing = &with_writer_lifespan(sample, sample_with_lifespan);
     }
 
     const DataSampleHeader& header = sample_for_processing->header_;
@@ -1416,7 +1414,7 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
     this->writer_activity(header);
 
     // Verify data has not exceeded its lifespan.
-    if (this->filter_sample(header)) break;
+    if (check_early ? expired : this->filter_sample(header)) break;
 
     // This adds the reader to the set/list of readers with data.
     RcHandle<SubscriberImpl> subscriber = get_subscriber_servant();
@@ -1434,8 +1432,13 @@ DataReaderImpl::data_received(const ReceivedDataSample& sample)
 
     bool is_new_instance = false;
     bool filtered = false;
-    dds_demarshal(*sample_for_processing, publication_handle, instance, is_new_instance, filtered,
-                  sample.header_.key_fields_only_ ? KEY_ONLY_MARSHALING : FULL_MARSHALING);
+    if (!demarshaled) {
+      dds_demarshal(*sample_for_processing, publication_handle, instance, is_new_instance, filtered, marshaling);
+    } else if (demarshaled_data) {
+      store_demarshaled(OPENDDS_MOVE_NS::move(demarshaled_data), header, publication_handle, instance, is_new_instance, filtered);
+    } else {
+      filtered = demarshal_filtered;
+    }
 
     // Per sample logging
     if (DCPS_debug_level >= 8) {
@@ -2166,6 +2169,23 @@ void DataReaderImpl::dispose_unregister(const ReceivedDataSample&,
   }
 }
 
+bool DataReaderImpl::demarshal(const ReceivedDataSample&,
+                               MarshalingType,
+                               DemarshaledSample_ptr&,
+                               bool&)
+{
+  return false;
+}
+
+void DataReaderImpl::store_demarshaled(DemarshaledSample_ptr,
+                                       const DataSampleHeader&,
+                                       DDS::InstanceHandle_t,
+                                       SubscriptionInstance_rch&,
+                                       bool&,
+                                       bool&)
+{
+}
+
 void DataReaderImpl::process_latency(const ReceivedDataSample& sample)
 {
   ACE_Guard<ACE_Recursive_Thread_Mutex> guard(statistics_lock_);
@@ -2464,6 +2484,44 @@ DataReaderImpl::lookup_instance_handles(const WriterIdSeq& ids,
   }
 }
 
+const ReceivedDataSample&
+DataReaderImpl::with_writer_lifespan(const ReceivedDataSample& sample,
+                                     ReceivedDataSample& sample_with_lifespan)
+{
+  // RTPS communicates Lifespan as writer QoS.  It is not required to be
+  // repeated as inline QoS on every DATA submessage, so attach the
+  // discovered writer's policy to the internal per-sample header.
+  if (is_bit()
+      || sample.header_.message_id_ != SAMPLE_DATA
+      || sample.header_.lifespan_duration_) {
+    return sample;
+  }
+
+  WriterInfo_rch writer;
+  {
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, read_guard, writers_lock_, sample);
+    const WriterMapType::const_iterator pos =
+      writers_.find(sample.header_.publication_id_);
+    if (pos != writers_.end()) {
+      writer = pos->second;
+    }
+  }
+  if (!writer) {
+    return sample;
+  }
+
+  const DDS::Duration_t lifespan = writer->writer_qos_lifespan().duration;
+  if (is_infinite(lifespan)) {
+    return sample;
+  }
+  sample_with_lifespan = sample;
+  DataSampleHeader& header = sample_with_lifespan.header_;
+  header.lifespan_duration_ = true;
+  header.lifespan_duration_sec_ = lifespan.sec;
+  header.lifespan_duration_nanosec_ = lifespan.nanosec;
+  return sample_with_lifespan;
+}
+
 bool
 DataReaderImpl::filter_sample(const DataSampleHeader& header)
 {
@@ -332,6 +332,31 @@ public:
                              bool& filtered,
                              MarshalingType marshaling_type) = 0;
 
+  /// The value of a sample deserialized by demarshal().
+  class DemarshaledSample {
+  public:
+    virtual ~DemarshaledSample() {}
+  };
+  typedef unique_ptr<DemarshaledSample> DemarshaledSample_ptr;
+
+  /// Deserialize and content filter sample without sample_lock_ (see
+  /// Service_Participant::concurrent_demarshal).  Returns false if this
+  /// isn't supported, in which case dds_demarshal() is used instead.
+  /// Otherwise data is null if the sample is dropped, and filtered is set if
+  /// it was because of the content filter.
+  virtual bool demarshal(const ReceivedDataSample& sample,
+                         MarshalingType marshaling_type,
+                         DemarshaledSample_ptr& data,
+                         bool& filtered);
+
+  /// Same as dds_demarshal() for the result of demarshal().
+  virtual void store_demarshaled(DemarshaledSample_ptr data,
+                                 const DataSampleHeader& header,
+                                 DDS::InstanceHandle_t publication_handle,
+                                 SubscriptionInstance_rch& instance,
+                                 bool& is_new_instance,
+                                 bool& filtered);
+
   virtual void dispose_unregister(const ReceivedDataSample& sample,
                                   DDS::InstanceHandle_t publication_handle,
                                   SubscriptionInstance_rch& instance);
@@ -674,6 +699,11 @@ protected:
    */
   bool filter_sample(const DataSampleHeader& header);
 
+  /// Returns sample, or sample_with_lifespan set to a copy of it with the
+  /// writer's LIFESPAN QoS if the sample doesn't have its own.
+  const ReceivedDataSample& with_writer_lifespan(const ReceivedDataSample& sample,
+                                                 ReceivedDataSample& sample_with_lifespan);
+
   bool ownership_filter_instance(const SubscriptionInstance_rch& instance,
                                  const GUID_t& pubid);
   bool time_based_filter_instance(const SubscriptionInstance_rch& instance,
@@ -869,6 +899,9 @@ private:
 
   bool always_get_history_;
 
+  /// Samples are deserialized before sample_lock_ is taken.
+  const bool concurrent_demarshal_;
+
   /// Flag indicating status of statistics gathering.
   AtomicBool statistics_enabled_;
 
@@ -10,6 +10,7 @@
 #include "BuiltInTopicUtils.h"
 #include "EncapsulationHeader.h"
 #include "GuidConverter.h"
+#include "HashedInstanceIndex_T.h"
 #include "MultiTopicImpl.h"
 #include "RakeResults_T.h"
 #include "SubscriberImpl.h"
@@ -58,6 +59,8 @@ namespace OpenDDS {
     typedef OPENDDS_MAP_CMP_T(MessageType, DDS::InstanceHandle_t,
                               typename TraitsType::LessThanType) InstanceMap;
     typedef OPENDDS_MAP(DDS::InstanceHandle_t, typename InstanceMap::iterator) ReverseInstanceMap;
+    typedef HashedInstanceIndex<InstanceMap, typename TraitsType::HashType,
+                                typename TraitsType::LessThanType> InstanceIndex;
 
     class SharedInstanceMap
       : public virtual RcObject
@@ -121,8 +124,16 @@ namespace OpenDDS {
 
     typedef OpenDDS::DCPS::Cached_Allocator_With_Overflow<MessageTypeMemoryBlock, ACE_Thread_Mutex>  DataAllocator;
 
+    struct Demarshaled : public DemarshaledSample {
+      explicit Demarshaled(unique_ptr<MessageTypeWithAllocator> d)
+        : data(OPENDDS_MOVE_NS::move(d))
+      {}
+      unique_ptr<MessageTypeWithAllocator> data;
+    };
+
     DataReaderImpl_T()
-      : filter_delayed_sample_task_(make_rch<SporadicEvent>(TheServiceParticipant->event_dispatcher(), make_rch<DRIEvent>(rchandle_from(this), &DataReaderImpl_T::filter_delayed)))
+      : instance_index_(instance_map_, TheServiceParticipant->hashed_instance_index())
+      , filter_delayed_sample_task_(make_rch<SporadicEvent>(TheServiceParticipant->event_dispatcher(), make_rch<DRIEvent>(rchandle_from(this), &DataReaderImpl_T::filter_delayed)))
       , marshal_skip_serialize_(false)
     {
       initialize_lookup_maps();
@@ -676,7 +687,7 @@ namespace OpenDDS {
   {
     ACE_Guard<ACE_Recursive_Thread_Mutex> guard(sample_lock_);
 
-    const typename InstanceMap::const_iterator it = instance_map_.find(instance_data);
+    const typename InstanceMap::const_iterator it = instance_index_.find(instance_data);
     if (it != instance_map_.end()) {
       return it->second;
     }
@@ -998,7 +1009,7 @@ namespace OpenDDS {
     }
 
     DDS::InstanceHandle_t handle(DDS::HANDLE_NIL);
-    typename InstanceMap::const_iterator const it = instance_map_.find(data);
+    typename InstanceMap::const_iterator const it = instance_index_.find(data);
     if (it != instance_map_.end()) {
       handle = it->second;
     }
@@ -1082,7 +1093,46 @@ protected:
                              bool& filtered,
                              OpenDDS::DCPS::MarshalingType marshaling_type)
   {
-    unique_ptr<MessageTypeWithAllocator> data(new (*data_allocator()) MessageTypeWithAllocator);
+    unique_ptr<MessageTypeWithAllocator> data;
+    if (deserialize(sample, marshaling_type, data, filtered)) {
+      store_instance_data(OPENDDS_MOVE_NS::move(data), publication_handle, sample.header_, instance, just_registered, filtered);
+    }
+  }
+
+  virtual bool demarshal(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                         OpenDDS::DCPS::MarshalingType marshaling_type,
+                         DemarshaledSample_ptr& result,
+                         bool& filtered)
+  {
+    if (!data_allocator()) {
+      return false;
+    }
+    unique_ptr<MessageTypeWithAllocator> data;
+    if (deserialize(sample, marshaling_type, data, filtered)) {
+      result.reset(new Demarshaled(OPENDDS_MOVE_NS::move(data)));
+    }
+    return true;
+  }
+
+  virtual void store_demarshaled(DemarshaledSample_ptr result,
+                                 const OpenDDS::DCPS::DataSampleHeader& header,
+                                 DDS::InstanceHandle_t publication_handle,
+                                 OpenDDS::DCPS::SubscriptionInstance_rch& instance,
+                                 bool& just_registered,
+                                 bool& filtered)
+  {
+    Demarshaled& demarshaled = static_cast<Demarshaled&>(*result);
+    store_instance_data(OPENDDS_MOVE_NS::move(demarshaled.data), publication_handle, header, instance, just_registered, filtered);
+  }
+
+  /// Deserialize and content filter sample into data.  Returns false if the
+  /// sample is dropped.  This doesn't need sample_lock_.
+  bool deserialize(const OpenDDS::DCPS::ReceivedDataSample& sample,
+                   OpenDDS::DCPS::MarshalingType marshaling_type,
+                   unique_ptr<MessageTypeWithAllocator>& data,
+                   bool& filtered)
+  {
+    data.reset(new (*data_allocator()) MessageTypeWithAllocator);
     dynamic_hook(*data);
 
     Message_Block_Ptr payload(sample.data(&mb_alloc_));
@@ -1092,10 +1142,9 @@ protected:
           ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR: DataReaderImpl::dds_demarshal: ")
                     ACE_TEXT("attempting to skip serialize but bad from_message_block. Returning from demarshal.\n")));
         }
-        return;
+        return false;
       }
-      store_instance_data(OPENDDS_MOVE_NS::move(data), publication_handle, sample.header_, instance, just_registered, filtered);
-      return;
+      return true;
     }
     const bool encapsulated = sample.header_.cdr_encapsulation_;
 
@@ -1114,7 +1163,7 @@ protected:
             ACE_TEXT("deserialization of encapsulation header failed.\n"),
             TraitsType::type_name()));
         }
-        return;
+        return false;
       } else if (read_status == EncapsulationReadStatus::ExtensibilityMismatch) {
         if (log_level >= LogLevel::Error) {
           ACE_ERROR((LM_ERROR,
@@ -1124,7 +1173,7 @@ protected:
                      LogGuid(sample.header_.publication_id_).c_str(),
                      LogGuid(subscription_id()).c_str()));
         }
-        return;
+        return false;
       }
       const Encoding& encoding = ser.encoding();
 
@@ -1137,7 +1186,7 @@ protected:
             TraitsType::type_name(),
             Encoding::kind_to_string(encoding.kind()).c_str()));
         }
-        return;
+        return false;
       }
       if (DCPS_debug_level >= 8) {
         ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) ")
@@ -1171,7 +1220,7 @@ protected:
                     TraitsType::type_name()));
         }
       }
-      return;
+      return false;
     }
 
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
@@ -1193,18 +1242,18 @@ protected:
               to_string(static_cast<MessageId>(sample.header_.message_id_))));
           }
           filtered = true;
-          return;
+          return false;
         }
         const MessageType& type = static_cast<MessageType&>(*data);
         if (!content_filtered_topic_->filter(type, sample_only_has_key_fields)) {
           filtered = true;
-          return;
+          return false;
         }
       }
     }
 #endif
 
-    store_instance_data(OPENDDS_MOVE_NS::move(data), publication_handle, sample.header_, instance, just_registered, filtered);
+    return true;
   }
 
   virtual void dispose_unregister(const OpenDDS::DCPS::ReceivedDataSample& sample,
@@ -1261,6 +1310,7 @@ protected:
     const typename ReverseInstanceMap::iterator pos = reverse_instance_map_.find(handle);
     if (pos != reverse_instance_map_.end()) {
       remove_from_lookup_maps(handle);
+      instance_index_.erase(pos->second);
       instance_map_.erase(pos->second);
       reverse_instance_map_.erase(pos);
     }
@@ -1762,7 +1812,7 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
   //!!! caller should already have the sample_lock_
   //We will unlock it before calling into listeners
 
-  typename InstanceMap::const_iterator const it = instance_map_.find(*instance_data);
+  typename InstanceMap::const_iterator const it = instance_index_.find(*instance_data);
 
   if (it == instance_map_.end()) {
     if (is_dispose_msg || is_unregister_msg) {
@@ -1918,6 +1968,7 @@ void store_instance_data(unique_ptr<MessageTypeWithAllocator> instance_data,
       }
       return;
     }
+    instance_index_.insert(bpair.first);
     reverse_instance_map_[handle] = bpair.first;
   }
   else
@@ -2476,6 +2527,8 @@ unique_ptr<DataAllocator> data_allocator_;
 
 InstanceMap instance_map_;
 ReverseInstanceMap reverse_instance_map_;
+/// Optional constant time lookup of instance_map_ entries by key
+InstanceIndex instance_index_;
 
 typedef DCPS::PmfNowEvent<DataReaderImpl_T> DRIEvent;
 
@@ -245,11 +245,20 @@ DataWriterImpl::add_association(const ReaderAssociation& reader,
 
   {
     ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
-    reader_info_.insert(std::make_pair(reader.readerId,
-                                       ReaderInfo(reader.filterClassName,
-                                                  publisher_content_filter_ ? reader.filterExpression.in() : "",
-                                                  reader.exprParams, participant_servant_,
-                                                  reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS)));
+    const std::pair<RepoIdToReaderInfoMap::iterator, bool> inserted =
+      reader_info_.insert(std::make_pair(reader.readerId,
+                                         ReaderInfo(reader.filterClassName,
+                                                    publisher_content_filter_ ? reader.filterExpression.in() : "",
+                                                    reader.exprParams, participant_servant_,
+                                                    reader.readerQos.durability.kind > DDS::VOLATILE_DURABILITY_QOS)));
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+    const ReaderInfo& ri = inserted.first->second;
+    if (inserted.second && ri.eval_) {
+      content_filter_index_.insert(reader.readerId, ri.eval_, ri.expression_params_);
+    }
+#else
+    ACE_UNUSED_ARG(inserted);
+#endif
   }
 
   if (DCPS_debug_level > 4) {
@@ -622,6 +631,10 @@ DataWriterImpl::remove_associations(const ReaderIdSeq & readers,
       data_container_->remove_reader_acks(readers[i]);
 
       ACE_GUARD(ACE_Thread_Mutex, reader_info_guard, this->reader_info_lock_);
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+      // Before the ReaderInfo releases its filter
+      content_filter_index_.remove(readers[i]);
+#endif
       reader_info_.erase(readers[i]);
       //else reader is already removed which indicates remove_association()
       //is called multiple times.
@@ -910,6 +923,9 @@ DataWriterImpl::update_subscription_params(const GUID_t& readerId,
 
   if (iter != reader_info_.end()) {
     iter->second.expression_params_ = params;
+    if (iter->second.eval_) {
+      content_filter_index_.insert(readerId, iter->second.eval_, params);
+    }
 
   } else if (DCPS_debug_level > 4 &&
              publisher_content_filter_) {
@@ -3217,17 +3233,9 @@ DDS::ReturnCode_t DataWriterImpl::write_w_timestamp(
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
   if (publisher_content_filter_) {
     ACE_GUARD_RETURN(ACE_Thread_Mutex, reader_info_guard, reader_info_lock_, DDS::RETCODE_ERROR);
-    for (RepoIdToReaderInfoMap::iterator iter = reader_info_.begin(),
-         end = reader_info_.end(); iter != end; ++iter) {
-      const ReaderInfo& ri = iter->second;
-      if (!ri.eval_.is_nil()) {
-        if (!filter_out.ptr()) {
-          filter_out = new OpenDDS::DCPS::GUIDSeq;
-        }
-        if (!sample.eval(*ri.eval_, ri.expression_params_)) {
-          push_back(filter_out.inout(), iter->first);
-        }
-      }
+    if (!content_filter_index_.empty()) {
+      filter_out = new OpenDDS::DCPS::GUIDSeq;
+      content_filter_index_.filter_out(sample, filter_out.inout());
     }
   }
 #endif
@@ -3253,6 +3261,96 @@ DDS::ReturnCode_t DataWriterImpl::write_sample(
   return write(OPENDDS_MOVE_NS::move(serialized), handle, source_timestamp, filter_out, sample.native_data());
 }
 
+ACE_Message_Block* DataWriterImpl::loan_sample(size_t max_size)
+{
+  if (!enabled_ || skip_serialize_ || !encoding_mode_.valid()) {
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl::loan_sample: "
+        "writer is not enabled or doesn't serialize samples\n"));
+    }
+    return 0;
+  }
+
+  // The cached data allocator only exists for bounded types and its chunks
+  // are sized for the bound, so use it unless the loan wouldn't fit.
+  const SerializedSizeBound bound = encoding_mode_.buffer_size_bound();
+  const size_t size = (cdr_encapsulation() ? EncapsulationHeader::serialized_size : 0) + max_size;
+  const bool use_data_allocator = data_allocator_.get() && bound && size <= bound.get();
+
+  Message_Block_Ptr mb;
+  ACE_Message_Block* tmp_mb;
+  ACE_NEW_MALLOC_RETURN(tmp_mb,
+    static_cast<ACE_Message_Block*>(
+      mb_allocator_->malloc(sizeof(ACE_Message_Block))),
+    ACE_Message_Block(
+      use_data_allocator ? bound.get() : size,
+      ACE_Message_Block::MB_DATA,
+      0, // cont
+      0, // data
+      use_data_allocator ? data_allocator_.get() : 0, // allocator_strategy
+      get_db_lock(), // data block locking_strategy
+      ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY,
+      ACE_Time_Value::zero,
+      ACE_Time_Value::max_time,
+      db_allocator_.get(),
+      mb_allocator_.get()),
+    0);
+  mb.reset(tmp_mb);
+
+  if (cdr_encapsulation()) {
+    Serializer serializer(mb.get(), encoding_mode_.encoding());
+    EncapsulationHeader encap;
+    if (!from_encoding(encap, encoding_mode_.encoding(), type_support_->base_extensibility())) {
+      // from_encoding logged the error
+      return 0;
+    }
+    if (!(serializer << encap)) {
+      if (log_level >= LogLevel::Error) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::loan_sample: "
+          "failed to serialize data encapsulation header\n"));
+      }
+      return 0;
+    }
+  }
+
+  return mb.release();
+}
+
+DDS::ReturnCode_t DataWriterImpl::write_loaned_sample(
+  ACE_Message_Block* sample,
+  DDS::InstanceHandle_t handle,
+  const DDS::Time_t& source_timestamp,
+  const void* real_data)
+{
+  Message_Block_Ptr serialized(sample);
+  if (!serialized || handle == DDS::HANDLE_NIL) {
+    return DDS::RETCODE_BAD_PARAMETER;
+  }
+
+  if (cdr_encapsulation() && !EncapsulationHeader::set_encapsulation_options(serialized)) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DataWriterImpl::write_loaned_sample: "
+        "set_encapsulation_options failed\n"));
+    }
+    return DDS::RETCODE_ERROR;
+  }
+
+  // list of reader GUID_ts that should not get data
+  GUIDSeq_var filter_out;
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+  if (publisher_content_filter_ && type_support_) {
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, reader_info_guard, reader_info_lock_, DDS::RETCODE_ERROR);
+    if (!content_filter_index_.empty()) {
+      filter_out = new OpenDDS::DCPS::GUIDSeq;
+      content_filter_index_.filter_out(serialized.get(), encoding_mode_.encoding(),
+                                       *type_support_, filter_out.inout());
+    }
+  }
+#endif
+
+  return write(OPENDDS_MOVE_NS::move(serialized), handle, source_timestamp, filter_out._retn(), real_data);
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
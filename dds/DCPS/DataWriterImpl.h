@@ -30,6 +30,7 @@
 #include "transport/framework/TransportSendListener.h"
 
 #ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+#  include "ContentFilterIndex.h"
 #  include "FilterEvaluator.h"
 #endif
 
@@ -286,6 +287,32 @@ public:
     const DDS::Time_t& source_timestamp,
     GUIDSeq* filter_out);
 
+  /**
+   * Zero-copy write support.  loan_sample returns a message block from
+   * this writer's allocators with room for max_size bytes of serialized
+   * sample after the encapsulation header, which is already written.  The
+   * application serializes the sample into it using
+   * loaned_sample_encoding() and passes it to write_loaned_sample, which
+   * takes ownership and hands the block to the WriteDataContainer and the
+   * transport without copying it.  A loan that isn't written is returned
+   * with ACE_Message_Block::release.  Returns null if the writer isn't
+   * enabled or serialization is skipped.
+   */
+  ACE_Message_Block* loan_sample(size_t max_size);
+
+  const Encoding& loaned_sample_encoding() const
+  {
+    return encoding_mode_.encoding();
+  }
+
+  /// The instance handle must be for a registered instance.  real_data is
+  /// the value of the sample for observers, if it's available.
+  DDS::ReturnCode_t write_loaned_sample(
+    ACE_Message_Block* sample,
+    DDS::InstanceHandle_t handle,
+    const DDS::Time_t& source_timestamp,
+    const void* real_data = 0);
+
   /**
    * Delegate to the WriteDataContainer to dispose all data
    * samples for a given instance and tell the transport to
@@ -585,6 +612,10 @@ protected:
 
   typedef OPENDDS_MAP_CMP(GUID_t, ReaderInfo, GUID_tKeyLessThan) RepoIdToReaderInfoMap;
   RepoIdToReaderInfoMap reader_info_;
+#ifndef OPENDDS_NO_CONTENT_FILTERED_TOPIC
+  /// Filters of reader_info_, also protected by reader_info_lock_
+  ContentFilterIndex content_filter_index_;
+#endif
 
   struct AckCustomization {
     GUIDSeq customized_;
@@ -96,6 +96,59 @@ public:
     return DataWriterImpl::write_w_timestamp(sample, handle, source_timestamp);
   }
 
+  /// Write a sample serialized into a block from DataWriterImpl::loan_sample
+  /// without copying it.  This takes ownership of the block, even on error.
+  /// Keyed types need the handle of the registered instance of the sample's
+  /// key.  The sample is deserialized to check that, and
+  /// RETCODE_PRECONDITION_NOT_MET is returned if the handle is for another
+  /// instance.
+  DDS::ReturnCode_t write_loaned(ACE_Message_Block* sample, DDS::InstanceHandle_t handle)
+  {
+    return write_loaned_w_timestamp(sample, handle, SystemTimePoint::now().to_idl_struct());
+  }
+
+  DDS::ReturnCode_t write_loaned_w_timestamp(
+    ACE_Message_Block* sample,
+    DDS::InstanceHandle_t handle,
+    const DDS::Time_t& source_timestamp)
+  {
+    if (!sample) {
+      return DDS::RETCODE_BAD_PARAMETER;
+    }
+
+    const bool keyed = DDSTraits<MessageType>::key_count() != 0;
+    MessageType data;
+    bool have_data = false;
+    if (keyed || get_observer(Observer::e_SAMPLE_SENT)) {
+      have_data = deserialize_loaned(*sample, data);
+      if (keyed && !have_data) {
+        ACE_Message_Block::release(sample);
+        if (log_level >= LogLevel::Notice) {
+          ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl_T::write_loaned_w_timestamp: "
+            "failed to deserialize the key of the loaned sample\n"));
+        }
+        return DDS::RETCODE_BAD_PARAMETER;
+      }
+    }
+
+    if (handle == DDS::HANDLE_NIL && !keyed) {
+      // All samples of a keyless type are the same instance.
+      handle = register_instance_w_timestamp(MessageType(), source_timestamp);
+    }
+    if (handle == DDS::HANDLE_NIL
+        || handle != lookup_instance(keyed ? data : MessageType())) {
+      ACE_Message_Block::release(sample);
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: DataWriterImpl_T::write_loaned_w_timestamp: "
+          "handle %d is not the registered instance of the loaned sample\n", handle));
+      }
+      return DDS::RETCODE_PRECONDITION_NOT_MET;
+    }
+
+    // Observers are given the value of the sample.
+    return DataWriterImpl::write_loaned_sample(sample, handle, source_timestamp, have_data ? &data : 0);
+  }
+
   DDS::ReturnCode_t dispose(const MessageType& instance_data, DDS::InstanceHandle_t instance_handle)
   {
     return dispose_w_timestamp(instance_data, instance_handle, SystemTimePoint::now().to_idl_struct());
@@ -129,6 +182,17 @@ public:
 private:
   typedef Sample_T<MessageType> SampleType;
 
+  bool deserialize_loaned(const ACE_Message_Block& sample, MessageType& data)
+  {
+    Message_Block_Ptr mb(sample.duplicate());
+    Serializer ser(mb.get(), loaned_sample_encoding());
+    if (cdr_encapsulation()
+        && read_encapsulation_header(ser, get_type_support()->base_extensibility()) != EncapsulationReadStatus::Ok) {
+      return false;
+    }
+    return ser >> data;
+  }
+
   // A class, normally provided by an unit test, that needs access to
   // private methods/members.
   friend class ::DDS_TEST;
@@ -24,12 +24,406 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
+namespace {
+  inline ACE_CDR::ULong lowest_bit(ACE_UINT32 x)
+  {
+#ifdef __GNUC__
+    return static_cast<ACE_CDR::ULong>(__builtin_ctz(x));
+#else
+    ACE_CDR::ULong i = 0;
+    for (; !(x & 1u); x >>= 1) {
+      ++i;
+    }
+    return i;
+#endif
+  }
+
+  inline ACE_CDR::ULong highest_bit(ACE_UINT32 x)
+  {
+#ifdef __GNUC__
+    return static_cast<ACE_CDR::ULong>(31 - __builtin_clz(x));
+#else
+    ACE_CDR::ULong i = 31;
+    for (; !(x & 0x80000000u); x <<= 1) {
+      --i;
+    }
+    return i;
+#endif
+  }
+
+  inline ACE_CDR::ULong count_bits(ACE_UINT32 x)
+  {
+    ACE_CDR::ULong count = 0;
+    for (; x; x &= x - 1) {
+      ++count;
+    }
+    return count;
+  }
+
+  /// Bits low through high (inclusive) of a word
+  inline ACE_UINT32 word_mask(ACE_CDR::ULong low, ACE_CDR::ULong high)
+  {
+    const ACE_UINT32 below_high = high == 31 ? 0xFFFFFFFFu : (1u << (high + 1)) - 1;
+    return below_high & ~((1u << low) - 1);
+  }
+
+  /// Index of the first bit at or after 'from' in an RTPS bitmap that is set
+  /// (or clear), or num_bits if there isn't one.
+  ACE_CDR::ULong find_rtps_bit(const ACE_CDR::Long bits[], ACE_CDR::ULong num_bits,
+                               ACE_CDR::ULong from, bool set)
+  {
+    while (from < num_bits) {
+      ACE_UINT32 word = static_cast<ACE_UINT32>(bits[from / 32]);
+      if (!set) {
+        word = ~word;
+      }
+      // The first bit is the msb
+      word &= 0xFFFFFFFFu >> (from % 32);
+      if (word) {
+        const ACE_CDR::ULong found = from / 32 * 32 + 31 - highest_bit(word);
+        return found < num_bits ? found : num_bits;
+      }
+      from = (from / 32 + 1) * 32;
+    }
+    return num_bits;
+  }
+}
+
+DisjointSequence::RangeCursor::RangeCursor(const DisjointSequence& seq)
+  : seq_(seq)
+  , iter_(seq.sequences_.begin())
+  , bit_(0)
+  , have_piece_(false)
+{
+}
+
+bool
+DisjointSequence::RangeCursor::next_piece(SequenceRange& range)
+{
+  // The ranges below the window, then the window, then the rest of the tree
+  if (iter_ != seq_.sequences_.end()
+      && (bit_ == WINDOW_BITS || iter_->first.getValue() < seq_.window_base_)) {
+    range = *iter_++;
+    return true;
+  }
+  if (bit_ == WINDOW_BITS) {
+    return false;
+  }
+  bit_ = seq_.window_find(bit_, true);
+  if (bit_ == WINDOW_BITS) {
+    return next_piece(range);
+  }
+  const ACE_CDR::ULong end = seq_.window_find(bit_, false);
+  range = SequenceRange(seq_.window_base_ + bit_, seq_.window_base_ + (end - 1));
+  bit_ = end;
+  return true;
+}
+
+bool
+DisjointSequence::RangeCursor::next(SequenceRange& range)
+{
+  if (!have_piece_ && !next_piece(piece_)) {
+    return false;
+  }
+  range = piece_;
+  have_piece_ = false;
+  while (next_piece(piece_)) {
+    if (piece_.first.getValue() - 1 != range.second.getValue()) {
+      have_piece_ = true;
+      break;
+    }
+    range.second = piece_.second;
+  }
+  return true;
+}
+
+SequenceNumber
+DisjointSequence::low() const
+{
+  if (!sequences_.empty() && sequences_.begin()->first.getValue() < window_base_) {
+    return sequences_.begin()->first;
+  }
+  if (window_count_) {
+    return window_base_ + window_find(0, true);
+  }
+  return sequences_.begin()->first;
+}
+
+SequenceNumber
+DisjointSequence::high() const
+{
+  if (!sequences_.empty()
+      && sequences_.rbegin()->second.getValue() - window_base_ >= WINDOW_BITS) {
+    return sequences_.rbegin()->second;
+  }
+  if (window_count_) {
+    return window_base_ + window_rfind(WINDOW_BITS - 1, true);
+  }
+  return sequences_.rbegin()->second;
+}
+
+SequenceNumber
+DisjointSequence::cumulative_ack() const
+{
+  RangeCursor cursor(*this);
+  SequenceRange range;
+  return cursor.next(range) ? range.second : SequenceNumber::SEQUENCENUMBER_UNKNOWN();
+}
+
+SequenceNumber
+DisjointSequence::last_ack() const
+{
+  if (empty()) {
+    return SequenceNumber::SEQUENCENUMBER_UNKNOWN();
+  }
+
+  // Find the end of the last run of bits in the window that could be part of
+  // the highest range.
+  ACE_CDR::ULong end = 0;
+  const RangeSet::const_reverse_iterator last = sequences_.rbegin();
+  if (last != sequences_.rend() && last->first.getValue() - window_base_ >= WINDOW_BITS) {
+    if (last->first.getValue() - window_base_ != WINDOW_BITS || !window_has(WINDOW_BITS - 1)) {
+      return last->first;
+    }
+    end = WINDOW_BITS;
+  } else if (window_count_) {
+    end = window_rfind(WINDOW_BITS - 1, true) + 1;
+  } else {
+    return last->first;
+  }
+
+  const ACE_CDR::ULong clear = window_rfind(end - 1, false);
+  if (clear != WINDOW_BITS) {
+    return window_base_ + clear + 1;
+  }
+
+  // The run starts at the start of the window, it could continue below it
+  const RangeSet::const_iterator below =
+    sequences_.ranges_.lower_bound(SequenceRange(0 /*ignored*/, window_base_ - 1));
+  if (below != sequences_.end() && below->second.getValue() == window_base_ - 1) {
+    return below->first;
+  }
+  return window_base_;
+}
+
+bool
+DisjointSequence::contains_any(const SequenceRange& range) const
+{
+  const SequenceNumber::Value first = range.first.getValue(), last = range.second.getValue();
+  if (first < window_base_
+      && sequences_.has_any(range.first, last < window_base_ ? range.second : SequenceNumber(window_base_ - 1))) {
+    return true;
+  }
+  if (last >= window_base_ && first - window_base_ < WINDOW_BITS) {
+    const ACE_CDR::ULong low = first < window_base_ ? 0 : static_cast<ACE_CDR::ULong>(first - window_base_);
+    const ACE_CDR::ULong high = last - window_base_ >= WINDOW_BITS
+      ? WINDOW_BITS - 1 : static_cast<ACE_CDR::ULong>(last - window_base_);
+    if (window_find(low, true) <= high) {
+      return true;
+    }
+  }
+  if (last - window_base_ >= WINDOW_BITS) {
+    const SequenceNumber::Value above = window_base_ + WINDOW_BITS;
+    return sequences_.has_any(first < above ? SequenceNumber(above) : range.first, range.second);
+  }
+  return false;
+}
+
+ACE_CDR::ULong
+DisjointSequence::window_find(ACE_CDR::ULong from, bool set) const
+{
+  while (from < WINDOW_BITS) {
+    ACE_UINT32 word = set ? window_[from / 32] : ~window_[from / 32];
+    word &= ~((1u << (from % 32)) - 1);
+    if (word) {
+      return from / 32 * 32 + lowest_bit(word);
+    }
+    from = (from / 32 + 1) * 32;
+  }
+  return WINDOW_BITS;
+}
+
+ACE_CDR::ULong
+DisjointSequence::window_rfind(ACE_CDR::ULong from, bool set) const
+{
+  for (ACE_CDR::ULong idx = from / 32 + 1; idx > 0; --idx) {
+    ACE_UINT32 word = set ? window_[idx - 1] : ~window_[idx - 1];
+    if (idx - 1 == from / 32) {
+      word &= word_mask(0, from % 32);
+    }
+    if (word) {
+      return (idx - 1) * 32 + highest_bit(word);
+    }
+  }
+  return WINDOW_BITS;
+}
+
+bool
+DisjointSequence::window_insert(ACE_CDR::ULong low, ACE_CDR::ULong high,
+                                OPENDDS_VECTOR(SequenceRange)* gaps)
+{
+  if (gaps) {
+    for (ACE_CDR::ULong bit = window_find(low, false); bit <= high;) {
+      ACE_CDR::ULong end = window_find(bit, true);
+      if (end > high + 1) {
+        end = high + 1;
+      }
+      gaps->push_back(SequenceRange(window_base_ + bit, window_base_ + (end - 1)));
+      if (end > high) {
+        break;
+      }
+      bit = window_find(end, false);
+    }
+  }
+
+  ACE_CDR::ULong added = 0;
+  for (ACE_CDR::ULong idx = low / 32; idx <= high / 32; ++idx) {
+    const ACE_UINT32 mask = word_mask(idx == low / 32 ? low % 32 : 0,
+                                      idx == high / 32 ? high % 32 : 31);
+    added += count_bits(mask & ~window_[idx]);
+    window_[idx] |= mask;
+  }
+  window_count_ += added;
+  return added != 0;
+}
+
+void
+DisjointSequence::advance_window(SequenceNumber::Value first, SequenceNumber::Value last)
+{
+  static const SequenceNumber::Value max_base = SequenceNumber::MAX_VALUE - WINDOW_BITS + 1;
+  if (last - window_base_ < WINDOW_BITS || window_base_ == max_base) {
+    return;
+  }
+
+  SequenceNumber::Value new_base = window_base_;
+  if (window_count_ == 0) {
+    // Nothing to move out, start the window at the new range
+    new_base = first;
+  } else {
+    // Moving past a run of present numbers adds at most one range to the
+    // tree.  If that isn't enough, keep the newest numbers in the window and
+    // leave room for more.
+    new_base += window_find(0, false);
+    if (last - new_base >= WINDOW_BITS) {
+      new_base = (std::max)(new_base, last - WINDOW_BITS / 2 + 1);
+    }
+  }
+
+  if (new_base > max_base) {
+    new_base = max_base;
+  }
+  if (new_base > window_base_) {
+    slide_window(new_base);
+  }
+}
+
+void
+DisjointSequence::slide_window(SequenceNumber::Value new_base)
+{
+  const SequenceNumber::Value distance = new_base - window_base_;
+  const ACE_CDR::ULong shift =
+    distance < WINDOW_BITS ? static_cast<ACE_CDR::ULong>(distance) : ACE_CDR::ULong(WINDOW_BITS);
+
+  // Move the numbers below new_base to the tree
+  for (ACE_CDR::ULong bit = window_find(0, true); bit < shift;) {
+    ACE_CDR::ULong end = window_find(bit, false);
+    if (end > shift) {
+      end = shift;
+    }
+    insert_tree(SequenceRange(window_base_ + bit, window_base_ + (end - 1)), 0);
+    bit = window_find(end, true);
+  }
+
+  const ACE_CDR::ULong words = shift / 32, bits = shift % 32;
+  window_count_ = 0;
+  for (ACE_CDR::ULong idx = 0; idx < WINDOW_WORDS; ++idx) {
+    const ACE_CDR::ULong src = idx + words;
+    ACE_UINT32 word = 0;
+    if (src < WINDOW_WORDS) {
+      word = window_[src] >> bits;
+      if (bits && src + 1 < WINDOW_WORDS) {
+        word |= window_[src + 1] << (32 - bits);
+      }
+    }
+    window_[idx] = word;
+    window_count_ += count_bits(word);
+  }
+  window_base_ = new_base;
+
+  // Move the ranges in the tree that are now in the window to the window
+  const SequenceNumber::Value top = window_base_ + WINDOW_BITS - 1;
+  RangeSet::Container& ranges = sequences_.ranges_;
+  RangeSet::Container::iterator iter = ranges.lower_bound(SequenceRange(0 /*ignored*/, window_base_));
+  while (iter != ranges.end() && iter->first.getValue() <= top) {
+    const SequenceRange range = *iter;
+    ranges.erase(iter++);
+    const SequenceNumber::Value first = range.first.getValue(), last = range.second.getValue();
+    if (first < window_base_) {
+      ranges.insert(iter, SequenceRange(range.first, window_base_ - 1));
+    }
+    if (last > top) {
+      ranges.insert(iter, SequenceRange(top + 1, range.second));
+    }
+    window_insert(first < window_base_ ? 0 : static_cast<ACE_CDR::ULong>(first - window_base_),
+                  last > top ? WINDOW_BITS - 1 : static_cast<ACE_CDR::ULong>(last - window_base_),
+                  0);
+  }
+}
+
 bool
 DisjointSequence::insert_i(const SequenceRange& range,
                            OPENDDS_VECTOR(SequenceRange)* gaps /* = 0 */)
 {
   OPENDDS_ASSERT(range.first <= range.second);
 
+  const SequenceNumber::Value first = range.first.getValue(), last = range.second.getValue();
+  advance_window(first, last);
+
+  // Insert the parts below, inside, and above the window, in that order so
+  // the gaps are in order.
+  const size_t gaps_before = gaps ? gaps->size() : 0;
+  bool inserted = false;
+  if (first < window_base_) {
+    const SequenceRange below(range.first,
+                              last < window_base_ ? range.second : SequenceNumber(window_base_ - 1));
+    if (insert_tree(below, gaps)) {
+      inserted = true;
+    }
+  }
+  if (last >= window_base_ && first - window_base_ < WINDOW_BITS) {
+    const ACE_CDR::ULong low = first < window_base_ ? 0 : static_cast<ACE_CDR::ULong>(first - window_base_);
+    const ACE_CDR::ULong high = last - window_base_ >= WINDOW_BITS
+      ? WINDOW_BITS - 1 : static_cast<ACE_CDR::ULong>(last - window_base_);
+    if (window_insert(low, high, gaps)) {
+      inserted = true;
+    }
+  }
+  if (last - window_base_ >= WINDOW_BITS) {
+    const SequenceNumber::Value above = window_base_ + WINDOW_BITS;
+    if (insert_tree(SequenceRange(first < above ? SequenceNumber(above) : range.first, range.second), gaps)) {
+      inserted = true;
+    }
+  }
+
+  if (gaps && gaps->size() > gaps_before + 1) {
+    // Join the gaps that were split at the edges of the window
+    size_t out = gaps_before;
+    for (size_t i = gaps_before + 1; i < gaps->size(); ++i) {
+      if ((*gaps)[i].first.getValue() - 1 == (*gaps)[out].second.getValue()) {
+        (*gaps)[out].second = (*gaps)[i].second;
+      } else {
+        (*gaps)[++out] = (*gaps)[i];
+      }
+    }
+    gaps->resize(out + 1);
+  }
+  return inserted;
+}
+
+bool
+DisjointSequence::insert_tree(const SequenceRange& range,
+                              OPENDDS_VECTOR(SequenceRange)* gaps)
+{
   typedef RangeSet::Container::iterator iter_t;
 
   iter_t range_above = sequences_.ranges_.lower_bound(range);
@@ -54,6 +448,26 @@ DisjointSequence::insert_i(const SequenceRange& range,
     sequences_.ranges_.lower_bound(SequenceRange(1 /*ignored*/,
                                                  (previous > 0) ? previous
                                                  : SequenceNumber::ZERO()));
+  if (gaps) {
+    // the parts of range that aren't covered by the ranges it overlaps
+    SequenceNumber::Value next = range.first.getValue();
+    bool covered = false;
+    for (iter_t gap_iter = range_below; !covered && gap_iter != sequences_.ranges_.end()
+           && gap_iter->first <= range.second; ++gap_iter) {
+      if (gap_iter->first.getValue() > next) {
+        gaps->push_back(SequenceRange(next, gap_iter->first.previous()));
+      }
+      if (gap_iter->second >= range.second) {
+        covered = true;
+      } else {
+        next = (std::max)(next, gap_iter->second.getValue() + 1);
+      }
+    }
+    if (!covered) {
+      gaps->push_back(SequenceRange(next, range.second));
+    }
+  }
+
   if (range_below != sequences_.ranges_.end()) {
     // if low end falls inside of the range_below range
     // then combine
@@ -61,24 +475,6 @@ DisjointSequence::insert_i(const SequenceRange& range,
       newRange.first = range_below->first;
     }
 
-    if (gaps) {
-      iter_t gap_iter = range_below;
-      if (range.first < gap_iter->second) {
-        gaps->push_back(SequenceRange(range.first,
-                                      gap_iter->second.previous()));
-      }
-      SequenceNumber last_gap = gap_iter++->second;
-      for (; gap_iter != range_above; ++gap_iter) {
-        const SequenceNumber in_range =
-          (std::min)(gap_iter->first.previous().getValue(), range.second.getValue());
-        gaps->push_back(SequenceRange(++last_gap, in_range));
-        last_gap = gap_iter->second;
-      }
-      if (last_gap < range.second) {
-        gaps->push_back(SequenceRange(++last_gap, range.second));
-      }
-    }
-
     sequences_.ranges_.erase(range_below, range_above);
   }
 
@@ -90,115 +486,19 @@ bool
 DisjointSequence::insert(SequenceNumber value, ACE_CDR::ULong num_bits,
                          const ACE_CDR::Long bits[])
 {
+  // See RTPS v2.1 section 9.4.2.6 SequenceNumberSet
   bool inserted = false;
-  RangeSet::Container::iterator iter = sequences_.ranges_.end();
-  bool range_start_is_valid = false;
-  SequenceNumber::Value range_start = 0;
   const SequenceNumber::Value val = value.getValue();
-
-  // See RTPS v2.1 section 9.4.2.6 SequenceNumberSet
-  for (ACE_CDR::ULong i = 0, x = 0, bit = 0; i < num_bits; ++i, ++bit) {
-
-    if (bit == 32) bit = 0;
-
-    if (bit == 0) {
-      x = static_cast<ACE_CDR::ULong>(bits[i / 32]);
-      if (x == 0) {
-        // skip an entire Long if it's all 0's (adds 32 due to ++i)
-        i += 31;
-        bit = 31;
-        //FUTURE: this could be generalized with something like the x86 "bsr"
-        //        instruction using compiler intrinsics, VC++ _BitScanReverse()
-        //        and GCC __builtin_clz()
-        continue;
-      }
-    }
-
-    if (x & (1u << (31 - bit))) {
-      if (!range_start_is_valid) {
-        range_start = val + i;
-        range_start_is_valid = true;
-      }
-    } else if (range_start_is_valid) {
-      // this is a "0" bit and we've previously seen a "1": insert a range
-      const SequenceNumber::Value to_insert = val + i - 1;
-      if (insert_bitmap_range(iter, SequenceRange(range_start, to_insert))) {
-        inserted = true;
-      }
-      range_start = 0;
-      range_start_is_valid = false;
-
-      if (iter != sequences_.ranges_.end() && iter->second.getValue() != to_insert) {
-        // skip ahead: next gap in sequence must be past iter->second
-        ACE_CDR::ULong next_i = ACE_CDR::ULong(iter->second.getValue() - val);
-        bit = next_i % 32;
-        if (next_i / 32 != i / 32 && next_i < num_bits) {
-          x = static_cast<ACE_CDR::ULong>(bits[next_i / 32]);
-        }
-        i = next_i;
-      }
-    }
-  }
-
-  if (range_start_is_valid) {
-    // iteration finished before we saw a "0" (inside a range)
-    SequenceNumber range_end = (value + static_cast<int>(num_bits)).previous();
-    if (insert_bitmap_range(iter, SequenceRange(range_start, range_end))) {
-      return true;
+  for (ACE_CDR::ULong i = find_rtps_bit(bits, num_bits, 0, true); i < num_bits;) {
+    const ACE_CDR::ULong end = find_rtps_bit(bits, num_bits, i, false);
+    if (insert_i(SequenceRange(val + i, val + (end - 1)))) {
+      inserted = true;
     }
+    i = find_rtps_bit(bits, num_bits, end, true);
   }
   return inserted;
 }
 
-bool
-DisjointSequence::insert_bitmap_range(RangeSet::Container::iterator& iter,
-                                      const SequenceRange& range)
-{
-  // This is similar to insert_i(), except it doesn't need an O(log(n)) search
-  // of sequences_ every time to find the starting point, and it doesn't
-  // compute the 'gaps'.
-
-  const SequenceNumber::Value previous = range.first.getValue() - 1,
-    next = range.second.getValue() + 1;
-
-  if (!sequences_.empty()) {
-    if (iter == sequences_.ranges_.end()) {
-      iter = sequences_.ranges_.lower_bound(SequenceRange(0 /*ignored*/, previous));
-    } else {
-      // start where we left off last time and get the lower_bound(previous)
-      for (; iter != sequences_.ranges_.end() && iter->second < previous; ++iter) ;
-    }
-  }
-
-  if (iter == sequences_.ranges_.end() || iter->first > next) {
-    // can't combine on either side, insert a new range
-    iter = sequences_.ranges_.insert(iter, range);
-    return true;
-  }
-
-  if (iter->first <= range.first && iter->second >= range.second) {
-    // range is already covered by this DisjointSet
-    return false;
-  }
-
-  // find the right-most (highest) range we can use
-  RangeSet::Container::iterator right = iter;
-  for (; right != sequences_.ranges_.end() && right->second < next; ++right) ;
-
-  SequenceNumber high = range.second;
-  if (right != sequences_.ranges_.end()
-      && right->first <= next && right->first > range.first) {
-    high = right->second;
-    ++right;
-  }
-
-  const SequenceNumber low = (std::min)(iter->first, range.first);
-  sequences_.ranges_.erase(iter, right);
-
-  iter = sequences_.ranges_.insert(SequenceRange(low, high)).first;
-  return true;
-}
-
 bool
 DisjointSequence::to_bitmap(ACE_CDR::Long bitmap[], ACE_CDR::ULong length,
                             ACE_CDR::ULong& num_bits, ACE_CDR::ULong& cumulative_bits_added, bool invert) const
@@ -209,20 +509,22 @@ DisjointSequence::to_bitmap(ACE_CDR::Long bitmap[], ACE_CDR::ULong length,
     return true;
   }
 
-  const SequenceNumber base = ++SequenceNumber(cumulative_ack());
+  RangeCursor cursor(*this);
+  SequenceRange prev, range;
+  cursor.next(prev);
+  const SequenceNumber base = ++SequenceNumber(prev.second);
 
-  for (RangeSet::const_iterator iter = sequences_.begin(), prev = iter++;
-       iter != sequences_.end(); ++iter, ++prev) {
+  for (; cursor.next(range); prev = range) {
 
     ACE_CDR::ULong low = 0, high = 0;
 
     if (invert) {
-      low = ACE_CDR::ULong(prev->second.getValue() + 1 - base.getValue());
-      high = ACE_CDR::ULong(iter->first.getValue() - 1 - base.getValue());
+      low = ACE_CDR::ULong(prev.second.getValue() + 1 - base.getValue());
+      high = ACE_CDR::ULong(range.first.getValue() - 1 - base.getValue());
 
     } else {
-      low = ACE_CDR::ULong(iter->first.getValue() - base.getValue());
-      high = ACE_CDR::ULong(iter->second.getValue() - base.getValue());
+      low = ACE_CDR::ULong(range.first.getValue() - base.getValue());
+      high = ACE_CDR::ULong(range.second.getValue() - base.getValue());
     }
 
     if (!fill_bitmap_range(low, high, bitmap, length, num_bits, cumulative_bits_added)) {
@@ -307,12 +609,12 @@ DisjointSequence::missing_sequence_ranges() const
     return missing;
   }
 
-  RangeSet::const_iterator secondIter = sequences_.begin();
-  for (RangeSet::const_iterator firstIter = secondIter++;
-       secondIter != sequences_.end(); ++firstIter, ++secondIter) {
+  RangeCursor cursor(*this);
+  SequenceRange prev, range;
+  for (cursor.next(prev); cursor.next(range); prev = range) {
 
-    const SequenceNumber missingLow = ++SequenceNumber(firstIter->second),
-                         missingHigh = secondIter->first.previous();
+    const SequenceNumber missingLow = ++SequenceNumber(prev.second),
+                         missingHigh = range.first.previous();
 
     if (missingLow <= missingHigh) {
       missing.push_back(SequenceRange(missingLow, missingHigh));
@@ -322,15 +624,28 @@ DisjointSequence::missing_sequence_ranges() const
   return missing;
 }
 
+OPENDDS_VECTOR(SequenceRange)
+DisjointSequence::present_sequence_ranges() const
+{
+  OPENDDS_VECTOR(SequenceRange) present;
+  RangeCursor cursor(*this);
+  SequenceRange range;
+  while (cursor.next(range)) {
+    present.push_back(range);
+  }
+  return present;
+}
+
 void
 DisjointSequence::dump() const
 {
   ACE_DEBUG((LM_DEBUG, "(%P|%t) DisjointSequence[%X]::dump included ranges of "
                        "SequenceNumbers:\n", this));
-  for (RangeSet::const_iterator iter = sequences_.begin();
-       iter != sequences_.end(); ++iter) {
+  RangeCursor cursor(*this);
+  SequenceRange range;
+  while (cursor.next(range)) {
     ACE_DEBUG((LM_DEBUG, "(%P|%t) DisjointSequence[%X]::dump\t%q-%q\n",
-               this, iter->first.getValue(), iter->second.getValue()));
+               this, range.first.getValue(), range.second.getValue()));
   }
 }
 
@@ -343,9 +658,19 @@ DisjointSequence::bitmap_num_longs(const SequenceNumber& low, const SequenceNumb
 void
 DisjointSequence::erase(const SequenceNumber value)
 {
+  const SequenceNumber::Value v = value.getValue();
+  if (in_window(v)) {
+    const ACE_CDR::ULong bit = static_cast<ACE_CDR::ULong>(v - window_base_);
+    if (window_has(bit)) {
+      window_[bit / 32] &= ~(1u << (bit % 32));
+      --window_count_;
+    }
+    return;
+  }
+
   RangeSet::Container::iterator iter =
     sequences_.ranges_.lower_bound(SequenceRange(0 /*ignored*/, value));
-  if (iter != sequences_.ranges_.end()) {
+  if (iter != sequences_.ranges_.end() && iter->first <= value) {
     if (iter->first == value &&
         iter->second == value) {
       sequences_.ranges_.erase(iter);
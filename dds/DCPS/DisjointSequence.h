@@ -11,6 +11,8 @@
 #include "SequenceNumber.h"
 #include "PoolAllocator.h"
 
+#include <cstring>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -20,6 +22,9 @@ namespace DCPS {
 /// Sequence numbers can be inserted as single numbers, ranges,
 /// or RTPS-style bitmaps.  The DisjointSequence can then be queried for
 /// contiguous ranges and internal gaps.
+/// Internally, the SequenceNumbers in a window just above the lowest range
+/// are kept in a bitmap and the rest are kept as ranges in a tree, so that
+/// numbers inserted in roughly increasing order rarely change the tree.
 class OpenDDS_Dcps_Export DisjointSequence {
 public:
 
@@ -284,14 +289,59 @@ public:
 
 private:
   typedef OrderedRanges<SequenceNumber> RangeSet;
+  /// SequenceNumbers outside of the window
   RangeSet sequences_;
 
+  /// Bit n % 32 of window_[n / 32] is set if window_base_ + n is in the set.
+  /// The tree never has ranges that overlap the window.  Inserting past the
+  /// end of the window moves it up, moving what's below it to the tree.
+  enum { WINDOW_WORDS = 8, WINDOW_BITS = WINDOW_WORDS * 32 };
+  SequenceNumber::Value window_base_;
+  ACE_CDR::ULong window_count_;
+  ACE_UINT32 window_[WINDOW_WORDS];
+
+  /// Visits the ranges of the set in order, joining the ones that meet at
+  /// the edges of the window.
+  class RangeCursor {
+  public:
+    explicit RangeCursor(const DisjointSequence& seq);
+    bool next(SequenceRange& range);
+
+  private:
+    bool next_piece(SequenceRange& range);
+
+    const DisjointSequence& seq_;
+    RangeSet::const_iterator iter_;
+    ACE_CDR::ULong bit_;
+    bool have_piece_;
+    SequenceRange piece_;
+  };
+
   // helper methods:
 
   bool insert_i(const SequenceRange& range,
                 OPENDDS_VECTOR(SequenceRange)* gaps = 0);
 
-  bool insert_bitmap_range(RangeSet::Container::iterator& iter, const SequenceRange& sr);
+  bool insert_tree(const SequenceRange& range,
+                   OPENDDS_VECTOR(SequenceRange)* gaps);
+
+  bool in_window(SequenceNumber::Value value) const;
+  bool window_has(ACE_CDR::ULong bit) const;
+
+  /// Index of the first bit at or after 'from' that is set (or clear), or
+  /// WINDOW_BITS if there isn't one.
+  ACE_CDR::ULong window_find(ACE_CDR::ULong from, bool set) const;
+
+  /// Index of the last bit at or before 'from' that is set (or clear), or
+  /// WINDOW_BITS if there isn't one.
+  ACE_CDR::ULong window_rfind(ACE_CDR::ULong from, bool set) const;
+
+  bool window_insert(ACE_CDR::ULong low, ACE_CDR::ULong high,
+                     OPENDDS_VECTOR(SequenceRange)* gaps);
+
+  /// Move the window up if needed to make room for a range ending at last
+  void advance_window(SequenceNumber::Value first, SequenceNumber::Value last);
+  void slide_window(SequenceNumber::Value new_base);
 
 public:
   /// Set the bits in range [low, high] in the bitmap, updating num_bits.
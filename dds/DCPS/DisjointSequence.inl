@@ -10,55 +10,45 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-ACE_INLINE SequenceNumber
-DisjointSequence::low() const
-{
-  return sequences_.begin()->first;
-}
-
-ACE_INLINE SequenceNumber
-DisjointSequence::high() const
-{
-  return sequences_.rbegin()->second;
-}
-
-ACE_INLINE SequenceNumber
-DisjointSequence::cumulative_ack() const
-{
-  return sequences_.empty()
-    ? SequenceNumber::SEQUENCENUMBER_UNKNOWN()
-    : sequences_.begin()->second;
-}
-
-ACE_INLINE SequenceNumber
-DisjointSequence::last_ack() const
-{
-  return sequences_.empty()
-    ? SequenceNumber::SEQUENCENUMBER_UNKNOWN()
-    : sequences_.rbegin()->first;
-}
-
 ACE_INLINE bool
 DisjointSequence::empty() const
 {
-  return sequences_.empty();
+  return sequences_.empty() && window_count_ == 0;
 }
 
 ACE_INLINE bool
 DisjointSequence::disjoint() const
 {
-  return sequences_.size() > 1;
+  return !empty() && cumulative_ack() != high();
 }
 
 ACE_INLINE
 DisjointSequence::DisjointSequence()
+  : window_base_(0)
+  , window_count_(0)
 {
+  std::memset(window_, 0, sizeof window_);
 }
 
 ACE_INLINE void
 DisjointSequence::reset()
 {
   sequences_.clear();
+  window_base_ = 0;
+  window_count_ = 0;
+  std::memset(window_, 0, sizeof window_);
+}
+
+ACE_INLINE bool
+DisjointSequence::in_window(SequenceNumber::Value value) const
+{
+  return value >= window_base_ && value - window_base_ < WINDOW_BITS;
+}
+
+ACE_INLINE bool
+DisjointSequence::window_has(ACE_CDR::ULong bit) const
+{
+  return (window_[bit / 32] & (1u << (bit % 32))) != 0;
 }
 
 ACE_INLINE bool
@@ -91,26 +81,16 @@ DisjointSequence::insert_filtered(const SequenceRange& range, const DisjointSequ
   return true;
 }
 
-ACE_INLINE OPENDDS_VECTOR(SequenceRange)
-DisjointSequence::present_sequence_ranges() const
-{
-  OPENDDS_VECTOR(SequenceRange) present;
-  std::copy(sequences_.begin(), sequences_.end(), std::back_inserter(present));
-  return present;
-}
-
 ACE_INLINE bool
 DisjointSequence::contains(SequenceNumber value) const
 {
+  const SequenceNumber::Value v = value.getValue();
+  if (in_window(v)) {
+    return window_has(static_cast<ACE_CDR::ULong>(v - window_base_));
+  }
   return sequences_.has(value);
 }
 
-ACE_INLINE bool
-DisjointSequence::contains_any(const SequenceRange& range) const
-{
-  return sequences_.has_any(range);
-}
-
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -19,12 +19,36 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-DispatchService::DispatchService(size_t count)
+namespace {
+  struct FunArgMatches {
+    typedef std::pair<DispatchService::FunArgPair, DispatchService::TimerId> TimerPair;
+    explicit FunArgMatches(const DispatchService::FunArgPair& fun_arg) : fun_arg_(fun_arg) {}
+    bool operator()(const TimerPair& timer) const { return timer.first == fun_arg_; }
+    const DispatchService::FunArgPair fun_arg_;
+  };
+
+#ifdef ACE_HAS_CPP11
+  /// The DispatchService and worker queue of the thread, if it's in a
+  /// work-stealing pool
+  thread_local const DispatchService* current_service = 0;
+  thread_local size_t current_worker = 0;
+#endif
+}
+
+DispatchService::DispatchService(size_t count, bool timer_wheel, bool work_stealing)
  : cv_(mutex_)
  , allow_dispatch_(true)
  , stop_when_empty_(false)
  , running_(true)
- , running_threads_(0)
+ , running_threads_(count) // so shutdown waits for threads that haven't started yet
+ , use_timer_wheel_(timer_wheel)
+ , work_stealing_(work_stealing)
+ , worker_queues_(make_worker_queues(work_stealing ? (std::max)(count, size_t(1)) : 0))
+ , queued_(0)
+ , idle_threads_(0)
+ , next_queue_(0)
+ , halt_(false)
+ , next_worker_(0)
  , max_timer_id_(LONG_MAX)
  , pool_(count, run, this)
 {
@@ -41,6 +65,13 @@ void DispatchService::shutdown(bool immediate, EventQueue* const pending)
   allow_dispatch_ = false;
   stop_when_empty_ = true;
   running_ = running_ && !immediate; // && with existing state in case shutdown has already been called
+  if (immediate) {
+    halt_ = true;
+  }
+  for (WorkerQueues::const_iterator it = worker_queues_.begin(); it != worker_queues_.end(); ++it) {
+    ACE_Guard<ACE_Thread_Mutex> queue_guard((*it)->mutex_);
+    (*it)->closed_ = true;
+  }
   cv_.notify_all();
 
   if (pool_.contains(ACE_Thread::self())) {
@@ -60,15 +91,30 @@ void DispatchService::shutdown(bool immediate, EventQueue* const pending)
   if (pending) {
     pending->clear();
     pending->swap(event_queue_);
+    for (WorkerQueues::const_iterator it = worker_queues_.begin(); it != worker_queues_.end(); ++it) {
+      pending->insert(pending->end(), (*it)->queue_.begin(), (*it)->queue_.end());
+    }
     const TimerQueueMap& cmap = timer_queue_map_;
     for (TimerQueueMap::const_iterator it = cmap.begin(), limit = cmap.end(); it != limit; ++it) {
       pending->push_back(it->second.first);
     }
+    expired_timers_.clear();
+    timer_wheel_.clear(&expired_timers_);
+    for (OPENDDS_VECTOR(TimerPair)::const_iterator it = expired_timers_.begin(); it != expired_timers_.end(); ++it) {
+      pending->push_back(it->first);
+    }
+    expired_timers_.clear();
   } else {
     event_queue_.clear();
+    timer_wheel_.clear();
   }
+  for (WorkerQueues::const_iterator it = worker_queues_.begin(); it != worker_queues_.end(); ++it) {
+    (*it)->queue_.clear();
+  }
+  queued_ = 0;
   timer_queue_map_.clear();
   timer_id_map_.clear();
+  wheel_id_map_.clear();
 }
 
 DispatchService::DispatchStatus DispatchService::dispatch(FunPtr fun, void* arg)
@@ -77,6 +123,10 @@ DispatchService::DispatchStatus DispatchService::dispatch(FunPtr fun, void* arg)
     return DS_ERROR;
   }
 
+  if (work_stealing_) {
+    return enqueue(std::make_pair(fun, arg)) ? DS_SUCCESS : DS_ERROR;
+  }
+
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
   if (allow_dispatch_) {
     event_queue_.push_back(std::make_pair(fun, arg));
@@ -94,6 +144,13 @@ DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const
 
   TimerId id = 0;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (allow_dispatch_ && use_timer_wheel_) {
+    id = schedule_in_wheel(std::make_pair(fun, arg), expiration);
+    if (id != TI_FAILURE) {
+      cv_.notify_one();
+    }
+    return id;
+  }
   if (allow_dispatch_) {
     TimerQueueMap::iterator pos = timer_queue_map_.insert(std::make_pair(expiration, std::make_pair(std::make_pair(fun, arg), 0)));
     // Make it a loop in case we ever recycle timer ids
@@ -111,9 +168,37 @@ DispatchService::TimerId DispatchService::schedule(FunPtr fun, void* arg, const
   return TI_FAILURE;
 }
 
+DispatchService::TimerId DispatchService::schedule_in_wheel(const FunArgPair& fun_arg, const MonotonicTimePoint& expiration)
+{
+  const TimerId starting_id = max_timer_id_;
+  TimerId id = 0;
+  do {
+    id = max_timer_id_ = max_timer_id_ == LONG_MAX ? 1 : max_timer_id_ + 1;
+    if (id == starting_id) {
+      return TI_FAILURE; // all ids in use ?!
+    }
+  } while (wheel_id_map_.find(id) != wheel_id_map_.end());
+  wheel_id_map_[id] = timer_wheel_.insert(expiration, std::make_pair(fun_arg, id));
+  return id;
+}
+
 size_t DispatchService::cancel(DispatchService::TimerId id, void** arg)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (use_timer_wheel_) {
+    const WheelIdMap::iterator pos = wheel_id_map_.find(id);
+    if (pos == wheel_id_map_.end()) {
+      return 0;
+    }
+    if (arg) {
+      *arg = timer_wheel_.value(pos->second).first.second;
+    }
+    // Waiting threads will find nothing to do at the old deadline, so they
+    // aren't woken up.
+    timer_wheel_.erase(pos->second);
+    wheel_id_map_.erase(pos);
+    return 1;
+  }
   TimerIdMap::iterator pos = timer_id_map_.find(id);
   if (pos != timer_id_map_.end()) {
     if (pos->second == timer_queue_map_.begin()) {
@@ -134,6 +219,16 @@ size_t DispatchService::cancel(FunPtr fun, void* arg)
   OPENDDS_ASSERT(fun);
   size_t count = 0;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  if (use_timer_wheel_) {
+    expired_timers_.clear();
+    timer_wheel_.erase_if(FunArgMatches(std::make_pair(fun, arg)), expired_timers_);
+    for (OPENDDS_VECTOR(TimerPair)::const_iterator it = expired_timers_.begin(); it != expired_timers_.end(); ++it) {
+      wheel_id_map_.erase(it->second);
+    }
+    count = expired_timers_.size();
+    expired_timers_.clear();
+    return count;
+  }
   for (TimerQueueMap::iterator it = timer_queue_map_.begin(); it != timer_queue_map_.end();) {
     if (it->second.first.first == fun && it->second.first.second == arg) {
       if (it == timer_queue_map_.begin()) {
@@ -151,6 +246,9 @@ size_t DispatchService::cancel(FunPtr fun, void* arg)
 
 size_t DispatchService::queue_size() const
 {
+  if (work_stealing_) {
+    return queued_;
+  }
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
   return event_queue_.size();
 }
@@ -158,7 +256,11 @@ size_t DispatchService::queue_size() const
 ACE_THR_FUNC_RETURN DispatchService::run(void* arg)
 {
   DispatchService& dispatcher = *static_cast<DispatchService*>(arg);
-  dispatcher.run_event_loop();
+  if (dispatcher.work_stealing_) {
+    dispatcher.run_work_stealing_loop();
+  } else {
+    dispatcher.run_event_loop();
+  }
   return 0;
 }
 
@@ -167,7 +269,6 @@ void DispatchService::run_event_loop()
   ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
   ACE_Reverse_Lock<ACE_Thread_Mutex> rev_lock(mutex_);
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  ++running_threads_;
   while (running_) {
 
     // Logical Order:
@@ -176,26 +277,16 @@ void DispatchService::run_event_loop()
     // - Check for early exit before execution
     // - Run first task from event queue
 
-    if (allow_dispatch_ && !timer_queue_map_.empty()) {
-      const MonotonicTimePoint now = MonotonicTimePoint::now();
-
-      TimerQueueMap::iterator last = timer_queue_map_.upper_bound(now), pos = last;
-      while (pos != timer_queue_map_.begin()) {
-        --pos;
-        event_queue_.push_back(pos->second.first);
-        timer_id_map_.erase(pos->second.second);
-      }
-      if (last != timer_queue_map_.begin()) {
-        timer_queue_map_.erase(timer_queue_map_.begin(), last);
-      }
+    if (allow_dispatch_ && has_timers()) {
+      expire_timers(MonotonicTimePoint::now());
     }
 
+    MonotonicTimePoint deadline;
     if (event_queue_.empty()) {
       if (stop_when_empty_) {
         running_ = false;
         cv_.notify_all();
-      } else if (allow_dispatch_ && timer_queue_map_.size()) {
-        MonotonicTimePoint deadline(timer_queue_map_.begin()->first);
+      } else if (allow_dispatch_ && next_timer_deadline(deadline)) {
         cv_.wait_until(deadline, thread_status_manager);
       } else {
         cv_.wait(thread_status_manager);
@@ -214,6 +305,181 @@ void DispatchService::run_event_loop()
   cv_.notify_all();
 }
 
+void DispatchService::run_work_stealing_loop()
+{
+  ThreadStatusManager& thread_status_manager = TheServiceParticipant->get_thread_status_manager();
+  size_t worker = 0;
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    worker = next_worker_++ % worker_queues_.size();
+  }
+#ifdef ACE_HAS_CPP11
+  current_service = this;
+  current_worker = worker;
+#endif
+
+  FunArgPair fun_arg;
+  while (!halt_) {
+    // The first worker keeps timers moving while all the threads are busy,
+    // the others only look at them once they run out of work.
+    if (worker == 0) {
+      ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+      move_expired_timers(worker);
+    }
+
+    if (take_work(worker, fun_arg)) {
+      ThreadStatusManager::Event ev(thread_status_manager);
+      fun_arg.first(fun_arg.second);
+      continue;
+    }
+
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    move_expired_timers(worker);
+    // enqueue increments queued_ before checking idle_threads_, so either it
+    // sees this thread is idle and notifies it, or this sees the work.
+    ++idle_threads_;
+    if (queued_ == 0 && !halt_) {
+      MonotonicTimePoint deadline;
+      if (stop_when_empty_) {
+        --idle_threads_;
+        break;
+      } else if (allow_dispatch_ && next_timer_deadline(deadline)) {
+        cv_.wait_until(deadline, thread_status_manager);
+      } else {
+        cv_.wait(thread_status_manager);
+      }
+    }
+    --idle_threads_;
+  }
+
+#ifdef ACE_HAS_CPP11
+  current_service = 0;
+#endif
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  --running_threads_;
+  cv_.notify_all();
+}
+
+DispatchService::WorkerQueues DispatchService::make_worker_queues(size_t count)
+{
+  WorkerQueues queues;
+  for (size_t i = 0; i < count; ++i) {
+    queues.push_back(make_rch<WorkerQueue>());
+  }
+  return queues;
+}
+
+bool DispatchService::enqueue(const FunArgPair& fun_arg)
+{
+  size_t index;
+#ifdef ACE_HAS_CPP11
+  if (current_service == this) {
+    index = current_worker;
+  } else
+#endif
+  {
+    index = next_queue_++ % worker_queues_.size();
+  }
+
+  {
+    WorkerQueue& wq = *worker_queues_[index];
+    ACE_Guard<ACE_Thread_Mutex> guard(wq.mutex_);
+    if (wq.closed_) {
+      return false;
+    }
+    wq.queue_.push_back(fun_arg);
+    ++queued_;
+  }
+
+  if (idle_threads_ > 0) {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    cv_.notify_one();
+  }
+  return true;
+}
+
+bool DispatchService::take_work(size_t worker, FunArgPair& fun_arg)
+{
+  // Look at the thread's own queue first, then the others starting with the
+  // next one.
+  const size_t count = worker_queues_.size();
+  for (size_t i = 0; i < count && queued_ > 0; ++i) {
+    WorkerQueue& wq = *worker_queues_[(worker + i) % count];
+    ACE_Guard<ACE_Thread_Mutex> guard(wq.mutex_);
+    if (!wq.queue_.empty()) {
+      fun_arg = wq.queue_.front();
+      wq.queue_.pop_front();
+      --queued_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void DispatchService::move_expired_timers(size_t worker)
+{
+  if (!allow_dispatch_ || !has_timers()) {
+    return;
+  }
+  expire_timers(MonotonicTimePoint::now());
+  if (event_queue_.empty()) {
+    return;
+  }
+
+  const size_t count = event_queue_.size();
+  {
+    WorkerQueue& wq = *worker_queues_[worker];
+    ACE_Guard<ACE_Thread_Mutex> guard(wq.mutex_);
+    wq.queue_.insert(wq.queue_.end(), event_queue_.begin(), event_queue_.end());
+    queued_ += count;
+  }
+  event_queue_.clear();
+  if (count > 1 && idle_threads_ > 0) {
+    cv_.notify_all();
+  }
+}
+
+bool DispatchService::has_timers() const
+{
+  return use_timer_wheel_ ? !timer_wheel_.empty() : !timer_queue_map_.empty();
+}
+
+void DispatchService::expire_timers(const MonotonicTimePoint& now)
+{
+  if (use_timer_wheel_) {
+    expired_timers_.clear();
+    timer_wheel_.expire(now, expired_timers_);
+    for (OPENDDS_VECTOR(TimerPair)::const_iterator it = expired_timers_.begin(); it != expired_timers_.end(); ++it) {
+      event_queue_.push_back(it->first);
+      wheel_id_map_.erase(it->second);
+    }
+    expired_timers_.clear();
+    return;
+  }
+
+  TimerQueueMap::iterator last = timer_queue_map_.upper_bound(now), pos = last;
+  while (pos != timer_queue_map_.begin()) {
+    --pos;
+    event_queue_.push_back(pos->second.first);
+    timer_id_map_.erase(pos->second.second);
+  }
+  if (last != timer_queue_map_.begin()) {
+    timer_queue_map_.erase(timer_queue_map_.begin(), last);
+  }
+}
+
+bool DispatchService::next_timer_deadline(MonotonicTimePoint& deadline) const
+{
+  if (use_timer_wheel_) {
+    return timer_wheel_.next_deadline(deadline);
+  }
+  if (timer_queue_map_.empty()) {
+    return false;
+  }
+  deadline = timer_queue_map_.begin()->first;
+  return true;
+}
+
 } // DCPS
 } // OpenDDS
 
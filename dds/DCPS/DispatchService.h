@@ -8,11 +8,13 @@
 #ifndef OPENDDS_DCPS_DISPATCH_SERVICE_H
 #define OPENDDS_DCPS_DISPATCH_SERVICE_H
 
+#include "AtomicBool.h"
 #include "ConditionVariable.h"
 #include "Definitions.h"
 #include "RcObject.h"
 #include "ThreadPool.h"
 #include "TimePoint_T.h"
+#include "TimerWheel_T.h"
 
 #include <ace/Thread_Mutex.h>
 
@@ -62,8 +64,14 @@ public:
    * completion-order guarantee.
    *
    * @param count the requested size of the internal thread pool
+   * @param timer_wheel keep scheduled work in a TimerWheel, which schedules
+   * and cancels in constant time, instead of a time-ordered map
+   * @param work_stealing give each thread its own queue of immediate work
+   * instead of sharing one.  Work dispatched by a thread of the pool goes on
+   * its own queue, other work is spread across the queues, and threads that
+   * run out of work take it from the other queues.
    */
-  explicit DispatchService(size_t count = 1);
+  explicit DispatchService(size_t count = 1, bool timer_wheel = false, bool work_stealing = false);
 
   virtual ~DispatchService();
 
@@ -153,6 +161,28 @@ private:
 
   static ACE_THR_FUNC_RETURN run(void* arg);
   void run_event_loop();
+  void run_work_stealing_loop();
+
+  bool has_timers() const;
+  void expire_timers(const MonotonicTimePoint& now);
+  bool next_timer_deadline(MonotonicTimePoint& deadline) const;
+  TimerId schedule_in_wheel(const FunArgPair& fun_arg, const MonotonicTimePoint& expiration);
+
+  /// Queue of immediate work for one thread if work_stealing_
+  struct WorkerQueue : public RcObject {
+    WorkerQueue() : closed_(false) {}
+    ACE_Thread_Mutex mutex_;
+    EventQueue queue_;
+    /// Set by shutdown to reject further work
+    bool closed_;
+  };
+  typedef RcHandle<WorkerQueue> WorkerQueue_rch;
+  typedef OPENDDS_VECTOR(WorkerQueue_rch) WorkerQueues;
+
+  static WorkerQueues make_worker_queues(size_t count);
+  bool enqueue(const FunArgPair& fun_arg);
+  bool take_work(size_t worker, FunArgPair& fun_arg);
+  void move_expired_timers(size_t worker);
 
   typedef std::pair<FunArgPair, TimerId> TimerPair;
   typedef OPENDDS_MULTIMAP(MonotonicTimePoint, TimerPair) TimerQueueMap;
@@ -167,6 +197,30 @@ private:
   EventQueue event_queue_;
   TimerQueueMap timer_queue_map_;
   TimerIdMap timer_id_map_;
+
+  /// Used instead of timer_queue_map_ and timer_id_map_ if use_timer_wheel_
+  const bool use_timer_wheel_;
+  typedef TimerWheel<TimerPair> Wheel;
+  Wheel timer_wheel_;
+#ifdef ACE_HAS_CPP11
+  typedef OPENDDS_UNORDERED_MAP(TimerId, Wheel::Handle) WheelIdMap;
+#else
+  typedef OPENDDS_MAP(TimerId, Wheel::Handle) WheelIdMap;
+#endif
+  WheelIdMap wheel_id_map_;
+  OPENDDS_VECTOR(TimerPair) expired_timers_;
+
+  /// Used instead of event_queue_ if work_stealing_
+  const bool work_stealing_;
+  WorkerQueues worker_queues_;
+  /// Number of events in worker_queues_
+  Atomic<size_t> queued_;
+  Atomic<size_t> idle_threads_;
+  Atomic<size_t> next_queue_;
+  /// Set by an immediate shutdown
+  AtomicBool halt_;
+  size_t next_worker_;
+
   TimerId max_timer_id_;
   ThreadPool pool_;
 };
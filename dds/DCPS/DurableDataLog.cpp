@@ -0,0 +1,669 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "DCPS/DdsDcps_pch.h" //Only the _pch include should start with DCPS/
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include "DurableDataLog.h"
+
+#include "DirentWrapper.h"
+#include "debug.h"
+
+#include <ace/CDR_Base.h>
+#include <ace/OS_NS_errno.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/OS_NS_string.h>
+#include <ace/OS_NS_sys_stat.h>
+#include <ace/OS_NS_unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+namespace {
+
+// A segment starts with the magic and the byte order of the records.
+const char segment_magic[] = { 'O', 'D', 'D', 'S', 'L', 'O', 'G', '1' };
+const size_t segment_header_size = 16;
+
+// A record is a header (the length of the payload, the checksum of the rest
+// of the record, the kind, and the queue) followed by the payload and padding
+// to a multiple of 8 bytes.  The header is written after the payload so a
+// partially written record is zeros or has the wrong checksum.
+const size_t record_header_size = 16;
+const size_t record_alignment = 8;
+
+const ACE_UINT32 RECORD_QUEUE = 1; // domain, topic, type, and sample count
+const ACE_UINT32 RECORD_SAMPLE = 2; // timestamp and data
+const ACE_UINT32 RECORD_DROP = 3;
+
+const ACE_TCHAR segment_prefix[] = ACE_TEXT("_segment.");
+const size_t segment_prefix_length = 9;
+
+size_t record_size(size_t length)
+{
+  return (record_header_size + length + record_alignment - 1) / record_alignment * record_alignment;
+}
+
+// FNV-1a
+ACE_UINT32 checksum(ACE_UINT32 hash, const char* data, size_t length)
+{
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+  }
+  return hash;
+}
+
+ACE_UINT32 record_checksum(ACE_UINT32 kind, ACE_UINT32 queue, ACE_UINT32 length,
+                           const char* payload1, size_t length1,
+                           const char* payload2, size_t length2)
+{
+  ACE_UINT32 hash = 2166136261u;
+  hash = checksum(hash, reinterpret_cast<const char*>(&kind), sizeof kind);
+  hash = checksum(hash, reinterpret_cast<const char*>(&queue), sizeof queue);
+  hash = checksum(hash, reinterpret_cast<const char*>(&length), sizeof length);
+  hash = checksum(hash, payload1, length1);
+  return checksum(hash, payload2, length2);
+}
+
+ACE_UINT32 read_uint32(const char* pos)
+{
+  ACE_UINT32 value;
+  std::memcpy(&value, pos, sizeof value);
+  return value;
+}
+
+void write_uint32(char* pos, ACE_UINT32 value)
+{
+  std::memcpy(pos, &value, sizeof value);
+}
+
+void append_uint32(OPENDDS_VECTOR(char)& buffer, ACE_UINT32 value)
+{
+  const char* const bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof value);
+}
+
+void append_string(OPENDDS_VECTOR(char)& buffer, const char* str)
+{
+  const size_t length = std::strlen(str);
+  append_uint32(buffer, static_cast<ACE_UINT32>(length));
+  buffer.insert(buffer.end(), str, str + length);
+}
+
+bool read_string(const char*& pos, const char* end, String& str)
+{
+  if (end - pos < 4) {
+    return false;
+  }
+  const ACE_UINT32 length = read_uint32(pos);
+  pos += 4;
+  if (static_cast<size_t>(end - pos) < length) {
+    return false;
+  }
+  str.assign(pos, length);
+  pos += length;
+  return true;
+}
+
+}
+
+DurableDataLog::DurableDataLog(const String& dir, size_t segment_size, bool sync)
+  : dir_(dir)
+  , segment_size_((std::max)(segment_size, segment_header_size + record_size(0)))
+  , sync_(sync)
+  , active_(0)
+  , next_segment_(1)
+  , next_queue_(1)
+{
+}
+
+DurableDataLog::~DurableDataLog()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, mutex_);
+  for (SegmentMap::iterator pos = segments_.begin(); pos != segments_.end(); ++pos) {
+    sync(*pos->second);
+  }
+}
+
+bool DurableDataLog::open(QueueList& queues)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+
+  const ACE_TString dir(ACE_TEXT_CHAR_TO_TCHAR(dir_.c_str()));
+  if (ACE_OS::mkdir(dir.c_str()) == -1 && errno != EEXIST) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DurableDataLog::open: "
+                 "couldn't create directory %C: %p\n", dir_.c_str(), ACE_TEXT("mkdir")));
+    }
+    return false;
+  }
+
+  ACE_Dirent dirent;
+  if (dirent.open(dir.c_str()) == -1) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DurableDataLog::open: "
+                 "couldn't read directory %C: %p\n", dir_.c_str(), ACE_TEXT("opendir")));
+    }
+    return false;
+  }
+
+  OPENDDS_VECTOR(ACE_UINT32) ids;
+  while (ACE_DIRENT* const entry = dirent.read()) {
+    if (ACE_OS::strncmp(entry->d_name, segment_prefix, segment_prefix_length) == 0) {
+      ACE_TCHAR* end = 0;
+      const unsigned long id = ACE_OS::strtoul(entry->d_name + segment_prefix_length, &end, 16);
+      if (id && end && !*end) {
+        ids.push_back(static_cast<ACE_UINT32>(id));
+      }
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+
+  Recovery recovery;
+  for (size_t i = 0; i != ids.size(); ++i) {
+    read_segment(ids[i], recovery);
+    next_segment_ = ids[i] + 1;
+  }
+
+  // Copies that weren't finished are ignored, the originals are still there.
+  // Queue ids increase, so this is the order the queues were begun in even
+  // if compact() moved them.
+  for (RecoveredMap::const_iterator pos = recovery.current.begin();
+       pos != recovery.current.end(); ++pos) {
+    // A queue that's missing samples wasn't committed, either because
+    // insert() stopped before commit() or because only some of its pages
+    // were written back.  Its records aren't live, so they are deleted with
+    // their segments.
+    if (pos->second.queue.samples.size() != pos->second.sample_count) {
+      if (log_level >= LogLevel::Notice) {
+        ACE_DEBUG((LM_NOTICE, "(%P|%t) NOTICE: DurableDataLog::open: "
+                   "ignoring queue %u of topic %C that has %B of %B samples\n",
+                   pos->first, pos->second.queue.topic_name.c_str(),
+                   pos->second.queue.samples.size(), pos->second.sample_count));
+      }
+      continue;
+    }
+    QueueRecords& qr = queues_[pos->first];
+    qr.records = pos->second.records;
+    qr.segments = recovery.segments[pos->first];
+    for (RecordList::const_iterator r = qr.records.begin(); r != qr.records.end(); ++r) {
+      segments_[r->segment]->live += r->size;
+    }
+    queues.push_back(pos->second.queue);
+  }
+
+  for (DropMap::iterator pos = drops_.begin(); pos != drops_.end(); ++pos) {
+    Drop& drop = pos->second;
+    drop.segments = recovery.segments[pos->first];
+    drop.segments.erase(drop.record.segment);
+    segments_[drop.record.segment]->live += drop.record.size;
+  }
+
+  release_segments();
+  return true;
+}
+
+String DurableDataLog::segment_path(ACE_UINT32 id) const
+{
+  char name[32];
+  ACE_OS::snprintf(name, sizeof name, "_segment.%08x", static_cast<unsigned int>(id));
+  String path = dir_;
+  if (!path.empty() && path[path.size() - 1] != '/' && path[path.size() - 1] != '\\') {
+    path += '/';
+  }
+  return path + name;
+}
+
+void DurableDataLog::read_segment(ACE_UINT32 id, Recovery& recovery)
+{
+  const String path = segment_path(id);
+  Segment_rch segment = make_rch<Segment>();
+  if (segment->map.map(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()), static_cast<size_t>(-1),
+                       O_RDWR, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_SHARED) == -1) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DurableDataLog::read_segment: "
+                 "couldn't map %C: %p\n", path.c_str(), ACE_TEXT("map")));
+    }
+    return;
+  }
+
+  const char* const begin = segment->addr();
+  const size_t size = segment->map.size();
+  if (size < segment_header_size ||
+      std::memcmp(begin, segment_magic, sizeof segment_magic) != 0 ||
+      begin[sizeof segment_magic] != ACE_CDR_BYTE_ORDER) {
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: DurableDataLog::read_segment: "
+                 "%C isn't a segment written by this platform, ignoring it\n", path.c_str()));
+    }
+    return;
+  }
+
+  size_t pos = segment_header_size;
+  while (size - pos >= record_header_size) {
+    const char* const header = begin + pos;
+    const ACE_UINT32 length = read_uint32(header);
+    const ACE_UINT32 sum = read_uint32(header + 4);
+    const ACE_UINT32 kind = read_uint32(header + 8);
+    const QueueId queue = read_uint32(header + 12);
+    if (kind == 0 || length > size - pos - record_header_size) {
+      break;
+    }
+    const char* const payload = header + record_header_size;
+    if (sum != record_checksum(kind, queue, length, payload, length, 0, 0)) {
+      break;
+    }
+    const Record record = { id, pos, (std::min)(record_size(length), size - pos) };
+    if (!recover(kind, queue, payload, length, record, recovery)) {
+      break;
+    }
+    pos += record.size;
+  }
+
+  if (pos < size && log_level >= LogLevel::Notice) {
+    ACE_DEBUG((LM_NOTICE, "(%P|%t) NOTICE: DurableDataLog::read_segment: "
+               "%C ends at %B of %B bytes\n", path.c_str(), pos, size));
+  }
+
+  segment->used = segment->synced = pos;
+  segments_[id] = segment;
+}
+
+bool DurableDataLog::recover(ACE_UINT32 kind, QueueId queue, const char* payload, size_t length,
+                             const Record& record, Recovery& recovery)
+{
+  next_queue_ = (std::max)(next_queue_, queue + 1);
+  recovery.segments[queue].insert(record.segment);
+
+  if (kind == RECORD_QUEUE) {
+    Recovered recovered;
+    const char* pos = payload;
+    const char* const end = payload + length;
+    if (end - pos < 4) {
+      return false;
+    }
+    recovered.queue.id = queue;
+    recovered.queue.domain_id = static_cast<DDS::DomainId_t>(read_uint32(pos));
+    pos += 4;
+    if (!read_string(pos, end, recovered.queue.topic_name) ||
+        !read_string(pos, end, recovered.queue.type_name) ||
+        end - pos < 4) {
+      return false;
+    }
+    recovered.sample_count = read_uint32(pos);
+    recovered.records.push_back(record);
+
+    if (drops_.count(queue)) {
+      return true;
+    }
+    if (recovery.current.count(queue)) {
+      recovery.copies[queue] = recovered;
+    } else {
+      recovery.current[queue] = recovered;
+    }
+
+  } else if (kind == RECORD_SAMPLE) {
+    if (length < 8) {
+      return false;
+    }
+    Sample sample;
+    sample.timestamp.sec = static_cast<CORBA::Long>(read_uint32(payload));
+    sample.timestamp.nanosec = read_uint32(payload + 4);
+    sample.data = payload + 8;
+    sample.length = length - 8;
+
+    RecoveredMap::iterator copy = recovery.copies.find(queue);
+    if (copy != recovery.copies.end()) {
+      copy->second.queue.samples.push_back(sample);
+      copy->second.records.push_back(record);
+      if (copy->second.queue.samples.size() == copy->second.sample_count) {
+        recovery.current[queue] = copy->second;
+        recovery.copies.erase(copy);
+      }
+      return true;
+    }
+    RecoveredMap::iterator current = recovery.current.find(queue);
+    if (current != recovery.current.end()) {
+      current->second.queue.samples.push_back(sample);
+      current->second.records.push_back(record);
+    }
+
+  } else if (kind == RECORD_DROP) {
+    // The segments of the drop are set at the end of open().
+    if (recovery.current.erase(queue)) {
+      recovery.copies.erase(queue);
+      drops_[queue].record = record;
+    } else {
+      DropMap::iterator drop = drops_.find(queue);
+      if (drop != drops_.end()) {
+        // A copy made by compact()
+        drop->second.record = record;
+      }
+    }
+
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+char* DurableDataLog::reserve(size_t size, Record& record)
+{
+  Segment_rch segment;
+  if (active_) {
+    segment = segments_[active_];
+    if (segment->used + size > segment->map.size()) {
+      sync(*segment);
+      segment.reset();
+    }
+  }
+
+  if (!segment) {
+    const ACE_UINT32 id = next_segment_;
+    const String path = segment_path(id);
+    segment = make_rch<Segment>();
+    if (segment->map.map(ACE_TEXT_CHAR_TO_TCHAR(path.c_str()),
+                         (std::max)(segment_size_, segment_header_size + size),
+                         O_RDWR | O_CREAT, ACE_DEFAULT_FILE_PERMS, PROT_RDWR, ACE_MAP_SHARED) == -1) {
+      if (log_level >= LogLevel::Error) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DurableDataLog::reserve: "
+                   "couldn't create %C: %p\n", path.c_str(), ACE_TEXT("map")));
+      }
+      return 0;
+    }
+    std::memcpy(segment->addr(), segment_magic, sizeof segment_magic);
+    segment->addr()[sizeof segment_magic] = ACE_CDR_BYTE_ORDER;
+    segment->used = segment_header_size;
+    segments_[id] = segment;
+    active_ = id;
+    ++next_segment_;
+  }
+
+  record.segment = active_;
+  record.offset = segment->used;
+  record.size = size;
+  segment->used += size;
+  segment->live += size;
+  return segment->addr() + record.offset;
+}
+
+bool DurableDataLog::write(ACE_UINT32 kind, QueueId queue, const char* payload1, size_t length1,
+                           const char* payload2, size_t length2, Record& record)
+{
+  const size_t length = length1 + length2;
+  if (length > ACE_UINT32_MAX - record_size(0)) {
+    return false;
+  }
+  char* const pos = reserve(record_size(length), record);
+  if (!pos) {
+    return false;
+  }
+  if (length1) {
+    std::memcpy(pos + record_header_size, payload1, length1);
+  }
+  if (length2) {
+    std::memcpy(pos + record_header_size + length1, payload2, length2);
+  }
+  write_uint32(pos, static_cast<ACE_UINT32>(length));
+  write_uint32(pos + 4, record_checksum(kind, queue, static_cast<ACE_UINT32>(length),
+                                        payload1, length1, payload2, length2));
+  write_uint32(pos + 8, kind);
+  write_uint32(pos + 12, queue);
+  return true;
+}
+
+bool DurableDataLog::copy(const Record& from, Record& to)
+{
+  // reserve() doesn't unmap any segments, so this stays valid.
+  const char* const source = segments_[from.segment]->addr() + from.offset;
+  char* const pos = reserve(from.size, to);
+  if (!pos) {
+    return false;
+  }
+  std::memcpy(pos, source, from.size);
+  return true;
+}
+
+bool DurableDataLog::sync(Segment& segment)
+{
+  if (segment.synced == segment.used) {
+    return true;
+  }
+  const size_t page = static_cast<size_t>(ACE_OS::getpagesize());
+  const size_t start = segment.synced / page * page;
+  if (segment.map.sync(segment.addr() + start, segment.used - start, MS_SYNC) == -1) {
+    if (log_level >= LogLevel::Error) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: DurableDataLog::sync: %p\n", ACE_TEXT("msync")));
+    }
+    return false;
+  }
+  segment.synced = segment.used;
+  return true;
+}
+
+DurableDataLog::QueueId DurableDataLog::begin_queue(DDS::DomainId_t domain_id,
+                                                    const char* topic_name,
+                                                    const char* type_name,
+                                                    size_t sample_count)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, 0);
+
+  OPENDDS_VECTOR(char) payload;
+  append_uint32(payload, static_cast<ACE_UINT32>(domain_id));
+  append_string(payload, topic_name);
+  append_string(payload, type_name);
+  append_uint32(payload, static_cast<ACE_UINT32>(sample_count));
+
+  const QueueId id = next_queue_;
+  Record record;
+  if (!write(RECORD_QUEUE, id, &payload[0], payload.size(), 0, 0, record)) {
+    return 0;
+  }
+  next_queue_ = id + 1 ? id + 1 : 1;
+
+  QueueRecords& qr = queues_[id];
+  qr.records.push_back(record);
+  qr.segments.insert(record.segment);
+  return id;
+}
+
+bool DurableDataLog::append(QueueId queue,
+                            const DDS::Time_t& timestamp,
+                            const char* data,
+                            size_t length)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+
+  const QueueMap::iterator pos = queues_.find(queue);
+  if (pos == queues_.end()) {
+    return false;
+  }
+
+  char header[8];
+  write_uint32(header, static_cast<ACE_UINT32>(timestamp.sec));
+  write_uint32(header + 4, timestamp.nanosec);
+  Record record;
+  if (!write(RECORD_SAMPLE, queue, header, sizeof header, data, length, record)) {
+    return false;
+  }
+  pos->second.records.push_back(record);
+  pos->second.segments.insert(record.segment);
+  return true;
+}
+
+bool DurableDataLog::commit()
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+  return !sync_ || !active_ || sync(*segments_[active_]);
+}
+
+bool DurableDataLog::drop(QueueId queue)
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+
+  const QueueMap::iterator pos = queues_.find(queue);
+  if (pos == queues_.end()) {
+    return false;
+  }
+
+  Drop drop;
+  if (!write(RECORD_DROP, queue, 0, 0, 0, 0, drop.record)) {
+    return false;
+  }
+  for (RecordList::const_iterator r = pos->second.records.begin(); r != pos->second.records.end(); ++r) {
+    segments_[r->segment]->live -= r->size;
+  }
+  drop.segments.swap(pos->second.segments);
+  drop.segments.erase(drop.record.segment);
+  queues_.erase(pos);
+
+  if (drop.segments.empty()) {
+    // The records of the queue will be deleted with the drop.
+    segments_[drop.record.segment]->live -= drop.record.size;
+  } else {
+    drops_[queue] = drop;
+  }
+
+  const bool synced = !sync_ || sync(*segments_[active_]);
+  release_segments();
+  return synced;
+}
+
+void DurableDataLog::release_segments()
+{
+  bool released = true;
+  while (released) {
+    released = false;
+
+    for (SegmentMap::iterator pos = segments_.begin(); pos != segments_.end();) {
+      if (pos->first == active_ || pos->second->live) {
+        ++pos;
+        continue;
+      }
+      const ACE_UINT32 id = pos->first;
+      pos->second->map.remove();
+      segments_.erase(pos++);
+      for (QueueMap::iterator q = queues_.begin(); q != queues_.end(); ++q) {
+        q->second.segments.erase(id);
+      }
+      for (DropMap::iterator d = drops_.begin(); d != drops_.end(); ++d) {
+        d->second.segments.erase(id);
+      }
+      released = true;
+    }
+
+    for (DropMap::iterator pos = drops_.begin(); pos != drops_.end();) {
+      if (pos->second.segments.empty()) {
+        segments_[pos->second.record.segment]->live -= pos->second.record.size;
+        drops_.erase(pos++);
+        released = true;
+      } else {
+        ++pos;
+      }
+    }
+  }
+}
+
+bool DurableDataLog::compaction_candidate(const Segment& segment, ACE_UINT32 id) const
+{
+  return id != active_ && segment.live * 2 < segment.used - segment_header_size;
+}
+
+bool DurableDataLog::compaction_needed() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, false);
+
+  for (SegmentMap::const_iterator pos = segments_.begin(); pos != segments_.end(); ++pos) {
+    if (compaction_candidate(*pos->second, pos->first)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DurableDataLog::compact()
+{
+  ACE_GUARD(ACE_Thread_Mutex, guard, mutex_);
+
+  SegmentSet candidates;
+  for (SegmentMap::const_iterator pos = segments_.begin(); pos != segments_.end(); ++pos) {
+    if (compaction_candidate(*pos->second, pos->first)) {
+      candidates.insert(pos->first);
+    }
+  }
+
+  for (SegmentSet::const_iterator id = candidates.begin(); id != candidates.end(); ++id) {
+    // A queue is copied as a whole so that its records stay in order.
+    for (QueueMap::iterator q = queues_.begin(); q != queues_.end(); ++q) {
+      RecordList& records = q->second.records;
+      bool in_segment = false;
+      for (RecordList::const_iterator r = records.begin(); r != records.end() && !in_segment; ++r) {
+        in_segment = r->segment == *id;
+      }
+      if (!in_segment) {
+        continue;
+      }
+
+      RecordList copies(records.size());
+      for (size_t i = 0; i != records.size(); ++i) {
+        if (!copy(records[i], copies[i])) {
+          // What was copied so far isn't live, the original is.
+          for (size_t j = 0; j != i; ++j) {
+            segments_[copies[j].segment]->live -= copies[j].size;
+          }
+          return;
+        }
+        q->second.segments.insert(copies[i].segment);
+      }
+      for (RecordList::const_iterator r = records.begin(); r != records.end(); ++r) {
+        segments_[r->segment]->live -= r->size;
+      }
+      records.swap(copies);
+    }
+
+    for (DropMap::iterator d = drops_.begin(); d != drops_.end(); ++d) {
+      Drop& drop = d->second;
+      if (drop.record.segment != *id) {
+        continue;
+      }
+      Record record;
+      if (!copy(drop.record, record)) {
+        return;
+      }
+      segments_[*id]->live -= drop.record.size;
+      drop.record = record;
+      // The segment the drop was in can have records of its queue.
+      drop.segments.insert(*id);
+      drop.segments.erase(record.segment);
+    }
+  }
+
+  // The copies have to be stored before the originals are deleted.
+  if (active_) {
+    sync(*segments_[active_]);
+  }
+  release_segments();
+}
+
+size_t DurableDataLog::segment_count() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, mutex_, 0);
+  return segments_.size();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_NO_PERSISTENCE_PROFILE
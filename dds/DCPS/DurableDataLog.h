@@ -0,0 +1,208 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_DURABLEDATALOG_H
+#define OPENDDS_DCPS_DURABLEDATALOG_H
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include "dcps_export.h"
+
+#include "PoolAllocator.h"
+#include "RcHandle_T.h"
+#include "RcObject.h"
+
+#include <dds/DdsDcpsInfrastructureC.h>
+
+#include <ace/Basic_Types.h>
+#include <ace/Mem_Map.h>
+#include <ace/Thread_Mutex.h>
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * @class DurableDataLog
+ *
+ * @brief Append-only storage for the samples of the @c PERSISTENT
+ *        DataDurabilityCache.
+ *
+ * The log is a sequence of fixed size segment files in the persistent data
+ * directory, each of which is mapped into memory.  A queue (the samples of
+ * one DataWriter that DataDurabilityCache::insert() persists) is stored as a
+ * queue record naming its domain, topic, and type followed by a record per
+ * sample.  The records of a queue are committed together, so the storage is
+ * synchronized once per queue instead of once per sample.  When a queue's
+ * samples are written to a new DataWriter or are cleaned up, a drop record
+ * is appended for it.
+ *
+ * A segment that only holds dropped queues is deleted.  compact() copies the
+ * queues that are still live out of segments that are mostly dropped so
+ * those can be deleted as well.
+ *
+ * Opening the log reads the segments in order to find the queues that
+ * haven't been dropped.  A record that was only partially written (because
+ * the process stopped) ends its segment, and a queue that has fewer sample
+ * records than its queue record says is ignored.
+ *
+ * The segment files are named "_segment.<id>" so that they are ignored by
+ * FileSystemStorage.
+ */
+class OpenDDS_Dcps_Export DurableDataLog : public virtual RcObject {
+public:
+  typedef ACE_UINT32 QueueId;
+
+  struct Sample {
+    DDS::Time_t timestamp;
+    /// Points into a segment, so it's valid until the log is modified.
+    const char* data;
+    size_t length;
+  };
+
+  struct Queue {
+    QueueId id;
+    DDS::DomainId_t domain_id;
+    String topic_name;
+    String type_name;
+    OPENDDS_VECTOR(Sample) samples;
+  };
+  typedef OPENDDS_VECTOR(Queue) QueueList;
+
+  /// segment_size is the size of the segment files.  A queue record or
+  /// sample that doesn't fit gets a segment of its own.  When sync is true,
+  /// commit() and drop() return after the records are written to storage.
+  /// Otherwise that is left to the operating system, except that segments
+  /// are flushed when they are full and by compact().
+  DurableDataLog(const String& dir, size_t segment_size, bool sync);
+  ~DurableDataLog();
+
+  /// Read the existing segments, creating the directory if needed.  queues
+  /// are the ones that haven't been dropped in the order they were begun.
+  bool open(QueueList& queues);
+
+  /// Start a queue of sample_count samples, returns 0 on failure.
+  QueueId begin_queue(DDS::DomainId_t domain_id,
+                      const char* topic_name,
+                      const char* type_name,
+                      size_t sample_count);
+
+  bool append(QueueId queue,
+              const DDS::Time_t& timestamp,
+              const char* data,
+              size_t length);
+
+  /// Flush the records appended since the last commit.
+  bool commit();
+
+  bool drop(QueueId queue);
+
+  /// True if there is a full segment that is less than half live.
+  bool compaction_needed() const;
+
+  /// Copy the live queues of segments that are less than half live to the
+  /// end of the log and delete those segments.
+  void compact();
+
+  size_t segment_count() const;
+
+private:
+  DurableDataLog(const DurableDataLog&);
+  DurableDataLog& operator=(const DurableDataLog&);
+
+  struct Segment : public virtual RcObject {
+    ACE_Mem_Map map;
+    /// End of the last record.
+    size_t used;
+    /// End of the last record that was flushed.
+    size_t synced;
+    /// Bytes of the records that haven't been dropped or copied.
+    size_t live;
+
+    Segment() : used(0), synced(0), live(0) {}
+    char* addr() const { return static_cast<char*>(map.addr()); }
+  };
+  typedef RcHandle<Segment> Segment_rch;
+  typedef OPENDDS_MAP(ACE_UINT32, Segment_rch) SegmentMap;
+  typedef OPENDDS_SET(ACE_UINT32) SegmentSet;
+
+  struct Record {
+    ACE_UINT32 segment;
+    size_t offset;
+    size_t size;
+  };
+  typedef OPENDDS_VECTOR(Record) RecordList;
+
+  struct QueueRecords {
+    /// The queue record followed by the sample records.
+    RecordList records;
+    /// Segments with records of the queue, including copies that are no
+    /// longer live.
+    SegmentSet segments;
+  };
+  typedef OPENDDS_MAP(QueueId, QueueRecords) QueueMap;
+
+  /// A drop record has to be kept while any segment other than its own still
+  /// has records of the queue it dropped.
+  struct Drop {
+    Record record;
+    SegmentSet segments;
+  };
+  typedef OPENDDS_MAP(QueueId, Drop) DropMap;
+
+  /// State of open().  A queue is begun again when compact() copies it, so
+  /// the copy replaces the original once all of its samples have been read.
+  struct Recovered {
+    Queue queue;
+    RecordList records;
+    size_t sample_count;
+  };
+  typedef OPENDDS_MAP(QueueId, Recovered) RecoveredMap;
+  struct Recovery {
+    RecoveredMap current;
+    RecoveredMap copies;
+    OPENDDS_MAP(QueueId, SegmentSet) segments;
+  };
+
+  String segment_path(ACE_UINT32 id) const;
+  void read_segment(ACE_UINT32 id, Recovery& recovery);
+  bool recover(ACE_UINT32 kind, QueueId queue, const char* payload, size_t length,
+               const Record& record, Recovery& recovery);
+  char* reserve(size_t size, Record& record);
+  bool write(ACE_UINT32 kind, QueueId queue, const char* payload1, size_t length1,
+             const char* payload2, size_t length2, Record& record);
+  bool copy(const Record& from, Record& to);
+  bool sync(Segment& segment);
+  void release_segments();
+  bool compaction_candidate(const Segment& segment, ACE_UINT32 id) const;
+
+  const String dir_;
+  const size_t segment_size_;
+  const bool sync_;
+  mutable ACE_Thread_Mutex mutex_;
+  SegmentMap segments_;
+  /// Segment that records are appended to, 0 if it has to be created.
+  ACE_UINT32 active_;
+  ACE_UINT32 next_segment_;
+  QueueId next_queue_;
+  QueueMap queues_;
+  DropMap drops_;
+};
+
+typedef RcHandle<DurableDataLog> DurableDataLog_rch;
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_NO_PERSISTENCE_PROFILE */
+
+#endif /* OPENDDS_DCPS_DURABLEDATALOG_H */
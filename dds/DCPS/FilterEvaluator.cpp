@@ -43,7 +43,9 @@ FilterEvaluator::DeserializedForEval::~DeserializedForEval()
 
 FilterEvaluator::FilterEvaluator(const char* filter, bool allowOrderBy)
   : extended_grammar_(false)
-  , filter_root_(0)
+  , temporaries_(0)
+  , stack_depth_(0)
+  , max_stack_depth_(0)
   , number_parameters_(0)
 {
   const char* out = filter + std::strlen(filter);
@@ -61,58 +63,21 @@ FilterEvaluator::FilterEvaluator(const char* filter, bool allowOrderBy)
     } else if (found_order_by && iter->TypeMatches<FieldName>()) {
       order_bys_.push_back(toString(iter));
     } else {
-      filter_root_ = walkAst(iter);
+      compile(iter);
     }
   }
 }
 
 FilterEvaluator::FilterEvaluator(const AstNodeWrapper& yardNode)
   : extended_grammar_(false)
-  , filter_root_(walkAst(yardNode))
+  , temporaries_(0)
+  , stack_depth_(0)
+  , max_stack_depth_(0)
   , number_parameters_(0)
 {
+  compile(yardNode);
 }
 
-class FilterEvaluator::EvalNode {
-public:
-  void addChild(EvalNode* n)
-  {
-    children_.push_back(n);
-  }
-
-  virtual ~EvalNode()
-  {
-    std::for_each(children_.begin(), children_.end(), deleteChild);
-  }
-
-  virtual bool has_non_key_fields(const TypeSupportImpl& ts) const
-  {
-    for (OPENDDS_VECTOR(EvalNode*)::const_iterator i = children_.begin(); i != children_.end(); ++i) {
-      EvalNode* child = *i;
-      if (child->has_non_key_fields(ts)) {
-        return true;
-      }
-    }
-    return false;
-  }
-
-  virtual Value eval(DataForEval& data) = 0;
-
-private:
-  static void deleteChild(EvalNode* child)
-  {
-    delete child;
-  }
-
-protected:
-  OPENDDS_VECTOR(EvalNode*) children_;
-};
-
-class FilterEvaluator::Operand : public FilterEvaluator::EvalNode {
-public:
-  virtual bool isParameter() const { return false; }
-};
-
 Value
 FilterEvaluator::DeserializedForEval::lookup(const char* field) const
 {
@@ -128,41 +93,42 @@ FilterEvaluator::SerializedForEval::SerializedForEval(ACE_Message_Block* data,
   , encoding_(encoding)
   , type_support_(type_support)
   , exten_(type_support.base_extensibility())
+  , header_read_(false)
 {}
 
 Value
 FilterEvaluator::SerializedForEval::lookup(const char* field) const
 {
-  const OPENDDS_MAP(OPENDDS_STRING, Value)::const_iterator iter = cache_.find(field);
-  if (iter != cache_.end()) {
-    return iter->second;
-  }
   Message_Block_Ptr mb(serialized_->duplicate());
   Serializer ser(mb.get(), encoding_);
   if (encoding_.is_encapsulated()) {
-    const EncapsulationReadStatus::Value read_status = read_encapsulation_header(ser, exten_);
-    if (read_status == EncapsulationReadStatus::HeaderError) {
-      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR ")
-        ACE_TEXT("FilterEvaluator::SerializedForEval::lookup: ")
-        ACE_TEXT("deserialization of encapsulation header failed.\n")));
-      throw std::runtime_error("FilterEvaluator::SerializedForEval::lookup:"
-        "deserialization of encapsulation header failed.\n");
-    } else if (read_status == EncapsulationReadStatus::ExtensibilityMismatch) {
-      ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR ")
-        ACE_TEXT("FilterEvaluator::SerializedForEval::lookup: ")
-        ACE_TEXT("failed to convert encapsulation header to encoding.\n")));
-      throw std::runtime_error("FilterEvaluator::SerializedForEval::lookup:"
-        "failed to convert encapsulation header to encoding.\n");
-    }
-  }
-  const Value v = meta_.getValue(ser, field, &type_support_);
-  cache_.insert(std::make_pair(OPENDDS_STRING(field), v));
-  return v;
+    if (header_read_) {
+      ser.skip(EncapsulationHeader::serialized_size);
+      ser.encoding(sample_encoding_);
+    } else {
+      const EncapsulationReadStatus::Value read_status = read_encapsulation_header(ser, exten_);
+      if (read_status == EncapsulationReadStatus::HeaderError) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR ")
+          ACE_TEXT("FilterEvaluator::SerializedForEval::lookup: ")
+          ACE_TEXT("deserialization of encapsulation header failed.\n")));
+        throw std::runtime_error("FilterEvaluator::SerializedForEval::lookup:"
+          "deserialization of encapsulation header failed.\n");
+      } else if (read_status == EncapsulationReadStatus::ExtensibilityMismatch) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) ERROR ")
+          ACE_TEXT("FilterEvaluator::SerializedForEval::lookup: ")
+          ACE_TEXT("failed to convert encapsulation header to encoding.\n")));
+        throw std::runtime_error("FilterEvaluator::SerializedForEval::lookup:"
+          "failed to convert encapsulation header to encoding.\n");
+      }
+      sample_encoding_ = ser.encoding();
+      header_read_ = true;
+    }
+  }
+  return meta_.getValue(ser, field, &type_support_);
 }
 
 FilterEvaluator::~FilterEvaluator()
 {
-  delete filter_root_;
 }
 
 bool FilterEvaluator::has_non_key_fields(const TypeSupportImpl& ts) const
@@ -173,299 +139,85 @@ bool FilterEvaluator::has_non_key_fields(const TypeSupportImpl& ts) const
     }
   }
 
-  return filter_root_->has_non_key_fields(ts);
-}
-
-namespace {
-
-  class FieldLookup : public FilterEvaluator::Operand {
-  public:
-    explicit FieldLookup(AstNode* fnNode)
-      : fieldName_(toString(fnNode))
-    {
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      return data.lookup(fieldName_.c_str());
-    }
-
-    bool has_non_key_fields(const TypeSupportImpl& ts) const
-    {
-      return !ts.is_dcps_key(fieldName_.c_str());
-    }
-
-    OPENDDS_STRING fieldName_;
-  };
-
-  class LiteralInt : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralInt(AstNode* fnNode)
-      : value_(0, true)
-    {
-      const OPENDDS_STRING strVal = toString(fnNode);
-      if (strVal.length() > 2 && strVal[0] == '0'
-          && (strVal[1] == 'x' || strVal[1] == 'X')) {
-        std::istringstream is(strVal.c_str() + 2);
-        ACE_UINT64 val;
-        is >> std::hex >> val;
-        value_ = Value(val, true);
-      } else if (!strVal.empty() && strVal[0] == '-') {
-        ACE_INT64 val;
-        std::istringstream is(strVal.c_str());
-        is >> val;
-        value_ = Value(val, true);
-      } else {
-        ACE_UINT64 val;
-        std::istringstream is(strVal.c_str());
-        is >> val;
-        value_ = Value(val, true);
-      }
-    }
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return value_;
-    }
-
-    Value value_;
-  };
-
-  class LiteralChar : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralChar(AstNode* fnNode)
-      : value_(toString(fnNode)[1])
-    {}
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_, true);
-    }
-
-    char value_;
-  };
-
-  class LiteralFloat : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralFloat(AstNode* fnNode)
-      : value_(std::atof(toString(fnNode).c_str()))
-    {}
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_, true);
-    }
-
-    double value_;
-  };
-
-  class LiteralString : public FilterEvaluator::Operand {
-  public:
-    explicit LiteralString(AstNode* fnNode)
-      : value_(toString(fnNode).substr(1) /* trim left ' */)
-    {
-      value_.erase(value_.length() - 1); // trim right '
-    }
-
-    Value eval(FilterEvaluator::DataForEval&)
-    {
-      return Value(value_.c_str(), true);
-    }
-
-    OPENDDS_STRING value_;
-  };
-
-  class Parameter : public FilterEvaluator::Operand {
-  public:
-    explicit Parameter(AstNode* fnNode)
-      : param_(static_cast<size_t>(std::atoi(toString(fnNode).c_str() + 1 /* skip % */)))
-    {}
-
-    bool isParameter() const { return true; }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      return Value(data.params_[static_cast<CORBA::ULong>(param_)], true);
-    }
-
-    size_t param() { return param_; }
-
-    size_t param_;
-  };
-
-  class Comparison : public FilterEvaluator::EvalNode {
-  public:
-    enum Operator {OPER_EQ, OPER_LT, OPER_GT, OPER_LTEQ, OPER_GTEQ, OPER_NEQ,
-      OPER_LIKE, OPER_INVALID};
-
-    explicit Comparison(AstNode* op, FilterEvaluator::Operand* left, FilterEvaluator::Operand* right)
-      : left_(left)
-      , right_(right)
-    {
-      addChild(left_);
-      addChild(right_);
-      setOperator(op);
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value left = left_->eval(data);
-      Value right = right_->eval(data);
-      switch (oper_type_) {
-      case OPER_EQ:
-        return left == right;
-      case OPER_LT:
-        return left < right;
-      case OPER_GT:
-        return right < left;
-      case OPER_LTEQ:
-        return !(right < left);
-      case OPER_GTEQ:
-        return !(left < right);
-      case OPER_NEQ:
-        return !(left == right);
-      case OPER_LIKE:
-        return left.like(right);
-      default:
-        break;
-      }
-      return false; // not reached
-    }
-
-  private:
-    void setOperator(AstNode* node)
-    {
-      if (node->TypeMatches<OP_EQ>()) {
-        oper_type_ = OPER_EQ;
-      } else if (node->TypeMatches<OP_LT>()) {
-        oper_type_ = OPER_LT;
-      } else if (node->TypeMatches<OP_GT>()) {
-        oper_type_ = OPER_GT;
-      } else if (node->TypeMatches<OP_LTEQ>()) {
-        oper_type_ = OPER_LTEQ;
-      } else if (node->TypeMatches<OP_GTEQ>()) {
-        oper_type_ = OPER_GTEQ;
-      } else if (node->TypeMatches<OP_NEQ>()) {
-        oper_type_ = OPER_NEQ;
-      } else if (node->TypeMatches<OP_LIKE>()) {
-        oper_type_ = OPER_LIKE;
-      } else {
-        oper_type_ = OPER_INVALID;
-      }
-    }
-
-    FilterEvaluator::Operand* left_;
-    FilterEvaluator::Operand* right_;
-    Operator oper_type_;
-  };
-
-  class Between : public FilterEvaluator::EvalNode {
-  public:
-    Between(FilterEvaluator::Operand* field, AstNode* betweenOrNot, FilterEvaluator::Operand* left, FilterEvaluator::Operand* right)
-      : invert_(betweenOrNot->TypeMatches<NOT_BETWEEN>())
-      , field_(field)
-      , left_(left)
-      , right_(right)
-    {
-      addChild(field_);
-      addChild(left_);
-      addChild(right_);
-    }
-
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value field = field_->eval(data);
-      Value left = left_->eval(data);
-      Value right = right_->eval(data);
-      bool btwn = !(field < left) && !(right < field);
-      return invert_ ? !btwn : btwn;
-    }
-
-  private:
-    bool invert_;
-    FilterEvaluator::Operand* field_;
-    FilterEvaluator::Operand* left_;
-    FilterEvaluator::Operand* right_;
-  };
-
-  class Call : public FilterEvaluator::Operand {
-  public:
-    enum Operator { OP_MOD };
-
-    explicit Call(const OPENDDS_STRING& name)
-    {
-      if (name == MOD) {
-        op_ = OP_MOD;
-      } else {
-        throw std::runtime_error("Unknown function: " + std::string(name.c_str ()));
-      }
+  for (OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator i = fields_.begin(); i != fields_.end(); ++i) {
+    if (!ts.is_dcps_key(i->c_str())) {
+      return true;
     }
+  }
+  return false;
+}
 
-    virtual Value eval(FilterEvaluator::DataForEval& data)
-    {
-      switch (op_) {
-      case OP_MOD:
-        {
-          if (children_.size() != 2) {
-            std::stringstream ss;
-            ss << MOD << " expects 2 arguments, given " << children_.size();
-            throw std::runtime_error(ss.str ());
-          }
-          Value left = children_[0]->eval(data);
-          Value right = children_[1]->eval(data);
-          return left % right;
-        }
-      }
-      throw std::runtime_error("Unknown function operator");
+FilterEvaluator::Literal::Literal(const Value& value)
+  : value_(value)
+{
+  for (int t = Value::VAL_BOOL; t <= Value::VAL_STRING; ++t) {
+    // Left as is if it can't be converted
+    Value converted(value);
+    if (t != value.type_) {
+      converted.convert(static_cast<Value::Type>(t));
     }
+    as_type_.push_back(converted);
+  }
+}
 
-  private:
-    Operator op_;
-  };
-
-  class Logical : public FilterEvaluator::EvalNode {
-  public:
-    enum LogicalOp {LG_AND, LG_OR, LG_NOT};
-
-    explicit Logical(EvalNode* child)
-      : op_(LG_NOT)
-    {
-      addChild(child);
-    }
+const Value&
+FilterEvaluator::Literal::as_type(Value::Type type) const
+{
+  const Value& converted = as_type_[type];
+  if (converted.type_ != type) {
+    throw std::runtime_error("Types don't match and aren't convertible.");
+  }
+  return converted;
+}
 
-    Logical(AstNode* op, EvalNode* left, EvalNode* right)
-    {
-      addChild(left);
-      addChild(right);
-      if (op->TypeMatches<AND>()) {
-        op_ = LG_AND;
-      } else if (op->TypeMatches<OR>()) {
-        op_ = LG_OR;
-      } else {
-        throw std::runtime_error("Unknown logical operator");
-      }
-    }
+namespace {
+  Value literalInt(const OPENDDS_STRING& strVal)
+  {
+    if (strVal.length() > 2 && strVal[0] == '0'
+        && (strVal[1] == 'x' || strVal[1] == 'X')) {
+      std::istringstream is(strVal.c_str() + 2);
+      ACE_UINT64 val;
+      is >> std::hex >> val;
+      return Value(val, true);
+    } else if (!strVal.empty() && strVal[0] == '-') {
+      ACE_INT64 val;
+      std::istringstream is(strVal.c_str());
+      is >> val;
+      return Value(val, true);
+    }
+    ACE_UINT64 val;
+    std::istringstream is(strVal.c_str());
+    is >> val;
+    return Value(val, true);
+  }
 
-    Value eval(FilterEvaluator::DataForEval& data)
-    {
-      Value left = children_[0]->eval(data);
-      OPENDDS_ASSERT(left.type_ == Value::VAL_BOOL);
-      switch (op_) {
-      case LG_NOT:
-        return !left.b_;
-      case LG_AND:
-        if (!left.b_) return false;
-        break;
-      case LG_OR:
-        if (left.b_) return true;
-        break;
-      }
-      return children_[1]->eval(data);
-    }
+  Value literalString(const OPENDDS_STRING& strVal)
+  {
+    // trim the quotes
+    const OPENDDS_STRING value = strVal.substr(1, strVal.length() - 2);
+    return Value(value.c_str(), true);
+  }
 
-  private:
-    LogicalOp op_;
-  };
+  FilterEvaluator::Instruction::OpCode comparison(AstNode* node)
+  {
+    typedef FilterEvaluator::Instruction I;
+    if (node->TypeMatches<OP_EQ>()) {
+      return I::OP_EQ;
+    } else if (node->TypeMatches<OP_LT>()) {
+      return I::OP_LT;
+    } else if (node->TypeMatches<OP_GT>()) {
+      return I::OP_GT;
+    } else if (node->TypeMatches<OP_LTEQ>()) {
+      return I::OP_LTEQ;
+    } else if (node->TypeMatches<OP_GTEQ>()) {
+      return I::OP_GTEQ;
+    } else if (node->TypeMatches<OP_NEQ>()) {
+      return I::OP_NEQ;
+    } else if (node->TypeMatches<OP_LIKE>()) {
+      return I::OP_LIKE;
+    }
+    throw std::runtime_error("Unknown comparison operator");
+  }
 }
 
 static size_t arity(const FilterEvaluator::AstNodeWrapper& node)
@@ -484,80 +236,176 @@ static FilterEvaluator::AstNodeWrapper child(const FilterEvaluator::AstNodeWrapp
   return iter;
 }
 
-FilterEvaluator::EvalNode*
-FilterEvaluator::walkAst(const FilterEvaluator::AstNodeWrapper& node)
+void
+FilterEvaluator::emit(Instruction::OpCode op, size_t arg, int stack_effect)
+{
+  program_.push_back(Instruction(op, arg));
+  stack_depth_ += stack_effect;
+  max_stack_depth_ = std::max(max_stack_depth_, stack_depth_);
+}
+
+size_t
+FilterEvaluator::add_field(const OPENDDS_STRING& field)
+{
+  const OPENDDS_VECTOR(OPENDDS_STRING)::const_iterator iter =
+    std::find(fields_.begin(), fields_.end(), field);
+  if (iter != fields_.end()) {
+    return static_cast<size_t>(iter - fields_.begin());
+  }
+  fields_.push_back(field);
+  return fields_.size() - 1;
+}
+
+void
+FilterEvaluator::compile(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<CompPredDef>()) {
-    Operand* left = walkOperand(child(node, 0));
-    const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-    Operand* right = walkOperand(child(node, 2));
-    if (left->isParameter() && right->isParameter()) {
+    const bool left_param = compileOperand(child(node, 0));
+    const Instruction::OpCode op = comparison(child(node, 1));
+    const bool right_param = compileOperand(child(node, 2));
+    if (left_param && right_param) {
       extended_grammar_ = true;
     }
-    return new Comparison(op, left, right);
+    emit(op, 0, -1);
+    return;
   } else if (node->TypeMatches<BetweenPredDef>()) {
-    Operand* field = walkOperand(child(node, 0));
-    const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-    Operand* low = walkOperand(child(node, 2));
-    Operand* high = walkOperand(child(node, 3));
-    return new Between(field, op, low, high);
+    compileOperand(child(node, 0));
+    const bool invert = child(node, 1)->TypeMatches<NOT_BETWEEN>();
+    compileOperand(child(node, 2));
+    compileOperand(child(node, 3));
+    emit(invert ? Instruction::OP_NOT_BETWEEN : Instruction::OP_BETWEEN, 0, -2);
+    return;
   } else if (node->TypeMatches<CondDef>() || node->TypeMatches<Cond>()) {
     size_t a = arity(node);
     if (a == 1) {
-      return walkAst(child(node, 0));
+      compile(child(node, 0));
+      return;
     } else if (a == 2) {
       OPENDDS_ASSERT(child(node, 0)->TypeMatches<NOT>());
-      return new Logical(walkAst(child(node, 1)));
+      compile(child(node, 1));
+      emit(Instruction::OP_NOT, 0, 0);
+      return;
     } else if (a == 3) {
-      EvalNode* left = walkAst(child(node, 0));
+      compile(child(node, 0));
       const FilterEvaluator::AstNodeWrapper& op = child(node, 1);
-      EvalNode* right = walkAst(child(node, 2));
-      return new Logical(op, left, right);
+      Instruction::OpCode jump;
+      if (op->TypeMatches<AND>()) {
+        jump = Instruction::OP_JUMP_IF_FALSE;
+      } else if (op->TypeMatches<OR>()) {
+        jump = Instruction::OP_JUMP_IF_TRUE;
+      } else {
+        throw std::runtime_error("Unknown logical operator");
+      }
+      // The right side only runs if the left side didn't decide the result.
+      const size_t jump_index = program_.size();
+      emit(jump, 0, -1);
+      compile(child(node, 2));
+      program_[jump_index].arg_ = program_.size();
+      return;
     }
   }
 
   throw std::runtime_error("Unexpected filter AST node");
 }
 
-FilterEvaluator::Operand*
-FilterEvaluator::walkOperand(const FilterEvaluator::AstNodeWrapper& node)
+bool
+FilterEvaluator::compileOperand(const FilterEvaluator::AstNodeWrapper& node)
 {
   if (node->TypeMatches<FieldName>()) {
-    return new FieldLookup(node);
+    emit(Instruction::OP_FIELD, add_field(toString(node)), 1);
   } else if (node->TypeMatches<IntVal>()) {
-    return new LiteralInt(node);
+    literals_.push_back(Literal(literalInt(toString(node))));
+    emit(Instruction::OP_LITERAL, literals_.size() - 1, 1);
   } else if (node->TypeMatches<CharVal>()) {
-    return new LiteralChar(node);
+    literals_.push_back(Literal(Value(toString(node)[1], true)));
+    emit(Instruction::OP_LITERAL, literals_.size() - 1, 1);
   } else if (node->TypeMatches<FloatVal>()) {
-    return new LiteralFloat(node);
+    literals_.push_back(Literal(Value(std::atof(toString(node).c_str()), true)));
+    emit(Instruction::OP_LITERAL, literals_.size() - 1, 1);
   } else if (node->TypeMatches<StrVal>()) {
-    return new LiteralString(node);
+    literals_.push_back(Literal(literalString(toString(node))));
+    emit(Instruction::OP_LITERAL, literals_.size() - 1, 1);
   } else if (node->TypeMatches<ParamVal>()) {
-    Parameter* retval = new Parameter(node);
+    const size_t param = static_cast<size_t>(std::atoi(toString(node).c_str() + 1 /* skip % */));
     // Keep track of the highest parameter number
-    if (retval->param() + 1 > number_parameters_) {
-      number_parameters_ = retval->param() + 1;
+    if (param + 1 > number_parameters_) {
+      number_parameters_ = param + 1;
     }
-    return retval;
+    emit(Instruction::OP_PARAM, param, 1);
+    ++temporaries_;
+    return true;
   } else if (node->TypeMatches<CallDef>()) {
     if (arity(node) == 1) {
-      return walkOperand(child(node, 0));
-    } else {
-      extended_grammar_ = true;
-      Call* call = new Call(toString(child(node, 0)));
-      for (AstNode* iter = child(node, 1); iter != 0; iter = iter->GetSibling()) {
-        call->addChild(walkOperand(iter));
-      }
-      return call;
+      return compileOperand(child(node, 0));
+    }
+    extended_grammar_ = true;
+    const OPENDDS_STRING name = toString(child(node, 0));
+    if (name != MOD) {
+      throw std::runtime_error("Unknown function: " + std::string(name.c_str()));
+    }
+    size_t args = 0;
+    for (AstNode* iter = child(node, 1); iter != 0; iter = iter->GetSibling()) {
+      compileOperand(iter);
+      ++args;
+    }
+    if (args != 2) {
+      std::stringstream ss;
+      ss << MOD << " expects 2 arguments, given " << args;
+      throw std::runtime_error(ss.str());
     }
+    emit(Instruction::OP_MOD, 0, -1);
+    ++temporaries_;
+  } else {
+    throw std::runtime_error("Unexpected filter operand node");
   }
-  throw std::runtime_error("Unexpected filter operand node");
+  return false;
 }
 
 bool
-FilterEvaluator::eval_i(DataForEval& data) const
+FilterEvaluator::single_comparison(OPENDDS_STRING& field, size_t& param,
+                                   Instruction::OpCode& op) const
+{
+  if (program_.size() != 3) {
+    return false;
+  }
+  op = program_[2].op_;
+  switch (op) {
+  case Instruction::OP_EQ:
+  case Instruction::OP_NEQ:
+    break;
+  case Instruction::OP_LT:
+  case Instruction::OP_GT:
+  case Instruction::OP_LTEQ:
+  case Instruction::OP_GTEQ:
+    if (program_[0].op_ == Instruction::OP_PARAM) {
+      // "%0 < x" is "x > %0"
+      static const Instruction::OpCode reversed[] = {
+        Instruction::OP_GT, Instruction::OP_LT, Instruction::OP_GTEQ, Instruction::OP_LTEQ};
+      op = reversed[op - Instruction::OP_LT];
+    }
+    break;
+  default:
+    return false;
+  }
+  if (program_[0].op_ == Instruction::OP_FIELD && program_[1].op_ == Instruction::OP_PARAM) {
+    field = fields_[program_[0].arg_];
+    param = program_[1].arg_;
+    return true;
+  } else if (program_[0].op_ == Instruction::OP_PARAM && program_[1].op_ == Instruction::OP_FIELD) {
+    field = fields_[program_[1].arg_];
+    param = program_[0].arg_;
+    return true;
+  }
+  return false;
+}
+
+Value
+FilterEvaluator::field_value(ACE_Message_Block* serializedSample, Encoding encoding,
+                             TypeSupportImpl& typeSupport, const char* field)
 {
-  return filter_root_->eval(data).b_;
+  const DDS::StringSeq no_params;
+  const SerializedForEval data(serializedSample, typeSupport, no_params, encoding);
+  return data.lookup(field);
 }
 
 OPENDDS_VECTOR(OPENDDS_STRING)
@@ -569,7 +417,7 @@ FilterEvaluator::getOrderBys() const
 bool
 FilterEvaluator::hasFilter() const
 {
-  return filter_root_ != 0;
+  return !program_.empty();
 }
 
 #ifdef _MSC_VER
@@ -994,6 +842,151 @@ Value::conversion(Value& lhs, Value& rhs)
   }
 }
 
+namespace {
+  const Value true_value(true);
+  const Value false_value(false);
+
+  struct StackEntry {
+    StackEntry(const Value* value = 0, const FilterEvaluator::Literal* literal = 0)
+      : value_(value), literal_(literal) {}
+
+    const Value* value_;
+    /// Set if value_ is a literal
+    const FilterEvaluator::Literal* literal_;
+  };
+
+  StackEntry boolean(bool b)
+  {
+    return StackEntry(b ? &true_value : &false_value);
+  }
+
+  /// Same as the Value operators, but literals compared to fields use their
+  /// conversion from when the filter was compiled and nothing is copied
+  /// unless both sides have to be converted at run time.
+  template<typename Visitor>
+  bool compare(const StackEntry& left, const StackEntry& right)
+  {
+    const Value* lhs = left.value_;
+    const Value* rhs = right.value_;
+    if (lhs->type_ != rhs->type_) {
+      if (left.literal_ && !rhs->conversion_preferred_) {
+        lhs = &left.literal_->as_type(rhs->type_);
+      } else if (right.literal_ && !lhs->conversion_preferred_) {
+        rhs = &right.literal_->as_type(lhs->type_);
+      } else {
+        Value lhs_copy(*lhs);
+        Value rhs_copy(*rhs);
+        Value::conversion(lhs_copy, rhs_copy);
+        Visitor visitor(lhs_copy);
+        return visit(visitor, rhs_copy);
+      }
+    }
+    Visitor visitor(*lhs);
+    return visit(visitor, *rhs);
+  }
+}
+
+bool
+FilterEvaluator::eval_i(DataForEval& data) const
+{
+  // Field values, then temporaries.  Reserving makes pointers to them stable.
+  OPENDDS_VECTOR(Value) values;
+  values.reserve(fields_.size() + temporaries_);
+  OPENDDS_VECTOR(const Value*) field_values(fields_.size(), static_cast<const Value*>(0));
+  OPENDDS_VECTOR(StackEntry) stack;
+  stack.reserve(static_cast<size_t>(max_stack_depth_));
+
+  size_t pc = 0;
+  while (pc < program_.size()) {
+    const Instruction& inst = program_[pc++];
+    switch (inst.op_) {
+    case Instruction::OP_FIELD:
+      if (!field_values[inst.arg_]) {
+        values.push_back(data.lookup(fields_[inst.arg_].c_str()));
+        field_values[inst.arg_] = &values.back();
+      }
+      stack.push_back(StackEntry(field_values[inst.arg_]));
+      break;
+    case Instruction::OP_LITERAL:
+      stack.push_back(StackEntry(&literals_[inst.arg_].value_, &literals_[inst.arg_]));
+      break;
+    case Instruction::OP_PARAM:
+      values.push_back(Value(data.params_[static_cast<CORBA::ULong>(inst.arg_)], true));
+      stack.push_back(StackEntry(&values.back()));
+      break;
+    case Instruction::OP_MOD:
+      {
+        const StackEntry right = stack.back();
+        stack.pop_back();
+        values.push_back(*stack.back().value_ % *right.value_);
+        stack.back() = StackEntry(&values.back());
+      }
+      break;
+    case Instruction::OP_NOT:
+      OPENDDS_ASSERT(stack.back().value_->type_ == Value::VAL_BOOL);
+      stack.back() = boolean(!stack.back().value_->b_);
+      break;
+    case Instruction::OP_JUMP_IF_FALSE:
+    case Instruction::OP_JUMP_IF_TRUE:
+      OPENDDS_ASSERT(stack.back().value_->type_ == Value::VAL_BOOL);
+      if (stack.back().value_->b_ == (inst.op_ == Instruction::OP_JUMP_IF_TRUE)) {
+        pc = inst.arg_;
+      } else {
+        stack.pop_back();
+      }
+      break;
+    case Instruction::OP_BETWEEN:
+    case Instruction::OP_NOT_BETWEEN:
+      {
+        const StackEntry high = stack.back();
+        stack.pop_back();
+        const StackEntry low = stack.back();
+        stack.pop_back();
+        const bool btwn = !compare<Less>(stack.back(), low) && !compare<Less>(high, stack.back());
+        stack.back() = boolean(btwn == (inst.op_ == Instruction::OP_BETWEEN));
+      }
+      break;
+    default:
+      {
+        const StackEntry right = stack.back();
+        stack.pop_back();
+        const StackEntry left = stack.back();
+        bool result = false;
+        switch (inst.op_) {
+        case Instruction::OP_EQ:
+          result = compare<Equals>(left, right);
+          break;
+        case Instruction::OP_LT:
+          result = compare<Less>(left, right);
+          break;
+        case Instruction::OP_GT:
+          result = compare<Less>(right, left);
+          break;
+        case Instruction::OP_LTEQ:
+          result = !compare<Less>(right, left);
+          break;
+        case Instruction::OP_GTEQ:
+          result = !compare<Less>(left, right);
+          break;
+        case Instruction::OP_NEQ:
+          result = !compare<Equals>(left, right);
+          break;
+        case Instruction::OP_LIKE:
+          result = left.value_->like(*right.value_);
+          break;
+        default:
+          throw std::runtime_error("Unexpected filter instruction");
+        }
+        stack.back() = boolean(result);
+      }
+      break;
+    }
+  }
+
+  OPENDDS_ASSERT(stack.size() == 1 && stack.back().value_->type_ == Value::VAL_BOOL);
+  return stack.back().value_->b_;
+}
+
 MetaStruct::~MetaStruct()
 {
 }
@@ -131,8 +131,50 @@ public:
     return eval_i(data);
   }
 
-  class EvalNode;
-  class Operand;
+  /// One step of a compiled filter.  Operands are pushed on a stack and
+  /// operators replace them with their result.
+  struct Instruction {
+    enum OpCode {
+      OP_FIELD, ///< push field arg_ of the sample
+      OP_LITERAL, ///< push literal arg_
+      OP_PARAM, ///< push parameter arg_
+      OP_MOD,
+      OP_EQ, OP_NEQ, OP_LT, OP_GT, OP_LTEQ, OP_GTEQ, OP_LIKE,
+      OP_BETWEEN, OP_NOT_BETWEEN,
+      OP_NOT,
+      OP_JUMP_IF_FALSE, ///< jump to arg_ keeping a false result, else pop it
+      OP_JUMP_IF_TRUE ///< jump to arg_ keeping a true result, else pop it
+    };
+
+    Instruction(OpCode op, size_t arg) : op_(op), arg_(arg) {}
+
+    OpCode op_;
+    size_t arg_;
+  };
+
+  /// A literal operand along with its conversion to each Value::Type, which
+  /// is what comparing it to a field of that type would convert it to.
+  struct OpenDDS_Dcps_Export Literal {
+    explicit Literal(const Value& value);
+    const Value& as_type(Value::Type type) const;
+
+    Value value_;
+    OPENDDS_VECTOR(Value) as_type_;
+  };
+
+  /**
+   * Returns true if the filter is a single comparison of a field with a
+   * parameter, like "symbol = %0", setting field, param, and op as if the
+   * field was on the left.
+   */
+  bool single_comparison(OPENDDS_STRING& field, size_t& param,
+                         Instruction::OpCode& op) const;
+
+  /**
+   * Returns the value of a field of a serialized sample.
+   */
+  static Value field_value(ACE_Message_Block* serializedSample, Encoding encoding,
+                           TypeSupportImpl& typeSupport, const char* field);
 
   struct OpenDDS_Dcps_Export DataForEval {
     DataForEval(const MetaStruct& meta, const DDS::StringSeq& params)
@@ -150,8 +192,11 @@ private:
   FilterEvaluator(const FilterEvaluator&);
   FilterEvaluator& operator=(const FilterEvaluator&);
 
-  EvalNode* walkAst(const AstNodeWrapper& node);
-  Operand* walkOperand(const AstNodeWrapper& node);
+  void compile(const AstNodeWrapper& node);
+  /// Returns true if the operand is a parameter
+  bool compileOperand(const AstNodeWrapper& node);
+  void emit(Instruction::OpCode op, size_t arg, int stack_effect);
+  size_t add_field(const OPENDDS_STRING& field);
 
   struct OpenDDS_Dcps_Export DeserializedForEval : DataForEval {
     DeserializedForEval(const void* data, const MetaStruct& meta,
@@ -169,14 +214,24 @@ private:
     ACE_Message_Block* serialized_;
     Encoding encoding_;
     TypeSupportImpl& type_support_;
-    mutable OPENDDS_MAP(OPENDDS_STRING, Value) cache_;
     Extensibility exten_;
+    /// Encoding of the sample after the encapsulation header, once it's read
+    mutable Encoding sample_encoding_;
+    mutable bool header_read_;
   };
 
   bool eval_i(DataForEval& data) const;
 
   bool extended_grammar_;
-  EvalNode* filter_root_;
+  /// Postfix form of the filter, empty if there is no filter
+  OPENDDS_VECTOR(Instruction) program_;
+  OPENDDS_VECTOR(Literal) literals_;
+  /// Fields used by the filter, each looked up at most once per sample
+  OPENDDS_VECTOR(OPENDDS_STRING) fields_;
+  /// Values created while evaluating parameters and function calls
+  size_t temporaries_;
+  int stack_depth_;
+  int max_stack_depth_;
   OPENDDS_VECTOR(OPENDDS_STRING) order_bys_;
   /// Number of parameters used in the filter, this should
   /// match the number of values passed when evaluating the filter
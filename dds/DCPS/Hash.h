@@ -52,6 +52,50 @@ inline unsigned fnv_1a_hash(const unsigned char* data, size_t length)
   return hash;
 }
 
+/// Helpers for the *_OpenDDS_KeyHash structures generated by opendds_idl.
+/// Equal keys (according to *_OpenDDS_KeyLessThan) must hash the same.
+inline void hash_key_combine(size_t& seed, size_t hash)
+{
+  seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+inline void hash_key_value(size_t& seed, const T& value)
+{
+  hash_key_combine(seed, fnv_1a_hash(reinterpret_cast<const unsigned char*>(&value), sizeof value));
+}
+
+inline void hash_key_value(size_t& seed, double value)
+{
+  if (value == 0) {
+    value = 0; // -0.0 == 0.0
+  }
+  hash_key_combine(seed, fnv_1a_hash(reinterpret_cast<const unsigned char*>(&value), sizeof value));
+}
+
+inline void hash_key_value(size_t& seed, float value)
+{
+  hash_key_value(seed, static_cast<double>(value));
+}
+
+inline void hash_key_value(size_t& seed, long double value)
+{
+  // Native long double can have padding bytes
+  hash_key_value(seed, static_cast<double>(value));
+}
+
+template <typename CharT>
+inline void hash_key_string(size_t& seed, const CharT* str)
+{
+  size_t length = 0;
+  if (str) {
+    while (str[length]) {
+      ++length;
+    }
+  }
+  hash_key_combine(seed, fnv_1a_hash(reinterpret_cast<const unsigned char*>(str), length * sizeof(CharT)));
+}
+
 }
 }
 OPENDDS_END_VERSIONED_NAMESPACE_DECL
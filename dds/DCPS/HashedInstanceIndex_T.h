@@ -0,0 +1,135 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_HASHED_INSTANCE_INDEX_T_H
+#define OPENDDS_DCPS_HASHED_INSTANCE_INDEX_T_H
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "PoolAllocator.h"
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Hash index over the keys of an ordered instance map (Map is a std::map of
+ * sample to instance handle ordered by LessThan).  The index points to the
+ * keys stored in the map, so samples aren't copied, and finds map iterators
+ * in constant time instead of walking the tree with full key comparisons.
+ * The map is still used for everything that needs the key order
+ * (read_next_instance and take_next_instance).
+ *
+ * Hash is the opendds_idl generated *_OpenDDS_KeyHash.  When it's void, or
+ * when std::unordered_map is not available, all lookups use the map.
+ */
+template <typename Map, typename Hash, typename LessThan>
+class HashedInstanceIndex {
+public:
+  typedef typename Map::key_type Key;
+  typedef typename Map::iterator iterator;
+
+  HashedInstanceIndex(Map& map, bool enabled)
+    : map_(map)
+    , enabled_(enabled)
+  {}
+
+  bool enabled() const
+  {
+#ifdef ACE_HAS_CPP11
+    return enabled_;
+#else
+    return false;
+#endif
+  }
+
+#ifdef ACE_HAS_CPP11
+  iterator find(const Key& key)
+  {
+    if (!enabled_) {
+      return map_.find(key);
+    }
+    const typename Index::const_iterator pos = index_.find(&key);
+    return pos == index_.end() ? map_.end() : pos->second;
+  }
+
+  void insert(iterator it)
+  {
+    if (enabled_) {
+      index_.insert(typename Index::value_type(&it->first, it));
+    }
+  }
+
+  void erase(iterator it)
+  {
+    if (enabled_) {
+      index_.erase(&it->first);
+    }
+  }
+
+  void clear()
+  {
+    index_.clear();
+  }
+
+private:
+  struct KeyPtrHash {
+    size_t operator()(const Key* key) const
+    {
+      return Hash()(*key);
+    }
+  };
+
+  struct KeyPtrEqual {
+    bool operator()(const Key* a, const Key* b) const
+    {
+      const LessThan less;
+      return !less(*a, *b) && !less(*b, *a);
+    }
+  };
+
+  typedef OPENDDS_UNORDERED_MAP_CHASH_CEQ_T(const Key*, iterator, KeyPtrHash, KeyPtrEqual) Index;
+  Index index_;
+#else
+  iterator find(const Key& key) { return map_.find(key); }
+  void insert(iterator) {}
+  void erase(iterator) {}
+  void clear() {}
+#endif
+
+private:
+  Map& map_;
+  const bool enabled_;
+};
+
+template <typename Map, typename LessThan>
+class HashedInstanceIndex<Map, void, LessThan> {
+public:
+  typedef typename Map::key_type Key;
+  typedef typename Map::iterator iterator;
+
+  HashedInstanceIndex(Map& map, bool)
+    : map_(map)
+  {}
+
+  bool enabled() const { return false; }
+  iterator find(const Key& key) { return map_.find(key); }
+  void insert(iterator) {}
+  void erase(iterator) {}
+  void clear() {}
+
+private:
+  Map& map_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_HASHED_INSTANCE_INDEX_T_H */
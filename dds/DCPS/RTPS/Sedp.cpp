@@ -8179,7 +8179,9 @@ namespace { namespace OPENDDS_RTPS_UNITY_BUILD_ID {
     Stats_Index_TypeLookupMatchingData = 14,
     Stats_Index_PendingRemoteReaderCryptoTokens = 15,
     Stats_Index_PendingRemoteWriterCryptoTokens = 16,
-    Stats_Len = 17;
+    Stats_Index_TypeAssignabilityCacheHits = 17,
+    Stats_Index_TypeAssignabilityCacheMisses = 18,
+    Stats_Len = 19;
 } }
 
 DCPS::StatisticSeq Sedp::stats_template()
@@ -8204,6 +8206,8 @@ DCPS::StatisticSeq Sedp::stats_template()
   stats[Stats_Index_TypeLookupMatchingData].name = "TypeLookupMatchingData";
   stats[Stats_Index_PendingRemoteReaderCryptoTokens].name = "PendingRemoteReaderCryptoTokens";
   stats[Stats_Index_PendingRemoteWriterCryptoTokens].name = "PendingRemoteWriterCryptoTokens";
+  stats[Stats_Index_TypeAssignabilityCacheHits].name = "TypeAssignabilityCacheHits";
+  stats[Stats_Index_TypeAssignabilityCacheMisses].name = "TypeAssignabilityCacheMisses";
   return stats;
 }
 
@@ -8230,6 +8234,10 @@ void Sedp::fill_stats(DCPS::StatisticSeq& stats, DDS::UInt32 begin) const
   stats[begin + Stats_Index_PendingRemoteReaderCryptoTokens].value = pending_remote_reader_crypto_tokens_.size();
   stats[begin + Stats_Index_PendingRemoteWriterCryptoTokens].value = pending_remote_writer_crypto_tokens_.size();
 #endif
+  if (type_lookup_service_) {
+    stats[begin + Stats_Index_TypeAssignabilityCacheHits].value = type_lookup_service_->assignability_cache_hits();
+    stats[begin + Stats_Index_TypeAssignabilityCacheMisses].value = type_lookup_service_->assignability_cache_misses();
+  }
 }
 
 size_t Sedp::total_reader_bytes_allocated() const
@@ -22,6 +22,10 @@
 #include <ace/WFMO_Reactor.h>
 #include <ace/WIN32_Proactor.h>
 
+#ifdef ACE_HAS_EVENT_POLL
+#  include <ace/Dev_Poll_Reactor.h>
+#endif
+
 #include <cstring>
 #include <exception>
 
@@ -73,6 +77,27 @@ ReactorTask::~ReactorTask()
   cleanup();
 }
 
+const EnumList<ReactorTask::ReactorType> ReactorTask::reactor_types[] =
+  {
+    { REACTOR_SELECT, "Select" },
+    { REACTOR_EPOLL, "Epoll" }
+  };
+
+ACE_Reactor* ReactorTask::make_reactor(ReactorType type)
+{
+  if (type == REACTOR_EPOLL) {
+#ifdef ACE_HAS_EVENT_POLL
+    return new ACE_Reactor(new ACE_Dev_Poll_Reactor, true);
+#else
+    if (log_level >= LogLevel::Warning) {
+      ACE_ERROR((LM_WARNING, "(%P|%t) WARNING: ReactorTask::make_reactor: "
+                 "epoll isn't available, using the select reactor\n"));
+    }
+#endif
+  }
+  return 0;
+}
+
 void ReactorTask::wait_for_startup_i() const
 {
   while (state_ == STATE_UNINITIALIZED) {
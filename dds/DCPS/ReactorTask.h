@@ -107,6 +107,24 @@ public:
   explicit ReactorTask(bool useAsyncSend = false);
   virtual ~ReactorTask();
 
+  /// Kind of ACE reactor (see make_reactor).
+  enum ReactorType {
+    /// ACE_Select_Reactor, or ACE_WFMO_Reactor for the asynchronous sends
+    /// of the multicast transport on Windows
+    REACTOR_SELECT,
+    /// ACE_Dev_Poll_Reactor using epoll(7), which isn't limited to
+    /// FD_SETSIZE handles and doesn't scan every handle on each dispatch.
+    /// Only available where ACE has ACE_HAS_EVENT_POLL (Linux).
+    REACTOR_EPOLL
+  };
+  static const EnumList<ReactorType> reactor_types[2];
+
+  /// Returns a reactor of the given type to pass to init_reactor_task or
+  /// open_reactor_task, or 0 for REACTOR_SELECT, which is the reactor they
+  /// create by default.  REACTOR_EPOLL falls back to REACTOR_SELECT with a
+  /// warning where it isn't available.
+  static ACE_Reactor* make_reactor(ReactorType type);
+
   // Use init_reactor_task (and not open_reactor_task) to initialize this
   // object without spawning a thread.
   // A subsequent call to run_reactor can optionally spawn threads to
@@ -87,6 +87,7 @@ public:
 
 #ifndef OPENDDS_NO_CONTENT_SUBSCRIPTION_PROFILE
   virtual bool eval(FilterEvaluator& evaluator, const DDS::StringSeq& params) const = 0;
+  virtual Value get_field_value(const char* field) const = 0;
 #endif
 
 protected:
@@ -259,6 +260,11 @@ public:
   {
     return evaluator.eval(*data_, params);
   }
+
+  Value get_field_value(const char* field) const
+  {
+    return getMetaStruct<NativeType>().getValue(data_, field);
+  }
 #endif
 
 private:
@@ -15,8 +15,8 @@ OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 namespace OpenDDS {
 namespace DCPS {
 
-ServiceEventDispatcher::ServiceEventDispatcher(size_t count)
- : dispatcher_(make_rch<DispatchService>(count ? count : 1))
+ServiceEventDispatcher::ServiceEventDispatcher(size_t count, bool timer_wheel, bool work_stealing)
+ : dispatcher_(make_rch<DispatchService>(count ? count : 1, timer_wheel, work_stealing))
 {
 }
 
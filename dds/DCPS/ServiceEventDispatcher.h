@@ -29,8 +29,12 @@ public:
    *
    * @param count the requested size of the internal thread pool (see
    * DispatchService); values less than 1 are treated as 1
+   * @param timer_wheel keep scheduled events in a TimerWheel (see
+   * DispatchService)
+   * @param work_stealing give each thread its own queue of immediate events
+   * (see DispatchService)
    */
-  explicit ServiceEventDispatcher(size_t count = 1);
+  explicit ServiceEventDispatcher(size_t count = 1, bool timer_wheel = false, bool work_stealing = false);
   virtual ~ServiceEventDispatcher();
 
   /**
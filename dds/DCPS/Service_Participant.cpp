@@ -459,9 +459,11 @@ Service_Participant::get_domain_participant_factory(int &argc,
 
       dp_factory_servant_ = make_rch<DomainParticipantFactoryImpl>();
 
-      event_dispatcher_ = make_rch<ServiceEventDispatcher>(event_dispatcher_thread_count());
+      event_dispatcher_ = make_rch<ServiceEventDispatcher>(event_dispatcher_thread_count(), timer_wheel(),
+                                                           event_dispatcher_work_stealing());
 
-      reactor_task_->open_reactor_task(&thread_status_manager_, "Service_Participant");
+      reactor_task_->open_reactor_task(&thread_status_manager_, "Service_Participant",
+                                       ReactorTask::make_reactor(reactor_type()));
       job_queue_ = make_rch<JobQueue>(event_dispatcher_);
       reactor_task_->job_queue(job_queue_);
 
@@ -1686,6 +1688,63 @@ Service_Participant::publisher_content_filter() const
                                     COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default);
 }
 
+void
+Service_Participant::hashed_instance_index(bool flag)
+{
+  config_store_->set_boolean(COMMON_DCPS_HASHED_INSTANCE_INDEX, flag);
+}
+
+bool
+Service_Participant::hashed_instance_index() const
+{
+  return config_store_->get_boolean(COMMON_DCPS_HASHED_INSTANCE_INDEX,
+                                    COMMON_DCPS_HASHED_INSTANCE_INDEX_default);
+}
+
+void
+Service_Participant::concurrent_demarshal(bool flag)
+{
+  config_store_->set_boolean(COMMON_DCPS_CONCURRENT_DEMARSHAL, flag);
+}
+
+bool
+Service_Participant::concurrent_demarshal() const
+{
+  return config_store_->get_boolean(COMMON_DCPS_CONCURRENT_DEMARSHAL,
+                                    COMMON_DCPS_CONCURRENT_DEMARSHAL_default);
+}
+
+void
+Service_Participant::timer_wheel(bool flag)
+{
+  config_store_->set_boolean(COMMON_DCPS_TIMER_WHEEL, flag);
+}
+
+bool
+Service_Participant::timer_wheel() const
+{
+  return config_store_->get_boolean(COMMON_DCPS_TIMER_WHEEL,
+                                    COMMON_DCPS_TIMER_WHEEL_default);
+}
+
+ReactorTask::ReactorType
+Service_Participant::reactor_type() const
+{
+  return config_store_->get(COMMON_DCPS_REACTOR_TYPE, ReactorTask::REACTOR_SELECT, ReactorTask::reactor_types);
+}
+
+void
+Service_Participant::reactor_type(ReactorTask::ReactorType type)
+{
+  config_store_->set(COMMON_DCPS_REACTOR_TYPE, type, ReactorTask::reactor_types);
+}
+
+void
+Service_Participant::reactor_type(const char* type)
+{
+  config_store_->set(COMMON_DCPS_REACTOR_TYPE, type, ReactorTask::reactor_types);
+}
+
 TimeDuration
 Service_Participant::pending_timeout() const
 {
@@ -1849,6 +1908,19 @@ Service_Participant::event_dispatcher_thread_count() const
   return value;
 }
 
+void
+Service_Participant::event_dispatcher_work_stealing(bool flag)
+{
+  config_store_->set_boolean(COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING, flag);
+}
+
+bool
+Service_Participant::event_dispatcher_work_stealing() const
+{
+  return config_store_->get_boolean(COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING,
+                                    COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING_default);
+}
+
 void
 Service_Participant::register_discovery_type(const char* section_name,
                                              Discovery::Config* cfg)
@@ -2219,7 +2291,17 @@ Service_Participant::get_data_durability_cache(
           const String persistent_data_dir =
             config_store_->get(COMMON_DCPS_PERSISTENT_DATA_DIR,
                                COMMON_DCPS_PERSISTENT_DATA_DIR_default);
-          this->persistent_data_cache_.reset(new DataDurabilityCache(kind, persistent_data_dir));
+          DurableDataLog_rch log;
+          if (config_store_->get_boolean(COMMON_DCPS_PERSISTENT_DATA_LOG,
+                                         COMMON_DCPS_PERSISTENT_DATA_LOG_default)) {
+            log = make_rch<DurableDataLog>(
+              persistent_data_dir,
+              config_store_->get_uint32(COMMON_DCPS_PERSISTENT_DATA_LOG_SEGMENT_SIZE,
+                                        COMMON_DCPS_PERSISTENT_DATA_LOG_SEGMENT_SIZE_default),
+              config_store_->get_boolean(COMMON_DCPS_PERSISTENT_DATA_LOG_SYNC,
+                                         COMMON_DCPS_PERSISTENT_DATA_LOG_SYNC_default));
+          }
+          this->persistent_data_cache_.reset(new DataDurabilityCache(kind, persistent_data_dir, log));
         }
 
       } catch (const std::exception& ex) {
@@ -82,6 +82,9 @@ const char COMMON_DCPS_CHUNK_ASSOCIATION_MULTIPLIER[] = "COMMON_DCPS_CHUNK_ASSOC
 const char COMMON_DCPS_CHUNK_ASSOCIATION_MUTLTIPLIER[] = "COMMON_DCPS_CHUNK_ASSOCIATION_MUTLTIPLIER";
 const size_t COMMON_DCPS_CHUNK_ASSOCIATION_MULTIPLIER_default = 10;
 
+const char COMMON_DCPS_CONCURRENT_DEMARSHAL[] = "COMMON_DCPS_CONCURRENT_DEMARSHAL";
+const bool COMMON_DCPS_CONCURRENT_DEMARSHAL_default = false;
+
 const char COMMON_DCPS_DEBUG_LEVEL[] = "COMMON_DCPS_DEBUG_LEVEL";
 
 const char COMMON_DCPS_DEFAULT_ADDRESS[] = "COMMON_DCPS_DEFAULT_ADDRESS";
@@ -102,9 +105,15 @@ const Discovery::RepoKey COMMON_DCPS_DEFAULT_DISCOVERY_default = Discovery::DEFA
 const char COMMON_DCPS_EVENT_DISPATCHER_THREADS[] = "COMMON_DCPS_EVENT_DISPATCHER_THREADS";
 const size_t COMMON_DCPS_EVENT_DISPATCHER_THREADS_default = 1u;
 
+const char COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING[] = "COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING";
+const bool COMMON_DCPS_EVENT_DISPATCHER_WORK_STEALING_default = false;
+
 const char COMMON_DCPS_GLOBAL_TRANSPORT_CONFIG[] = "COMMON_DCPS_GLOBAL_TRANSPORT_CONFIG";
 const String COMMON_DCPS_GLOBAL_TRANSPORT_CONFIG_default = "";
 
+const char COMMON_DCPS_HASHED_INSTANCE_INDEX[] = "COMMON_DCPS_HASHED_INSTANCE_INDEX";
+const bool COMMON_DCPS_HASHED_INSTANCE_INDEX_default = false;
+
 const char COMMON_DCPS_INFO_REPO[] = "COMMON_DCPS_INFO_REPO";
 
 const char COMMON_DCPS_LIVELINESS_FACTOR[] = "COMMON_DCPS_LIVELINESS_FACTOR";
@@ -122,13 +131,28 @@ const TimeDuration COMMON_DCPS_PENDING_TIMEOUT_default(0, 0);
 #ifndef OPENDDS_NO_PERSISTENCE_PROFILE
 const char COMMON_DCPS_PERSISTENT_DATA_DIR[] = "COMMON_DCPS_PERSISTENT_DATA_DIR";
 const String COMMON_DCPS_PERSISTENT_DATA_DIR_default = "OpenDDS-durable-data-dir";
+
+const char COMMON_DCPS_PERSISTENT_DATA_LOG[] = "COMMON_DCPS_PERSISTENT_DATA_LOG";
+const bool COMMON_DCPS_PERSISTENT_DATA_LOG_default = false;
+
+const char COMMON_DCPS_PERSISTENT_DATA_LOG_SEGMENT_SIZE[] = "COMMON_DCPS_PERSISTENT_DATA_LOG_SEGMENT_SIZE";
+const size_t COMMON_DCPS_PERSISTENT_DATA_LOG_SEGMENT_SIZE_default = 1024 * 1024 * 16;
+
+const char COMMON_DCPS_PERSISTENT_DATA_LOG_SYNC[] = "COMMON_DCPS_PERSISTENT_DATA_LOG_SYNC";
+const bool COMMON_DCPS_PERSISTENT_DATA_LOG_SYNC_default = true;
 #endif
 
 const char COMMON_DCPS_PUBLISHER_CONTENT_FILTER[] = "COMMON_DCPS_PUBLISHER_CONTENT_FILTER";
 const bool COMMON_DCPS_PUBLISHER_CONTENT_FILTER_default = true;
 
+const char COMMON_DCPS_REACTOR_TYPE[] = "COMMON_DCPS_REACTOR_TYPE";
+const String COMMON_DCPS_REACTOR_TYPE_default = "Select";
+
 const char COMMON_DCPS_THREAD_STATUS_INTERVAL[] = "COMMON_DCPS_THREAD_STATUS_INTERVAL";
 
+const char COMMON_DCPS_TIMER_WHEEL[] = "COMMON_DCPS_TIMER_WHEEL";
+const bool COMMON_DCPS_TIMER_WHEEL_default = false;
+
 const char COMMON_DCPS_TRANSPORT_DEBUG_LEVEL[] = "COMMON_DCPS_TRANSPORT_DEBUG_LEVEL";
 
 const char COMMON_DCPS_TYPE_OBJECT_ENCODING[] = "COMMON_DCPS_TYPE_OBJECT_ENCODING";
@@ -351,6 +375,13 @@ public:
   size_t event_dispatcher_thread_count() const;
   //@}
 
+  /// Accessors for giving each thread of the EventDispatchers that are
+  /// created after it's set its own queue of events.
+  //@{
+  void event_dispatcher_work_stealing(bool);
+  bool event_dispatcher_work_stealing() const;
+  //@}
+
   ///
   void add_discovery(Discovery_rch discovery);
 
@@ -424,6 +455,34 @@ public:
   bool publisher_content_filter() const;
   //@}
 
+  /// Accessors for HashedInstanceIndex.
+  //@{
+  void hashed_instance_index(bool);
+  bool hashed_instance_index() const;
+  //@}
+
+  /// Accessors for ConcurrentDemarshal, which is used by the DataReaders
+  /// that are created after it's set.
+  //@{
+  void concurrent_demarshal(bool);
+  bool concurrent_demarshal() const;
+  //@}
+
+  /// Accessors for TimerWheel, which is used by the EventDispatchers that
+  /// are created after it's set.
+  //@{
+  void timer_wheel(bool);
+  bool timer_wheel() const;
+  //@}
+
+  /// Accessors for ReactorType, the kind of reactor used by the
+  /// Service_Participant and by the transports that don't set their own.
+  //@{
+  ReactorTask::ReactorType reactor_type() const;
+  void reactor_type(ReactorTask::ReactorType type);
+  void reactor_type(const char* type);
+  //@}
+
   /// Accessors for pending data timeout.
   //@{
   TimeDuration pending_timeout() const;
@@ -0,0 +1,409 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TIMER_WHEEL_T_H
+#define OPENDDS_DCPS_TIMER_WHEEL_T_H
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include "PoolAllocator.h"
+#include "TimeTypes.h"
+
+#include <algorithm>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Hierarchical timing wheel of values of type T, each with an expiration
+ * time.  Time is divided into ticks of a fixed resolution.  Each of the LEVELS
+ * wheels has SLOTS slots, and a slot on level L covers SLOTS^L ticks.  A timer
+ * is put in the slot for its expiration tick on the lowest level where that
+ * slot is ahead of the current tick, and is moved down a level when the
+ * wheel reaches its slot.  Inserting and erasing are constant time, and
+ * expiring timers only visits the slots that have timers in them.
+ *
+ * Timers are never expired early.  They can be expired up to one resolution
+ * late.  Timers that expire together are returned in order of expiration,
+ * then insertion.
+ */
+template <typename T>
+class TimerWheel {
+public:
+  /// Identifies an inserted timer until it's erased or expired
+  typedef size_t Handle;
+
+  explicit TimerWheel(const TimeDuration& resolution = TimeDuration::from_msec(1),
+                      const MonotonicTimePoint& start = MonotonicTimePoint::now())
+    : start_(start)
+    , resolution_usec_(1)
+    , now_tick_(0)
+    , size_(0)
+    , next_seq_(0)
+    , free_(NIL)
+    , due_(NIL)
+    , overflow_(NIL)
+  {
+    ACE_UINT64 usec = 0;
+    resolution.value().to_usec(usec);
+    if (usec) {
+      resolution_usec_ = usec;
+    }
+    std::fill(&heads_[0][0], &heads_[0][0] + LEVELS * SLOTS, Handle(NIL));
+    std::fill(occupied_, occupied_ + LEVELS, ACE_UINT64(0));
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  Handle insert(const MonotonicTimePoint& expiration, const T& value)
+  {
+    Handle h = free_;
+    if (h == NIL) {
+      h = nodes_.size();
+      nodes_.push_back(Node());
+    } else {
+      free_ = nodes_[h].next_;
+    }
+    Node& node = nodes_[h];
+    node.value_ = value;
+    node.expiration_ = expiration;
+    node.tick_ = to_tick(expiration);
+    node.seq_ = next_seq_++;
+    place(h);
+    ++size_;
+    return h;
+  }
+
+  const T& value(Handle h) const { return nodes_[h].value_; }
+  const MonotonicTimePoint& expiration(Handle h) const { return nodes_[h].expiration_; }
+
+  void erase(Handle h)
+  {
+    unlink(h);
+    release(h);
+  }
+
+  /// Remove the timers that expire at or before now, rounded to the
+  /// resolution, and append them to expired.
+  void expire(const MonotonicTimePoint& now, OPENDDS_VECTOR(T)& expired)
+  {
+    OPENDDS_VECTOR(Handle) handles;
+    take_list(due_, handles);
+    due_ = NIL;
+
+    const ACE_UINT64 target = now_floor_tick(now);
+    while (size_ != handles.size()) {
+      const ACE_UINT64 tick = next_tick();
+      if (tick > target) {
+        break;
+      }
+      now_tick_ = tick;
+      // Timers moved down to now_tick_ are put in due_
+      cascade();
+      take_list(due_, handles);
+      due_ = NIL;
+      const unsigned slot = unsigned(now_tick_ % SLOTS);
+      take_list(heads_[0][slot], handles);
+      heads_[0][slot] = NIL;
+      occupied_[0] &= ~(ACE_UINT64(1) << slot);
+    }
+    if (target > now_tick_) {
+      now_tick_ = target;
+    }
+
+    std::sort(handles.begin(), handles.end(), ExpirationLess(nodes_));
+    for (typename OPENDDS_VECTOR(Handle)::const_iterator i = handles.begin(); i != handles.end(); ++i) {
+      expired.push_back(nodes_[*i].value_);
+      release(*i);
+    }
+  }
+
+  /**
+   * When expire() needs to be called next.  This is no later than the first
+   * expiration, but it can be earlier when timers need to move between
+   * levels.  Returns false if there are no timers.
+   */
+  bool next_deadline(MonotonicTimePoint& deadline) const
+  {
+    if (empty()) {
+      return false;
+    }
+    if (due_ != NIL) {
+      deadline = start_;
+      return true;
+    }
+    const ACE_UINT64 usec = next_tick() * resolution_usec_;
+    deadline = start_ + TimeDuration(time_t(usec / 1000000), suseconds_t(usec % 1000000));
+    return true;
+  }
+
+  /// Remove all the timers and append them to values in order of expiration
+  void clear(OPENDDS_VECTOR(T)* values = 0)
+  {
+    if (values) {
+      OPENDDS_VECTOR(Handle) handles;
+      for (Handle h = 0; h < nodes_.size(); ++h) {
+        if (nodes_[h].level_ != FREE) {
+          handles.push_back(h);
+        }
+      }
+      std::sort(handles.begin(), handles.end(), ExpirationLess(nodes_));
+      for (typename OPENDDS_VECTOR(Handle)::const_iterator i = handles.begin(); i != handles.end(); ++i) {
+        values->push_back(nodes_[*i].value_);
+      }
+    }
+    nodes_.clear();
+    std::fill(&heads_[0][0], &heads_[0][0] + LEVELS * SLOTS, Handle(NIL));
+    std::fill(occupied_, occupied_ + LEVELS, ACE_UINT64(0));
+    size_ = 0;
+    free_ = NIL;
+    due_ = NIL;
+    overflow_ = NIL;
+  }
+
+  /// Erase the timers with values that pred returns true for and append the
+  /// values to erased.
+  template <typename Pred>
+  void erase_if(Pred pred, OPENDDS_VECTOR(T)& erased)
+  {
+    for (Handle h = 0; h < nodes_.size(); ++h) {
+      if (nodes_[h].level_ != FREE && pred(nodes_[h].value_)) {
+        erased.push_back(nodes_[h].value_);
+        erase(h);
+      }
+    }
+  }
+
+private:
+  enum {
+    SLOT_BITS = 6,
+    SLOTS = 1 << SLOT_BITS,
+    LEVELS = 6,
+    /// Level of a node in due_
+    DUE = LEVELS,
+    /// Level of a node in overflow_
+    BEYOND = LEVELS + 1,
+    /// Level of a node on the free list
+    FREE = LEVELS + 2
+  };
+  static const Handle NIL = ~Handle(0);
+
+  struct Node {
+    Node() : tick_(0), seq_(0), prev_(NIL), next_(NIL), level_(FREE), slot_(0) {}
+    T value_;
+    MonotonicTimePoint expiration_;
+    ACE_UINT64 tick_;
+    ACE_UINT64 seq_;
+    Handle prev_;
+    Handle next_;
+    unsigned level_;
+    unsigned slot_;
+  };
+
+  struct ExpirationLess {
+    explicit ExpirationLess(const OPENDDS_VECTOR(Node)& nodes) : nodes_(nodes) {}
+    bool operator()(Handle a, Handle b) const
+    {
+      const Node& x = nodes_[a];
+      const Node& y = nodes_[b];
+      return x.expiration_ < y.expiration_ || (x.expiration_ == y.expiration_ && x.seq_ < y.seq_);
+    }
+    const OPENDDS_VECTOR(Node)& nodes_;
+  };
+
+  /// First tick at or after expiration
+  ACE_UINT64 to_tick(const MonotonicTimePoint& expiration) const
+  {
+    if (expiration <= start_) {
+      return 0;
+    }
+    ACE_UINT64 usec = 0;
+    (expiration - start_).value().to_usec(usec);
+    return (usec + resolution_usec_ - 1) / resolution_usec_;
+  }
+
+  /// Last tick at or before now
+  ACE_UINT64 now_floor_tick(const MonotonicTimePoint& now) const
+  {
+    if (now <= start_) {
+      return 0;
+    }
+    ACE_UINT64 usec = 0;
+    (now - start_).value().to_usec(usec);
+    return usec / resolution_usec_;
+  }
+
+  static unsigned lowest_bit(ACE_UINT64 x)
+  {
+#ifdef __GNUC__
+    return unsigned(__builtin_ctzll(x));
+#else
+    unsigned i = 0;
+    for (; !(x & 1); x >>= 1) {
+      ++i;
+    }
+    return i;
+#endif
+  }
+
+  /// Level of the highest SLOT_BITS group where tick differs from now_tick_
+  unsigned level_for(ACE_UINT64 tick) const
+  {
+    ACE_UINT64 diff = (tick ^ now_tick_) >> SLOT_BITS;
+    unsigned level = 0;
+    for (; diff; diff >>= SLOT_BITS) {
+      ++level;
+    }
+    return level;
+  }
+
+  void place(Handle h)
+  {
+    Node& node = nodes_[h];
+    if (node.tick_ <= now_tick_) {
+      link(h, due_, DUE, 0);
+      return;
+    }
+    const unsigned level = level_for(node.tick_);
+    if (level >= LEVELS) {
+      // Past the current rotation of the top level
+      link(h, overflow_, BEYOND, 0);
+      return;
+    }
+    const unsigned slot = unsigned((node.tick_ >> (SLOT_BITS * level)) % SLOTS);
+    link(h, heads_[level][slot], level, slot);
+    occupied_[level] |= ACE_UINT64(1) << slot;
+  }
+
+  void link(Handle h, Handle& head, unsigned level, unsigned slot)
+  {
+    Node& node = nodes_[h];
+    node.level_ = level;
+    node.slot_ = slot;
+    node.prev_ = NIL;
+    node.next_ = head;
+    if (head != NIL) {
+      nodes_[head].prev_ = h;
+    }
+    head = h;
+  }
+
+  void unlink(Handle h)
+  {
+    Node& node = nodes_[h];
+    if (node.prev_ != NIL) {
+      nodes_[node.prev_].next_ = node.next_;
+    } else if (node.level_ == DUE) {
+      due_ = node.next_;
+    } else if (node.level_ == BEYOND) {
+      overflow_ = node.next_;
+    } else {
+      heads_[node.level_][node.slot_] = node.next_;
+      if (node.next_ == NIL) {
+        occupied_[node.level_] &= ~(ACE_UINT64(1) << node.slot_);
+      }
+    }
+    if (node.next_ != NIL) {
+      nodes_[node.next_].prev_ = node.prev_;
+    }
+  }
+
+  void release(Handle h)
+  {
+    Node& node = nodes_[h];
+    node.value_ = T();
+    node.level_ = FREE;
+    node.prev_ = NIL;
+    node.next_ = free_;
+    free_ = h;
+    --size_;
+  }
+
+  void take_list(Handle head, OPENDDS_VECTOR(Handle)& handles)
+  {
+    for (Handle h = head; h != NIL; h = nodes_[h].next_) {
+      handles.push_back(h);
+    }
+  }
+
+  /// The next tick after now_tick_ where a slot on some level is reached
+  /// that has timers in it.
+  ACE_UINT64 next_tick() const
+  {
+    ACE_UINT64 best = ~ACE_UINT64(0);
+    for (unsigned level = 0; level < LEVELS; ++level) {
+      const unsigned shift = SLOT_BITS * level;
+      const unsigned current = unsigned((now_tick_ >> shift) % SLOTS);
+      const ACE_UINT64 ahead = current == SLOTS - 1 ? 0 : occupied_[level] & (~ACE_UINT64(0) << (current + 1));
+      if (ahead) {
+        const ACE_UINT64 rotation = now_tick_ >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+        const ACE_UINT64 tick = rotation + (ACE_UINT64(lowest_bit(ahead)) << shift);
+        best = (std::min)(best, tick);
+      }
+    }
+    if (overflow_ != NIL) {
+      // The top level wraps around
+      const unsigned shift = SLOT_BITS * LEVELS;
+      best = (std::min)(best, ((now_tick_ >> shift) + 1) << shift);
+    }
+    return best;
+  }
+
+  /// Move the timers in the slots reached at now_tick_ down to lower levels
+  void cascade()
+  {
+    if (!(now_tick_ & ((ACE_UINT64(1) << (SLOT_BITS * LEVELS)) - 1))) {
+      replace_list(overflow_);
+    }
+    for (unsigned level = LEVELS - 1; level > 0; --level) {
+      const unsigned shift = SLOT_BITS * level;
+      if (now_tick_ & ((ACE_UINT64(1) << shift) - 1)) {
+        continue;
+      }
+      const unsigned slot = unsigned((now_tick_ >> shift) % SLOTS);
+      occupied_[level] &= ~(ACE_UINT64(1) << slot);
+      replace_list(heads_[level][slot]);
+    }
+  }
+
+  void replace_list(Handle& head)
+  {
+    Handle h = head;
+    head = NIL;
+    while (h != NIL) {
+      const Handle next = nodes_[h].next_;
+      place(h);
+      h = next;
+    }
+  }
+
+  const MonotonicTimePoint start_;
+  ACE_UINT64 resolution_usec_;
+  /// Timers with ticks up to this have been expired
+  ACE_UINT64 now_tick_;
+  size_t size_;
+  ACE_UINT64 next_seq_;
+  OPENDDS_VECTOR(Node) nodes_;
+  Handle free_;
+  /// Timers that were inserted already expired
+  Handle due_;
+  /// Timers past the current rotation of the top level
+  Handle overflow_;
+  Handle heads_[LEVELS][SLOTS];
+  /// Bit n is set if slot n of a level has timers
+  ACE_UINT64 occupied_[LEVELS];
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TIMER_WHEEL_T_H */
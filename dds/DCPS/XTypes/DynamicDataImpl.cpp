@@ -8,6 +8,7 @@
 #ifndef OPENDDS_SAFETY_PROFILE
 #  include "DynamicDataImpl.h"
 
+#  include "DynamicTypeImpl.h"
 #  include "DynamicTypeMemberImpl.h"
 #  include "Utils.h"
 
@@ -428,40 +429,49 @@ DDS::ReturnCode_t DynamicDataImpl::clear_value(DDS::MemberId id)
     }
 
     DDS::DynamicType_var elem_type = get_base_type(type_desc_->element_type());
-    erase_member(id);
-    for (CORBA::ULong i = id_to_index(id) + 1; i < size; ++i) {
+    const CORBA::ULong index = id_to_index(id);
+    // Rebuild the maps in one pass.  Moving the elements one at a time would
+    // insert into and erase from the middle of the flat maps for each of them.
+    SingleMap singles;
+    SequenceMap sequences;
+    ComplexMap complexes;
+    for (CORBA::ULong i = 0; i < size; ++i) {
+      if (i == index) {
+        continue;
+      }
       const DDS::MemberId curr_id = index_to_id(i);
-      const DDS::MemberId prev_id = index_to_id(i - 1);
+      const DDS::MemberId new_id = index_to_id(i < index ? i : i - 1);
       const_single_iterator single_it = container_.single_map_.find(curr_id);
       if (single_it != container_.single_map_.end()) {
-        container_.single_map_.insert(std::make_pair(prev_id, single_it->second));
-        container_.single_map_.erase(curr_id);
+        singles.insert(std::make_pair(new_id, single_it->second));
         continue;
       }
       const_sequence_iterator seq_it = container_.sequence_map_.find(curr_id);
       if (seq_it != container_.sequence_map_.end()) {
-        container_.sequence_map_.insert(std::make_pair(prev_id, seq_it->second));
-        container_.sequence_map_.erase(curr_id);
+        sequences.insert(std::make_pair(new_id, seq_it->second));
         continue;
       }
       const_complex_iterator complex_it = container_.complex_map_.find(curr_id);
       if (complex_it != container_.complex_map_.end()) {
-        container_.complex_map_.insert(std::make_pair(prev_id, complex_it->second));
-        container_.complex_map_.erase(curr_id);
+        complexes.insert(std::make_pair(new_id, complex_it->second));
         continue;
       }
       // Since the backing store is read-only, we can't shift its elements. Instead,
       // copy (and shift) the elements that are missing in the container from the backing store.
-      if (backing_store_) {
+      if (i > index && backing_store_) {
         DynamicDataImpl* elem_ddi = new DynamicDataImpl(elem_type);
         DDS::DynamicData_var elem_dd = elem_ddi;
         const DDS::ReturnCode_t rc = set_member_backing_store(elem_ddi, curr_id);
         if (rc != DDS::RETCODE_OK && rc != DDS::RETCODE_NO_DATA) {
           return DDS::RETCODE_ERROR;
         }
-        container_.complex_map_.insert(std::make_pair(prev_id, elem_dd));
+        complexes.insert(std::make_pair(new_id, elem_dd));
       }
     }
+    container_.single_map_.swap(singles);
+    container_.sequence_map_.swap(sequences);
+    container_.complex_map_.swap(complexes);
+    container_.set_capacity_hint();
 
     // Then disable the backing store.
     set_backing_store(0);
@@ -472,7 +482,7 @@ DDS::ReturnCode_t DynamicDataImpl::clear_value(DDS::MemberId id)
     if (id >= size) {
       return DDS::RETCODE_BAD_PARAMETER;
     }
-    OPENDDS_MAP(DDS::MemberId, MapEntry) replacement;
+    MapMap replacement;
     DynamicDataBase* base = dynamic_cast<DynamicDataBase*>(backing_store_.in());
     for (CORBA::ULong i = 0; i < size; ++i) {
       const DDS::MemberId curr_id = index_to_id(i);
@@ -494,6 +504,7 @@ DDS::ReturnCode_t DynamicDataImpl::clear_value(DDS::MemberId id)
       }
     }
     container_.map_map_.swap(replacement);
+    container_.set_capacity_hint();
     set_backing_store(0);
     break;
   }
@@ -987,6 +998,11 @@ DynamicDataImpl::SingleValue::SingleValue(const CORBA::WChar* wstr)
 #endif
 
 DynamicDataImpl::SingleValue::~SingleValue()
+{
+  destroy();
+}
+
+void DynamicDataImpl::SingleValue::destroy()
 {
 #define SINGLE_VALUE_DESTRUCT(T) static_cast<ACE_OutputCDR::T*>(active_)->~T(); break
   switch (kind_) {
@@ -1133,9 +1149,12 @@ DynamicDataImpl::SingleValue::SingleValue(const SingleValue& other)
 
 DynamicDataImpl::SingleValue& DynamicDataImpl::SingleValue::operator=(const SingleValue& other)
 {
-  kind_ = other.kind_;
-  active_ = 0;
-  copy(other);
+  if (this != &other) {
+    destroy();
+    kind_ = other.kind_;
+    active_ = 0;
+    copy(other);
+  }
   return *this;
 }
 
@@ -1211,6 +1230,22 @@ DynamicDataImpl::SequenceValue::SequenceValue(const DDS::WstringSeq& wstr_seq)
 
 DynamicDataImpl::SequenceValue::SequenceValue(const SequenceValue& rhs)
   : elem_kind_(rhs.elem_kind_), active_(0)
+{
+  copy(rhs);
+}
+
+DynamicDataImpl::SequenceValue& DynamicDataImpl::SequenceValue::operator=(const SequenceValue& rhs)
+{
+  if (this != &rhs) {
+    destroy();
+    elem_kind_ = rhs.elem_kind_;
+    active_ = 0;
+    copy(rhs);
+  }
+  return *this;
+}
+
+void DynamicDataImpl::SequenceValue::copy(const SequenceValue& rhs)
 {
 #define SEQUENCE_VALUE_PLACEMENT_NEW(T, N)  active_ = new(N) DDS::T(reinterpret_cast<const DDS::T&>(rhs.N)); break;
   switch (elem_kind_) {
@@ -1255,6 +1290,11 @@ DynamicDataImpl::SequenceValue::SequenceValue(const SequenceValue& rhs)
 }
 
 DynamicDataImpl::SequenceValue::~SequenceValue()
+{
+  destroy();
+}
+
+void DynamicDataImpl::SequenceValue::destroy()
 {
 #define SEQUENCE_VALUE_DESTRUCT(T) static_cast<DDS::T*>(active_)->~T(); break
   switch (elem_kind_) {
@@ -4388,6 +4428,57 @@ void DynamicDataImpl::DataContainer::clear()
   map_map_.clear();
 }
 
+void DynamicDataImpl::DataContainer::set_capacity_hint()
+{
+  // Large or unbounded collections are left to grow as needed.
+  static const size_t max_hint = 64;
+  if (!type_ || !type_desc_) {
+    return;
+  }
+  size_t hint = 0;
+  switch (type_->get_kind()) {
+  case TK_STRUCTURE:
+    hint = type_->get_member_count();
+    break;
+  case TK_UNION:
+    // Discriminator and branch
+    hint = 2;
+    break;
+  case TK_ARRAY:
+    hint = bound_total(type_desc_);
+    break;
+  case TK_SEQUENCE:
+  case TK_MAP:
+  case TK_STRING8:
+  case TK_STRING16:
+    hint = type_desc_->bound().length() ? type_desc_->bound()[0] : 0;
+    break;
+  default:
+    break;
+  }
+  hint = (std::min)(hint, max_hint);
+  single_map_.capacity_hint(hint);
+  sequence_map_.capacity_hint(hint);
+  complex_map_.capacity_hint(hint);
+  map_map_.capacity_hint(hint);
+}
+
+void DynamicDataImpl::DataContainer::set_member_slots()
+{
+  if (!type_ || type_->get_kind() != TK_STRUCTURE) {
+    return;
+  }
+  const DynamicTypeImpl* const type_impl = dynamic_cast<const DynamicTypeImpl*>(type_.in());
+  if (!type_impl) {
+    return;
+  }
+  const MemberSlots* const slots = &type_impl->member_slots();
+  single_map_.member_slots(slots);
+  sequence_map_.member_slots(slots);
+  complex_map_.member_slots(slots);
+  map_map_.member_slots(slots);
+}
+
 // Get largest index among elements of a sequence-like type written to the single map.
 bool DynamicDataImpl::DataContainer::get_largest_single_index(CORBA::ULong& largest_index) const
 {
@@ -8,6 +8,7 @@
 
 #ifndef OPENDDS_SAFETY_PROFILE
 #  include "DynamicDataBase.h"
+#  include "MemberMap_T.h"
 
 #  include <dds/DCPS/FilterEvaluator.h>
 #  include <dds/DCPS/Sample.h>
@@ -496,6 +497,7 @@ private:
     void copy(const SingleValue& other);
 
     ~SingleValue();
+    void destroy();
 
     // Return a reference to the stored value. Mostly for serialization.
     template<typename T> const T& get() const;
@@ -554,6 +556,7 @@ private:
 #endif
 
     SequenceValue(const SequenceValue& rhs);
+    SequenceValue& operator=(const SequenceValue& rhs);
     ~SequenceValue();
 
     template<typename T> const T& get() const;
@@ -585,12 +588,17 @@ private:
     };
 
   private:
-    SequenceValue& operator=(const SequenceValue& rhs);
+    void copy(const SequenceValue& rhs);
+    void destroy();
   };
 
-  typedef OPENDDS_MAP(DDS::MemberId, SingleValue)::const_iterator const_single_iterator;
-  typedef OPENDDS_MAP(DDS::MemberId, SequenceValue)::const_iterator const_sequence_iterator;
-  typedef OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var)::const_iterator const_complex_iterator;
+  typedef MemberMap<DDS::MemberId, SingleValue> SingleMap;
+  typedef MemberMap<DDS::MemberId, SequenceValue> SequenceMap;
+  typedef MemberMap<DDS::MemberId, DDS::DynamicData_var> ComplexMap;
+
+  typedef SingleMap::const_iterator const_single_iterator;
+  typedef SequenceMap::const_iterator const_sequence_iterator;
+  typedef ComplexMap::const_iterator const_complex_iterator;
 
   struct MapEntry {
     MapEntry();
@@ -600,7 +608,8 @@ private:
     DDS::DynamicData_var value_;
   };
 
-  typedef OPENDDS_MAP(DDS::MemberId, MapEntry)::const_iterator const_map_iterator;
+  typedef MemberMap<DDS::MemberId, MapEntry> MapMap;
+  typedef MapMap::const_iterator const_map_iterator;
 
   // Container for all data written to this DynamicData object.
   // At anytime, there can be at most 1 entry for any given MemberId in all maps.
@@ -610,7 +619,10 @@ private:
       : type_(type)
       , type_desc_(data->type_desc_)
       , data_(data)
-    {}
+    {
+      set_capacity_hint();
+      set_member_slots();
+    }
 
     DataContainer(const DataContainer& other, const DynamicDataImpl* data)
       : single_map_(other.single_map_)
@@ -624,6 +636,15 @@ private:
 
     void clear();
 
+    // Reserve room in each map for the number of members the type can have
+    // the first time something is inserted, so that filling in a sample
+    // doesn't grow the maps one value at a time.
+    void set_capacity_hint();
+
+    // Let the maps of a struct find members through the slots of its type
+    // instead of searching by id.
+    void set_member_slots();
+
     // Get the largest index of all elements in each map.
     // Call only for collection-like types (sequence, string, etc).
     // Must be called with a non-empty map.
@@ -641,10 +662,10 @@ private:
     bool get_largest_index_basic_sequence(CORBA::ULong& index) const;
 
     // Internal data
-    OPENDDS_MAP(DDS::MemberId, SingleValue) single_map_;
-    OPENDDS_MAP(DDS::MemberId, SequenceValue) sequence_map_;
-    OPENDDS_MAP(DDS::MemberId, DDS::DynamicData_var) complex_map_;
-    OPENDDS_MAP(DDS::MemberId, MapEntry) map_map_;
+    SingleMap single_map_;
+    SequenceMap sequence_map_;
+    ComplexMap complex_map_;
+    MapMap map_map_;
 
     const DDS::DynamicType_var& type_;
     const DDS::TypeDescriptor_var& type_desc_;
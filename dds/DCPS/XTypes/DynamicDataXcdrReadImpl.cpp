@@ -161,6 +161,7 @@ void DynamicDataXcdrReadImpl::copy(const DynamicDataXcdrReadImpl& other)
   type_ = other.type_;
   item_count_ = other.item_count_;
   item_count_limit_ = other.item_count_limit_;
+  member_offsets_ = other.member_offsets_;
 }
 
 DDS::ReturnCode_t DynamicDataXcdrReadImpl::set_descriptor(MemberId, DDS::MemberDescriptor*)
@@ -2517,8 +2518,29 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
       return DDS::RETCODE_ERROR;
     }
     const size_t end_of_struct = strm_.rpos() + dheader;
+    const ACE_CDR::ULong index = member_desc->index();
+    if (index >= member_offsets_.no_data_index) {
+      return DDS::RETCODE_NO_DATA;
+    }
+
+    // Start from the furthest member before this one that has been reached.
+    OPENDDS_VECTOR(size_t)& offsets = member_offsets_.by_index;
+    ACE_CDR::ULong i = 0;
+    if (!offsets.empty()) {
+      i = (std::min)(index, static_cast<ACE_CDR::ULong>(offsets.size() - 1));
+      if (!skip_to_offset(offsets[i])) {
+        if (DCPS::DCPS_debug_level >= 1) {
+          ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                     ACE_TEXT(" Failed to skip to member at index %d\n"), i));
+        }
+        return DDS::RETCODE_ERROR;
+      }
+    }
 
-    for (ACE_CDR::ULong i = 0; i < member_desc->index(); ++i) {
+    for (; i < index; ++i) {
+      if (i == offsets.size()) {
+        offsets.push_back(strm_.rpos());
+      }
       DDS::DynamicTypeMember_var dtm;
       DDS::ReturnCode_t rc = type_->get_member_by_index(dtm, i);
       if (rc != DDS::RETCODE_OK) {
@@ -2551,9 +2573,13 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return DDS::RETCODE_ERROR;
       }
       if (xcdr2_appendable && strm_.rpos() >= end_of_struct) {
+        member_offsets_.no_data_index = i + 1;
         return DDS::RETCODE_NO_DATA;
       }
     }
+    if (index == offsets.size()) {
+      offsets.push_back(strm_.rpos());
+    }
 
     if (member_desc->is_optional()) {
       bool has_value = false;
@@ -2581,6 +2607,20 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
     }
 
     const size_t end_of_struct = strm_.rpos() + dheader;
+
+    const MemberMap<MemberId, size_t>::const_iterator found = member_offsets_.by_id.find(id);
+    const size_t resume_at = found != member_offsets_.by_id.end() ? found->second : member_offsets_.next_header;
+    if (resume_at && !skip_to_offset(resume_at)) {
+      if (DCPS::DCPS_debug_level >= 1) {
+        ACE_ERROR((LM_ERROR, ACE_TEXT("(%P|%t) DynamicDataXcdrReadImpl::skip_to_struct_member -")
+                   ACE_TEXT(" Failed to skip to a known position while finding member ID %d\n"), id));
+      }
+      return DDS::RETCODE_ERROR;
+    }
+    if (found != member_offsets_.by_id.end()) {
+      return DDS::RETCODE_OK;
+    }
+
     while (true) {
       if (strm_.rpos() >= end_of_struct) {
         if (DCPS::DCPS_debug_level >= 1) {
@@ -2601,6 +2641,9 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
         return DDS::RETCODE_ERROR;
       }
 
+      member_offsets_.by_id.insert(std::make_pair(member_id, strm_.rpos()));
+      member_offsets_.next_header = strm_.rpos() + member_size;
+
       if (member_id == id) {
         return DDS::RETCODE_OK;
       }
@@ -2616,6 +2659,12 @@ DDS::ReturnCode_t DynamicDataXcdrReadImpl::skip_to_struct_member(DDS::MemberDesc
   }
 }
 
+bool DynamicDataXcdrReadImpl::skip_to_offset(size_t rpos)
+{
+  const size_t current = strm_.rpos();
+  return rpos >= current && strm_.skip(rpos - current);
+}
+
 bool DynamicDataXcdrReadImpl::get_from_struct_common_checks(const DDS::MemberDescriptor_var& md,
   MemberId id, TypeKind kind, bool is_sequence)
 {
@@ -8,6 +8,7 @@
 
 #ifndef OPENDDS_SAFETY_PROFILE
 #  include "DynamicDataBase.h"
+#  include "MemberMap_T.h"
 #  include "TypeObject.h"
 
 #  include <dds/DCPS/PoolAllocator.h>
@@ -448,10 +449,14 @@ private:
   template<typename UIntType, TypeKind UIntTypeKind>
   bool get_boolean_from_bitmask(ACE_CDR::ULong index, ACE_CDR::Boolean& value);
 
-  /// Skip to a member with a given ID in a struct.
-  ///
+  /// Skip to a member with a given ID in a struct.  Positions found along
+  /// the way are kept in member_offsets_ so later calls can go directly to
+  /// them.
   DDS::ReturnCode_t skip_to_struct_member(DDS::MemberDescriptor* member_desc, MemberId id);
 
+  /// Skip forward to an absolute read position of strm_.
+  bool skip_to_offset(size_t rpos);
+
   bool get_from_struct_common_checks(const DDS::MemberDescriptor_var& md, MemberId id,
                                      TypeKind kind, bool is_sequence = false);
 
@@ -601,6 +606,32 @@ private:
   /// Cache the number of items (i.e., members or elements) in the data it holds.
   ACE_CDR::ULong item_count_;
   ACE_CDR::ULong item_count_limit_;
+
+  /// Read positions of struct members found by skip_to_struct_member.  Each
+  /// public interface reads from the start of the same data, so a position
+  /// found once is valid for the life of this object.
+  struct MemberOffsets {
+    MemberOffsets()
+      : no_data_index(ACE_UINT32_MAX)
+      , next_header(0)
+    {}
+
+    /// For final and appendable structs, the position of each member by
+    /// index, up to the furthest member reached so far.
+    OPENDDS_VECTOR(size_t) by_index;
+
+    /// Members at or after this index are past the end of an XCDR2
+    /// appendable struct, so they aren't in the sample.
+    ACE_CDR::ULong no_data_index;
+
+    /// For mutable structs, the position of the value of each member whose
+    /// EMHEADER has been read.
+    MemberMap<MemberId, size_t> by_id;
+
+    /// Position of the first EMHEADER that hasn't been read, or 0.
+    size_t next_header;
+  };
+  MemberOffsets member_offsets_;
 };
 
 OpenDDS_Dcps_Export bool print_dynamic_data(DDS::DynamicData_ptr dd,
@@ -86,6 +86,11 @@ public:
   {
     return evaluator.eval(*this, params);
   }
+
+  DCPS::Value get_field_value(const char* field) const
+  {
+    return DCPS::getMetaStruct<DynamicSample>().getValue(this, field);
+  }
 #endif
 
   struct KeyLessThan {
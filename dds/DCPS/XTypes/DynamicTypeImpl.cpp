@@ -174,6 +174,7 @@ void DynamicTypeImpl::insert_dynamic_member(DDS::DynamicTypeMember_ptr dtm)
 
   if (d->id() != MEMBER_ID_INVALID) {
     members_by_id_.insert(std::make_pair(d->id(), DDS::DynamicTypeMember::_duplicate(dtm)));
+    member_slots_.add(d->id());
   }
   members_by_name_.insert(std::make_pair(d->name(), DDS::DynamicTypeMember::_duplicate(dtm)));
 }
@@ -183,6 +184,7 @@ void DynamicTypeImpl::clear()
   members_by_name_.clear();
   members_by_id_.clear();
   members_by_index_.clear();
+  member_slots_.clear();
   descriptor_ = 0;
 }
 
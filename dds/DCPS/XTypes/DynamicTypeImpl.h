@@ -5,6 +5,7 @@
 
 #include "TypeDescriptorImpl.h"
 #include "MemberDescriptorImpl.h"
+#include "MemberMap_T.h"
 
 #include <dds/DCPS/RcHandle_T.h>
 #include <dds/DCPS/RcObject.h>
@@ -96,6 +97,12 @@ public:
     return preset_type_info_set_ ? &preset_type_info_ : 0;
   }
 
+  /// Slots of the member ids, in the order the members were inserted.
+  const MemberSlots& member_slots() const
+  {
+    return member_slots_;
+  }
+
 #if OPENDDS_CONFIG_IDL_MAP
   typedef DDS::DynamicTypeMembersByName DynamicTypeMembersByName;
   typedef DDS::DynamicTypeMembersById DynamicTypeMembersById;
@@ -110,6 +117,7 @@ private:
 
   typedef OPENDDS_VECTOR(DDS::DynamicTypeMember_var) DynamicTypeMembersByIndex;
   DynamicTypeMembersByIndex members_by_index_;
+  MemberSlots member_slots_;
 
   DDS::TypeDescriptor_var descriptor_;
   TypeIdentifier minimal_ti_;
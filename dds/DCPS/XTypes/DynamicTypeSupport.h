@@ -59,6 +59,7 @@ namespace OpenDDS {
       typedef DDS::DynamicDataWriter DataWriterType;
       typedef DDS::DynamicDataReader DataReaderType;
       typedef XTypes::DynamicSample::KeyLessThan LessThanType;
+      typedef void HashType; // no hashed instance index
       typedef DCPS::KeyOnly<const XTypes::DynamicSample> KeyOnlyType;
       static const char* type_name() { return "Dynamic"; } // used for logging
     };
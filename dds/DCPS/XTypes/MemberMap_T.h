@@ -0,0 +1,260 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_XTYPES_MEMBER_MAP_T_H
+#define OPENDDS_DCPS_XTYPES_MEMBER_MAP_T_H
+
+#if !defined (ACE_LACKS_PRAGMA_ONCE)
+#  pragma once
+#endif /* ACE_LACKS_PRAGMA_ONCE */
+
+#include <dds/DCPS/PoolAllocator.h>
+
+#include <ace/CDR_Base.h>
+
+#include <algorithm>
+#include <utility>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace XTypes {
+
+const size_t no_member_slot = static_cast<size_t>(-1);
+
+/**
+ * Gives each member id of a type a slot: 0 for the first member added, 1 for
+ * the next, and so on.  A MemberMap with the slots of its type finds a value
+ * by indexing an array of positions by slot.
+ *
+ * Sequential ids are looked up in an array.  Ids far from the number of
+ * members, for example the hashed ids of @autoid(HASH) types, are in a map.
+ */
+class MemberSlots {
+public:
+  MemberSlots() : count_(0) {}
+
+  /// Ignored if id already has a slot.
+  void add(ACE_CDR::ULong id)
+  {
+    if (slot(id) != no_member_slot) {
+      return;
+    }
+    if (id < dense_limit()) {
+      if (id >= by_id_.size()) {
+        by_id_.resize(id + 1, no_member_slot);
+      }
+      by_id_[id] = count_;
+    } else {
+      sparse_[id] = count_;
+    }
+    ++count_;
+  }
+
+  size_t slot(ACE_CDR::ULong id) const
+  {
+    if (id < by_id_.size()) {
+      return by_id_[id];
+    }
+    const OPENDDS_MAP(ACE_CDR::ULong, size_t)::const_iterator it = sparse_.find(id);
+    return it == sparse_.end() ? no_member_slot : it->second;
+  }
+
+  size_t count() const { return count_; }
+
+  void clear()
+  {
+    by_id_.clear();
+    sparse_.clear();
+    count_ = 0;
+  }
+
+private:
+  size_t dense_limit() const { return 2 * count_ + 64; }
+
+  OPENDDS_VECTOR(size_t) by_id_;
+  OPENDDS_MAP(ACE_CDR::ULong, size_t) sparse_;
+  size_t count_;
+};
+
+/**
+ * Map from member ids (or element indexes) to values, stored contiguously and
+ * sorted by id.  It has the subset of the interface of std::map used by
+ * DynamicDataImpl, but inserting doesn't allocate a node per value and
+ * iterating is a linear walk.
+ *
+ * The ids of the elements of collections are their indexes and the ids of
+ * struct members are usually sequential, so the map is usually dense.  When
+ * every id below id is present, id is also the position of its value, so
+ * find() is constant time.  Otherwise it's a binary search.
+ *
+ * When the map is given the MemberSlots of a struct type, it also keeps the
+ * position of the value of each member by slot, so find() is constant time
+ * whatever the ids are.  Ids without a slot fall back to the search above.
+ *
+ * Inserting or erasing invalidates iterators.  Inserting in order of id
+ * appends, so it's amortized constant time.
+ */
+template <typename Key, typename Value>
+class MemberMap {
+public:
+  typedef std::pair<Key, Value> value_type;
+  typedef OPENDDS_VECTOR(value_type) Container;
+  typedef typename Container::iterator iterator;
+  typedef typename Container::const_iterator const_iterator;
+  typedef typename Container::const_reverse_iterator const_reverse_iterator;
+
+  /// capacity_hint is reserved on the first insert, for example the number
+  /// of members of a struct.
+  explicit MemberMap(size_t capacity_hint = 0)
+    : capacity_hint_(capacity_hint)
+    , slots_(0)
+  {}
+
+  void capacity_hint(size_t hint) { capacity_hint_ = hint; }
+
+  /// slots must outlive the map, or be unset before it's destroyed.
+  void member_slots(const MemberSlots* slots)
+  {
+    slots_ = slots;
+    positions_.clear();
+    if (slots_) {
+      positions_.resize(slots_->count(), no_member_slot);
+      for (size_t i = 0; i < values_.size(); ++i) {
+        set_position(values_[i].first, i);
+      }
+    }
+  }
+
+  bool empty() const { return values_.empty(); }
+  size_t size() const { return values_.size(); }
+
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+  const_reverse_iterator rbegin() const { return values_.rbegin(); }
+  const_reverse_iterator rend() const { return values_.rend(); }
+
+  iterator find(Key id)
+  {
+    const size_t slot = slots_ ? slots_->slot(id) : no_member_slot;
+    if (slot < positions_.size()) {
+      const size_t pos = positions_[slot];
+      return pos == no_member_slot ? values_.end() : values_.begin() + pos;
+    }
+    const iterator pos = lower_bound(id);
+    return pos != values_.end() && pos->first == id ? pos : values_.end();
+  }
+
+  const_iterator find(Key id) const
+  {
+    return const_cast<MemberMap*>(this)->find(id);
+  }
+
+  /// Same as std::map::insert: an existing value isn't replaced.
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    if (values_.empty() && capacity_hint_) {
+      values_.reserve(capacity_hint_);
+    }
+    if (values_.empty() || values_.back().first < value.first) {
+      values_.push_back(value);
+      set_position(value.first, values_.size() - 1);
+      return std::make_pair(values_.end() - 1, true);
+    }
+    const iterator pos = lower_bound(value.first);
+    if (pos->first == value.first) {
+      return std::make_pair(pos, false);
+    }
+    const iterator inserted = values_.insert(pos, value);
+    update_positions(inserted - values_.begin());
+    return std::make_pair(inserted, true);
+  }
+
+  size_t erase(Key id)
+  {
+    const iterator pos = find(id);
+    if (pos == values_.end()) {
+      return 0;
+    }
+    erase(pos);
+    return 1;
+  }
+
+  void erase(iterator pos)
+  {
+    const size_t index = pos - values_.begin();
+    set_position(pos->first, no_member_slot);
+    values_.erase(pos);
+    update_positions(index);
+  }
+
+  /// Keeps the storage for reuse.
+  void clear()
+  {
+    values_.clear();
+    std::fill(positions_.begin(), positions_.end(), no_member_slot);
+  }
+
+  void swap(MemberMap& other)
+  {
+    values_.swap(other.values_);
+    std::swap(capacity_hint_, other.capacity_hint_);
+    std::swap(slots_, other.slots_);
+    positions_.swap(other.positions_);
+  }
+
+private:
+  struct KeyLess {
+    bool operator()(const value_type& value, Key id) const { return value.first < id; }
+  };
+
+  iterator lower_bound(Key id)
+  {
+    if (id < values_.size() && values_[id].first == id) {
+      return values_.begin() + id;
+    }
+    return std::lower_bound(values_.begin(), values_.end(), id, KeyLess());
+  }
+
+  void set_position(Key id, size_t pos)
+  {
+    if (!slots_) {
+      return;
+    }
+    const size_t slot = slots_->slot(id);
+    if (slot == no_member_slot) {
+      return;
+    }
+    if (slot >= positions_.size()) {
+      positions_.resize(slot + 1, no_member_slot);
+    }
+    positions_[slot] = pos;
+  }
+
+  /// Inserting or erasing at from moved the values after it.
+  void update_positions(size_t from)
+  {
+    if (!slots_) {
+      return;
+    }
+    for (size_t i = from; i < values_.size(); ++i) {
+      set_position(values_[i].first, i);
+    }
+  }
+
+  Container values_;
+  size_t capacity_hint_;
+  const MemberSlots* slots_;
+  OPENDDS_VECTOR(size_t) positions_;
+};
+
+} // namespace XTypes
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif // OPENDDS_DCPS_XTYPES_MEMBER_MAP_T_H
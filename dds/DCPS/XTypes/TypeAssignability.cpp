@@ -256,6 +256,21 @@ bool TypeAssignability::assignable(const TypeIdentifier& ta,
 
 bool TypeAssignability::assignable(const TypeInformation& ta,
                                    const TypeInformation& tb) const
+{
+  // Endpoint matching checks the same pairs of types many times.
+  const TypeLookupService::AssignabilityKey key(ta, tb, consistency_flags());
+  bool result = false;
+  size_t generation = 0;
+  if (tl_service_->get_assignable(key, result, generation)) {
+    return result;
+  }
+  result = assignable_i(ta, tb);
+  tl_service_->cache_assignable(key, result, generation);
+  return result;
+}
+
+bool TypeAssignability::assignable_i(const TypeInformation& ta,
+                                     const TypeInformation& tb) const
 {
   if (use_complete_type_objects()) {
     const TypeIdentifier& complete_ta = ta.complete.typeid_with_size.type_id;
@@ -1726,6 +1741,15 @@ bool TypeAssignability::strongly_assignable(const TypeIdentifier& tia,
   return false;
 }
 
+unsigned char TypeAssignability::consistency_flags() const
+{
+  return static_cast<unsigned char>(
+    (type_consistency_.prevent_type_widening ? 1 : 0) |
+    (type_consistency_.ignore_sequence_bounds ? 2 : 0) |
+    (type_consistency_.ignore_string_bounds ? 4 : 0) |
+    (type_consistency_.ignore_member_names ? 8 : 0));
+}
+
 bool TypeAssignability::use_complete_type_objects() const
 {
   return type_consistency_.prevent_type_widening ||
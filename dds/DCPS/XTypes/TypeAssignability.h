@@ -85,6 +85,7 @@ public:
   }
 
 private:
+  bool assignable_i(const TypeInformation& ta, const TypeInformation& tb) const;
   bool assignable_alias(const MinimalTypeObject& ta, const MinimalTypeObject& tb) const;
   bool assignable_annotation(const MinimalTypeObject& ta, const MinimalTypeObject& tb) const;
   bool assignable_annotation(const MinimalTypeObject& ta, const TypeIdentifier& tb) const;
@@ -118,6 +119,8 @@ private:
   bool assignable_plain_map(const TypeIdentifier& ta, const MinimalTypeObject& tb) const;
 
   // General helpers
+  /// Packed type_consistency_ for TypeLookupService::AssignabilityKey
+  unsigned char consistency_flags() const;
   bool use_complete_type_objects() const;
   bool strongly_assignable(const TypeIdentifier& ta, const TypeIdentifier& tb) const;
   bool is_delimited(const TypeIdentifier& ti) const;
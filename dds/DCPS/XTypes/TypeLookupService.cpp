@@ -35,6 +35,9 @@ namespace OpenDDS {
 namespace XTypes {
 
 TypeLookupService::TypeLookupService()
+  : types_generation_(0)
+  , assignability_cache_hits_(0)
+  , assignability_cache_misses_(0)
 {
   to_empty_.minimal.kind = TK_NONE;
   to_empty_.complete.kind = TK_NONE;
@@ -145,6 +148,7 @@ void TypeLookupService::add_type_objects_to_cache(const TypeIdentifierTypeObject
       TypeObject to = types[i].type_object;
       if (set_type_object_defaults(to)) {
         type_map_.insert(std::make_pair(types[i].type_identifier, to));
+        types_changed();
       }
     }
   }
@@ -154,6 +158,7 @@ void TypeLookupService::add(TypeMap::const_iterator begin, TypeMap::const_iterat
 {
   ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
   type_map_.insert(begin, end);
+  types_changed();
 }
 
 void TypeLookupService::add(const TypeIdentifier& ti, const TypeObject& tobj)
@@ -162,6 +167,7 @@ void TypeLookupService::add(const TypeIdentifier& ti, const TypeObject& tobj)
   TypeMap::const_iterator pos = type_map_.find(ti);
   if (pos == type_map_.end()) {
     type_map_.insert(std::make_pair(ti, tobj));
+    types_changed();
   }
 }
 
@@ -171,6 +177,70 @@ void TypeLookupService::update_type_identifier_map(const TypeIdentifierPairSeq&
     const TypeIdentifierPair& pair = tid_pairs[i];
     complete_to_minimal_ti_map_.insert(std::make_pair(pair.type_identifier1, pair.type_identifier2));
   }
+  if (tid_pairs.length()) {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+    types_changed();
+  }
+}
+
+void TypeLookupService::types_changed()
+{
+  ++types_generation_;
+  assignability_cache_.clear();
+}
+
+bool TypeLookupService::AssignabilityKey::operator<(const AssignabilityKey& other) const
+{
+  if (consistency != other.consistency) {
+    return consistency < other.consistency;
+  }
+  if (reader_minimal != other.reader_minimal) {
+    return reader_minimal < other.reader_minimal;
+  }
+  if (writer_minimal != other.writer_minimal) {
+    return writer_minimal < other.writer_minimal;
+  }
+  if (reader_complete != other.reader_complete) {
+    return reader_complete < other.reader_complete;
+  }
+  return writer_complete < other.writer_complete;
+}
+
+bool TypeLookupService::get_assignable(const AssignabilityKey& key, bool& assignable,
+                                       size_t& generation) const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, false);
+  const AssignabilityMap::const_iterator pos = assignability_cache_.find(key);
+  if (pos != assignability_cache_.end()) {
+    ++assignability_cache_hits_;
+    assignable = pos->second;
+    return true;
+  }
+  ++assignability_cache_misses_;
+  generation = types_generation_;
+  return false;
+}
+
+void TypeLookupService::cache_assignable(const AssignabilityKey& key, bool assignable,
+                                         size_t generation)
+{
+  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+  // Drop results computed before types were added.
+  if (generation == types_generation_) {
+    assignability_cache_[key] = assignable;
+  }
+}
+
+size_t TypeLookupService::assignability_cache_hits() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, 0);
+  return assignability_cache_hits_;
+}
+
+size_t TypeLookupService::assignability_cache_misses() const
+{
+  ACE_GUARD_RETURN(ACE_Thread_Mutex, g, mutex_, 0);
+  return assignability_cache_misses_;
 }
 
 void TypeLookupService::cache_type_info(const DDS::BuiltinTopicKey_t& key,
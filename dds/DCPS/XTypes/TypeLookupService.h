@@ -77,6 +77,39 @@ public:
   void clear_type_info(const DDS::BuiltinTopicKey_t& key);
   const TypeInformation& get_type_info(const DDS::BuiltinTopicKey_t& key) const;
 
+  /// For caching the results of TypeAssignability for endpoint matching.
+  /// Adding types clears the cache since a result may depend on types that
+  /// weren't known when it was computed.
+  ///@{
+  struct AssignabilityKey {
+    AssignabilityKey(const TypeInformation& reader, const TypeInformation& writer,
+                     unsigned char consistency_flags)
+      : reader_minimal(reader.minimal.typeid_with_size.type_id)
+      , reader_complete(reader.complete.typeid_with_size.type_id)
+      , writer_minimal(writer.minimal.typeid_with_size.type_id)
+      , writer_complete(writer.complete.typeid_with_size.type_id)
+      , consistency(consistency_flags)
+    {}
+
+    bool operator<(const AssignabilityKey& other) const;
+
+    TypeIdentifier reader_minimal;
+    TypeIdentifier reader_complete;
+    TypeIdentifier writer_minimal;
+    TypeIdentifier writer_complete;
+    /// Flags from the reader's TypeConsistencyEnforcementQosPolicy
+    unsigned char consistency;
+  };
+
+  /// Return true and set assignable if there is a cached result for key.
+  /// Otherwise set generation for passing to cache_assignable.
+  bool get_assignable(const AssignabilityKey& key, bool& assignable, size_t& generation) const;
+  /// Cache a result computed when the types were at generation.
+  void cache_assignable(const AssignabilityKey& key, bool assignable, size_t generation);
+  size_t assignability_cache_hits() const;
+  size_t assignability_cache_misses() const;
+  ///@}
+
 private:
   const TypeObject& get_type_object_i(const TypeIdentifier& type_id) const;
   void get_type_dependencies_i(const TypeIdentifierSeq& type_ids,
@@ -124,6 +157,16 @@ private:
                           DCPS::BuiltinTopicKey_tKeyLessThan) TypeInformationMap;
   TypeInformationMap type_info_map_;
   TypeInformation type_info_empty_;
+
+  /// Call with mutex_ held when the known types change.
+  void types_changed();
+
+  typedef OPENDDS_MAP(AssignabilityKey, bool) AssignabilityMap;
+  AssignabilityMap assignability_cache_;
+  /// Incremented by types_changed
+  size_t types_generation_;
+  mutable size_t assignability_cache_hits_;
+  mutable size_t assignability_cache_misses_;
 };
 
 typedef DCPS::RcHandle<TypeLookupService> TypeLookupService_rch;
@@ -51,6 +51,7 @@ namespace Security {
 CryptoBuiltInImpl::CryptoBuiltInImpl()
   : mutex_()
   , next_handle_(1)
+  , reuse_cipher_contexts_(true)
 {
   openssl_init();
 }
@@ -1079,9 +1080,20 @@ namespace {
 
   struct CipherContext {
     EVP_CIPHER_CTX* ctx_;
-    CipherContext() : ctx_(EVP_CIPHER_CTX_new()) {}
-    operator EVP_CIPHER_CTX*() { return ctx_; }
+    CipherContext() : ctx_(0) {}
     ~CipherContext() { EVP_CIPHER_CTX_free(ctx_); }
+
+    EVP_CIPHER_CTX* init(bool encrypt, const unsigned char* key, const unsigned char* iv)
+    {
+      ctx_ = EVP_CIPHER_CTX_new();
+      if (!ctx_) {
+        return 0;
+      }
+      const int result = encrypt ?
+        EVP_EncryptInit_ex(ctx_, EVP_aes_256_gcm(), 0, key, iv) :
+        EVP_DecryptInit_ex(ctx_, EVP_aes_256_gcm(), 0, key, iv);
+      return result == 1 ? ctx_ : 0;
+    }
   };
 
   bool inc32(unsigned char* a)
@@ -1138,13 +1150,14 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   const KeyId_t sKey = std::make_pair(sending_datawriter_crypto, key_idx);
 
   if (encrypts(keyseq[key_idx])) {
-    ok = encrypt(keyseq[key_idx], sessions_[sKey], plain_buffer,
-                 header, footer, out, ex);
+    out.length(plain_buffer.length());
+    ok = encrypt(keyseq[key_idx], sessions_[sKey], plain_buffer.get_buffer(),
+                 plain_buffer.length(), header, footer, out.get_buffer(), ex);
     pOut = &out;
 
   } else if (authenticates(keyseq[key_idx])) {
-    ok = authtag(keyseq[key_idx], sessions_[sKey], plain_buffer,
-                 header, footer, ex);
+    ok = authtag(keyseq[key_idx], sessions_[sKey], plain_buffer.get_buffer(),
+                 plain_buffer.length(), header, footer, ex);
 
   } else {
     return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
@@ -1177,6 +1190,41 @@ bool CryptoBuiltInImpl::encode_serialized_payload(
   return ser.good_bit();
 }
 
+void CryptoBuiltInImpl::reuse_cipher_contexts(bool reuse)
+{
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  reuse_cipher_contexts_ = reuse;
+}
+
+CryptoBuiltInImpl::CachedCipher::~CachedCipher()
+{
+  EVP_CIPHER_CTX_free(ctx_);
+}
+
+EVP_CIPHER_CTX* CryptoBuiltInImpl::CachedCipher::init(bool encrypt,
+                                                      const unsigned char* key,
+                                                      const unsigned char* iv)
+{
+  if (!ctx_) {
+    ctx_ = EVP_CIPHER_CTX_new();
+    if (!ctx_) {
+      return 0;
+    }
+  }
+
+  // Without a cipher and key, Init keeps the key schedule and only sets the IV,
+  // which restarts GCM for a new message.
+  const bool rekey = !keyed_ || encrypt != encrypt_;
+  const EVP_CIPHER* const cipher = rekey ? EVP_aes_256_gcm() : 0;
+  const unsigned char* const new_key = rekey ? key : 0;
+  const int result = encrypt ?
+    EVP_EncryptInit_ex(ctx_, cipher, 0, new_key, iv) :
+    EVP_DecryptInit_ex(ctx_, cipher, 0, new_key, iv);
+  keyed_ = result == 1;
+  encrypt_ = encrypt;
+  return keyed_ ? ctx_ : 0;
+}
+
 bool CryptoBuiltInImpl::Session::create_key(const KeyMaterial& master, SecurityException& ex)
 {
   RAND_bytes(id_, sizeof id_);
@@ -1204,12 +1252,12 @@ void CryptoBuiltInImpl::Session::inc_iv()
 }
 
 bool CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master, Session& sess,
-                                      const DDS::OctetSeq& plain,
+                                      unsigned int plain_len,
                                       CryptoHeader& header,
                                       SecurityException& ex)
 {
   const unsigned int blocks =
-    (plain.length() + BLOCK_LEN_BYTES - 1) / BLOCK_LEN_BYTES;
+    (plain_len + BLOCK_LEN_BYTES - 1) / BLOCK_LEN_BYTES;
 
   if (!sess.key_.length()) {
     if (!sess.create_key(master, ex)) {
@@ -1236,9 +1284,9 @@ bool CryptoBuiltInImpl::encauth_setup(const KeyMaterial& master, Session& sess,
 }
 
 bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
-                                const DDS::OctetSeq& plain,
+                                const unsigned char* plain, unsigned int n,
                                 CryptoHeader& header, CryptoFooter& footer,
-                                DDS::OctetSeq& out, SecurityException& ex)
+                                unsigned char* out, SecurityException& ex)
 {
   if (security_debug.showkeys) {
     ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) {showkeys} CryptoBuiltInImpl::encrypt: ")
@@ -1246,7 +1294,7 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  if (!encauth_setup(master, sess, plain, header, ex)) {
+  if (!encauth_setup(master, sess, n, header, ex)) {
     return false;
   }
   static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
@@ -1255,46 +1303,47 @@ bool CryptoBuiltInImpl::encrypt(const KeyMaterial& master, Session& sess,
   std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
 
   if (security_debug.fake_encryption) {
-    out = plain;
+    std::memcpy(out, plain, n);
     return true;
   }
 
-  CipherContext ctx;
+  CipherContext uncached;
   const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  EVP_CIPHER_CTX* const ctx = reuse_cipher_contexts_ ?
+    sess.cipher_.init(true, key, iv) : uncached.init(true, key, iv);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
+  // GCM is a stream mode, so the ciphertext is the same size as the plaintext
   int len;
-  out.length(plain.length() + BLOCK_LEN_BYTES - 1);
-  unsigned char* const out_buffer = out.get_buffer();
-  if (EVP_EncryptUpdate(ctx, out_buffer, &len,
-                        plain.get_buffer(), static_cast<int>(plain.length())) != 1) {
+  if (EVP_EncryptUpdate(ctx, out, &len, plain, static_cast<int>(n)) != 1) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_EncryptUpdate", ERR_peek_last_error());
   }
 
   int padLen;
-  if (EVP_EncryptFinal_ex(ctx, out_buffer + len, &padLen) != 1) {
+  if (EVP_EncryptFinal_ex(ctx, out + len, &padLen) != 1) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_EncryptFinal_ex", ERR_peek_last_error());
   }
 
-  out.length(static_cast<DDS::UInt32>(len + padLen));
+  if (static_cast<unsigned int>(len + padLen) != n) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - unexpected ciphertext length");
+  }
 
   if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, sizeof footer.common_mac,
                           &footer.common_mac) == 1) {
     return true;
   }
-  out.length(0);
   return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::encrypt - EVP_CIPHER_CTX_ctrl", ERR_peek_last_error());
 }
 
 bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
-                                const DDS::OctetSeq& plain,
+                                const unsigned char* plain, unsigned int n,
                                 CryptoHeader& header,
                                 CryptoFooter& footer,
                                 SecurityException& ex)
 {
-  if (!encauth_setup(master, sess, plain, header, ex)) {
+  if (!encauth_setup(master, sess, n, header, ex)) {
     return false;
   }
   static const int IV_LEN = 12, IV_SUFFIX_IDX = 4;
@@ -1302,18 +1351,20 @@ bool CryptoBuiltInImpl::authtag(const KeyMaterial& master, Session& sess,
   std::memcpy(iv, &sess.id_, sizeof sess.id_);
   std::memcpy(iv + IV_SUFFIX_IDX, &sess.iv_suffix_, sizeof sess.iv_suffix_);
 
-  CipherContext ctx;
+  CipherContext uncached;
   const unsigned char* const key = sess.key_.get_buffer();
-  if (EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), 0, key, iv) != 1) {
+  EVP_CIPHER_CTX* const ctx = reuse_cipher_contexts_ ?
+    sess.cipher_.init(true, key, iv) : uncached.init(true, key, iv);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_EncryptInit_ex", ERR_peek_last_error());
   }
 
-  int n;
-  if (EVP_EncryptUpdate(ctx, 0, &n, plain.get_buffer(), static_cast<int>(plain.length())) != 1) {
+  int len;
+  if (EVP_EncryptUpdate(ctx, 0, &len, plain, static_cast<int>(n)) != 1) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_EncryptUpdate", ERR_peek_last_error());
   }
 
-  if (EVP_EncryptFinal_ex(ctx, 0, &n) != 1) {
+  if (EVP_EncryptFinal_ex(ctx, 0, &len) != 1) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::authtag - EVP_EncryptFinal_ex", ERR_peek_last_error());
   }
 
@@ -1358,41 +1409,87 @@ namespace {
 
   const int SEQLEN_SZ = 4;
 
-  // Precondition: the bytes of 'original' starting at 'offset' to the end of 'original' are a valid Submessage
-  // If that Submessage has octetsToNextHeader == 0, returns true and makes 'modified' a copy of 'original'
-  // with the Submessage's octetsToNextHeader set to the actual byte count from the end of its SubmessageHeader
-  // to the end of 'original', rounded up to the alignment requirements (4 bytes). Otherwise returns false.
-  bool setOctetsToNextHeader(DDS::OctetSeq& modified, const DDS::OctetSeq& original, unsigned int offset = 0)
+  // Precondition: the 'length' bytes at 'submessage' are a valid Submessage
+  // If that Submessage has octetsToNextHeader == 0, returns true and sets its octetsToNextHeader
+  // to the actual byte count from the end of its SubmessageHeader to the end of 'submessage',
+  // rounded up to the alignment requirements (4 bytes). Otherwise returns false.
+  bool setOctetsToNextHeader(unsigned char* submessage, size_t length)
   {
-    if (offset + RTPS::SMHDR_SZ >= original.length()) {
+    if (length <= RTPS::SMHDR_SZ || submessage[2] || submessage[3]) {
       return false;
     }
 
-    const size_t origLength = original.length() - offset;
-    ACE_Message_Block mb_in(to_mb(original.get_buffer() + offset), origLength);
-    mb_in.wr_ptr(origLength);
-
-    Serializer ser_in(&mb_in, common_encoding);
-    ser_in.skip(1); // submessageId
-
-    unsigned char flags;
-    ser_in >> ACE_InputCDR::to_octet(flags);
-    const unsigned int flag_e = flags & RTPS::FLAG_E;
-    ser_in.swap_bytes(ACE_CDR_BYTE_ORDER != flag_e);
-
-    ACE_UINT16 submessageLength;
-    ser_in >> submessageLength;
-    if (submessageLength == 0) {
-      modified = original;
-      const size_t len = roundUp(static_cast<unsigned int>(origLength - RTPS::SMHDR_SZ), RTPS::SM_ALIGN);
-      modified[offset + 2 + !flag_e] = len & 0xff;
-      modified[offset + 2 + flag_e] = (len >> 8) & 0xff;
-      return true;
+    const unsigned int flag_e = submessage[1] & RTPS::FLAG_E;
+    const size_t len = roundUp(static_cast<unsigned int>(length - RTPS::SMHDR_SZ), RTPS::SM_ALIGN);
+    submessage[2 + !flag_e] = len & 0xff;
+    submessage[2 + flag_e] = (len >> 8) & 0xff;
+    return true;
+  }
+
+  size_t cryptoHeaderSize()
+  {
+    size_t size = 0;
+    serialized_size(common_encoding, size, CryptoHeader());
+    return size;
+  }
+
+  // Size of the protected form of a 'plain_len' byte Submessage, sets 'body_offset' to where
+  // the ciphertext or plaintext starts in it
+  size_t protectedSubmessageSize(unsigned int plain_len, bool encrypt, size_t& body_offset)
+  {
+    size_t size = RTPS::SMHDR_SZ; // prefix submessage header
+    serialized_size(common_encoding, size, CryptoHeader());
+
+    if (encrypt) {
+      size += RTPS::SMHDR_SZ + SEQLEN_SZ;
     }
-    return false;
+
+    body_offset = size;
+    size += plain_len; // submessage inside wrapper
+    align(size, RTPS::SM_ALIGN);
+
+    size += RTPS::SMHDR_SZ; // postfix submessage header
+    serialized_size(common_encoding, size, CryptoFooter());
+    return size;
+  }
+
+  // Size of the protected form of an RTPS Message given the length of the 'transformed' message
+  // (INFO_SRC in place of the RTPS Header), sets 'body_offset' as above
+  size_t protectedMessageSize(unsigned int transformed_len, bool encrypt, size_t& body_offset)
+  {
+    size_t size = RTPS::RTPSHDR_SZ + RTPS::SMHDR_SZ; // RTPS Header, SRTPS Prefix
+    serialized_size(common_encoding, size, CryptoHeader());
+
+    if (encrypt) {
+      size += RTPS::SMHDR_SZ + SEQLEN_SZ;
+    }
+
+    body_offset = size;
+    size += transformed_len;
+    align(size, RTPS::SM_ALIGN);
+
+    size += RTPS::SMHDR_SZ; // SRTPS Postfix
+    serialized_size(common_encoding, size, CryptoFooter());
+    return size;
   }
 }
 
+NativeCryptoHandle CryptoBuiltInImpl::submessage_encode_handle(
+  NativeCryptoHandle sender,
+  NativeCryptoHandle single_receiver) const
+{
+  if (single_receiver != DDS::HANDLE_NIL) {
+    const KeyTable_t::const_iterator iter = keys_.find(sender);
+    if (iter != keys_.end()) {
+      const KeySeq& keys = iter->second;
+      if (keys.length() == 1 && is_volatile_placeholder(keys[0])) {
+        return single_receiver;
+      }
+    }
+  }
+  return sender;
+}
+
 bool CryptoBuiltInImpl::encode_submessage(
   DDS::OctetSeq& encoded_rtps_submessage,
   const DDS::OctetSeq& plain_rtps_submessage,
@@ -1411,73 +1508,70 @@ bool CryptoBuiltInImpl::encode_submessage(
     return true;
   }
 
+  const KeyMaterial& key = keyseq[submessage_key_index];
+  const bool encrypting = encrypts(key);
+  if (!encrypting && !authenticates(key)) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+  }
+
+  size_t body_offset;
+  encoded_rtps_submessage.length(static_cast<unsigned int>(
+    protectedSubmessageSize(plain_rtps_submessage.length(), encrypting, body_offset)));
+  const KeyId_t sKey = std::make_pair(sender_handle, submessage_key_index);
+  return write_protected_submessage(encoded_rtps_submessage.get_buffer(),
+                                    plain_rtps_submessage.get_buffer(),
+                                    plain_rtps_submessage.length(),
+                                    key, sessions_[sKey], ex);
+}
+
+bool CryptoBuiltInImpl::write_protected_submessage(
+  unsigned char* out,
+  const unsigned char* plain, unsigned int plain_len,
+  const KeyMaterial& master, Session& sess,
+  SecurityException& ex)
+{
+  const bool authOnly = !encrypts(master);
+  size_t body_offset;
+  const size_t size = protectedSubmessageSize(plain_len, !authOnly, body_offset);
+  unsigned char* const body = out + body_offset;
+
   bool ok;
   CryptoHeader header;
   CryptoFooter footer;
-  DDS::OctetSeq out;
-  const DDS::OctetSeq* pOut = &plain_rtps_submessage;
-  const KeyId_t sKey = std::make_pair(sender_handle, submessage_key_index);
-  bool authOnly = false;
-
-  if (encrypts(keyseq[submessage_key_index])) {
-    ok = encrypt(keyseq[submessage_key_index], sessions_[sKey], plain_rtps_submessage,
-                 header, footer, out, ex);
-    pOut = &out;
 
-  } else if (authenticates(keyseq[submessage_key_index])) {
+  if (authOnly) {
     // the original submessage may have octetsToNextHeader = 0 which isn't
     // legal when appending SEC_POSTFIX, patch in the actual submsg length
-    if (setOctetsToNextHeader(out, plain_rtps_submessage)) {
-      pOut = &out;
-    }
-    ok = authtag(keyseq[submessage_key_index], sessions_[sKey], *pOut,
-                 header, footer, ex);
-    authOnly = true;
+    std::memcpy(body, plain, plain_len);
+    setOctetsToNextHeader(body, plain_len);
+    ok = authtag(master, sess, body, plain_len, header, footer, ex);
 
   } else {
-    return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+    ok = encrypt(master, sess, plain, plain_len, header, footer, body, ex);
   }
 
   if (!ok) {
     return false; // either encrypt() or authtag() already set 'ex'
   }
 
-  size_t size = 0;
-
-  size += RTPS::SMHDR_SZ; // prefix submessage header
-  serialized_size(common_encoding, size, header);
-  const ACE_UINT16 hdrLen = static_cast<ACE_UINT16>(size - RTPS::SMHDR_SZ);
-
-  if (!authOnly) {
-    size += RTPS::SMHDR_SZ + SEQLEN_SZ;
-  }
-
-  size += pOut->length(); // submessage inside wrapper
-  align(size, RTPS::SM_ALIGN);
-
-  size += RTPS::SMHDR_SZ; // postfix submessage header
-  const size_t preFooter = size;
-  serialized_size(common_encoding, size, footer);
-
-  encoded_rtps_submessage.length(static_cast<unsigned int>(size));
-  ACE_Message_Block mb(to_mb(encoded_rtps_submessage.get_buffer()), size);
+  ACE_Message_Block mb(to_mb(out), size);
   Serializer ser(&mb, common_encoding);
-  RTPS::SubmessageHeader smHdr = {RTPS::SEC_PREFIX, 0, hdrLen};
+  RTPS::SubmessageHeader smHdr = {RTPS::SEC_PREFIX, 0, static_cast<ACE_UINT16>(cryptoHeaderSize())};
   ser << smHdr;
   ser << header;
 
   if (!authOnly) {
     smHdr.submessageId = RTPS::SEC_BODY;
-    smHdr.submessageLength = static_cast<ACE_UINT16>(roundUp(SEQLEN_SZ + pOut->length(), RTPS::SM_ALIGN));
+    smHdr.submessageLength = static_cast<ACE_UINT16>(roundUp(SEQLEN_SZ + plain_len, RTPS::SM_ALIGN));
     ser << smHdr;
-    ser << pOut->length();
+    ser << plain_len;
   }
 
-  ser.write_octet_array(pOut->get_buffer(), pOut->length());
+  mb.wr_ptr(plain_len); // body was written in place
   ser.align_w(RTPS::SM_ALIGN);
 
   smHdr.submessageId = RTPS::SEC_POSTFIX;
-  smHdr.submessageLength = static_cast<ACE_UINT16>(size - preFooter);
+  smHdr.submessageLength = static_cast<ACE_UINT16>(mb.space() - RTPS::SMHDR_SZ);
   ser << smHdr;
   ser << footer;
 
@@ -1513,9 +1607,8 @@ bool CryptoBuiltInImpl::encode_datawriter_submessage(
     }
   }
 
-  NativeCryptoHandle encode_handle = sending_datawriter_crypto;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(encode_handle);
+  const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(sending_datawriter_crypto);
   if (eo_iter == encrypt_options_.end()) {
     return CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
   }
@@ -1526,15 +1619,8 @@ bool CryptoBuiltInImpl::encode_datawriter_submessage(
     return true;
   }
 
-  if (receiving_datareader_crypto_list.length() == 1) {
-    const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
-    if (iter != keys_.end()) {
-      const KeySeq& dw_keys = iter->second;
-      if (dw_keys.length() == 1 && is_volatile_placeholder(dw_keys[0])) {
-        encode_handle = receiving_datareader_crypto_list[0];
-      }
-    }
-  }
+  const NativeCryptoHandle encode_handle = submessage_encode_handle(sending_datawriter_crypto,
+    len == 1 ? receiving_datareader_crypto_list[0] : DDS::HANDLE_NIL);
 
   const bool ok = encode_submessage(encoded_rtps_submessage,
                                     plain_rtps_submessage, encode_handle, ex);
@@ -1561,17 +1647,9 @@ bool CryptoBuiltInImpl::encode_datareader_submessage(
     }
   }
 
-  NativeCryptoHandle encode_handle = sending_datareader_crypto;
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  if (receiving_datawriter_crypto_list.length() == 1) {
-    const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
-    if (iter != keys_.end()) {
-      const KeySeq& dr_keys = iter->second;
-      if (dr_keys.length() == 1 && is_volatile_placeholder(dr_keys[0])) {
-        encode_handle = receiving_datawriter_crypto_list[0];
-      }
-    }
-  }
+  const NativeCryptoHandle encode_handle = submessage_encode_handle(sending_datareader_crypto,
+    receiving_datawriter_crypto_list.length() == 1 ? receiving_datawriter_crypto_list[0] : DDS::HANDLE_NIL);
 
   return encode_submessage(encoded_rtps_submessage, plain_rtps_submessage,
                            encode_handle, ex);
@@ -1604,6 +1682,12 @@ bool CryptoBuiltInImpl::encode_rtps_message(
     return CommonUtilities::set_security_error(ex, -1, 0, "No key for sending_participant_crypto");
   }
 
+  const KeyMaterial& key = keyseq[0];
+  const bool encrypting = encrypts(key);
+  if (!encrypting && !authenticates(key)) {
+    return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+  }
+
   // The input with its RTPS Header changed to an InfoSrc submessage acts as plaintext for encrypt/authenticate
   DDS::OctetSeq transformed(plain_rtps_message.length() + RTPS::SMHDR_SZ);
   transformed.length(transformed.maximum());
@@ -1613,69 +1697,66 @@ bool CryptoBuiltInImpl::encode_rtps_message(
   transformed[3] = RTPS::INFO_SRC_SZ;
   std::memcpy(transformed.get_buffer() + RTPS::SMHDR_SZ, plain_rtps_message.get_buffer(), plain_rtps_message.length());
 
-  bool ok, addSecBody = false;
+  size_t body_offset;
+  encoded_rtps_message.length(static_cast<unsigned int>(
+    protectedMessageSize(transformed.length(), encrypting, body_offset)));
+  const KeyId_t sKey = std::make_pair(sending_participant_crypto, 0);
+  return write_protected_message(encoded_rtps_message.get_buffer(), plain_rtps_message.get_buffer(),
+                                 transformed.get_buffer(), transformed.length(),
+                                 key, sessions_[sKey], ex);
+}
+
+bool CryptoBuiltInImpl::write_protected_message(
+  unsigned char* out, const unsigned char* rtps_header,
+  const unsigned char* transformed, unsigned int len,
+  const KeyMaterial& master, Session& sess,
+  SecurityException& ex)
+{
+  const bool addSecBody = encrypts(master);
+  size_t body_offset;
+  const size_t size = protectedMessageSize(len, addSecBody, body_offset);
+  unsigned char* const body = out + body_offset;
+
+  bool ok;
   CryptoHeader cryptoHdr;
   CryptoFooter cryptoFooter;
-  DDS::OctetSeq out;
-  const DDS::OctetSeq* pOut = &transformed;
-  const KeyMaterial& key = keyseq[0];
-  const KeyId_t sKey = std::make_pair(sending_participant_crypto, 0);
 
-  if (encrypts(key)) {
-    ok = encrypt(key, sessions_[sKey], transformed, cryptoHdr, cryptoFooter, out, ex);
-    pOut = &out;
-    addSecBody = true;
+  if (addSecBody) {
+    ok = encrypt(master, sess, transformed, len, cryptoHdr, cryptoFooter, body, ex);
 
-  } else if (authenticates(key)) {
+  } else {
     // the original message's last submsg may have octetsToNextHeader = 0 which
     // isn't valid when appending SEC_POSTFIX, patch in the actual submsg length
-    const unsigned int offsetFinal = findLastSubmessage(transformed);
-    if (offsetFinal && setOctetsToNextHeader(out, transformed, offsetFinal)) {
-      pOut = &out;
+    std::memcpy(body, transformed, len);
+    const DDS::OctetSeq body_seq(len, len, body, false);
+    const unsigned int offsetFinal = findLastSubmessage(body_seq);
+    if (offsetFinal) {
+      setOctetsToNextHeader(body + offsetFinal, len - offsetFinal);
     }
-    ok = authtag(key, sessions_[sKey], *pOut, cryptoHdr, cryptoFooter, ex);
-
-  } else {
-    return CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+    ok = authtag(master, sess, body, len, cryptoHdr, cryptoFooter, ex);
   }
 
   if (!ok) {
     return false; // either encrypt() or authtag() already set 'ex'
   }
 
-  size_t size = RTPS::RTPSHDR_SZ + RTPS::SMHDR_SZ; // RTPS Header, SRTPS Prefix
-  serialized_size(common_encoding, size, cryptoHdr);
-  const ACE_UINT16 cryptoHdrLen =
-    static_cast<ACE_UINT16>(size - RTPS::RTPSHDR_SZ - RTPS::SMHDR_SZ);
-
-  if (addSecBody) {
-    size += RTPS::SMHDR_SZ + SEQLEN_SZ;
-  }
-
-  size += pOut->length();
-  align(size, RTPS::SM_ALIGN);
-
-  size += RTPS::SMHDR_SZ; // SRTPS Postfix
-  serialized_size(common_encoding, size, cryptoFooter);
-
-  encoded_rtps_message.length(static_cast<unsigned int>(size));
-  ACE_Message_Block mb(to_mb(encoded_rtps_message.get_buffer()), size);
+  ACE_Message_Block mb(to_mb(out), size);
   Serializer ser(&mb, common_encoding);
 
-  ser.write_octet_array(plain_rtps_message.get_buffer(), RTPS::RTPSHDR_SZ);
+  ser.write_octet_array(rtps_header, RTPS::RTPSHDR_SZ);
 
-  RTPS::SubmessageHeader smHdr = {RTPS::SRTPS_PREFIX, 0, cryptoHdrLen};
+  RTPS::SubmessageHeader smHdr = {RTPS::SRTPS_PREFIX, 0, static_cast<ACE_UINT16>(cryptoHeaderSize())};
   ser << smHdr;
   ser << cryptoHdr;
 
   if (addSecBody) {
     smHdr.submessageId = RTPS::SEC_BODY;
-    smHdr.submessageLength = static_cast<ACE_UINT16>(roundUp(SEQLEN_SZ + pOut->length(), RTPS::SM_ALIGN));
+    smHdr.submessageLength = static_cast<ACE_UINT16>(roundUp(SEQLEN_SZ + len, RTPS::SM_ALIGN));
     ser << smHdr;
-    ser << pOut->length();
+    ser << len;
   }
 
-  ser.write_octet_array(pOut->get_buffer(), pOut->length());
+  mb.wr_ptr(len); // body was written in place
   ser.align_w(RTPS::SM_ALIGN);
 
   smHdr.submessageId = RTPS::SRTPS_POSTFIX;
@@ -1686,6 +1767,136 @@ bool CryptoBuiltInImpl::encode_rtps_message(
   return ser.good_bit();
 }
 
+ACE_Message_Block* CryptoBuiltInImpl::encode_batch(
+  const char* plain, size_t plain_length,
+  const SubmessageSeq& submessages,
+  ParticipantCryptoHandle sending_participant,
+  SecurityException& ex)
+{
+  if (plain_length < RTPS::RTPSHDR_SZ) {
+    CommonUtilities::set_security_error(ex, -1, 0, "Invalid RTPS message");
+    return 0;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+
+  // Find the keys first so the output can be sized before anything is encoded
+  size_t size = plain_length;
+  size_t end = RTPS::RTPSHDR_SZ;
+  batch_keys_.clear();
+  for (SubmessageSeq::const_iterator it = submessages.begin(); it != submessages.end(); ++it) {
+    if (it->offset_ < end || it->length_ < RTPS::SMHDR_SZ || it->offset_ + it->length_ > plain_length) {
+      CommonUtilities::set_security_error(ex, -1, 0, "Invalid submessage in batch");
+      return 0;
+    }
+    end = it->offset_ + it->length_;
+
+    const BatchKey copy = {0, KeyId_t()};
+    if (it->from_writer_) {
+      const EncryptOptions_t::const_iterator eo_iter = encrypt_options_.find(it->sender_);
+      if (eo_iter == encrypt_options_.end()) {
+        CommonUtilities::set_security_error(ex, -1, 0, "Datawriter handle lacks encrypt options");
+        return 0;
+      }
+      if (!eo_iter->second.submessage_) {
+        batch_keys_.push_back(copy);
+        continue;
+      }
+    }
+
+    const NativeCryptoHandle encode_handle = submessage_encode_handle(it->sender_, it->receiver_);
+    const KeyTable_t::const_iterator iter = keys_.find(encode_handle);
+    if (iter == keys_.end() || !iter->second.length()) {
+      batch_keys_.push_back(copy);
+      continue;
+    }
+
+    const KeyMaterial& key = iter->second[submessage_key_index];
+    if (!encrypts(key) && !authenticates(key)) {
+      CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+      return 0;
+    }
+    const BatchKey protect = {&key, std::make_pair(encode_handle, submessage_key_index)};
+    batch_keys_.push_back(protect);
+
+    size_t body_offset;
+    size += protectedSubmessageSize(static_cast<unsigned int>(it->length_), encrypts(key), body_offset);
+    size -= it->length_;
+  }
+
+  // The submessages are protected into a message that starts with an INFO_SRC
+  // header so it can be the plaintext of the RTPS message protection below.
+  Message_Block_Ptr submsgs(new ACE_Message_Block(RTPS::SMHDR_SZ + size));
+  unsigned char* const transformed = reinterpret_cast<unsigned char*>(submsgs->wr_ptr());
+  transformed[0] = RTPS::INFO_SRC;
+  transformed[1] = 0; // flags: big-endian
+  transformed[2] = 0; // high byte of octetsToNextHeader
+  transformed[3] = RTPS::INFO_SRC_SZ;
+
+  const unsigned char* const in = reinterpret_cast<const unsigned char*>(plain);
+  unsigned char* out = transformed + RTPS::SMHDR_SZ;
+  size_t pos = 0;
+  for (size_t i = 0; i < submessages.size(); ++i) {
+    const Submessage& sm = submessages[i];
+    std::memcpy(out, in + pos, sm.offset_ - pos);
+    out += sm.offset_ - pos;
+    pos = sm.offset_ + sm.length_;
+
+    const BatchKey& bk = batch_keys_[i];
+    const unsigned int sm_len = static_cast<unsigned int>(sm.length_);
+    if (!bk.key_) {
+      std::memcpy(out, in + sm.offset_, sm_len);
+      out += sm_len;
+      continue;
+    }
+
+    if (!write_protected_submessage(out, in + sm.offset_, sm_len, *bk.key_, sessions_[bk.session_], ex)) {
+      return 0;
+    }
+    size_t body_offset;
+    out += protectedSubmessageSize(sm_len, encrypts(*bk.key_), body_offset);
+  }
+  std::memcpy(out, in + pos, plain_length - pos);
+  submsgs->wr_ptr(RTPS::SMHDR_SZ + size);
+
+  if (sending_participant == DDS::HANDLE_NIL) {
+    submsgs->rd_ptr(RTPS::SMHDR_SZ);
+    return submsgs.release();
+  }
+
+  const KeyTable_t::const_iterator iter = keys_.find(sending_participant);
+  if (iter == keys_.end()) {
+    CommonUtilities::set_security_error(ex, -1, 0, "No entry for sending_participant_crypto");
+    return 0;
+  }
+
+  const KeySeq& keyseq = iter->second;
+  if (!keyseq.length()) {
+    CommonUtilities::set_security_error(ex, -1, 0, "No key for sending_participant_crypto");
+    return 0;
+  }
+
+  const KeyMaterial& key = keyseq[0];
+  const bool encrypting = encrypts(key);
+  if (!encrypting && !authenticates(key)) {
+    CommonUtilities::set_security_error(ex, -1, 0, "Key transform kind unrecognized");
+    return 0;
+  }
+
+  size_t body_offset;
+  const unsigned int transformed_len = static_cast<unsigned int>(RTPS::SMHDR_SZ + size);
+  const size_t message_size = protectedMessageSize(transformed_len, encrypting, body_offset);
+  Message_Block_Ptr message(new ACE_Message_Block(message_size));
+  const KeyId_t sKey = std::make_pair(sending_participant, 0);
+  if (!write_protected_message(reinterpret_cast<unsigned char*>(message->wr_ptr()),
+                               transformed + RTPS::SMHDR_SZ, transformed, transformed_len,
+                               key, sessions_[sKey], ex)) {
+    return 0;
+  }
+  message->wr_ptr(message_size);
+  return message.release();
+}
+
 namespace {
   bool matches(const KeyMaterial_AES_GCM_GMAC& k, const CryptoHeader& h)
   {
@@ -1784,7 +1995,7 @@ bool CryptoBuiltInImpl::preprocess_secure_submsg(
   return false;
 }
 
-KeyOctetSeq
+const KeyOctetSeq&
 CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
                                     const CryptoHeader& header,
                                     SecurityException& ex)
@@ -1800,6 +2011,7 @@ CryptoBuiltInImpl::Session::get_key(const KeyMaterial& master,
 
 bool CryptoBuiltInImpl::Session::derive_key(const KeyMaterial& master, SecurityException& ex)
 {
+  cipher_.reset();
   PrivateKey pkey(master.master_sender_key);
   DigestContext ctx;
   const EVP_MD* md = EVP_get_digestbyname("SHA256");
@@ -1851,7 +2063,7 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
       to_dds_string(master).c_str()));
   }
 
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  const KeyOctetSeq& sess_key = sess.get_key(master, header, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1870,10 +2082,12 @@ bool CryptoBuiltInImpl::decrypt(const KeyMaterial& master, Session& sess,
     return true;
   }
 
-  CipherContext ctx;
+  CipherContext uncached;
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = reuse_cipher_contexts_ ?
+    sess.cipher_.init(false, sess_key.get_buffer(), header.session_id) :
+    uncached.init(false, sess_key.get_buffer(), header.session_id);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::decrypt - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
@@ -1906,7 +2120,7 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
                                SecurityException& ex)
 
 {
-  const KeyOctetSeq sess_key = sess.get_key(master, header, ex);
+  const KeyOctetSeq& sess_key = sess.get_key(master, header, ex);
   if (!sess_key.length()) {
     return false;
   }
@@ -1919,10 +2133,12 @@ bool CryptoBuiltInImpl::verify(const KeyMaterial& master, Session& sess,
     return CommonUtilities::set_security_error(ex, -1, 0, "unsupported transformation kind");
   }
 
-  CipherContext ctx;
+  CipherContext uncached;
   // session_id is start of IV contiguous bytes
-  if (EVP_DecryptInit_ex(ctx, EVP_aes_256_gcm(), 0, sess_key.get_buffer(),
-                         header.session_id) != 1) {
+  EVP_CIPHER_CTX* const ctx = reuse_cipher_contexts_ ?
+    sess.cipher_.init(false, sess_key.get_buffer(), header.session_id) :
+    uncached.init(false, sess_key.get_buffer(), header.session_id);
+  if (!ctx) {
     return CommonUtilities::set_security_error(ex, -1, 0, "CryptoBuiltInImpl::verify - EVP_DecryptInit_ex", ERR_peek_last_error());
   }
 
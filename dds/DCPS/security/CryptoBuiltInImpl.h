@@ -9,6 +9,7 @@
 #include "OpenDDS_Security_Export.h"
 #include "CryptoBuiltInC.h"
 
+#include <dds/DCPS/security/framework/BatchCryptoTransform.h>
 #include <dds/DdsSecurityCoreC.h>
 #include <dds/Versioned_Namespace.h>
 
@@ -17,12 +18,14 @@
 #include <ace/Thread_Mutex.h>
 
 #include <map>
+#include <vector>
 
 #if !defined (ACE_LACKS_PRAGMA_ONCE)
 #pragma once
 #endif /* ACE_LACKS_PRAGMA_ONCE */
 
 class DDS_TEST;
+struct evp_cipher_ctx_st;
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -34,11 +37,16 @@ class OpenDDS_Security_Export CryptoBuiltInImpl
   , public virtual DDS::Security::CryptoKeyExchange
   , public virtual DDS::Security::CryptoTransform
   , public virtual CORBA::LocalObject
+  , public BatchCryptoTransform
 {
 public:
   CryptoBuiltInImpl();
   virtual ~CryptoBuiltInImpl();
 
+  /// Keep an AES-GCM context with the session key already set up for each
+  /// Session, so encrypting or decrypting a message only sets the IV.
+  /// Defaults to true.
+  void reuse_cipher_contexts(bool reuse);
 
 private:
   // Local Object
@@ -239,6 +247,15 @@ private:
     DDS::Security::DatawriterCryptoHandle sending_datawriter_crypto,
     DDS::Security::SecurityException& ex);
 
+
+  // Batch Crypto Transform
+
+  virtual ACE_Message_Block* encode_batch(
+    const char* plain, size_t plain_length,
+    const SubmessageSeq& submessages,
+    DDS::Security::ParticipantCryptoHandle sending_participant,
+    DDS::Security::SecurityException& ex);
+
   CryptoBuiltInImpl(const CryptoBuiltInImpl&);
   CryptoBuiltInImpl& operator=(const CryptoBuiltInImpl&);
 
@@ -247,6 +264,7 @@ private:
 
   ACE_Thread_Mutex mutex_;
   int next_handle_;
+  bool reuse_cipher_contexts_;
 
   typedef KeyMaterial_AES_GCM_GMAC KeyMaterial;
   typedef KeyMaterial_AES_GCM_GMAC_Seq KeySeq;
@@ -281,14 +299,37 @@ private:
   typedef std::map<HandlePair_t, DDS::Security::NativeCryptoHandle> DerivedKeyIndex_t;
   DerivedKeyIndex_t derived_key_handles_;
 
+  /// Cipher context that keeps the key schedule for a Session's key_ between
+  /// messages.  Copies start out empty.
+  class CachedCipher {
+  public:
+    CachedCipher() : ctx_(0), keyed_(false), encrypt_(false) {}
+    CachedCipher(const CachedCipher&) : ctx_(0), keyed_(false), encrypt_(false) {}
+    CachedCipher& operator=(const CachedCipher&) { reset(); return *this; }
+    ~CachedCipher();
+
+    /// Returns the context ready for a new message using key and iv, or 0 on
+    /// failure.  The key is only set up if it's not the one from last time.
+    evp_cipher_ctx_st* init(bool encrypt, const unsigned char* key, const unsigned char* iv);
+
+    /// The key changed or the context is in an unknown state.
+    void reset() { keyed_ = false; }
+
+  private:
+    evp_cipher_ctx_st* ctx_;
+    bool keyed_;
+    bool encrypt_;
+  };
+
   struct Session {
     SessionIdType id_;
     IV_SuffixType iv_suffix_;
     KeyOctetSeq key_;
     ACE_UINT64 counter_;
+    CachedCipher cipher_;
 
-    KeyOctetSeq get_key(const KeyMaterial& master, const CryptoHeader& header,
-                        DDS::Security::SecurityException& ex);
+    const KeyOctetSeq& get_key(const KeyMaterial& master, const CryptoHeader& header,
+                               DDS::Security::SecurityException& ex);
     bool create_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool derive_key(const KeyMaterial& master, DDS::Security::SecurityException& ex);
     bool next_id(const KeyMaterial& master, DDS::Security::SecurityException& ex);
@@ -301,25 +342,55 @@ private:
   void clear_endpoint_data(DDS::Security::NativeCryptoHandle handle);
   void clear_common_data(DDS::Security::NativeCryptoHandle handle);
 
+  /// Handle whose keys protect submessages from sender, which is the
+  /// receiver's handle when sender only has a volatile placeholder key
+  DDS::Security::NativeCryptoHandle submessage_encode_handle(
+    DDS::Security::NativeCryptoHandle sender,
+    DDS::Security::NativeCryptoHandle single_receiver) const;
+
   bool encode_submessage(DDS::OctetSeq& encoded_rtps_submessage,
                          const DDS::OctetSeq& plain_rtps_submessage,
                          DDS::Security::NativeCryptoHandle sender_handle,
                          DDS::Security::SecurityException& ex);
 
+  /// Write the SEC_PREFIX/SEC_BODY/SEC_POSTFIX form of a plain_len byte
+  /// submessage to out, which has room for protected_submessage_size() bytes
+  bool write_protected_submessage(unsigned char* out,
+                                  const unsigned char* plain, unsigned int plain_len,
+                                  const KeyMaterial& master, Session& sess,
+                                  DDS::Security::SecurityException& ex);
+
+  /// Write the SRTPS_PREFIX/SEC_BODY/SRTPS_POSTFIX form of an RTPS message to
+  /// out, which has room for protected_message_size() bytes.  transformed is
+  /// the message with its RTPS header replaced by an INFO_SRC submessage.
+  bool write_protected_message(unsigned char* out, const unsigned char* rtps_header,
+                               const unsigned char* transformed, unsigned int len,
+                               const KeyMaterial& master, Session& sess,
+                               DDS::Security::SecurityException& ex);
+
+  /// Writes exactly n bytes of ciphertext to out
   bool encrypt(const KeyMaterial& master, Session& sess,
-               const DDS::OctetSeq& plain,
+               const unsigned char* plain, unsigned int n,
                CryptoHeader& header, CryptoFooter& footer,
-               DDS::OctetSeq& out, DDS::Security::SecurityException& ex);
+               unsigned char* out, DDS::Security::SecurityException& ex);
 
   bool authtag(const KeyMaterial& master, Session& sess,
-               const DDS::OctetSeq& plain,
+               const unsigned char* plain, unsigned int n,
                CryptoHeader& header, CryptoFooter& footer,
                DDS::Security::SecurityException& ex);
 
   bool encauth_setup(const KeyMaterial& master, Session& sess,
-                     const DDS::OctetSeq& plain, CryptoHeader& header,
+                     unsigned int plain_len, CryptoHeader& header,
                      DDS::Security::SecurityException& ex);
 
+  /// Key and session for each submessage of encode_batch, null key_ for
+  /// submessages that are copied as-is.  Reused between calls.
+  struct BatchKey {
+    const KeyMaterial* key_;
+    KeyId_t session_;
+  };
+  std::vector<BatchKey> batch_keys_;
+
   bool decode_submessage(DDS::OctetSeq& plain_rtps_submessage,
                          const DDS::OctetSeq& encoded_rtps_submessage,
                          DDS::Security::NativeCryptoHandle sender_handle,
@@ -0,0 +1,76 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_SECURITY_FRAMEWORK_BATCHCRYPTOTRANSFORM_H
+#define OPENDDS_DCPS_SECURITY_FRAMEWORK_BATCHCRYPTOTRANSFORM_H
+
+#include <dds/DCPS/PoolAllocator.h>
+#include <dds/DCPS/dcps_export.h>
+
+#include <dds/OpenDDSConfigWrapper.h>
+
+#if OPENDDS_CONFIG_SECURITY
+#  include <dds/DdsSecurityCoreC.h>
+#endif
+
+#ifndef ACE_LACKS_PRAGMA_ONCE
+#  pragma once
+#endif
+
+ACE_BEGIN_VERSIONED_NAMESPACE_DECL
+class ACE_Message_Block;
+ACE_END_VERSIONED_NAMESPACE_DECL
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace Security {
+
+#if OPENDDS_CONFIG_SECURITY
+/**
+ * Optional interface for a CryptoTransform plugin that can protect a whole
+ * RTPS message, submessages first, in one call.  Transports use it instead of
+ * the per-submessage CryptoTransform operations when the plugin object also
+ * implements this.
+ */
+class OpenDDS_Dcps_Export BatchCryptoTransform {
+public:
+  /// A submessage of the plain message sent by a local endpoint
+  struct Submessage {
+    /// Position of the submessage header in the plain message
+    size_t offset_;
+    /// Including the header
+    size_t length_;
+    /// The sender is a DataWriter, otherwise it's a DataReader
+    bool from_writer_;
+    DDS::Security::NativeCryptoHandle sender_;
+    /// Remote endpoint of a submessage with a single destination, or HANDLE_NIL
+    DDS::Security::NativeCryptoHandle receiver_;
+  };
+  typedef OPENDDS_VECTOR(Submessage) SubmessageSeq;
+
+  virtual ~BatchCryptoTransform() {}
+
+  /**
+   * Replace each of the submessages of the plain_length bytes at plain, in
+   * order, as encode_datawriter_submessage or encode_datareader_submessage
+   * would, then protect the result as encode_rtps_message would unless
+   * sending_participant is HANDLE_NIL.  Returns a new message, or 0 with ex
+   * set on failure.
+   */
+  virtual ACE_Message_Block* encode_batch(
+    const char* plain, size_t plain_length,
+    const SubmessageSeq& submessages,
+    DDS::Security::ParticipantCryptoHandle sending_participant,
+    DDS::Security::SecurityException& ex) = 0;
+};
+#endif
+
+} // namespace Security
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif
@@ -98,6 +98,15 @@ public:
   /// @param size number of bytes to use as the payload
   void replace(const char* data, size_t size);
 
+  /// @brief Replace all payload bytes with a single block of size bytes.
+  /// Its contents are undefined until they're written with copy_data_from().
+  void allocate(size_t size);
+
+  /// @brief Copy the first size bytes of src's payload into the block
+  /// created by allocate(), starting at offset
+  /// @returns false if src doesn't have size bytes or they don't fit
+  bool copy_data_from(const ReceivedDataSample& src, size_t offset, size_t size);
+
   ReceivedDataSample get_fragment_range(FragmentNumber start_frag, FragmentNumber end_frag = INVALID_FRAGMENT);
 
 private:
@@ -52,11 +52,15 @@ TransportImpl::TransportImpl(TransportInst_rch config,
                    config->name().c_str(),
                    global_thread_count));
       }
-      event_dispatcher_ = make_rch<ServiceEventDispatcher>(global_thread_count);
+      event_dispatcher_ = make_rch<ServiceEventDispatcher>(global_thread_count,
+                                                           TheServiceParticipant->timer_wheel(),
+                                                           TheServiceParticipant->event_dispatcher_work_stealing());
       owns_event_dispatcher_ = true;
     }
   } else {
-    event_dispatcher_ = make_rch<ServiceEventDispatcher>(event_dispatcher_threads);
+    event_dispatcher_ = make_rch<ServiceEventDispatcher>(event_dispatcher_threads,
+                                                         TheServiceParticipant->timer_wheel(),
+                                                         TheServiceParticipant->event_dispatcher_work_stealing());
     owns_event_dispatcher_ = true;
   }
 
@@ -131,7 +135,11 @@ TransportImpl::create_reactor_task(bool useAsyncSend, const OPENDDS_STRING& name
   reactor_task_ = make_rch<ReactorTask>(useAsyncSend);
   reactor_task_->job_queue(TheServiceParticipant->job_queue());
 
-  if (reactor_task_->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), name)) {
+  // Asynchronous sends need the default reactor (see ReactorTask).
+  const TransportInst_rch cfg = config();
+  ACE_Reactor* const reactor = useAsyncSend || !cfg ? 0 : ReactorTask::make_reactor(cfg->reactor_type());
+
+  if (reactor_task_->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), name, reactor)) {
     throw Transport::MiscProblem(); // error already logged by TRT::open()
   }
 }
@@ -80,6 +80,7 @@ TransportInst::dump_to_str(DDS::DomainId_t) const
   ret += formatNameForDump("optimum_packet_size")     + to_dds_string(unsigned(optimum_packet_size())) + '\n';
   ret += formatNameForDump("thread_per_connection")   + (thread_per_connection() ? "true" : "false") + '\n';
   ret += formatNameForDump("event_dispatcher_threads") + to_dds_string(unsigned(event_dispatcher_threads())) + '\n';
+  ret += formatNameForDump("reactor_type") + (reactor_type() == ReactorTask::REACTOR_EPOLL ? "Epoll" : "Select") + '\n';
   ret += formatNameForDump("datalink_release_delay")  + to_dds_string(datalink_release_delay()) + '\n';
   ret += formatNameForDump("datalink_control_chunks") + to_dds_string(unsigned(datalink_control_chunks())) + '\n';
   ret += formatNameForDump("fragment_reassembly_timeout") + fragment_reassembly_timeout().str() + '\n';
@@ -166,6 +167,20 @@ TransportInst::event_dispatcher_threads() const
                                                            static_cast<DDS::UInt32>(DEFAULT_EVENT_DISPATCHER_THREADS));
 }
 
+void
+TransportInst::reactor_type(ReactorTask::ReactorType rt)
+{
+  TheServiceParticipant->config_store()->set(config_key("REACTOR_TYPE").c_str(), rt, ReactorTask::reactor_types);
+}
+
+ReactorTask::ReactorType
+TransportInst::reactor_type() const
+{
+  return TheServiceParticipant->config_store()->get(config_key("REACTOR_TYPE").c_str(),
+                                                    TheServiceParticipant->reactor_type(),
+                                                    ReactorTask::reactor_types);
+}
+
 void
 TransportInst::datalink_release_delay(long drd)
 {
@@ -22,6 +22,7 @@
 #include <dds/DCPS/NetworkAddress.h>
 #include <dds/DCPS/PoolAllocator.h>
 #include <dds/DCPS/RcObject.h>
+#include <dds/DCPS/ReactorTask.h>
 #include <dds/DCPS/ReactorTask_rch.h>
 #include <dds/DCPS/TimeDuration.h>
 #include <dds/DCPS/dcps_export.h>
@@ -105,6 +106,11 @@ public:
   void event_dispatcher_threads(size_t edt);
   size_t event_dispatcher_threads() const;
 
+  /// Kind of reactor used by this transport's ReactorTask.  The default is
+  /// Service_Participant::reactor_type.
+  void reactor_type(ReactorTask::ReactorType rt);
+  ReactorTask::ReactorType reactor_type() const;
+
   /// Delay in milliseconds that the datalink should be released after all
   /// associations are removed. The default value is 10 seconds.
   void datalink_release_delay(long drd);
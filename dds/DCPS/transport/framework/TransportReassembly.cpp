@@ -12,6 +12,8 @@
 #include "dds/DCPS/GuidConverter.h"
 #include "dds/DCPS/DisjointSequence.h"
 
+#include <algorithm>
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -42,8 +44,14 @@ TransportReassembly::FragSample::FragSample(const FragmentRange& fragRange,
 }
 #endif
 
-TransportReassembly::TransportReassembly(const TimeDuration& timeout)
+const ACE_UINT32 TransportReassembly::MIN_CONTIGUOUS_FRAGMENT_SIZE;
+
+TransportReassembly::TransportReassembly(const TimeDuration& timeout,
+                                         size_t max_contiguous_size,
+                                         size_t max_contiguous_writer_size)
   : timeout_(timeout)
+  , max_contiguous_size_(max_contiguous_size)
+  , max_contiguous_writer_size_(max_contiguous_writer_size)
 {
 }
 
@@ -86,6 +94,10 @@ TransportReassembly::get_gaps(const SequenceNumber& seq, const GUID_t& pub_id,
     return 0;
   }
 
+  if (iter->second.contiguous_) {
+    return iter->second.get_contiguous_gaps(bitmap, length, numBits);
+  }
+
   // RTPS's FragmentNumbers are 32-bit values, so we'll only be using the
   // low 32 bits of the 64-bit generalized sequence numbers in
   // FragSample::frag_range_.
@@ -139,10 +151,11 @@ TransportReassembly::get_gaps(const SequenceNumber& seq, const GUID_t& pub_id,
 bool
 TransportReassembly::reassemble(const FragmentRange& fragRange,
                                 ReceivedDataSample& data,
-                                ACE_UINT32 total_frags)
+                                ACE_UINT32 total_frags,
+                                size_t sample_size)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  return reassemble_i(fragRange, fragRange.first == 1, data, total_frags);
+  return reassemble_i(fragRange, fragRange.first == 1, data, total_frags, sample_size);
 }
 
 bool
@@ -160,7 +173,8 @@ bool
 TransportReassembly::reassemble_i(const FragmentRange& fragRange,
                                   bool firstFrag,
                                   ReceivedDataSample& data,
-                                  ACE_UINT32 total_frags)
+                                  ACE_UINT32 total_frags,
+                                  size_t sample_size)
 {
   if (Transport_debug_level > 5) {
     LogGuid logger(data.header_.publication_id_);
@@ -180,6 +194,14 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
   if (iter == fragments_.end()) {
     FragInfo& finfo = fragments_[key];
     finfo = FragInfo(firstFrag, FragInfo::FragSampleList(), total_frags, expiration);
+    if (sample_size && sample_size <= max_contiguous_size_) {
+      const ContiguousSizeMap::iterator size_iter = contiguous_sizes_.find(key.publication_);
+      const size_t writer_size = size_iter == contiguous_sizes_.end() ? 0 : size_iter->second;
+      if (sample_size <= max_contiguous_writer_size_ - (std::min)(writer_size, max_contiguous_writer_size_)
+          && finfo.init_contiguous(sample_size, data.fragment_size_)) {
+        contiguous_sizes_[key.publication_] = writer_size + sample_size;
+      }
+    }
     finfo.insert(fragRange, data);
     expiration_queue_.push_back(std::make_pair(expiration, key));
     data.clear();
@@ -199,7 +221,7 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
     if (firstFrag) {
       iter->second.have_first_ = true;
     }
-    if (iter->second.total_frags_ < total_frags) {
+    if (!iter->second.contiguous_ && iter->second.total_frags_ < total_frags) {
       iter->second.total_frags_ = total_frags;
     }
     iter->second.expiration_ = expiration;
@@ -210,15 +232,10 @@ TransportReassembly::reassemble_i(const FragmentRange& fragRange,
     return false;
   }
 
-  // We can deliver data if all three of these conditions are met:
-  // 1. we've seen the "first fragment" flag  [first frag is here]
-  // 2. all fragments have been coalesced     [no gaps in the seq numbers]
-  // 3. the "more fragments" flag is not set  [last frag is here]
-  if (iter->second.have_first_
-      && iter->second.sample_list_.size() == 1
-      && !iter->second.sample_list_.front().rec_ds_.header_.more_fragments_) {
-    std::swap(data, iter->second.sample_list_.front().rec_ds_);
-    fragments_.erase(iter);
+  ReceivedDataSample* const complete = iter->second.complete();
+  if (complete) {
+    std::swap(data, *complete);
+    erase(iter);
     completed_[key.publication_].insert(key.data_sample_seq_);
     if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
       ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::reassemble_i: "
@@ -245,6 +262,11 @@ TransportReassembly::data_unavailable(const FragmentRange& dropped)
        ++iter) {
     const FragKey& key = iter->first;
     FragInfo& finfo = iter->second;
+    if (finfo.contiguous_) {
+      // Only transports that use transport sequence numbers as fragment
+      // numbers drop ranges, and those never know the size of the sample.
+      continue;
+    }
     FragInfo::FragSampleList& flist = finfo.sample_list_;
 
     ReceivedDataSample dummy;
@@ -290,13 +312,31 @@ TransportReassembly::data_unavailable(const SequenceNumber& dataSampleSeq,
                                       const GUID_t& pub_id)
 {
   ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
-  if (fragments_.erase(FragKey(pub_id, dataSampleSeq)) &&
-      (Transport_debug_level > 5 || transport_debug.log_fragment_storage)) {
+  const FragInfoMap::iterator iter = fragments_.find(FragKey(pub_id, dataSampleSeq));
+  if (iter == fragments_.end()) {
+    return;
+  }
+  erase(iter);
+  if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
       ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::data_unavailable: "
                   "removed leaving %B fragments\n", fragments_.size()));
   }
 }
 
+void TransportReassembly::erase(FragInfoMap::iterator iter)
+{
+  if (iter->second.contiguous_) {
+    const ContiguousSizeMap::iterator size_iter = contiguous_sizes_.find(iter->first.publication_);
+    if (size_iter != contiguous_sizes_.end()) {
+      size_iter->second -= (std::min)(size_iter->second, iter->second.sample_size_);
+      if (size_iter->second == 0) {
+        contiguous_sizes_.erase(size_iter);
+      }
+    }
+  }
+  fragments_.erase(iter);
+}
+
 void TransportReassembly::check_expirations(const MonotonicTimePoint& now)
 {
   while (!expiration_queue_.empty() && expiration_queue_.front().first <= now) {
@@ -304,7 +344,7 @@ void TransportReassembly::check_expirations(const MonotonicTimePoint& now)
     if (iter != fragments_.end()) {
       // FragInfo::expiration_ may have changed after insertion into expiration_queue_
       if (iter->second.expiration_ <= now) {
-        fragments_.erase(iter);
+        erase(iter);
         if (Transport_debug_level > 5 || transport_debug.log_fragment_storage) {
           ACE_DEBUG((LM_DEBUG, "(%P|%t) TransportReassembly::check_expirations: "
                      "purge expired leaving %B fragments\n", fragments_.size()));
@@ -345,9 +385,23 @@ size_t TransportReassembly::total_frags() const
   return total;
 }
 
+size_t TransportReassembly::contiguous_size() const
+{
+  size_t total = 0;
+  ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+  for (ContiguousSizeMap::const_iterator iter = contiguous_sizes_.begin(); iter != contiguous_sizes_.end(); ++iter) {
+    total += iter->second;
+  }
+  return total;
+}
+
 TransportReassembly::FragInfo::FragInfo()
   : have_first_(false)
   , total_frags_(0)
+  , contiguous_(false)
+  , sample_size_(0)
+  , fragment_size_(0)
+  , received_count_(0)
 {}
 
 TransportReassembly::FragInfo::FragInfo(bool hf, const FragSampleList& rl, ACE_UINT32 tf, const MonotonicTimePoint& expiration)
@@ -355,6 +409,10 @@ TransportReassembly::FragInfo::FragInfo(bool hf, const FragSampleList& rl, ACE_U
   , sample_list_(rl)
   , total_frags_(tf)
   , expiration_(expiration)
+  , contiguous_(false)
+  , sample_size_(0)
+  , fragment_size_(0)
+  , received_count_(0)
 {
   for (FragSampleList::iterator it = sample_list_.begin(), prev = it; it != sample_list_.end(); ++it) {
     sample_finder_[it->frag_range_.second] = it;
@@ -382,6 +440,14 @@ TransportReassembly::FragInfo::operator=(const FragInfo& rhs)
     gap_list_ = rhs.gap_list_;
     total_frags_ = rhs.total_frags_;
     expiration_ = rhs.expiration_;
+    contiguous_ = rhs.contiguous_;
+    contiguous_sample_ = rhs.contiguous_sample_;
+    sample_size_ = rhs.sample_size_;
+    fragment_size_ = rhs.fragment_size_;
+    received_ = rhs.received_;
+    received_count_ = rhs.received_count_;
+    first_range_ = rhs.first_range_;
+    first_sample_ = rhs.first_sample_;
     sample_finder_.clear();
     gap_finder_.clear();
     for (FragSampleList::iterator it = sample_list_.begin(); it != sample_list_.end(); ++it) {
@@ -410,9 +476,208 @@ namespace {
 #endif
 
 
+bool
+TransportReassembly::FragInfo::init_contiguous(size_t sample_size, ACE_UINT32 fragment_size)
+{
+  if (fragment_size < MIN_CONTIGUOUS_FRAGMENT_SIZE || total_frags_ == 0 ||
+      (sample_size + fragment_size - 1) / fragment_size != total_frags_) {
+    return false;
+  }
+  contiguous_ = true;
+  contiguous_sample_.fragment_size_ = fragment_size;
+  sample_size_ = sample_size;
+  fragment_size_ = fragment_size;
+  received_.assign((total_frags_ + 31) / 32, 0);
+  received_count_ = 0;
+  return true;
+}
+
+ReceivedDataSample*
+TransportReassembly::FragInfo::complete()
+{
+  if (contiguous_) {
+    if (received_count_ < total_frags_) {
+      return 0;
+    }
+    contiguous_sample_.header_.message_length_ = static_cast<ACE_UINT32>(sample_size_);
+    contiguous_sample_.header_.more_fragments_ = false;
+    return &contiguous_sample_;
+  }
+
+  // We can deliver data if all three of these conditions are met:
+  // 1. we've seen the "first fragment" flag  [first frag is here]
+  // 2. all fragments have been coalesced     [no gaps in the seq numbers]
+  // 3. the "more fragments" flag is not set  [last frag is here]
+  if (have_first_
+      && sample_list_.size() == 1
+      && !sample_list_.front().rec_ds_.header_.more_fragments_) {
+    return &sample_list_.front().rec_ds_;
+  }
+  return 0;
+}
+
+CORBA::ULong
+TransportReassembly::FragInfo::get_contiguous_gaps(CORBA::Long bitmap[], CORBA::ULong length,
+                                                   CORBA::ULong& numBits) const
+{
+  // Find the first missing fragment, skipping whole words of arrived ones
+  ACE_UINT32 first = 0;
+  while (first / 32 < received_.size() && received_[first / 32] == 0xffffffff) {
+    first += 32;
+  }
+  while (first < total_frags_ && has_fragment(first)) {
+    ++first;
+  }
+  if (first >= total_frags_) {
+    return 0;
+  }
+
+  // As with the list, gaps after the last fragment that has arrived are only
+  // reported if none have arrived after the first gap.
+  ACE_UINT32 last = total_frags_ - 1;
+  while (last > first && !has_fragment(last)) {
+    --last;
+  }
+  if (last == first) {
+    last = total_frags_ - 1;
+  }
+
+  for (ACE_UINT32 i = first; i <= last; ++i) {
+    if (has_fragment(i)) {
+      continue;
+    }
+    ACE_UINT32 end = i;
+    while (end < last && !has_fragment(end + 1)) {
+      ++end;
+    }
+    ACE_CDR::ULong bits_added = 0;
+    if (!DisjointSequence::fill_bitmap_range(i - first, end - first,
+                                             bitmap, length, numBits, bits_added)) {
+      break;
+    }
+    i = end;
+  }
+
+  // FragmentNumbers start at 1
+  return first + 1;
+}
+
+namespace {
+  void add_content_filter_entries(DataSampleHeader& to, const DataSampleHeader& from)
+  {
+    if (!from.content_filter_) {
+      return;
+    }
+    to.content_filter_ = true;
+    const CORBA::ULong entries = from.content_filter_entries_.length();
+    CORBA::ULong x = to.content_filter_entries_.length();
+    to.content_filter_entries_.length(x + entries);
+    for (CORBA::ULong i = 0; i < entries; ++i) {
+      to.content_filter_entries_[x++] = from.content_filter_entries_[i];
+    }
+  }
+}
+
+bool
+TransportReassembly::FragInfo::insert_contiguous(const FragmentRange& fragRange,
+                                                 ReceivedDataSample& data)
+{
+  const SequenceNumber::Value sn = data.header_.sequence_.getValue();
+  if (fragRange.first < 1 || fragRange.first > fragRange.second ||
+      fragRange.second > total_frags_) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: TransportReassembly::FragInfo::insert_contiguous: ")
+      ACE_TEXT("(SN: %q) fragments %q-%q are outside of the %u in the sample\n"),
+      sn, fragRange.first, fragRange.second, total_frags_));
+    return false;
+  }
+
+  const ACE_UINT32 first = static_cast<ACE_UINT32>(fragRange.first - 1);
+  const ACE_UINT32 last = static_cast<ACE_UINT32>(fragRange.second - 1);
+  ACE_UINT32 missing = 0;
+  for (ACE_UINT32 i = first; i <= last; ++i) {
+    if (!has_fragment(i)) {
+      ++missing;
+    }
+  }
+  if (missing == 0) {
+    VDBG((LM_DEBUG, "(%P|%t) TransportReassembly::insert_contiguous: (SN: %q) duplicate fragment range %q-%q, dropping\n", sn, fragRange.first, fragRange.second));
+    return false;
+  }
+
+  const size_t size = contiguous_length(fragRange);
+  if (data.data_length() < size) {
+    ACE_ERROR((LM_ERROR,
+      ACE_TEXT("(%P|%t) ERROR: TransportReassembly::FragInfo::insert_contiguous: ")
+      ACE_TEXT("(SN: %q) fragments %q-%q have %B bytes, expected %B\n"),
+      sn, fragRange.first, fragRange.second, data.data_length(), size));
+    return false;
+  }
+
+  // Allocating the buffer is put off until a second range of fragments
+  // arrives so that a single fragment claiming to be part of a large sample
+  // doesn't allocate memory for all of it.
+  const bool allocate = received_count_ != 0 || missing == total_frags_;
+  if (allocate && !contiguous_sample_.has_data()) {
+    contiguous_sample_.allocate(sample_size_);
+    if (first_sample_.has_data()) {
+      copy_contiguous(first_range_, first_sample_);
+      first_sample_.clear();
+    }
+  }
+  if (allocate) {
+    copy_contiguous(fragRange, data);
+  } else {
+    first_range_ = fragRange;
+    first_sample_ = data;
+  }
+
+  for (ACE_UINT32 i = first; i <= last; ++i) {
+    received_[i / 32] |= 1u << (i % 32);
+  }
+
+  // Keep the header of the last fragment, which is what joining the
+  // fragments' headers in order would do.
+  if (received_count_ == 0) {
+    contiguous_sample_.header_ = data.header_;
+  } else if (fragRange.second == total_frags_) {
+    DataSampleHeader header = data.header_;
+    add_content_filter_entries(header, contiguous_sample_.header_);
+    contiguous_sample_.header_ = header;
+  } else {
+    add_content_filter_entries(contiguous_sample_.header_, data.header_);
+  }
+  received_count_ += missing;
+
+  VDBG((LM_DEBUG, "(%P|%t) TransportReassembly::insert_contiguous: (SN: %q) copied %q-%q, have %u of %u fragments\n", sn, fragRange.first, fragRange.second, received_count_, total_frags_));
+  data.clear();
+  return true;
+}
+
+size_t
+TransportReassembly::FragInfo::contiguous_length(const FragmentRange& fragRange) const
+{
+  // The last fragment may be short, and the data may be followed by padding
+  const size_t offset = static_cast<size_t>(fragRange.first - 1) * fragment_size_;
+  const size_t frags = static_cast<size_t>(fragRange.second - fragRange.first + 1);
+  return (std::min)(frags * fragment_size_, sample_size_ - offset);
+}
+
+void
+TransportReassembly::FragInfo::copy_contiguous(const FragmentRange& fragRange,
+                                               const ReceivedDataSample& data)
+{
+  const size_t offset = static_cast<size_t>(fragRange.first - 1) * fragment_size_;
+  contiguous_sample_.copy_data_from(data, offset, contiguous_length(fragRange));
+}
+
 bool
 TransportReassembly::FragInfo::insert(const FragmentRange& fragRange, ReceivedDataSample& data)
 {
+  if (contiguous_) {
+    return insert_contiguous(fragRange, data);
+  }
+
   const FragmentNumber prev = fragRange.first - 1, next = fragRange.second + 1;
 
   FragSampleList::iterator start = sample_list_.begin();
@@ -64,7 +64,17 @@ typedef std::pair<FragmentNumber, FragmentNumber> FragmentRange;
 
 class OpenDDS_Dcps_Export TransportReassembly : public RcObject {
 public:
-  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300));
+  /// Samples of up to max_contiguous_size bytes are reassembled in a single
+  /// buffer when their size is known, see FragInfo::contiguous_.  Once the
+  /// incomplete samples of a writer reassembled this way add up to
+  /// max_contiguous_writer_size bytes, its other samples use the list.
+  explicit TransportReassembly(const TimeDuration& timeout = TimeDuration(300),
+                               size_t max_contiguous_size = 0,
+                               size_t max_contiguous_writer_size = 0);
+
+  /// Fragments smaller than this always use the list, which limits the
+  /// number of fragments tracked for a sample reassembled in one buffer.
+  static const ACE_UINT32 MIN_CONTIGUOUS_FRAGMENT_SIZE = 256;
 
   /// Called by TransportReceiveStrategy if the fragmentation header flag
   /// is set.  Returns true/false to indicate if data should be delivered to
@@ -72,7 +82,10 @@ public:
   bool reassemble(const SequenceNumber& transportSeq, bool firstFrag,
                   ReceivedDataSample& data, ACE_UINT32 total_frags = 0);
 
-  bool reassemble(const FragmentRange& fragRange, ReceivedDataSample& data, ACE_UINT32 total_frags = 0);
+  /// sample_size is the size of the whole sample, if it's known.  Then
+  /// data.fragment_size_ must be the size of each fragment except the last.
+  bool reassemble(const FragmentRange& fragRange, ReceivedDataSample& data,
+                  ACE_UINT32 total_frags = 0, size_t sample_size = 0);
 
   /// Called by TransportReceiveStrategy to indicate that we can
   /// stop tracking partially-reassembled messages when we know the
@@ -109,11 +122,14 @@ public:
   size_t queue_size() const;
   size_t completed_size() const;
   size_t total_frags() const;
+  /// Bytes reserved by incomplete samples reassembled in a single buffer
+  size_t contiguous_size() const;
 
 private:
 
   bool reassemble_i(const FragmentRange& fragRange, bool firstFrag,
-                    ReceivedDataSample& data, ACE_UINT32 total_frags);
+                    ReceivedDataSample& data, ACE_UINT32 total_frags,
+                    size_t sample_size = 0);
 
   // A FragSample represents a chunk of a partially-reassembled message.
   // The frag_range_ range is the range of transport sequence numbers
@@ -156,6 +172,16 @@ private:
 
     bool insert(const FragmentRange& fragRange, ReceivedDataSample& data);
 
+    /// Switch to contiguous mode, returns false if the sizes don't agree
+    /// with total_frags_.
+    bool init_contiguous(size_t sample_size, ACE_UINT32 fragment_size);
+
+    /// Returns the reassembled sample if all the fragments have arrived
+    ReceivedDataSample* complete();
+
+    CORBA::ULong get_contiguous_gaps(CORBA::Long bitmap[], CORBA::ULong length,
+                                     CORBA::ULong& numBits) const;
+
     bool have_first_;
     FragSampleList sample_list_;
     FragSampleListIterMap sample_finder_;
@@ -163,6 +189,31 @@ private:
     FragGapListIterMap gap_finder_;
     ACE_UINT32 total_frags_;
     MonotonicTimePoint expiration_;
+
+    /// In contiguous mode the fragments are copied to their offset in
+    /// contiguous_sample_ as they arrive instead of being kept in
+    /// sample_list_, and received_ has bit n % 32 of word n / 32 set if
+    /// fragment n + 1 has arrived.  The buffer isn't allocated until a
+    /// second range of fragments arrives, until then the first one is kept
+    /// in first_sample_.
+    bool contiguous_;
+    ReceivedDataSample contiguous_sample_;
+    size_t sample_size_;
+    ACE_UINT32 fragment_size_;
+    OPENDDS_VECTOR(ACE_UINT32) received_;
+    ACE_UINT32 received_count_;
+    FragmentRange first_range_;
+    ReceivedDataSample first_sample_;
+
+  private:
+    bool insert_contiguous(const FragmentRange& fragRange, ReceivedDataSample& data);
+    void copy_contiguous(const FragmentRange& fragRange, const ReceivedDataSample& data);
+    size_t contiguous_length(const FragmentRange& fragRange) const;
+
+    bool has_fragment(ACE_UINT32 index) const
+    {
+      return (received_[index / 32] & (1u << (index % 32))) != 0;
+    }
   };
 
   mutable ACE_Thread_Mutex mutex_;
@@ -181,9 +232,15 @@ private:
   typedef OPENDDS_MAP_CMP(GUID_t, DisjointSequence, GUID_tKeyLessThan) CompletedMap;
   CompletedMap completed_;
 
+  typedef OPENDDS_MAP_CMP(GUID_t, size_t, GUID_tKeyLessThan) ContiguousSizeMap;
+  ContiguousSizeMap contiguous_sizes_;
+
   TimeDuration timeout_;
+  size_t max_contiguous_size_;
+  size_t max_contiguous_writer_size_;
 
   void check_expirations(const MonotonicTimePoint& now);
+  void erase(FragInfoMap::iterator iter);
 };
 
 typedef RcHandle<TransportReassembly> TransportReassembly_rch;
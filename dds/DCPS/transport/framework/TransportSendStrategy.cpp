@@ -249,6 +249,10 @@ TransportSendStrategy::perform_work()
     // packet as possible.
     outcome = send_packet();
 
+    if (outcome != OUTCOME_COMPLETE_SEND || queue_.size() == 0) {
+      burst_sent_i();
+    }
+
     // If we sent the whole packet (eg, partial_send is false), and the queue_
     // is now empty, then we've cleared the backpressure situation.
     if ((outcome == OUTCOME_COMPLETE_SEND) && (queue_.size() == 0)) {
@@ -1218,6 +1222,9 @@ TransportSendStrategy::send(TransportQueueElement* element, bool relink)
           }
         }
       }
+
+      // The rest of the fragments, if any, are queued or were dropped.
+      burst_sent_i();
     }
   }
 
@@ -199,8 +199,18 @@ protected:
   /// Specific implementation processing of prepared packet.
   virtual void prepare_packet_i();
 
+  /// Called with lock_ held when send() or perform_work() won't send
+  /// another packet right away, either because there isn't one or because
+  /// sending stopped.  A transport that holds packets to send several of
+  /// them together sends what it's holding here.
+  virtual void burst_sent_i() {}
+
   TransportQueueElement* current_packet_first_element() const;
 
+  /// True if the current packet holds a fragment of a larger message and
+  /// isn't the last fragment of that message.
+  bool current_packet_has_more_fragments() const;
+
   /// The maximum size of a message allowed by the this TransportImpl, or 0
   /// if there is no such limit.  This is expected to be a constant, for example
   /// UDP/IPv4 can send messages of up to 65466 bytes.
@@ -155,6 +155,13 @@ TransportQueueElement* TransportSendStrategy::current_packet_first_element() con
   return this->elems_.peek();
 }
 
+ACE_INLINE
+bool TransportSendStrategy::current_packet_has_more_fragments() const
+{
+  const TransportQueueElement* const elem = this->elems_.peek();
+  return elem && elem->is_fragment() && !this->header_.last_fragment_;
+}
+
 } // namespace DCPS
 } // namespace OpenDDS
 
@@ -15,6 +15,7 @@
 #include <dds/DCPS/Logging.h>
 #include <dds/DCPS/NetworkResource.h>
 #include <dds/DCPS/Qos_Helper.h>
+#include <dds/DCPS/ServiceEventDispatcher.h>
 #include <dds/DCPS/Util.h>
 
 #include <dds/DCPS/transport/framework/TransportCustomizedElement.h>
@@ -412,6 +413,34 @@ RtpsUdpDataLink::open(const ACE_SOCK_Dgram& unicast_socket
 #endif
   }
 
+#ifdef OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+  if (cfg->use_udp_gro() && !cfg->use_ice()) {
+    // The receive strategy splits coalesced datagrams using the UDP_GRO
+    // control message, so failing to enable this isn't an error.
+    int gro = 1;
+    if (unicast_socket_.get_handle() != ACE_INVALID_HANDLE &&
+        unicast_socket_.set_option(SOL_UDP, UDP_GRO, &gro, sizeof gro) < 0
+        && log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: RtpsUdpDataLink::open: "
+                 "failed to enable UDP_GRO: %m\n"));
+    }
+#ifdef ACE_HAS_IPV6
+    if (ipv6_unicast_socket_.get_handle() != ACE_INVALID_HANDLE &&
+        ipv6_unicast_socket_.set_option(SOL_UDP, UDP_GRO, &gro, sizeof gro) < 0
+        && log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: RtpsUdpDataLink::open: "
+                 "failed to enable UDP_GRO on the IPv6 socket: %m\n"));
+    }
+#endif
+  }
+#endif
+
+  // Each receive thread is a dispatcher of its own so that the samples of
+  // a writer, which always go to the same one, are delivered in order.
+  for (size_t i = 0; i < cfg->receive_threads(); ++i) {
+    receive_dispatchers_.push_back(make_rch<ServiceEventDispatcher>(1));
+  }
+
   send_strategy()->send_buffer(&multi_buff_);
 
   if (start(send_strategy_,
@@ -1039,6 +1068,73 @@ RtpsUdpDataLink::stop_i()
   ipv6_unicast_socket_.close();
   ipv6_multicast_socket_.close();
 #endif
+
+  // Samples that are still queued are dropped.  They can't outlive the
+  // receive strategy since their buffers come from its allocators.
+  for (ReceiveDispatchers::iterator it = receive_dispatchers_.begin(); it != receive_dispatchers_.end(); ++it) {
+    (*it)->shutdown(true);
+  }
+}
+
+void
+RtpsUdpDataLink::deliver_received(ReceivedDataSample& sample, const GUID_t& reader)
+{
+  if (!dispatch_received(sample, reader, 0)) {
+    data_received(sample, reader);
+  }
+}
+
+void
+RtpsUdpDataLink::deliver_received_include(ReceivedDataSample& sample, RepoIdSet& incl)
+{
+  if (!dispatch_received(sample, GUID_UNKNOWN, &incl)) {
+    data_received_include(sample, incl);
+  }
+}
+
+bool
+RtpsUdpDataLink::dispatch_received(const ReceivedDataSample& sample, const GUID_t& reader, RepoIdSet* incl)
+{
+  if (receive_dispatchers_.empty()) {
+    return false;
+  }
+
+  RcHandle<ConstSharedRepoIdSet> shared_incl;
+  if (incl) {
+    shared_incl = make_rch<ConstSharedRepoIdSet>();
+    const_cast<RepoIdSet&>(shared_incl->guids_).swap(*incl);
+  }
+
+  const GUID_t& writer = sample.header_.publication_id_;
+  const size_t shard = one_at_a_time_hash(reinterpret_cast<const uint8_t*>(&writer), sizeof writer) % receive_dispatchers_.size();
+  // After stop_i() the dispatcher refuses the sample and it's dropped.
+  receive_dispatchers_[shard]->dispatch(make_rch<DeliverReceived>(rchandle_from(this), sample, reader, shared_incl));
+  return true;
+}
+
+RtpsUdpDataLink::DeliverReceived::DeliverReceived(const RtpsUdpDataLink_rch& link,
+                                                  const ReceivedDataSample& sample,
+                                                  const GUID_t& reader,
+                                                  const RcHandle<ConstSharedRepoIdSet>& incl)
+  : link_(link)
+  , sample_(sample)
+  , reader_(reader)
+  , incl_(incl)
+{}
+
+void
+RtpsUdpDataLink::DeliverReceived::execute()
+{
+  const RtpsUdpDataLink_rch link = link_.lock();
+  if (!link) {
+    return;
+  }
+
+  if (incl_) {
+    link->data_received_include(sample_, incl_->guids_);
+  } else {
+    link->data_received(sample_, reader_);
+  }
 }
 
 RcHandle<SingleSendBuffer>
@@ -4665,7 +4761,7 @@ RtpsUdpDataLink::RtpsReader::deliver_held_data(const GUID_t& src)
                  it->header_.sequence_.getValue(),
                  reader.c_str()));
     }
-    link->data_received(*it, dst);
+    link->deliver_received(*it, dst);
   }
 }
 
@@ -262,6 +262,13 @@ public:
   EventDispatcher_rch event_dispatcher() { return event_dispatcher_; }
   RcHandle<JobQueue> get_job_queue() const { return job_queue_; }
 
+  /// Same as DataLink::data_received and DataLink::data_received_include,
+  /// except that with RtpsUdpInst::receive_threads the sample is delivered by
+  /// the receive thread of its writer.  In that case the readers are moved
+  /// out of incl instead of being copied, leaving it empty.
+  void deliver_received(ReceivedDataSample& sample, const GUID_t& reader = GUID_UNKNOWN);
+  void deliver_received_include(ReceivedDataSample& sample, RepoIdSet& incl);
+
   static StatisticSeq stats_template();
   void fill_stats(StatisticSeq& stats, DDS::UInt32& idx) const;
   void local_reliable_reader_stats(size_t& local_reader_count, size_t& remote_reliable_writer_count, size_t& pending_reliable_readers_count, size_t& readers_of_writer_count, size_t& writer_to_seq_best_effort_readers_count) const;
@@ -294,6 +301,29 @@ private:
   RcHandle<JobQueue> job_queue_;
   EventDispatcher_rch event_dispatcher_;
 
+  /// Delivers a sample on a receive thread.
+  class DeliverReceived : public Job {
+  public:
+    DeliverReceived(const RtpsUdpDataLink_rch& link,
+                    const ReceivedDataSample& sample,
+                    const GUID_t& reader,
+                    const RcHandle<ConstSharedRepoIdSet>& incl);
+
+  private:
+    void execute();
+
+    WeakRcHandle<RtpsUdpDataLink> link_;
+    ReceivedDataSample sample_;
+    const GUID_t reader_;
+    const RcHandle<ConstSharedRepoIdSet> incl_;
+  };
+
+  /// One single threaded dispatcher per receive thread, created by open()
+  /// and not modified after that, so they can be used without locking.
+  typedef OPENDDS_VECTOR(EventDispatcher_rch) ReceiveDispatchers;
+  ReceiveDispatchers receive_dispatchers_;
+  bool dispatch_received(const ReceivedDataSample& sample, const GUID_t& reader, RepoIdSet* incl);
+
   RtpsUdpSendStrategy_rch send_strategy() const;
   RtpsUdpReceiveStrategy_rch receive_strategy() const;
 
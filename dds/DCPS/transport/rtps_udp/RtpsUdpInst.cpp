@@ -41,6 +41,14 @@ RtpsUdpInst::RtpsUdpInst(const OPENDDS_STRING& name,
   , receive_address_duration_(*this, &RtpsUdpInst::receive_address_duration, &RtpsUdpInst::receive_address_duration)
   , responsive_mode_(*this, &RtpsUdpInst::responsive_mode, &RtpsUdpInst::responsive_mode)
   , send_delay_(*this, &RtpsUdpInst::send_delay, &RtpsUdpInst::send_delay)
+  , io_batch_size_(*this, &RtpsUdpInst::io_batch_size, &RtpsUdpInst::io_batch_size)
+  , use_udp_gso_(*this, &RtpsUdpInst::use_udp_gso, &RtpsUdpInst::use_udp_gso)
+  , use_udp_gro_(*this, &RtpsUdpInst::use_udp_gro, &RtpsUdpInst::use_udp_gro)
+  , contiguous_reassembly_max_size_(*this, &RtpsUdpInst::contiguous_reassembly_max_size,
+                                    &RtpsUdpInst::contiguous_reassembly_max_size)
+  , contiguous_reassembly_max_writer_size_(*this, &RtpsUdpInst::contiguous_reassembly_max_writer_size,
+                                           &RtpsUdpInst::contiguous_reassembly_max_writer_size)
+  , receive_threads_(*this, &RtpsUdpInst::receive_threads, &RtpsUdpInst::receive_threads)
   , opendds_discovery_guid_(GUID_UNKNOWN)
 {}
 
@@ -637,6 +645,86 @@ RtpsUdpInst::stun_server_address() const
                                                     ConfigStoreImpl::Kind_ANY);
 }
 
+void
+RtpsUdpInst::io_batch_size(size_t ibs)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("IO_BATCH_SIZE").c_str(), static_cast<DDS::UInt32>(ibs));
+}
+
+size_t
+RtpsUdpInst::io_batch_size() const
+{
+  const size_t ibs = TheServiceParticipant->config_store()->get_uint32(config_key("IO_BATCH_SIZE").c_str(), 1);
+  if (ibs == 0) {
+    return 1;
+  }
+  return ibs > MAX_IO_BATCH_SIZE ? static_cast<size_t>(MAX_IO_BATCH_SIZE) : ibs;
+}
+
+void
+RtpsUdpInst::use_udp_gso(bool flag)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("USE_UDP_GSO").c_str(), flag);
+}
+
+bool
+RtpsUdpInst::use_udp_gso() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("USE_UDP_GSO").c_str(), false);
+}
+
+void
+RtpsUdpInst::use_udp_gro(bool flag)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("USE_UDP_GRO").c_str(), flag);
+}
+
+bool
+RtpsUdpInst::use_udp_gro() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("USE_UDP_GRO").c_str(), false);
+}
+
+void
+RtpsUdpInst::contiguous_reassembly_max_size(size_t crms)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_SIZE").c_str(),
+                                                    static_cast<DDS::UInt32>(crms));
+}
+
+size_t
+RtpsUdpInst::contiguous_reassembly_max_size() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_SIZE").c_str(),
+                                                           1024 * 1024);
+}
+
+void
+RtpsUdpInst::contiguous_reassembly_max_writer_size(size_t crmws)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_WRITER_SIZE").c_str(),
+                                                    static_cast<DDS::UInt32>(crmws));
+}
+
+size_t
+RtpsUdpInst::contiguous_reassembly_max_writer_size() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("CONTIGUOUS_REASSEMBLY_MAX_WRITER_SIZE").c_str(),
+                                                           4 * 1024 * 1024);
+}
+
+void
+RtpsUdpInst::receive_threads(size_t rt)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("RECEIVE_THREADS").c_str(), static_cast<DDS::UInt32>(rt));
+}
+
+size_t
+RtpsUdpInst::receive_threads() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("RECEIVE_THREADS").c_str(), 0);
+}
+
 TransportImpl_rch
 RtpsUdpInst::new_impl(DDS::DomainId_t domain)
 {
@@ -659,6 +747,12 @@ RtpsUdpInst::dump_to_str(DDS::DomainId_t domain) const
   ret += formatNameForDump("nak_response_delay") + nak_response_delay().str() + '\n';
   ret += formatNameForDump("heartbeat_period") + heartbeat_period().str() + '\n';
   ret += formatNameForDump("responsive_mode") + (responsive_mode() ? "true" : "false") + '\n';
+  ret += formatNameForDump("io_batch_size") + to_dds_string(unsigned(io_batch_size())) + '\n';
+  ret += formatNameForDump("use_udp_gso") + (use_udp_gso() ? "true" : "false") + '\n';
+  ret += formatNameForDump("use_udp_gro") + (use_udp_gro() ? "true" : "false") + '\n';
+  ret += formatNameForDump("contiguous_reassembly_max_size") + to_dds_string(unsigned(contiguous_reassembly_max_size())) + '\n';
+  ret += formatNameForDump("contiguous_reassembly_max_writer_size") + to_dds_string(unsigned(contiguous_reassembly_max_writer_size())) + '\n';
+  ret += formatNameForDump("receive_threads") + to_dds_string(unsigned(receive_threads())) + '\n';
   ret += formatNameForDump("multicast_group_address") + LogAddr(multicast_group_address(domain)).str() + '\n';
   ret += formatNameForDump("local_address") + LogAddr(local_address()).str() + '\n';
   ret += formatNameForDump("advertised_address") + LogAddr(advertised_address()).str() + '\n';
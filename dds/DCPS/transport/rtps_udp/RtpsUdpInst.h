@@ -16,6 +16,23 @@
 #include <dds/DCPS/SafetyProfileStreams.h>
 #include <dds/DCPS/transport/framework/TransportInst.h>
 
+#if defined ACE_LINUX && !defined ACE_LACKS_SENDMSG
+// sendmmsg(2) and recvmmsg(2) are used when IoBatchSize is more than 1
+#  define OPENDDS_RTPS_UDP_HAS_MMSG
+// UDP segmentation and receive offload are used for UseUdpGso and UseUdpGro
+#  define OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+#  include <netinet/udp.h>
+#  ifndef SOL_UDP
+#    define SOL_UDP IPPROTO_UDP
+#  endif
+#  ifndef UDP_SEGMENT
+#    define UDP_SEGMENT 103
+#  endif
+#  ifndef UDP_GRO
+#    define UDP_GRO 104
+#  endif
+#endif
+
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
 namespace OpenDDS {
@@ -90,6 +107,45 @@ public:
   void send_delay(const TimeDuration& sd);
   TimeDuration send_delay() const;
 
+  /// Maximum number of datagrams sent or received per system call.
+  /// Values more than 1 only have an effect on platforms with sendmmsg and
+  /// recvmmsg (see OPENDDS_RTPS_UDP_HAS_MMSG).
+  static const size_t MAX_IO_BATCH_SIZE = 64;
+  ConfigValue<RtpsUdpInst, size_t> io_batch_size_;
+  void io_batch_size(size_t ibs);
+  size_t io_batch_size() const;
+
+  /// Send the fragments of a large message as one buffer that the kernel
+  /// (or NIC) splits into datagrams (UDP_SEGMENT, Linux only).
+  ConfigValue<RtpsUdpInst, bool> use_udp_gso_;
+  void use_udp_gso(bool flag);
+  bool use_udp_gso() const;
+
+  /// Let the kernel coalesce datagrams received on the unicast sockets
+  /// (UDP_GRO, Linux only).  Not used with ICE.
+  ConfigValue<RtpsUdpInst, bool> use_udp_gro_;
+  void use_udp_gro(bool flag);
+  bool use_udp_gro() const;
+
+  /// Fragmented samples up to this size are reassembled in one buffer
+  /// allocated once a second fragment arrives.
+  ConfigValue<RtpsUdpInst, size_t> contiguous_reassembly_max_size_;
+  void contiguous_reassembly_max_size(size_t crms);
+  size_t contiguous_reassembly_max_size() const;
+
+  /// Limit on the total size of the incomplete samples from one writer
+  /// that are reassembled in one buffer.
+  ConfigValue<RtpsUdpInst, size_t> contiguous_reassembly_max_writer_size_;
+  void contiguous_reassembly_max_writer_size(size_t crmws);
+  size_t contiguous_reassembly_max_writer_size() const;
+
+  /// Number of threads that deliver received samples to the local readers.
+  /// The samples of a writer are always delivered by the same thread.  0
+  /// delivers them on the thread that reads the sockets.
+  ConfigValue<RtpsUdpInst, size_t> receive_threads_;
+  void receive_threads(size_t rt);
+  size_t receive_threads() const;
+
   /// Diagnostic aid.
   virtual OPENDDS_STRING dump_to_str(DDS::DomainId_t domain) const;
 
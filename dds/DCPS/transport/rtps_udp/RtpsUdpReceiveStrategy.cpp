@@ -35,41 +35,35 @@ namespace DCPS {
 RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
                                                const GuidPrefix_t& local_prefix,
                                                ThreadStatusManager& thread_status_manager)
-  : BaseReceiveStrategy(link->config(), BUFFER_COUNT)
+  : BaseReceiveStrategy(link->config(), batch_size(link))
   , link_(link)
   , last_received_()
   , recvd_sample_(0)
   , fragment_size_(0)
   , total_frags_(0)
-  , reassembly_(link->config()->fragment_reassembly_timeout())
+  , sample_size_(0)
+  , reassembly_(link->config()->fragment_reassembly_timeout(),
+                link->config()->contiguous_reassembly_max_size(),
+                link->config()->contiguous_reassembly_max_writer_size())
   , receiver_(local_prefix)
   , thread_status_manager_(thread_status_manager)
+  , io_batch_size_(batch_size(link))
+#ifdef OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+  , udp_gro_(link->config() && link->config()->use_udp_gro() && !link->config()->use_ice())
+#else
+  , udp_gro_(false)
+#endif
 #if OPENDDS_CONFIG_SECURITY
   , secure_sample_()
   , encoded_rtps_(false)
   , encoded_submsg_(false)
 #endif
 {
-  // Since BUFFER_COUNT is 1, the index will always be 0
-  const size_t INDEX = 0;
-
-  if (receive_buffers_[INDEX] == 0) {
-    ACE_NEW_MALLOC(
-      receive_buffers_[INDEX],
-      (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
-      ACE_Message_Block(
-        RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
-        ACE_Message_Block::MB_DATA,         // Default
-        0,                                  // Start with no continuation
-        0,                                  // Let the constructor allocate
-        &data_allocator_,                   // Our buffer cache
-        &receive_lock_,                     // Our locking strategy
-        ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
-        ACE_Time_Value::zero,               // Default
-        ACE_Time_Value::max_time,           // Default
-        &db_allocator_,                     // Our data block cache
-        &mb_allocator_                      // Our message block cache
-      ));
+  // Without batching, BUFFER_COUNT is 1 and the index will always be 0
+  for (size_t index = 0; index < receive_buffers_.size(); ++index) {
+    if (receive_buffers_[index] == 0) {
+      allocate_receive_buffer(index);
+    }
   }
 
 #if OPENDDS_CONFIG_SECURITY
@@ -77,12 +71,77 @@ RtpsUdpReceiveStrategy::RtpsUdpReceiveStrategy(RtpsUdpDataLink* link,
 #endif
 }
 
+size_t
+RtpsUdpReceiveStrategy::batch_size(RtpsUdpDataLink* link)
+{
+#ifdef OPENDDS_RTPS_UDP_HAS_MMSG
+  const RtpsUdpInst_rch config = link->config();
+  return config ? config->io_batch_size() : BUFFER_COUNT;
+#else
+  ACE_UNUSED_ARG(link);
+  return BUFFER_COUNT;
+#endif
+}
+
+int
+RtpsUdpReceiveStrategy::allocate_receive_buffer(size_t index)
+{
+  ACE_NEW_MALLOC_RETURN(
+    receive_buffers_[index],
+    (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
+    ACE_Message_Block(
+      RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
+      ACE_Message_Block::MB_DATA,         // Default
+      0,                                  // Start with no continuation
+      0,                                  // Let the constructor allocate
+      &data_allocator_,                   // Our buffer cache
+      &receive_lock_,                     // Our locking strategy
+      ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
+      ACE_Time_Value::zero,               // Default
+      ACE_Time_Value::max_time,           // Default
+      &db_allocator_,                     // Our data block cache
+      &mb_allocator_                      // Our message block cache
+    ),
+    -1);
+  return 0;
+}
+
+int
+RtpsUdpReceiveStrategy::replace_shared_receive_buffer(size_t index)
+{
+  // If the buffer still has a reference count, we'll need to allocate a new one for the read
+  if (receive_buffers_[index]->data_block()->reference_count() > 1) {
+
+    VDBG_LVL((LM_DEBUG, "(%P|%t) DBG: RtpsUdpReceiveStrategy::replace_shared_receive_buffer: reallocating receive buffer %B based on reference count\n", index), 5);
+
+    ACE_DES_FREE(
+      receive_buffers_[index],
+      mb_allocator_.free,
+      ACE_Message_Block);
+
+    return allocate_receive_buffer(index);
+  }
+  return 0;
+}
+
 int
 RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 {
   ThreadStatusManager::Event ev(thread_status_manager_);
 
-  // Since BUFFER_COUNT is 1, the index will always be 0
+#ifdef OPENDDS_RTPS_UDP_HAS_MMSG
+  if ((io_batch_size_ > 1 || udp_gro_)
+#if OPENDDS_CONFIG_SECURITY
+      // STUN messages for ICE need the local address, which is only
+      // available from receive_bytes.
+      && !link_->get_ice_endpoint()
+#endif
+      ) {
+    return handle_input_batched(fd);
+  }
+#endif
+
+  // Since only one datagram is read at a time, the index will always be 0
   const size_t INDEX = 0;
 
   ACE_Message_Block* const cur_rb = receive_buffers_[INDEX];
@@ -103,16 +162,131 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 
   ACE_INET_Addr remote_address;
   bool stop = false;
-  ssize_t bytes_remaining = receive_bytes(&iov,
-                                          1,
-                                          remote_address,
-                                          fd,
-                                          stop);
+  const ssize_t bytes_remaining = receive_bytes(&iov,
+                                                1,
+                                                remote_address,
+                                                fd,
+                                                stop);
 
   if (stop) {
     return 0;
   }
 
+  const int result = process_datagram(INDEX, bytes_remaining, remote_address);
+  return result == 0 ? replace_shared_receive_buffer(INDEX) : result;
+}
+
+#ifdef OPENDDS_RTPS_UDP_HAS_MMSG
+int
+RtpsUdpReceiveStrategy::handle_input_batched(ACE_HANDLE fd)
+{
+  const ACE_SOCK_Dgram& socket = choose_recv_socket(fd);
+
+  mmsghdr msgs[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+  iovec iovs[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+  ACE_INET_Addr remote_addresses[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+  union Control {
+    cmsghdr align;
+    char buffer[CMSG_SPACE(sizeof(int))];
+  } controls[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+
+  for (size_t i = 0; i < io_batch_size_; ++i) {
+    if (replace_shared_receive_buffer(i) != 0) {
+      return -1;
+    }
+    ACE_Message_Block* const rb = receive_buffers_[i];
+    rb->reset();
+    iovs[i].iov_base = rb->wr_ptr();
+    iovs[i].iov_len = rb->space();
+    std::memset(&msgs[i], 0, sizeof msgs[i]);
+    msgs[i].msg_hdr.msg_name = remote_addresses[i].get_addr();
+    msgs[i].msg_hdr.msg_namelen = remote_addresses[i].get_size();
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    if (udp_gro_) {
+      msgs[i].msg_hdr.msg_control = controls[i].buffer;
+      msgs[i].msg_hdr.msg_controllen = sizeof controls[i].buffer;
+    }
+  }
+
+  // The reactor only knows that the first datagram is ready, so don't wait
+  // for the rest of the batch.
+  const int count = ::recvmmsg(socket.get_handle(), msgs,
+                               static_cast<unsigned int>(io_batch_size_), MSG_DONTWAIT, 0);
+  if (count < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) {
+      return 0;
+    }
+    relink();
+    return -1;
+  }
+
+  RtpsUdpTransport& tport = *link_->transport();
+  const ACE_INET_Addr local_address;
+  for (int i = 0; i < count; ++i) {
+    ACE_INET_Addr& remote_address = remote_addresses[i];
+    remote_address.set_size(static_cast<int>(msgs[i].msg_hdr.msg_namelen));
+    remote_address.set_type(static_cast<sockaddr_in*>(remote_address.get_addr())->sin_family);
+
+    // With UDP_GRO the kernel may have coalesced datagrams of the same size
+    // from the same sender.  Each one is processed as if it was received
+    // on its own.
+    const size_t length = msgs[i].msg_len;
+    size_t segment_size = length;
+#ifdef OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+    for (cmsghdr* cmsg = udp_gro_ ? CMSG_FIRSTHDR(&msgs[i].msg_hdr) : 0; cmsg;
+         cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int gso_size = 0;
+        std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof gso_size);
+        if (gso_size > 0) {
+          segment_size = static_cast<size_t>(gso_size);
+        }
+      }
+    }
+#endif
+
+    // The samples delivered from a segment refer to the receive buffer, so
+    // it isn't replaced until the next call reads into it.
+    ACE_Message_Block* const rb = receive_buffers_[i];
+    for (size_t offset = 0; offset < length; offset += segment_size) {
+      iovec segment;
+      segment.iov_base = rb->base() + offset;
+      segment.iov_len = std::min(segment_size, length - offset);
+      rb->rd_ptr(rb->base() + offset);
+      rb->wr_ptr(rb->base() + offset);
+
+      bool stop = false;
+      ssize_t bytes = process_received_bytes(&segment, 1, static_cast<ssize_t>(segment.iov_len),
+                                             remote_address, local_address,
+#if OPENDDS_CONFIG_SECURITY
+                                             link_->get_ice_agent(), link_->get_ice_endpoint(),
+#endif
+                                             tport, stop);
+      remote_address_ = remote_address;
+      bytes = decode_received_bytes(&segment, 1, bytes, remote_address, stop);
+      if (stop) {
+        continue;
+      }
+
+      const int result = process_datagram(static_cast<size_t>(i), bytes, remote_address);
+      if (result != 0) {
+        return result;
+      }
+    }
+  }
+
+  return 0;
+}
+#endif
+
+int
+RtpsUdpReceiveStrategy::process_datagram(size_t index,
+                                         ssize_t bytes_remaining,
+                                         const ACE_INET_Addr& remote_address)
+{
+  ACE_Message_Block* const rb = receive_buffers_[index];
+
   if (bytes_remaining < 0) {
     relink();
     return -1;
@@ -120,7 +294,7 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
 
   ACE_UINT32 bytes_remaining_unsigned = static_cast<ACE_UINT32>(bytes_remaining);
 
-  cur_rb->wr_ptr(bytes_remaining_unsigned);
+  rb->wr_ptr(bytes_remaining_unsigned);
 
   if (bytes_remaining == 0) {
     if (gracefully_disconnected_) {
@@ -135,9 +309,9 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
     receive_transport_header_.length_ = bytes_remaining_unsigned;
   }
 
-  receive_transport_header_ = *cur_rb;
+  receive_transport_header_ = *rb;
   if (!receive_transport_header_.valid()) {
-    cur_rb->reset();
+    rb->reset();
     if (DCPS_debug_level > 0) {
       ACE_DEBUG((LM_WARNING, ACE_TEXT("(%P|%t) WARNING: RtpsUdpReceiveStrategy::handle_input: TransportHeader invalid.\n")));
     }
@@ -153,12 +327,12 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
     const ScopedHeaderProcessing shp(*this);
     while (bytes_remaining_unsigned > 0) {
       data_sample_header_.pdu_remaining(bytes_remaining_unsigned);
-      data_sample_header_ = *cur_rb;
+      data_sample_header_ = *rb;
       if (!check_header(data_sample_header_)) {
         return 0;
       }
       const ACE_UINT32 serialized_size = static_cast<ACE_UINT32>(data_sample_header_.get_serialized_size());
-      if (!RtpsSampleHeader::has_valid_cursor(*cur_rb) || serialized_size > bytes_remaining_unsigned) {
+      if (!RtpsSampleHeader::has_valid_cursor(*rb) || serialized_size > bytes_remaining_unsigned) {
         return 0;
       }
       bytes_remaining_unsigned -= serialized_size;
@@ -166,7 +340,7 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
       if (message_length > bytes_remaining_unsigned) {
         return 0;
       }
-      ReceivedDataSample rds = data_sample_header_.message_length() ? ReceivedDataSample(*cur_rb) : ReceivedDataSample();
+      ReceivedDataSample rds = data_sample_header_.message_length() ? ReceivedDataSample(*rb) : ReceivedDataSample();
       if (data_sample_header_.into_received_data_sample(rds)) {
 
         if (data_sample_header_.more_fragments() || receive_transport_header_.last_fragment()) {
@@ -183,7 +357,7 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
           deliver_sample(rds, remote_address);
         }
       }
-      cur_rb->rd_ptr(message_length);
+      rb->rd_ptr(message_length);
       bytes_remaining_unsigned -= message_length;
 
       // For the reassembly algorithm, the 'last_fragment_' header bit only
@@ -192,35 +366,6 @@ RtpsUdpReceiveStrategy::handle_input(ACE_HANDLE fd)
     }
   }
 
-  // If newly selected buffer index still has a reference count, we'll need to allocate a new one for the read
-  if (receive_buffers_[INDEX]->data_block()->reference_count() > 1) {
-
-    VDBG_LVL((LM_DEBUG, "(%P|%t) DBG: RtpsUdpReceiveStrategy::handle_input: reallocating primary receive buffer based on reference count\n"), 5);
-
-    ACE_DES_FREE(
-      receive_buffers_[INDEX],
-      mb_allocator_.free,
-      ACE_Message_Block);
-
-    ACE_NEW_MALLOC_RETURN(
-      receive_buffers_[INDEX],
-      (ACE_Message_Block*) mb_allocator_.malloc(sizeof(ACE_Message_Block)),
-      ACE_Message_Block(
-        RECEIVE_DATA_BUFFER_SIZE,           // Buffer size
-        ACE_Message_Block::MB_DATA,         // Default
-        0,                                  // Start with no continuation
-        0,                                  // Let the constructor allocate
-        &data_allocator_,                   // Our buffer cache
-        &receive_lock_,                     // Our locking strategy
-        ACE_DEFAULT_MESSAGE_BLOCK_PRIORITY, // Default
-        ACE_Time_Value::zero,               // Default
-        ACE_Time_Value::max_time,           // Default
-        &db_allocator_,                     // Our data block cache
-        &mb_allocator_                      // Our message block cache
-      ),
-      -1);
-  }
-
   return 0;
 }
 
@@ -243,6 +388,26 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
 #endif
   );
 
+  return process_received_bytes(iov, n, ret, remote_address, local_address,
+#if OPENDDS_CONFIG_SECURITY
+                                ice_agent, endpoint,
+#endif
+                                tport, stop);
+}
+
+ssize_t
+RtpsUdpReceiveStrategy::process_received_bytes(iovec iov[],
+                                               int n,
+                                               ssize_t ret,
+                                               const ACE_INET_Addr& remote_address,
+                                               const ACE_INET_Addr& local_address,
+#if OPENDDS_CONFIG_SECURITY
+                                               DCPS::RcHandle<ICE::Agent> ice_agent,
+                                               DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
+#endif
+                                               RtpsUdpTransport& tport,
+                                               bool& stop)
+{
   if (ret == -1) {
     return ret;
   }
@@ -265,6 +430,7 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
   ACE_ERROR((LM_ERROR, "ERROR: RtpsUdpReceiveStrategy::receive_bytes_helper potential STUN message "
              "received but this version of the ACE library doesn't support the local_address "
              "extension in ACE_SOCK_Dgram::recv\n"));
+  ACE_UNUSED_ARG(local_address);
   ACE_UNUSED_ARG(stop);
   ACE_NOTSUP_RETURN(-1);
 # else
@@ -303,6 +469,7 @@ RtpsUdpReceiveStrategy::receive_bytes_helper(iovec iov[],
   head->release();
 # endif
 #else
+  ACE_UNUSED_ARG(local_address);
   ACE_UNUSED_ARG(stop);
 #endif
 
@@ -371,6 +538,16 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
 #endif
   remote_address_ = remote_address;
 
+  return decode_received_bytes(iov, n, ret, remote_address, stop);
+}
+
+ssize_t
+RtpsUdpReceiveStrategy::decode_received_bytes(iovec iov[],
+                                              int n,
+                                              ssize_t ret,
+                                              const ACE_INET_Addr& remote_address,
+                                              bool& stop)
+{
 #if OPENDDS_CONFIG_SECURITY
   if (stop) {
     return ret;
@@ -469,6 +646,11 @@ RtpsUdpReceiveStrategy::receive_bytes(iovec iov[],
     encoded_rtps_ = true;
     return static_cast<ssize_t>(plainLen);
   }
+#else
+  ACE_UNUSED_ARG(iov);
+  ACE_UNUSED_ARG(n);
+  ACE_UNUSED_ARG(remote_address);
+  ACE_UNUSED_ARG(stop);
 #endif
 
   return ret;
@@ -618,7 +800,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
             ACE_TEXT("calling DataLink::data_received for seq: %q to reader %C\n"),
             this, sample.header_.sequence_.getValue(), LogGuid(reader).c_str()));
         }
-        link_->data_received(sample, reader);
+        link_->deliver_received(sample, reader);
       }
     } else {
       if (Transport_debug_level > 5) {
@@ -651,14 +833,14 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               ACE_TEXT("calling DataLink::data_received for seq: %q TO ALL, no exclusion or inclusion\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received(sample);
+          link_->deliver_received(sample);
         } else {
           if (Transport_debug_level > 5) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy[%@]::deliver_sample_i - ")
               ACE_TEXT("calling DataLink::data_received_include for seq: %q to directedWriteReaders\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received_include(sample, directedWriteReaders);
+          link_->deliver_received_include(sample, directedWriteReaders);
         }
      } else {
         if (directedWriteReaders.empty()) {
@@ -667,7 +849,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               ACE_TEXT("calling DataLink::data_received_include for seq: %q to readers_selected_\n"),
               this, sample.header_.sequence_.getValue()));
           }
-          link_->data_received_include(sample, readers_selected_);
+          link_->deliver_received_include(sample, readers_selected_);
         } else {
           if (Transport_debug_level > 5) {
             ACE_DEBUG((LM_DEBUG, ACE_TEXT("(%P|%t) RtpsUdpReceiveStrategy[%@]::deliver_sample_i - ")
@@ -675,7 +857,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
               this, sample.header_.sequence_.getValue()));
           }
           set_intersect(directedWriteReaders, readers_selected_, GUID_tKeyLessThan());
-          link_->data_received_include(sample, directedWriteReaders);
+          link_->deliver_received_include(sample, directedWriteReaders);
         }
       }
     }
@@ -704,7 +886,7 @@ RtpsUdpReceiveStrategy::deliver_sample_i(ReceivedDataSample& sample,
       sample.header_.message_id_ = DATAWRITER_LIVELINESS;
       receiver_.fill_header(sample.header_);
       sample.header_.publication_id_.entityId = submessage.heartbeat_sm().writerId;
-      link_->data_received(sample);
+      link_->deliver_received(sample);
     }
     break;
 
@@ -1093,6 +1275,7 @@ RtpsUdpReceiveStrategy::check_header(const RtpsSampleHeader& header)
     frags_.second = RtpsSampleHeader::last_fragment(rtps);
     fragment_size_ = rtps.fragmentSize;
     total_frags_ = RtpsSampleHeader::total_fragments(rtps);
+    sample_size_ = rtps.sampleSize;
   }
 
   return true;
@@ -1148,7 +1331,7 @@ bool RtpsUdpReceiveStrategy::reassemble_i(ReceivedDataSample& data, RtpsSampleHe
   using namespace RTPS;
   receiver_.fill_header(data.header_); // set publication_id_.guidPrefix
   data.fragment_size_ = fragment_size_;
-  if (link_->is_target(data.header_.publication_id_) && reassembly_.reassemble(frags_, data, total_frags_)) {
+  if (link_->is_target(data.header_.publication_id_) && reassembly_.reassemble(frags_, data, total_frags_, sample_size_)) {
 
     // Reassembly was successful, replace DataFrag with Data.  This doesn't have
     // to be a fully-formed DataSubmessage, just enough for this class to use
@@ -95,6 +95,38 @@ public:
   void fill_stats(StatisticSeq& stats, DDS::UInt32& idx) const;
 
 private:
+  static size_t batch_size(RtpsUdpDataLink* link);
+  int allocate_receive_buffer(size_t index);
+  int replace_shared_receive_buffer(size_t index);
+
+  /// Read up to io_batch_size_ datagrams with one recvmmsg call, splitting
+  /// any that were coalesced by UDP_GRO.
+  int handle_input_batched(ACE_HANDLE fd);
+
+  /// Parse and deliver the datagram in receive_buffers_[index].  This
+  /// doesn't replace the buffer, so the caller has to before reading into
+  /// it again.
+  int process_datagram(size_t index, ssize_t bytes_remaining,
+                       const ACE_INET_Addr& remote_address);
+
+  static ssize_t process_received_bytes(iovec iov[],
+                                        int n,
+                                        ssize_t ret,
+                                        const ACE_INET_Addr& remote_address,
+                                        const ACE_INET_Addr& local_address,
+#if OPENDDS_CONFIG_SECURITY
+                                        DCPS::RcHandle<ICE::Agent> agent,
+                                        DCPS::WeakRcHandle<ICE::Endpoint> endpoint,
+#endif
+                                        RtpsUdpTransport& tport,
+                                        bool& stop);
+
+  ssize_t decode_received_bytes(iovec iov[],
+                                int n,
+                                ssize_t ret,
+                                const ACE_INET_Addr& remote_address,
+                                bool& stop);
+
   bool getDirectedWriteReaders(RepoIdSet& directedWriteReaders, const RTPS::DataSubmessage& ds) const;
 
   const ACE_SOCK_Dgram& choose_recv_socket(ACE_HANDLE fd) const;
@@ -147,6 +179,7 @@ private:
   ACE_UINT16 fragment_size_;
   FragmentRange frags_;
   ACE_UINT32 total_frags_;
+  ACE_UINT32 sample_size_;
   TransportReassembly reassembly_;
 
   struct MessageReceiver {
@@ -178,6 +211,8 @@ private:
 
   MessageReceiver receiver_;
   ThreadStatusManager& thread_status_manager_;
+  const size_t io_batch_size_;
+  const bool udp_gro_;
   ACE_INET_Addr remote_address_;
   RTPS::Message message_;
 
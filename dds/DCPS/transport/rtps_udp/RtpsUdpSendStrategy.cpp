@@ -14,6 +14,7 @@
 #include <dds/OpenDDSConfigWrapper.h>
 
 #include <dds/DCPS/LogAddr.h>
+#include <dds/DCPS/debug.h>
 #include <dds/DCPS/Serializer.h>
 
 #include <dds/DCPS/RTPS/MessageUtils.h>
@@ -24,6 +25,7 @@
 #include <dds/DCPS/transport/framework/TransportCustomizedElement.h>
 #include <dds/DCPS/transport/framework/TransportSendElement.h>
 
+#include <algorithm>
 #include <cstring>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
@@ -45,10 +47,17 @@ RtpsUdpSendStrategy::RtpsUdpSendStrategy(RtpsUdpDataLink* link,
     override_dest_(0),
     override_single_dest_(0),
     max_message_size_(link->config()->max_message_size()),
+    io_batch_size_(link->config()->io_batch_size()),
     rtps_header_db_(RTPS::RTPSHDR_SZ, ACE_Message_Block::MB_DATA,
                     rtps_header_data_, 0, 0, ACE_Message_Block::DONT_DELETE, 0),
     rtps_header_mb_(&rtps_header_db_, ACE_Message_Block::DONT_DELETE),
-    network_is_unreachable_(false)
+    network_is_unreachable_(false),
+#ifdef OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+    use_udp_gso_(link->config()->use_udp_gso()),
+#else
+    use_udp_gso_(false),
+#endif
+    gso_batch_(use_udp_gso_ ? UDP_MAX_MESSAGE_SIZE : 0)
 {
   std::memcpy(rtps_message_.hdr.prefix, RTPS::PROTOCOL_RTPS, sizeof RTPS::PROTOCOL_RTPS);
   rtps_message_.hdr.version = OpenDDS::RTPS::PROTOCOLVERSION;
@@ -91,10 +100,12 @@ ssize_t
 RtpsUdpSendStrategy::send_bytes_i_helper(const iovec iov[], int n)
 {
   if (override_single_dest_) {
+    flush_segments();
     return send_single_i(iov, n, *override_single_dest_);
   }
 
   if (override_dest_) {
+    flush_segments();
     return send_multi_i(iov, n, *override_dest_);
   }
 
@@ -121,6 +132,10 @@ RtpsUdpSendStrategy::send_bytes_i_helper(const iovec iov[], int n)
     return result;
   }
 
+  if (use_udp_gso_) {
+    return send_segment_i(iov, n, addrs, current_packet_has_more_fragments());
+  }
+
   return send_multi_i(iov, n, addrs);
 }
 
@@ -172,6 +187,7 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
     message.hdr = rtps_message_.hdr;
   }
 
+  flush_segments();
   const AMB_Continuation cont(rtps_header_mb_lock_, rtps_header_mb_, submessages);
 
 #if OPENDDS_CONFIG_SECURITY
@@ -212,6 +228,7 @@ RtpsUdpSendStrategy::send_rtps_control(RTPS::Message& message,
     message.hdr = rtps_message_.hdr;
   }
 
+  flush_segments();
   const AMB_Continuation cont(rtps_header_mb_lock_, rtps_header_mb_, submessages);
 
 #if OPENDDS_CONFIG_SECURITY
@@ -255,6 +272,12 @@ ssize_t
 RtpsUdpSendStrategy::send_multi_i(const iovec iov[], int n,
                                   const NetworkAddressSet& addrs)
 {
+#ifdef OPENDDS_RTPS_UDP_HAS_MMSG
+  if (io_batch_size_ > 1 && addrs.size() > 1) {
+    return send_multi_batched_i(iov, n, addrs);
+  }
+#endif
+
   ssize_t result = -1;
   typedef NetworkAddressSet::const_iterator iter_t;
   for (iter_t iter = addrs.begin(); iter != addrs.end(); ++iter) {
@@ -317,17 +340,27 @@ RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
 #else
   const ssize_t result = socket.send(iov, n, addr.to_addr());
 #endif
+  send_result(iov, n, addr, result, *transport);
+  return result;
+}
+
+void
+RtpsUdpSendStrategy::send_result(const iovec iov[], int n,
+                                 const NetworkAddress& addr,
+                                 ssize_t result,
+                                 RtpsUdpTransport& transport)
+{
   if (result < 0) {
-    transport->core().send_fail(addr, MCK_RTPS, result);
+    transport.core().send_fail(addr, MCK_RTPS, result);
     const int err = errno;
     if (err != ENETUNREACH || !network_is_unreachable_) {
       errno = err;
       const ACE_Log_Priority prio = ss_shouldWarn(errno) ? LM_WARNING : LM_ERROR;
-      ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_single_i() - "
+      ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_result() - "
                  "destination %C failed send: %m\n", DCPS::LogAddr(addr).c_str()));
       if (errno == EMSGSIZE) {
         for (int i = 0; i < n; ++i) {
-          ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_single_i: "
+          ACE_ERROR((prio, "(%P|%t) RtpsUdpSendStrategy::send_result: "
               "iovec[%d].iov_len = %B\n", i, size_t(iov[i].iov_len)));
         }
       }
@@ -338,10 +371,204 @@ RtpsUdpSendStrategy::send_single_i(const iovec iov[], int n,
     // Reset errno since the rest of framework expects it.
     errno = err;
   } else {
-    transport->core().send(addr, MCK_RTPS, result);
+    transport.core().send(addr, MCK_RTPS, result);
     network_is_unreachable_ = false;
   }
+}
+
+#ifdef OPENDDS_RTPS_UDP_HAS_MMSG
+ssize_t
+RtpsUdpSendStrategy::send_multi_batched_i(const iovec iov[], int n,
+                                          const NetworkAddressSet& addrs)
+{
+  RtpsUdpTransport_rch transport = link_->transport();
+  if (!transport) {
+    return 0;
+  }
+
+  mmsghdr msgs[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+  ACE_INET_Addr inet_addrs[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+  const NetworkAddress* dests[RtpsUdpInst::MAX_IO_BATCH_SIZE];
+
+  ssize_t result = -1;
+  typedef NetworkAddressSet::const_iterator iter_t;
+  iter_t iter = addrs.begin();
+  while (iter != addrs.end()) {
+    // Collect up to io_batch_size_ destinations that use the same socket.
+    const ACE_SOCK_Dgram* socket = 0;
+    size_t count = 0;
+    for (; iter != addrs.end() && count < io_batch_size_; ++iter) {
+      if (!*iter) {
+        continue;
+      }
+      const ACE_SOCK_Dgram& dest_socket = choose_send_socket(*iter);
+      if (socket && socket != &dest_socket) {
+        break;
+      }
+#ifdef OPENDDS_TESTING_FEATURES
+      ssize_t total_length;
+      if (transport->core().should_drop(iov, n, total_length)) {
+        result = total_length;
+        continue;
+      }
+#endif
+      socket = &dest_socket;
+      dests[count] = &*iter;
+      iter->to_addr(inet_addrs[count]);
+      std::memset(&msgs[count], 0, sizeof msgs[count]);
+      msgs[count].msg_hdr.msg_name = inet_addrs[count].get_addr();
+      msgs[count].msg_hdr.msg_namelen = inet_addrs[count].get_size();
+      msgs[count].msg_hdr.msg_iov = const_cast<iovec*>(iov);
+      msgs[count].msg_hdr.msg_iovlen = n;
+      ++count;
+    }
+
+    size_t offset = 0;
+    while (offset < count) {
+      const int sent = ::sendmmsg(socket->get_handle(), msgs + offset,
+                                  static_cast<unsigned int>(count - offset), 0);
+      if (sent <= 0) {
+        // sendmmsg stops at the first failure, which is reported in errno
+        // only when nothing was sent.
+        send_result(iov, n, *dests[offset], -1, *transport);
+        ++offset;
+        continue;
+      }
+      for (int i = 0; i < sent; ++i, ++offset) {
+        const ssize_t bytes = static_cast<ssize_t>(msgs[offset].msg_len);
+        send_result(iov, n, *dests[offset], bytes, *transport);
+        result = bytes;
+      }
+    }
+  }
+  return result;
+}
+#endif
+
+ssize_t
+RtpsUdpSendStrategy::send_segment_i(const iovec iov[], int n,
+                                    const NetworkAddressSet& addrs,
+                                    bool more_fragments)
+{
+  size_t length = 0;
+  for (int i = 0; i < n; ++i) {
+    length += iov[i].iov_len;
+  }
+
+  ACE_Guard<ACE_Thread_Mutex> guard(gso_mutex_);
+  if (gso_batch_.needs_flush(addrs, length)) {
+    // The segments were all reported as sent already, so a failure here
+    // isn't reported.
+    flush_segments_i();
+  }
+
+  if (!use_udp_gso_ || (!more_fragments && gso_batch_.empty())) {
+    guard.release();
+    return send_multi_i(iov, n, addrs);
+  }
+
+  gso_batch_.append(iov, n, addrs);
+
+  // The earlier segments were reported as sent when they were appended, so
+  // a failure to send the batch is only reported for the last segment, the
+  // one that completes it.
+  if (gso_batch_.complete(length, more_fragments) && !flush_segments_i()) {
+    return -1;
+  }
+  return static_cast<ssize_t>(length);
+}
+
+void
+RtpsUdpSendStrategy::burst_sent_i()
+{
+  // Don't leave segments waiting for a later send if the rest of a
+  // message's fragments were queued or dropped.
+  flush_segments();
+}
+
+void
+RtpsUdpSendStrategy::flush_segments()
+{
+  if (use_udp_gso_) {
+    ACE_GUARD(ACE_Thread_Mutex, g, gso_mutex_);
+    flush_segments_i();
+  }
+}
+
+bool
+RtpsUdpSendStrategy::flush_segments_i()
+{
+  SegmentSender sender(*this);
+  return gso_batch_.flush(sender);
+}
+
+ssize_t
+RtpsUdpSendStrategy::send_segments_i(const NetworkAddress& addr,
+                                     const UdpSegmentBatch& batch)
+{
+#ifdef OPENDDS_RTPS_UDP_HAS_UDP_OFFLOAD
+  RtpsUdpTransport_rch transport = link_->transport();
+  if (!use_udp_gso_ || !transport) {
+    return -1;
+  }
+
+  const ACE_SOCK_Dgram& socket = choose_send_socket(addr);
+
+  ACE_INET_Addr inet_addr;
+  addr.to_addr(inet_addr);
+  iovec iov;
+  iov.iov_base = const_cast<char*>(batch.data());
+  iov.iov_len = batch.length();
+
+  union {
+    cmsghdr align;
+    char buffer[CMSG_SPACE(sizeof(ACE_UINT16))];
+  } control;
+  std::memset(&control, 0, sizeof control);
+
+  msghdr msg;
+  std::memset(&msg, 0, sizeof msg);
+  msg.msg_name = inet_addr.get_addr();
+  msg.msg_namelen = inet_addr.get_size();
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof control.buffer;
+
+  cmsghdr* const cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(ACE_UINT16));
+  const ACE_UINT16 segment_size = static_cast<ACE_UINT16>(batch.segment_size());
+  std::memcpy(CMSG_DATA(cmsg), &segment_size, sizeof segment_size);
+
+  const ssize_t result = ::sendmsg(socket.get_handle(), &msg, 0);
+  if (result < 0) {
+    // The batch sends the segments one at a time after this, which reports
+    // any failure for each of them.
+    const int err = errno;
+    if (err == EIO || err == EINVAL || err == ENOPROTOOPT || err == EOPNOTSUPP) {
+      // The kernel or the device can't segment, so stop trying.
+      if (log_level >= LogLevel::Notice) {
+        ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: RtpsUdpSendStrategy::send_segments_i: "
+                   "UDP segmentation offload isn't available: %m, disabling UseUdpGso\n"));
+      }
+      use_udp_gso_ = false;
+    }
+    errno = err;
+    return -1;
+  }
+
+  for (size_t offset = 0; offset < batch.length(); offset += batch.segment_size()) {
+    iov.iov_len = std::min(batch.segment_size(), batch.length() - offset);
+    send_result(&iov, 1, addr, static_cast<ssize_t>(iov.iov_len), *transport);
+  }
   return result;
+#else
+  ACE_UNUSED_ARG(addr);
+  ACE_UNUSED_ARG(batch);
+  return -1;
+#endif
 }
 
 void
@@ -448,6 +675,11 @@ RtpsUdpSendStrategy::pre_send_packet(const ACE_Message_Block* plain)
     return plain->duplicate();
   }
 
+  Security::BatchCryptoTransform* const batch = dynamic_cast<Security::BatchCryptoTransform*>(crypto.in());
+  if (batch) {
+    return encode_batch(plain, *batch);
+  }
+
   bool stateless_or_volatile = false;
   Message_Block_Ptr submessages(encode_submessages(plain, crypto, stateless_or_volatile));
 
@@ -737,6 +969,138 @@ RtpsUdpSendStrategy::encode_submessages(const ACE_Message_Block* plain,
   return replace_chunks(plain, replacements);
 }
 
+ACE_Message_Block*
+RtpsUdpSendStrategy::encode_batch(const ACE_Message_Block* plain,
+                                  Security::BatchCryptoTransform& crypto)
+{
+  // Same parsing as encode_submessages, but the submessages are only located
+  // here and the plugin protects them and the message together.
+  Message_Block_Ptr flat;
+  if (plain->cont()) {
+    flat.reset(new ACE_Message_Block(plain->total_length()));
+    for (const ACE_Message_Block* mb = plain; mb; mb = mb->cont()) {
+      flat->copy(mb->rd_ptr(), mb->length());
+    }
+    plain = flat.get();
+  }
+
+  RTPS::MessageParser parser(*plain);
+  bool ok = parser.parseHeader();
+
+  GUID_t sender = GUID_UNKNOWN;
+  assign(sender.guidPrefix, link_->local_prefix());
+
+  GUID_t receiver = GUID_UNKNOWN;
+
+  bool stateless_or_volatile = false;
+  Security::BatchCryptoTransform::SubmessageSeq submessages;
+  const Security::HandleRegistry_rch handle_registry = link_->handle_registry();
+
+  while (ok && parser.remaining()) {
+
+    const char* const submessage_start = parser.current();
+
+    if (!parser.parseSubmessageHeader()) {
+      ok = false;
+      break;
+    }
+
+    const RTPS::SubmessageHeader smhdr = parser.submessageHeader();
+    const Security::BatchCryptoTransform::Submessage sm = {
+      static_cast<size_t>(submessage_start - plain->rd_ptr()),
+      RTPS::SMHDR_SZ + (smhdr.submessageLength ? smhdr.submessageLength : parser.remaining()),
+      false, DDS::HANDLE_NIL, DDS::HANDLE_NIL
+    };
+
+    CORBA::ULong dataExtra = 0;
+
+    switch (smhdr.submessageId) {
+    case RTPS::INFO_DST: {
+      GuidPrefix_t_forany guidPrefix(receiver.guidPrefix);
+      if (!(parser >> guidPrefix)) {
+        ok = false;
+      }
+      break;
+    }
+    case RTPS::DATA:
+    case RTPS::DATA_FRAG:
+      if (!(parser >> dataExtra)) { // extraFlags|octetsToInlineQos
+        ok = false;
+        break;
+      }
+      // fall-through
+    case RTPS::HEARTBEAT:
+    case RTPS::GAP:
+    case RTPS::HEARTBEAT_FRAG: {
+      if (!(parser >> receiver.entityId) || !(parser >> sender.entityId)) { // readerId, writerId
+        ok = false;
+        break;
+      }
+
+      check_stateless_volatile(sender.entityId, stateless_or_volatile);
+      const DDS::Security::DatawriterCryptoHandle dwch = handle_registry->get_local_datawriter_crypto_handle(sender);
+      if (dwch != DDS::HANDLE_NIL) {
+        submessages.push_back(sm);
+        submessages.back().from_writer_ = true;
+        submessages.back().sender_ = dwch;
+        if (std::memcmp(&GUID_UNKNOWN, &receiver, sizeof receiver)) {
+          submessages.back().receiver_ = handle_registry->get_remote_datareader_crypto_handle(receiver);
+        }
+      }
+      break;
+    }
+    case RTPS::ACKNACK:
+    case RTPS::NACK_FRAG: {
+      if (!(parser >> sender.entityId) || !(parser >> receiver.entityId)) { // readerId, writerId
+        ok = false;
+        break;
+      }
+
+      check_stateless_volatile(receiver.entityId, stateless_or_volatile);
+      const DDS::Security::DatareaderCryptoHandle drch = handle_registry->get_local_datareader_crypto_handle(sender);
+      if (drch != DDS::HANDLE_NIL) {
+        submessages.push_back(sm);
+        submessages.back().sender_ = drch;
+        if (std::memcmp(&GUID_UNKNOWN, &receiver, sizeof receiver)) {
+          submessages.back().receiver_ = handle_registry->get_remote_datawriter_crypto_handle(receiver);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+    }
+
+    if (!ok || !parser.hasNextSubmessage()) {
+      break;
+    }
+
+    if (!parser.skipToNextSubmessage()) {
+      ok = false;
+    }
+  }
+
+  if (!ok) {
+    return 0;
+  }
+
+  const DDS::Security::ParticipantCryptoHandle participant =
+    stateless_or_volatile ? DDS::HANDLE_NIL : link_->local_crypto_handle();
+  if (submessages.empty() && participant == DDS::HANDLE_NIL) {
+    return plain->duplicate();
+  }
+
+  DDS::Security::SecurityException ex = {"", 0, 0};
+  ACE_Message_Block* const encoded =
+    crypto.encode_batch(plain->rd_ptr(), plain->length(), submessages, participant, ex);
+  if (!encoded && Transport_debug_level) {
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RtpsUdpSendStrategy::encode_batch: "
+               "plugin failed to encode RTPS message from handle %d [%d.%d]: %C\n",
+               participant, ex.code, ex.minor_code, ex.message.in()));
+  }
+  return encoded;
+}
+
 ACE_Message_Block*
 RtpsUdpSendStrategy::replace_chunks(const ACE_Message_Block* plain,
                                     const OPENDDS_VECTOR(Chunk)& replacements)
@@ -786,6 +1150,7 @@ RtpsUdpSendStrategy::replace_chunks(const ACE_Message_Block* plain,
 void
 RtpsUdpSendStrategy::stop_i()
 {
+  flush_segments();
 }
 
 size_t RtpsUdpSendStrategy::max_message_size() const
@@ -8,6 +8,7 @@
 
 #include "Rtps_Udp_Export.h"
 #include "RtpsUdpDataLink_rch.h"
+#include "UdpSegmentBatch.h"
 
 #include <dds/DCPS/AtomicBool.h>
 #include <dds/DCPS/NetworkAddress.h>
@@ -19,6 +20,7 @@
 #include <dds/OpenDDSConfigWrapper.h>
 
 #if OPENDDS_CONFIG_SECURITY
+#  include <dds/DCPS/security/framework/BatchCryptoTransform.h>
 #  include <dds/DdsSecurityCoreC.h>
 #endif
 
@@ -30,6 +32,7 @@ namespace OpenDDS {
 namespace DCPS {
 
 class RtpsUdpInst;
+class RtpsUdpTransport;
 
 class OpenDDS_Rtps_Udp_Export RtpsUdpSendStrategy
   : public TransportSendStrategy {
@@ -89,6 +92,8 @@ protected:
 
   virtual size_t max_message_size() const;
 
+  virtual void burst_sent_i();
+
   virtual void add_delayed_notification(TransportQueueElement* element);
 
 private:
@@ -98,6 +103,40 @@ private:
   const ACE_SOCK_Dgram& choose_send_socket(const NetworkAddress& addr) const;
   ssize_t send_single_i(const iovec iov[], int n,
                         const NetworkAddress& addr);
+  void send_result(const iovec iov[], int n, const NetworkAddress& addr,
+                   ssize_t result, RtpsUdpTransport& transport);
+
+  /// Send the same datagram to all of addrs using one sendmmsg call per
+  /// socket instead of one send call per destination.
+  ssize_t send_multi_batched_i(const iovec iov[], int n,
+                               const NetworkAddressSet& addrs);
+
+  /// Append a datagram for addrs to the pending segments, which are sent
+  /// together when the last fragment of the message is appended or when the
+  /// burst ends (burst_sent_i).  The earlier segments are reported as sent
+  /// when they are appended, so a failure to send the segments is only
+  /// reported for the last one.
+  ssize_t send_segment_i(const iovec iov[], int n,
+                         const NetworkAddressSet& addrs, bool more_fragments);
+  void flush_segments();
+  bool flush_segments_i();
+  ssize_t send_segments_i(const NetworkAddress& addr, const UdpSegmentBatch& batch);
+
+  class SegmentSender : public UdpSegmentBatch::Sender {
+  public:
+    explicit SegmentSender(RtpsUdpSendStrategy& outer) : outer_(outer) {}
+    ssize_t send_segments(const NetworkAddress& addr, const UdpSegmentBatch& batch)
+    {
+      return outer_.send_segments_i(addr, batch);
+    }
+    ssize_t send_datagram(const iovec& iov, const NetworkAddressSet& addrs)
+    {
+      return outer_.send_multi_i(&iov, 1, addrs);
+    }
+  private:
+    RtpsUdpSendStrategy& outer_;
+  };
+  friend class SegmentSender;
 
 #if OPENDDS_CONFIG_SECURITY
   ACE_Message_Block* pre_send_packet(const ACE_Message_Block* plain);
@@ -131,6 +170,10 @@ private:
   ACE_Message_Block* encode_rtps_message(const ACE_Message_Block* plain,
                                          DDS::Security::CryptoTransform* crypto);
 
+  /// Protect all of plain with one call to the plugin
+  ACE_Message_Block* encode_batch(const ACE_Message_Block* plain,
+                                  Security::BatchCryptoTransform& crypto);
+
   ACE_Message_Block* replace_chunks(const ACE_Message_Block* plain,
                                     const OPENDDS_VECTOR(Chunk)& replacements);
 #endif
@@ -140,6 +183,7 @@ private:
   const NetworkAddress* override_single_dest_;
 
   const size_t max_message_size_;
+  const size_t io_batch_size_;
   RTPS::Message rtps_message_;
   ACE_Thread_Mutex rtps_message_mutex_;
   char rtps_header_data_[RTPS::RTPSHDR_SZ];
@@ -147,6 +191,11 @@ private:
   ACE_Message_Block rtps_header_mb_;
   ACE_Thread_Mutex rtps_header_mb_lock_;
   AtomicBool network_is_unreachable_;
+
+  /// Pending datagrams for UDP segmentation offload (UseUdpGso)
+  AtomicBool use_udp_gso_;
+  ACE_Thread_Mutex gso_mutex_;
+  UdpSegmentBatch gso_batch_;
 };
 
 } // namespace DCPS
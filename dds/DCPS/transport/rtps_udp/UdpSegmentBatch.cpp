@@ -0,0 +1,88 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "UdpSegmentBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+UdpSegmentBatch::UdpSegmentBatch(size_t capacity)
+  : buffer_(capacity)
+  , length_(0)
+  , segment_size_(0)
+  , segments_(0)
+{
+}
+
+bool UdpSegmentBatch::needs_flush(const NetworkAddressSet& addrs, size_t length) const
+{
+  return segments_ && (addrs != addrs_ || length > segment_size_
+                       || length_ + length > buffer_.size()
+                       || segments_ == MAX_SEGMENTS);
+}
+
+void UdpSegmentBatch::append(const iovec iov[], int n, const NetworkAddressSet& addrs)
+{
+  const size_t start = length_;
+  for (int i = 0; i < n; ++i) {
+    std::memcpy(&buffer_[length_], iov[i].iov_base, iov[i].iov_len);
+    length_ += iov[i].iov_len;
+  }
+  if (!segments_) {
+    segment_size_ = length_ - start;
+    addrs_ = addrs;
+  }
+  ++segments_;
+}
+
+bool UdpSegmentBatch::flush(Sender& sender)
+{
+  if (!segments_) {
+    return true;
+  }
+
+  bool sent = false;
+  NetworkAddressSet unsent;
+  typedef NetworkAddressSet::const_iterator iter_t;
+  for (iter_t iter = addrs_.begin(); iter != addrs_.end(); ++iter) {
+    if (!*iter) {
+      continue;
+    }
+    if (segments_ > 1 && sender.send_segments(*iter, *this) >= 0) {
+      sent = true;
+    } else {
+      unsent.insert(*iter);
+    }
+  }
+
+  for (size_t offset = 0; !unsent.empty() && offset < length_; offset += segment_size_) {
+    iovec iov;
+    iov.iov_base = &buffer_[offset];
+    iov.iov_len = std::min(segment_size_, length_ - offset);
+    const ssize_t result = sender.send_datagram(iov, unsent);
+    if (offset + segment_size_ >= length_ && result >= 0) {
+      sent = true;
+    }
+  }
+
+  clear();
+  return sent;
+}
+
+void UdpSegmentBatch::clear()
+{
+  length_ = segment_size_ = segments_ = 0;
+  addrs_.clear();
+}
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
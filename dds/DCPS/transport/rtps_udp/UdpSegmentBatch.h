@@ -0,0 +1,91 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_DCPS_TRANSPORT_RTPS_UDP_UDPSEGMENTBATCH_H
+#define OPENDDS_DCPS_TRANSPORT_RTPS_UDP_UDPSEGMENTBATCH_H
+
+#include "Rtps_Udp_Export.h"
+
+#include <dds/DCPS/NetworkAddress.h>
+#include <dds/DCPS/PoolAllocator.h>
+
+#include <dds/Versioned_Namespace.h>
+
+#include <ace/os_include/sys/os_uio.h>
+#include <ace/os_include/sys/os_types.h>
+
+OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
+
+namespace OpenDDS {
+namespace DCPS {
+
+/**
+ * Datagrams for the same destinations waiting to be sent as one buffer
+ * using UDP segmentation offload.  All of the segments except the last are
+ * the same size.  This isn't thread-safe.
+ */
+class OpenDDS_Rtps_Udp_Export UdpSegmentBatch {
+public:
+  /// UDP_MAX_SEGMENTS in Linux
+  static const size_t MAX_SEGMENTS = 64;
+
+  /// How the segments are sent.
+  class Sender {
+  public:
+    virtual ~Sender() {}
+
+    /// Send all of the segments to addr in one call.  Returns -1 if they
+    /// weren't sent, in which case they are sent one at a time.
+    virtual ssize_t send_segments(const NetworkAddress& addr, const UdpSegmentBatch& batch) = 0;
+
+    /// Send one datagram to addrs.  Returns -1 if it wasn't sent to any of them.
+    virtual ssize_t send_datagram(const iovec& iov, const NetworkAddressSet& addrs) = 0;
+  };
+
+  explicit UdpSegmentBatch(size_t capacity);
+
+  bool empty() const { return segments_ == 0; }
+  size_t segments() const { return segments_; }
+  size_t segment_size() const { return segment_size_; }
+  size_t length() const { return length_; }
+  const char* data() const { return buffer_.empty() ? 0 : &buffer_[0]; }
+  const NetworkAddressSet& addrs() const { return addrs_; }
+
+  /// True if a datagram of length bytes for addrs can't be appended until
+  /// the pending segments are sent.
+  bool needs_flush(const NetworkAddressSet& addrs, size_t length) const;
+
+  /// Copy a datagram into the batch.  needs_flush must be false.
+  void append(const iovec iov[], int n, const NetworkAddressSet& addrs);
+
+  /// True if the datagram of length bytes that was just appended has to
+  /// be the last segment.
+  bool complete(size_t length, bool more_fragments) const
+  {
+    return !more_fragments || length < segment_size_ || segments_ == MAX_SEGMENTS;
+  }
+
+  /// Send the pending segments and clear the batch.  The segments are sent
+  /// to each destination with one Sender::send_segments call, falling back
+  /// to Sender::send_datagram for the destinations where that failed.
+  /// Returns false if the last segment wasn't sent to any destination.
+  bool flush(Sender& sender);
+
+  void clear();
+
+private:
+  OPENDDS_VECTOR(char) buffer_;
+  size_t length_;
+  size_t segment_size_;
+  size_t segments_;
+  NetworkAddressSet addrs_;
+};
+
+} // namespace DCPS
+} // namespace OpenDDS
+
+OPENDDS_END_VERSIONED_NAMESPACE_DECL
+
+#endif /* OPENDDS_DCPS_TRANSPORT_RTPS_UDP_UDPSEGMENTBATCH_H */
@@ -47,6 +47,11 @@ typedef ACE_Local_Memory_Pool ShmemPool;
 typedef int ShmemSharedSemaphore;
 #endif
 
+// The ring (ShmemInst::use_ring) keeps lock-free atomics in the pool
+#if defined ACE_HAS_CPP11 && !defined OPENDDS_SHMEM_UNSUPPORTED
+#  define OPENDDS_SHMEM_RING
+#endif
+
 typedef ACE_Malloc_T<ShmemPool, ACE_Process_Mutex, ACE_PI_Control_Block> ShmemAllocator;
 
 } // namespace DCPS
@@ -31,6 +31,24 @@ namespace {
   const Encoding encoding_unaligned_native(Encoding::KIND_UNALIGNED_CDR);
 }
 
+#ifdef OPENDDS_SHMEM_RING
+ACE_UINT32
+ShmemRing::capacity_for(size_t control_size)
+{
+  ACE_UINT32 capacity = 2;
+  while (capacity < 0x80000000 && size_for(capacity * 2) <= control_size) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+size_t
+ShmemRing::size_for(ACE_UINT32 capacity)
+{
+  return sizeof(ShmemRing) + (capacity - 1) * sizeof(Slot);
+}
+#endif
+
 ShmemDataLink::ShmemDataLink(const RcHandle<ShmemTransport>& transport)
   : DataLink(transport,
              0,     // priority
@@ -20,6 +20,9 @@
 
 #include <string>
 #include <set>
+#ifdef OPENDDS_SHMEM_RING
+#  include <atomic>
+#endif
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -47,6 +50,64 @@ struct ShmemData {
   ACE_Based_Pointer_Basic<char> payload_;
 };
 
+/**
+ * With ShmemInst::share_payloads_, this is allocated before each payload so
+ * the payload can be referenced from the control areas of more than one data
+ * link.  Only the writing transport uses it; readers see a normal payload.
+ */
+struct ShmemPayloadHeader {
+  ACE_UINT32 refcount_;
+  /// Keeps the payload 8-byte aligned
+  ACE_UINT32 reserved_;
+};
+
+#ifdef OPENDDS_SHMEM_RING
+/**
+ * Single-producer/single-consumer queue of samples from one writing transport
+ * to one reading transport, bound in the writer's pool as "Ring-<reader pool>".
+ * The writer owns head_ and released_ and the reader owns tail_.  They are
+ * kept on separate cache lines so that the two processes don't invalidate each
+ * other's line on every sample.
+ */
+struct ShmemRing {
+  static const size_t CACHE_LINE_SIZE = 64;
+  typedef std::atomic<ACE_UINT32> Index;
+
+  struct Slot {
+    char transport_header_[TRANSPORT_HDR_SERIALIZED_SZ];
+    ACE_Based_Pointer_Basic<char> payload_;
+  };
+
+  /// Next slot the writer fills
+  Index head_;
+  /// Slots before this have had their payloads freed by the writer
+  ACE_UINT32 released_;
+  char writer_pad_[CACHE_LINE_SIZE - sizeof(Index) - sizeof(ACE_UINT32)];
+  /// Next slot the reader takes
+  Index tail_;
+  char reader_pad_[CACHE_LINE_SIZE - sizeof(Index)];
+  /// Always a power of two
+  ACE_UINT32 capacity_;
+  Slot slots_[1];
+
+  Slot& slot(ACE_UINT32 index) { return slots_[index & (capacity_ - 1)]; }
+
+  /// Number of slots in a ring that fits in control_size bytes
+  static ACE_UINT32 capacity_for(size_t control_size);
+  static size_t size_for(ACE_UINT32 capacity);
+};
+
+/// Bound in the reading transport's pool as "ReadSignal".  The reader sets
+/// waiting_ before blocking on its semaphore and writers only post the
+/// semaphore when they take waiting_ back from 1 to 0.
+struct ShmemReadSignal {
+  std::atomic<ACE_UINT32> waiting_;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "ShmemRing needs lock-free atomics to share them between processes");
+#endif
+
 class OpenDDS_Shmem_Export ShmemDataLink
   : public DataLink {
 public:
@@ -80,7 +141,7 @@ public:
   ShmemAllocator* local_allocator();
   ShmemAllocator* peer_allocator();
 
-  void read() { recv_strategy_->read(); }
+  bool read() { return recv_strategy_->read(); }
   void signal_semaphore();
   ShmemTransport_rch transport() const;
   ShmemInst_rch config() const;
@@ -25,6 +25,9 @@ ShmemInst::ShmemInst(const std::string& name)
   : TransportInst("shmem", name)
   , pool_size_(*this, &ShmemInst::pool_size, &ShmemInst::pool_size)
   , datalink_control_size_(*this, &ShmemInst::datalink_control_size, &ShmemInst::datalink_control_size)
+  , use_ring_(*this, &ShmemInst::use_ring, &ShmemInst::use_ring)
+  , ring_spin_count_(*this, &ShmemInst::ring_spin_count, &ShmemInst::ring_spin_count)
+  , share_payloads_(*this, &ShmemInst::share_payloads, &ShmemInst::share_payloads)
 {
   std::ostringstream pool;
   pool << "OpenDDS-" << ACE_OS::getpid() << '-' << this->name();
@@ -44,6 +47,9 @@ ShmemInst::dump_to_str(DDS::DomainId_t domain) const
   os << TransportInst::dump_to_str(domain);
   os << formatNameForDump("pool_size") << pool_size() << "\n"
      << formatNameForDump("datalink_control_size") << datalink_control_size() << "\n"
+     << formatNameForDump("use_ring") << (use_ring() ? "true" : "false") << "\n"
+     << formatNameForDump("ring_spin_count") << ring_spin_count() << "\n"
+     << formatNameForDump("share_payloads") << (share_payloads() ? "true" : "false") << "\n"
      << formatNameForDump("pool_name") << this->poolname_ << "\n"
      << formatNameForDump("host_name") << this->hostname() << "\n"
      << formatNameForDump("association_resend_period") << association_resend_period().str() << "\n";
@@ -97,6 +103,43 @@ ShmemInst::datalink_control_size() const
   return TheServiceParticipant->config_store()->get_uint32(config_key("DATALINK_CONTROL_SIZE").c_str(), 4 * 1024);
 }
 
+void
+ShmemInst::use_ring(bool ur)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("USE_RING").c_str(), ur);
+}
+
+bool
+ShmemInst::use_ring() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("USE_RING").c_str(), false);
+}
+
+void
+ShmemInst::ring_spin_count(size_t rsc)
+{
+  TheServiceParticipant->config_store()->set_uint32(config_key("RING_SPIN_COUNT").c_str(),
+                                                    static_cast<DDS::UInt32>(rsc));
+}
+
+size_t
+ShmemInst::ring_spin_count() const
+{
+  return TheServiceParticipant->config_store()->get_uint32(config_key("RING_SPIN_COUNT").c_str(), 1000);
+}
+
+void
+ShmemInst::share_payloads(bool sp)
+{
+  TheServiceParticipant->config_store()->set_boolean(config_key("SHARE_PAYLOADS").c_str(), sp);
+}
+
+bool
+ShmemInst::share_payloads() const
+{
+  return TheServiceParticipant->config_store()->get_boolean(config_key("SHARE_PAYLOADS").c_str(), false);
+}
+
 void
 ShmemInst::hostname(const String& h)
 {
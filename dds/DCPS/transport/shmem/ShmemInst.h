@@ -36,6 +36,27 @@ public:
   void datalink_control_size(size_t dcs);
   size_t datalink_control_size() const;
 
+  /// Send samples through a lock-free single-producer/single-consumer ring in
+  /// the control area instead of scanning its slots, and only wake the reading
+  /// transport when it's blocked.  Needs C++11; defaults to false.
+  ConfigValue<ShmemInst, bool> use_ring_;
+  void use_ring(bool ur);
+  bool use_ring() const;
+
+  /// When use_ring_ is set, the number of times the read thread polls its
+  /// links without finding a sample before it blocks on its semaphore.
+  /// Defaults to 1000; 0 blocks as soon as there is nothing to read.
+  ConfigValue<ShmemInst, size_t> ring_spin_count_;
+  void ring_spin_count(size_t rsc);
+  size_t ring_spin_count() const;
+
+  /// Copy a sample into the pool once and share it between the data links to
+  /// all of the reading transports instead of copying it for each of them.
+  /// Defaults to false.
+  ConfigValue<ShmemInst, bool> share_payloads_;
+  void share_payloads(bool sp);
+  bool share_payloads() const;
+
   bool is_reliable() const { return true; }
 
   virtual size_t populate_locator(OpenDDS::DCPS::TransportLocator& trans_info,
@@ -24,33 +24,50 @@ ShmemReceiveStrategy::ShmemReceiveStrategy(ShmemDataLink* link)
   : TransportReceiveStrategy<>(link->config())
   , link_(link)
   , current_data_(0)
+#ifdef OPENDDS_SHMEM_RING
+  , ring_(0)
+#endif
   , partial_recv_remaining_(0)
   , partial_recv_ptr_(0)
 {
 }
 
-void
+bool
 ShmemReceiveStrategy::read()
 {
   if (partial_recv_remaining_) {
     VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::read link %@ "
           "resuming partial recv\n", link_));
     handle_dds_input(ACE_INVALID_HANDLE);
-    return;
+    return true;
   }
 
+  ShmemAllocator* alloc = link_->peer_allocator();
+  void* mem = 0;
+
+#ifdef OPENDDS_SHMEM_RING
+  // The writer uses a ring if it has use_ring set.  Stop looking for one once
+  // its control area has been found.
+  if (!ring_ && !current_data_ && alloc
+      && alloc->find(("Ring-" + link_->local_address()).c_str(), mem) == 0) {
+    ring_ = reinterpret_cast<ShmemRing*>(mem);
+    bound_name_ = "Ring-" + link_->local_address();
+  }
+  if (ring_) {
+    return alloc && read_ring();
+  }
+#endif
+
   if (bound_name_.empty()) {
     bound_name_ = "Write-" + link_->local_address();
   }
 
-  ShmemAllocator* alloc = link_->peer_allocator();
-  void* mem = 0;
   if (alloc == 0 || -1 == alloc->find(bound_name_.c_str(), mem)) {
     VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::read link %@ "
               "peer allocator not found, receive_bytes will close link\n",
               link_), 1);
     handle_dds_input(ACE_INVALID_HANDLE); // will return 0 to the TRecvStrateg.
-    return;
+    return false;
   }
 
   if (!current_data_) {
@@ -62,7 +79,7 @@ ShmemReceiveStrategy::read()
     if (!start) {
       start = current_data_;
     } else if (start == current_data_) {
-      return; // none found => don't call handle_dds_input()
+      return false; // none found => don't call handle_dds_input()
     }
     if (current_data_[1].status_ == ShmemData::EndOfAlloc) {
       current_data_ = reinterpret_cast<ShmemData*>(mem) - 1; // incremented by the for loop
@@ -75,8 +92,33 @@ ShmemReceiveStrategy::read()
   // If we get this far, current_data_ points to the first ShmemData::DataInUse.
   // handle_dds_input() will call our receive_bytes() to get the data.
   handle_dds_input(ACE_INVALID_HANDLE);
+  return true;
 }
 
+#ifdef OPENDDS_SHMEM_RING
+bool
+ShmemReceiveStrategy::read_ring()
+{
+  // Take what the writer has queued, but no more than one ring's worth so the
+  // other links get a turn.
+  bool found = false;
+  for (ACE_UINT32 i = 0; i < ring_->capacity_; ++i) {
+    if (ring_->head_.load(std::memory_order_acquire) == ring_->tail_.load(std::memory_order_relaxed)) {
+      break;
+    }
+    found = true;
+    VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::read_ring link %@ "
+          "reading at ring slot #%u\n",
+          link_, ring_->tail_.load(std::memory_order_relaxed) & (ring_->capacity_ - 1)));
+    handle_dds_input(ACE_INVALID_HANDLE);
+    if (partial_recv_remaining_ || gracefully_disconnected_) {
+      break;
+    }
+  }
+  return found;
+}
+#endif
+
 ssize_t
 ShmemReceiveStrategy::receive_bytes(iovec iov[],
                                     int n,
@@ -89,9 +131,27 @@ ShmemReceiveStrategy::receive_bytes(iovec iov[],
 
   // check that the writer's shared memory is still available
   ShmemAllocator* alloc = link_->peer_allocator();
-  void* mem;
-  if (!alloc || -1 == alloc->find(bound_name_.c_str(), mem) || !current_data_
-      || current_data_->status_ != ShmemData::InUse) {
+  const char* transport_header = 0;
+  const char* payload = 0;
+#ifdef OPENDDS_SHMEM_RING
+  if (ring_) {
+    const ACE_UINT32 tail = ring_->tail_.load(std::memory_order_relaxed);
+    if (alloc && ring_->head_.load(std::memory_order_acquire) != tail) {
+      ShmemRing::Slot& slot = ring_->slot(tail);
+      transport_header = slot.transport_header_;
+      payload = slot.payload_;
+    }
+  } else
+#endif
+  {
+    void* mem;
+    if (alloc && -1 != alloc->find(bound_name_.c_str(), mem) && current_data_
+        && current_data_->status_ == ShmemData::InUse) {
+      transport_header = current_data_->transport_header_;
+      payload = current_data_->payload_;
+    }
+  }
+  if (!transport_header) {
     VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::receive_bytes closing\n"),
              1);
     gracefully_disconnected_ = true; // do not attempt reconnect via relink()
@@ -112,8 +172,8 @@ ShmemReceiveStrategy::receive_bytes(iovec iov[],
     dst_iter = (char*)iov[0].iov_base;
 
   } else {
-    remaining = TransportHeader::get_length(current_data_->transport_header_);
-    const size_t hdr_sz = sizeof(current_data_->transport_header_);
+    remaining = TransportHeader::get_length(transport_header);
+    const size_t hdr_sz = TRANSPORT_HDR_SERIALIZED_SZ;
     // BUFFER_LOW_WATER in the framework ensures a large enough buffer
     if (static_cast<size_t>(iov[0].iov_len) <= hdr_sz) {
       VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemReceiveStrategy::receive_bytes "
@@ -124,11 +184,10 @@ ShmemReceiveStrategy::receive_bytes(iovec iov[],
     }
 
     VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::receive_bytes "
-          "header %@ payload %@ len %B\n", current_data_->transport_header_,
-          (char*)current_data_->payload_, remaining));
-    std::memcpy(iov[0].iov_base, current_data_->transport_header_, hdr_sz);
+          "header %@ payload %@ len %B\n", transport_header, payload, remaining));
+    std::memcpy(iov[0].iov_base, transport_header, hdr_sz);
     total += static_cast<ssize_t>(hdr_sz);
-    src_iter = current_data_->payload_;
+    src_iter = payload;
     if (static_cast<size_t>(iov[0].iov_len) > hdr_sz) {
       dst_iter = (char*)iov[0].iov_base + hdr_sz;
     } else if (n > 1) {
@@ -171,7 +230,16 @@ ShmemReceiveStrategy::receive_bytes(iovec iov[],
     partial_recv_ptr_ = 0;
     VDBG((LM_DEBUG, "(%P|%t) ShmemReceiveStrategy::receive_bytes "
           "receive done\n"));
-    current_data_->status_ = ShmemData::RecvDone;
+#ifdef OPENDDS_SHMEM_RING
+    if (ring_) {
+      // The writer frees the payload once it sees tail_ move past it
+      ring_->tail_.store(ring_->tail_.load(std::memory_order_relaxed) + 1,
+                         std::memory_order_release);
+    } else
+#endif
+    {
+      current_data_->status_ = ShmemData::RecvDone;
+    }
   }
 
   return total;
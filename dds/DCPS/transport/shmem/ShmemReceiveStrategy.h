@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMRECEIVESTRATEGY_H
 
 #include "Shmem_Export.h"
+#include "ShmemAllocator.h"
 
 #include "ace/INET_Addr.h"
 
@@ -21,13 +22,15 @@ namespace DCPS {
 
 class ShmemDataLink;
 struct ShmemData;
+struct ShmemRing;
 
 class OpenDDS_Shmem_Export ShmemReceiveStrategy
   : public TransportReceiveStrategy<> {
 public:
   explicit ShmemReceiveStrategy(ShmemDataLink* link);
 
-  void read();
+  /// Returns true if a sample was read
+  bool read();
 
 protected:
   virtual ssize_t receive_bytes(iovec iov[],
@@ -46,6 +49,10 @@ private:
   ShmemDataLink* link_;
   std::string bound_name_;
   ShmemData* current_data_;
+#ifdef OPENDDS_SHMEM_RING
+  bool read_ring();
+  ShmemRing* ring_;
+#endif
   size_t partial_recv_remaining_;
   const char* partial_recv_ptr_;
   ACE_Thread_Mutex mutex_;
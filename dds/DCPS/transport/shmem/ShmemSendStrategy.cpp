@@ -8,6 +8,7 @@
 #include "ShmemSendStrategy.h"
 #include "ShmemDataLink.h"
 #include "ShmemInst.h"
+#include "ShmemTransport.h"
 
 #include "dds/DCPS/transport/framework/NullSynchStrategy.h"
 
@@ -26,6 +27,11 @@ ShmemSendStrategy::ShmemSendStrategy(ShmemDataLink* link)
   , link_(link)
   , current_data_(0)
   , datalink_control_size_(link->config()->datalink_control_size())
+  , use_ring_(link->config()->use_ring())
+#ifdef OPENDDS_SHMEM_RING
+  , ring_(0)
+  , peer_signal_(0)
+#endif
 {
 #ifdef OPENDDS_SHMEM_UNIX
   memset(&peer_semaphore_, 0, sizeof(peer_semaphore_));
@@ -35,24 +41,35 @@ ShmemSendStrategy::ShmemSendStrategy(ShmemDataLink* link)
 bool
 ShmemSendStrategy::start_i()
 {
-  bound_name_ = "Write-" + link_->peer_address();
-  ShmemAllocator* alloc = link_->local_allocator();
+#ifdef OPENDDS_SHMEM_RING
+  if (use_ring_) {
+    bound_name_ = "Ring-" + link_->peer_address();
+    if (!start_ring()) {
+      return false;
+    }
+  } else
+#endif
+  {
+    bound_name_ = "Write-" + link_->peer_address();
+    ShmemAllocator* alloc = link_->local_allocator();
 
-  const size_t n_elems = datalink_control_size_ / sizeof(ShmemData),
-    extra = datalink_control_size_ % sizeof(ShmemData);
+    const size_t n_elems = datalink_control_size_ / sizeof(ShmemData),
+      extra = datalink_control_size_ % sizeof(ShmemData);
 
-  void* mem = 0;
-  if (alloc == 0 || (mem = alloc->calloc(datalink_control_size_)) == 0) {
-    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
-              "to allocate %B bytes for control\n", link_, datalink_control_size_), 0);
-    return false;
-  }
+    void* mem = 0;
+    if (alloc == 0 || (mem = alloc->calloc(datalink_control_size_)) == 0) {
+      VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
+                "to allocate %B bytes for control\n", link_, datalink_control_size_), 0);
+      return false;
+    }
 
-  ShmemData* data = reinterpret_cast<ShmemData*>(mem);
-  const size_t limit = (extra >= sizeof(int)) ? n_elems : (n_elems - 1);
-  data[limit].status_ = ShmemData::EndOfAlloc;
-  alloc->bind(bound_name_.c_str(), mem);
+    ShmemData* data = reinterpret_cast<ShmemData*>(mem);
+    const size_t limit = (extra >= sizeof(int)) ? n_elems : (n_elems - 1);
+    data[limit].status_ = ShmemData::EndOfAlloc;
+    alloc->bind(bound_name_.c_str(), mem);
+  }
 
+  void* mem = 0;
   ShmemAllocator* peer = link_->peer_allocator();
   peer->find("Semaphore", mem);
   ShmemSharedSemaphore* sem = reinterpret_cast<ShmemSharedSemaphore*>(mem);
@@ -70,9 +87,85 @@ ShmemSendStrategy::start_i()
 #else
   ACE_UNUSED_ARG(sem);
 #endif
+
+#ifdef OPENDDS_SHMEM_RING
+  // Readers that don't publish a ReadSignal get a post for every sample
+  if (use_ring_ && peer->find("ReadSignal", mem) == 0) {
+    peer_signal_ = reinterpret_cast<ShmemReadSignal*>(mem);
+  }
+#endif
+  return true;
+}
+
+#ifdef OPENDDS_SHMEM_RING
+bool
+ShmemSendStrategy::start_ring()
+{
+  ShmemAllocator* alloc = link_->local_allocator();
+  void* mem = 0;
+  if (alloc && alloc->find(bound_name_.c_str(), mem) == 0) {
+    // An earlier link to the same reader left its ring bound, and the reader
+    // may still be reading from it, so keep using it.
+    ring_ = reinterpret_cast<ShmemRing*>(mem);
+    return true;
+  }
+
+  const ACE_UINT32 capacity = ShmemRing::capacity_for(datalink_control_size_);
+  const size_t size = ShmemRing::size_for(capacity);
+  if (alloc == 0 || (mem = alloc->calloc(size)) == 0) {
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
+              "to allocate %B bytes for ring\n", link_, size), 0);
+    return false;
+  }
+
+  ring_ = reinterpret_cast<ShmemRing*>(mem);
+  ring_->capacity_ = capacity;
+  alloc->bind(bound_name_.c_str(), mem);
+  VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
+            "using ring of %u slots\n", link_, capacity), 1);
   return true;
 }
 
+ssize_t
+ShmemSendStrategy::send_ring_i(ShmemTransport& transport, const iovec& header,
+                               char* payload, size_t payload_size)
+{
+  // Free the payloads the reader has finished with
+  const ACE_UINT32 tail = ring_->tail_.load(std::memory_order_acquire);
+  for (; ring_->released_ != tail; ++ring_->released_) {
+    transport.release_payload(ring_->slot(ring_->released_).payload_);
+  }
+
+  const ACE_UINT32 head = ring_->head_.load(std::memory_order_relaxed);
+  if (head - tail >= ring_->capacity_) {
+    transport.release_payload(payload);
+    VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ "
+              "ring is full\n", link_), 0);
+    return -1;
+  }
+
+  ShmemRing::Slot& slot = ring_->slot(head);
+  VDBG((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
+        "writing at ring slot #%u payload %@ len %B\n",
+        link_, head & (ring_->capacity_ - 1), payload, payload_size));
+  std::memcpy(slot.transport_header_, header.iov_base, sizeof(slot.transport_header_));
+  slot.payload_ = payload;
+
+  // The store to head_ and the load of waiting_ are sequentially consistent,
+  // and the reader has a sequentially consistent fence between setting
+  // waiting_ and loading head_ (see ShmemTransport::ReadTask::svc), so either
+  // the reader sees this sample after it sets waiting_, or this sees waiting_
+  // set and posts the semaphore.
+  ring_->head_.store(head + 1, std::memory_order_seq_cst);
+  if (!peer_signal_ || (peer_signal_->waiting_.load(std::memory_order_seq_cst)
+                        && peer_signal_->waiting_.exchange(0, std::memory_order_seq_cst))) {
+    ACE_OS::sema_post(&peer_semaphore_);
+  }
+
+  return static_cast<ssize_t>(payload_size + header.iov_len);
+}
+#endif
+
 ssize_t
 ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
 {
@@ -91,33 +184,30 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     return -1;
   }
 
-  //FUTURE: use the ShmemTransport object to see if we already have the
-  //        same payload data available in the pool (from other DataLinks),
-  //        and if so, add a refcount to the start of the "from_pool" allocation
-
   size_t pool_alloc_size = 0;
   for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
     pool_alloc_size += iov[i].iov_len;
   }
 
-  ShmemAllocator* alloc = link_->local_allocator();
-  void* from_pool = 0;
-  if (alloc == 0 || (from_pool = alloc->malloc(pool_alloc_size)) == 0) {
+  ShmemTransport_rch transport = link_->transport();
+  ShmemAllocator* alloc = transport ? transport->alloc() : 0;
+  char* payload = 0;
+  if (alloc == 0 || (payload = transport->copy_payload(iov, n, pool_alloc_size)) == 0) {
     VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
               "to allocate %B bytes for data\n", link_, pool_alloc_size), 0);
     errno = ENOMEM;
     return -1;
   }
 
-  char* payload = reinterpret_cast<char*>(from_pool);
-  char* iter = payload;
-  for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
-    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
-    iter += iov[i].iov_len;
+#ifdef OPENDDS_SHMEM_RING
+  if (ring_) {
+    return send_ring_i(*transport, iov[0], payload, pool_alloc_size);
   }
+#endif
 
   void* mem = 0;
   if (-1 == alloc->find(bound_name_.c_str(), mem) || mem == 0) {
+    transport->release_payload(payload);
     VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ failed "
               "to find control segment with bound name %C\n", link_, bound_name_.c_str()), 0);
     errno = ENOENT;
@@ -127,10 +217,7 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
   for (ShmemData* it = reinterpret_cast<ShmemData*>(mem);
        it->status_ != ShmemData::EndOfAlloc; ++it) {
     if (it->status_ == ShmemData::RecvDone) {
-      alloc->free(it->payload_);
-      // This will eventually be refcounted so instead of a free(), the previous
-      // statement would decrement the refcount and check for 0 before free().
-      // See the 'FUTURE' comment above.
+      transport->release_payload(it->payload_);
       it->status_ = ShmemData::Free;
       VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemSendStrategy for link %@ "
                 "releasing control block #%d\n", link_,
@@ -147,6 +234,7 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     if (!start) {
       start = current_data_;
     } else if (start == current_data_) {
+      transport->release_payload(payload);
       VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ out of "
                 "space for control\n", link_), 0);
       return -1;
@@ -166,6 +254,7 @@ ShmemSendStrategy::send_bytes_i(const iovec iov[], int n)
     current_data_->payload_ = payload;
     current_data_->status_ = ShmemData::InUse;
   } else {
+    transport->release_payload(payload);
     VDBG_LVL((LM_ERROR, "(%P|%t) ERROR: ShmemSendStrategy for link %@ "
               "failed to find space for control\n", link_), 0);
     return -1;
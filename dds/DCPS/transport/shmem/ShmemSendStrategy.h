@@ -9,6 +9,7 @@
 #define OPENDDS_DCPS_TRANSPORT_SHMEM_SHMEMSENDSTRATEGY_H
 
 #include "Shmem_Export.h"
+#include "ShmemAllocator.h"
 
 #include "dds/DCPS/transport/framework/TransportSendStrategy.h"
 
@@ -23,7 +24,10 @@ namespace DCPS {
 
 class ShmemDataLink;
 class ShmemInst;
+class ShmemTransport;
 struct ShmemData;
+struct ShmemRing;
+struct ShmemReadSignal;
 typedef RcHandle<ShmemInst> ShmemInst_rch;
 
 class OpenDDS_Shmem_Export ShmemSendStrategy
@@ -38,11 +42,23 @@ protected:
   virtual ssize_t send_bytes_i(const iovec iov[], int n);
 
 private:
+#ifdef OPENDDS_SHMEM_RING
+  bool start_ring();
+  ssize_t send_ring_i(ShmemTransport& transport, const iovec& header,
+                      char* payload, size_t payload_size);
+#endif
+
   ShmemDataLink* link_;
   std::string bound_name_;
   ACE_sema_t peer_semaphore_;
   ShmemData* current_data_;
   const size_t datalink_control_size_;
+  const bool use_ring_;
+#ifdef OPENDDS_SHMEM_RING
+  ShmemRing* ring_;
+  /// 0 if the reading transport always needs its semaphore posted
+  ShmemReadSignal* peer_signal_;
+#endif
 };
 
 } // namespace DCPS
@@ -10,6 +10,7 @@
 #include "ShmemReceiveStrategy.h"
 
 #include <dds/DCPS/debug.h>
+#include <dds/DCPS/DataSampleHeader.h>
 #include <dds/DCPS/AssociationData.h>
 #include <dds/DCPS/NetworkResource.h>
 #include <dds/DCPS/transport/framework/TransportExceptions.h>
@@ -28,6 +29,7 @@ namespace DCPS {
 ShmemTransport::ShmemTransport(const ShmemInst_rch& inst,
                                  DDS::DomainId_t domain)
   : TransportImpl(inst, domain)
+  , share_payloads_(false)
 {
   if (!(configure_i(inst) && open())) {
     throw Transport::UnableToCreate();
@@ -199,7 +201,29 @@ ShmemTransport::configure_i(const ShmemInst_rch& config)
                      false);
   }
 
-  read_task_.reset(new ReadTask(this, ace_sema));
+  ShmemReadSignal* read_signal = 0;
+  if (config->use_ring()) {
+#  ifdef OPENDDS_SHMEM_RING
+    mem = alloc_->calloc(sizeof(ShmemReadSignal));
+    if (mem == 0) {
+      if (log_level >= LogLevel::Error) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: ShmemTransport::configure_i: failed to allocate"
+                   " space for read signal in shared memory!\n"));
+      }
+      return false;
+    }
+    read_signal = reinterpret_cast<ShmemReadSignal*>(mem);
+    alloc_->bind("ReadSignal", read_signal);
+#  else
+    if (log_level >= LogLevel::Notice) {
+      ACE_ERROR((LM_NOTICE, "(%P|%t) NOTICE: ShmemTransport::configure_i: "
+                 "use_ring needs C++11, using the control area instead\n"));
+    }
+#  endif
+  }
+
+  share_payloads_ = config->share_payloads();
+  read_task_.reset(new ReadTask(this, ace_sema, read_signal, config->ring_spin_count()));
 
   VDBG_LVL((LM_DEBUG, "(%P|%t) ShmemTransport %@ configured with address %C\n",
             this, config->poolname().c_str()), 1);
@@ -229,6 +253,11 @@ ShmemTransport::shutdown_i()
 
   read_task_.reset();
 
+  {
+    GuardType guard(payloads_lock_);
+    last_payload_ = SharedPayload();
+  }
+
   if (alloc_) {
 #ifndef OPENDDS_SHMEM_UNSUPPORTED
     void* mem = 0;
@@ -298,9 +327,12 @@ ShmemTransport::release_datalink(DataLink* link)
             link), 1);
 }
 
-ShmemTransport::ReadTask::ReadTask(ShmemTransport* outer, ACE_sema_t semaphore)
+ShmemTransport::ReadTask::ReadTask(ShmemTransport* outer, ACE_sema_t semaphore,
+                                   ShmemReadSignal* read_signal, size_t spin_count)
   : outer_(outer)
   , semaphore_(semaphore)
+  , read_signal_(read_signal)
+  , spin_count_(spin_count)
   , stopped_(false)
 {
   activate();
@@ -311,11 +343,48 @@ ShmemTransport::ReadTask::svc()
 {
   ThreadStatusManager::Start s(TheServiceParticipant->get_thread_status_manager(), "ShmemTransport");
 
+#ifdef OPENDDS_SHMEM_RING
+  size_t idle = 0;
+#endif
   while (!stopped_) {
+#ifdef OPENDDS_SHMEM_RING
+    if (read_signal_) {
+      // Writers using rings only post the semaphore when waiting_ is set, so
+      // poll for a while before setting it and blocking.  idle is only reset
+      // by reading something, so a post from a writer that isn't using a ring
+      // doesn't start a new round of polling.
+      if (outer_->read_from_links()) {
+        idle = 0;
+        continue;
+      }
+      if (idle < spin_count_) {
+        ++idle;
+        ACE_OS::thr_yield();
+        continue;
+      }
+      // Check once more after setting waiting_ in case a writer queued a
+      // sample before it could see waiting_ set, see ShmemSendStrategy::send_ring_i.
+      // The rings' head_ is loaded with acquire ordering, which doesn't keep
+      // the load from moving before this store, so the fence is needed.
+      read_signal_->waiting_.store(1, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (outer_->read_from_links()) {
+        read_signal_->waiting_.store(0);
+        continue;
+      }
+    }
+#endif
     ACE_OS::sema_wait(&semaphore_);
     if (stopped_) {
       return 0;
     }
+#ifdef OPENDDS_SHMEM_RING
+    if (read_signal_) {
+      // A writer not using a ring posts without clearing waiting_
+      read_signal_->waiting_.store(0);
+      continue;
+    }
+#endif
     outer_->read_from_links();
   }
   return 0;
@@ -342,22 +411,26 @@ ShmemTransport::ReadTask::signal_semaphore()
   ACE_OS::sema_post(&semaphore_);
 }
 
-void
+bool
 ShmemTransport::read_from_links()
 {
-  std::vector<ShmemDataLink_rch> dl_copies;
   {
     GuardType guard(links_lock_);
     typedef ShmemDataLinkMap::iterator iter_t;
     for (iter_t it = links_.begin(); it != links_.end(); ++it) {
-      dl_copies.push_back(it->second);
+      read_links_.push_back(it->second);
     }
   }
 
+  bool found = false;
   typedef std::vector<ShmemDataLink_rch>::iterator dl_iter_t;
-  for (dl_iter_t dl_it = dl_copies.begin(); !is_shut_down() && dl_it != dl_copies.end(); ++dl_it) {
-    dl_it->in()->read();
+  for (dl_iter_t dl_it = read_links_.begin(); !is_shut_down() && dl_it != read_links_.end(); ++dl_it) {
+    if (dl_it->in()->read()) {
+      found = true;
+    }
   }
+  read_links_.clear();
+  return found;
 }
 
 void
@@ -369,6 +442,107 @@ ShmemTransport::signal_semaphore()
   read_task_->signal_semaphore();
 }
 
+char*
+ShmemTransport::copy_payload(const iovec iov[], int n, size_t size)
+{
+  if (!alloc_) {
+    return 0;
+  }
+
+  if (!share_payloads_) {
+    char* const payload = static_cast<char*>(alloc_->malloc(size));
+    if (payload) {
+      char* iter = payload;
+      for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
+        std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
+        iter += iov[i].iov_len;
+      }
+    }
+    return payload;
+  }
+
+  // A packet is only shared when it's a single complete sample without any
+  // content filtering information, since that's different for each link.
+  // iov[1] is then the DataSampleHeader and the data that follows it never
+  // changes for a given writer and sequence number.
+  DataSampleHeader header;
+  bool shareable = false;
+  if (n > 1) {
+    ACE_Message_Block mb(static_cast<const char*>(iov[1].iov_base), iov[1].iov_len);
+    mb.wr_ptr(iov[1].iov_len);
+    if (!DataSampleHeader::partial(mb)) {
+      header = mb;
+      shareable = header.message_id_ == SAMPLE_DATA && !header.more_fragments_
+        && !header.content_filter_
+        && header.get_serialized_size() == static_cast<size_t>(iov[1].iov_len)
+        && size == iov[1].iov_len + header.message_length_;
+    }
+  }
+
+  if (shareable) {
+    GuardType guard(payloads_lock_);
+    if (last_payload_.payload_ && last_payload_.size_ == size
+        && last_payload_.sequence_ == header.sequence_
+        && last_payload_.publication_id_ == header.publication_id_
+        && std::memcmp(last_payload_.payload_, iov[1].iov_base, iov[1].iov_len) == 0) {
+      ++(reinterpret_cast<ShmemPayloadHeader*>(last_payload_.payload_) - 1)->refcount_;
+      VDBG((LM_DEBUG, "(%P|%t) ShmemTransport::copy_payload "
+            "sharing payload %@ len %B\n", last_payload_.payload_, size));
+      return last_payload_.payload_;
+    }
+  }
+
+  void* const mem = alloc_->malloc(sizeof(ShmemPayloadHeader) + size);
+  if (!mem) {
+    return 0;
+  }
+  ShmemPayloadHeader* const payload_header = static_cast<ShmemPayloadHeader*>(mem);
+  payload_header->refcount_ = 1;
+  payload_header->reserved_ = 0;
+  char* const payload = reinterpret_cast<char*>(payload_header + 1);
+  char* iter = payload;
+  for (int i = 1 /* skip TransportHeader in [0] */; i < n; ++i) {
+    std::memcpy(iter, iov[i].iov_base, iov[i].iov_len);
+    iter += iov[i].iov_len;
+  }
+
+  if (shareable) {
+    GuardType guard(payloads_lock_);
+    if (last_payload_.payload_) {
+      release_payload_i(last_payload_.payload_);
+    }
+    ++payload_header->refcount_; // for last_payload_
+    last_payload_.publication_id_ = header.publication_id_;
+    last_payload_.sequence_ = header.sequence_;
+    last_payload_.payload_ = payload;
+    last_payload_.size_ = size;
+  }
+  return payload;
+}
+
+void
+ShmemTransport::release_payload(char* payload)
+{
+  if (!alloc_) {
+    return;
+  }
+  if (!share_payloads_) {
+    alloc_->free(payload);
+    return;
+  }
+  GuardType guard(payloads_lock_);
+  release_payload_i(payload);
+}
+
+void
+ShmemTransport::release_payload_i(char* payload)
+{
+  ShmemPayloadHeader* const payload_header = reinterpret_cast<ShmemPayloadHeader*>(payload) - 1;
+  if (--payload_header->refcount_ == 0) {
+    alloc_->free(payload_header);
+  }
+}
+
 std::string
 ShmemTransport::address()
 {
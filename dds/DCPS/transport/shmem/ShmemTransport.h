@@ -16,6 +16,7 @@
 #include <dds/DCPS/AtomicBool.h>
 
 #include <string>
+#include <vector>
 
 OPENDDS_BEGIN_VERSIONED_NAMESPACE_DECL
 
@@ -23,6 +24,7 @@ namespace OpenDDS {
 namespace DCPS {
 
 class ShmemInst;
+struct ShmemReadSignal;
 
 class OpenDDS_Shmem_Export ShmemTransport : public TransportImpl {
 public:
@@ -34,6 +36,12 @@ public:
   std::string address();
   void signal_semaphore();
 
+  /// Copy the payload of a packet (iov[1] to iov[n - 1]) into the pool.  When
+  /// payloads are shared, this returns the existing copy if the packet is the
+  /// same sample as the last one copied.  Returns 0 if the pool is full.
+  char* copy_payload(const iovec iov[], int n, size_t size);
+  void release_payload(char* payload);
+
   ShmemInst_rch config() const;
 
 protected:
@@ -68,7 +76,7 @@ private:
 
   std::pair<std::string, std::string> blob_to_key(const TransportBLOB& blob);
 
-  void read_from_links(); // callback from ReadTask
+  bool read_from_links(); // callback from ReadTask, true if a sample was read
 
   typedef ACE_Thread_Mutex LockType;
   typedef ACE_Guard<LockType> GuardType;
@@ -80,11 +88,32 @@ private:
   typedef OPENDDS_MAP(std::string, ShmemDataLink_rch) ShmemDataLinkMap;
   ShmemDataLinkMap links_;
 
+  /// Only used by read_from_links, kept to avoid allocating on every poll
+  std::vector<ShmemDataLink_rch> read_links_;
+
   unique_ptr<ShmemAllocator> alloc_;
 
+  /// ShmemInst::share_payloads_ when configured
+  bool share_payloads_;
+
+  /// The most recently copied sample, which is what the next data link is
+  /// most likely to be sending when a writer has more than one reading
+  /// transport.  Protected by payloads_lock_ along with the reference counts.
+  struct SharedPayload {
+    SharedPayload() : payload_(0), size_(0) {}
+    GUID_t publication_id_;
+    SequenceNumber sequence_;
+    char* payload_;
+    size_t size_;
+  };
+  LockType payloads_lock_;
+  SharedPayload last_payload_;
+  void release_payload_i(char* payload);
+
   class ReadTask : public ACE_Task_Base {
   public:
-    ReadTask(ShmemTransport* outer, ACE_sema_t semaphore);
+    ReadTask(ShmemTransport* outer, ACE_sema_t semaphore,
+             ShmemReadSignal* read_signal, size_t spin_count);
     int svc();
     void stop();
     void signal_semaphore();
@@ -92,6 +121,9 @@ private:
   private:
     ShmemTransport* outer_;
     ACE_sema_t semaphore_;
+    /// Set when polling rings, see ShmemInst::use_ring_
+    ShmemReadSignal* read_signal_;
+    const size_t spin_count_;
     AtomicBool stopped_;
   };
   unique_ptr<ReadTask> read_task_;
@@ -11,17 +11,52 @@
 
 #include "utl_identifier.h"
 
+#include <sstream>
 #include <string>
 using std::string;
 
+namespace {
+  /// Find the type of a key named by a DCPS_DATA_KEY pragma, which may
+  /// refer to a member of a nested struct ("a.b.c").
+  AST_Type* pragma_key_type(AST_Structure* node, const string& path)
+  {
+    string::size_type start = 0;
+    while (node) {
+      const string::size_type dot = path.find('.', start);
+      const string member = path.substr(start, dot == string::npos ? dot : dot - start);
+      AST_Type* type = 0;
+      const Fields fields(node);
+      for (Fields::Iterator i = fields.begin(); i != fields.end(); ++i) {
+        if (member == (*i)->local_name()->get_string()) {
+          type = AstTypeClassification::resolveActualType((*i)->field_type());
+          break;
+        }
+      }
+      if (!type || dot == string::npos) {
+        return type;
+      }
+      node = dynamic_cast<AST_Structure*>(type);
+      start = dot + 1;
+    }
+    return 0;
+  }
+}
+
 struct KeyLessThanWrapper {
   size_t n_;
   const string cxx_name_;
+  const string local_name_;
+  const bool use_cxx11_;
+  std::ostringstream key_hash_;
 
   explicit KeyLessThanWrapper(UTL_ScopedName* name)
     : n_(0)
     , cxx_name_(scoped(name))
+    , local_name_(name->last_component()->get_string())
+    , use_cxx11_(be_global->language_mapping() == BE_GlobalData::LANGMAP_CXX11)
   {
+    be_global->add_include("dds/DCPS/Hash.h");
+
     be_global->header_ << be_global->versioning_begin() << "\n";
 
     for (UTL_ScopedName* sn = name; sn && sn->tail();
@@ -36,7 +71,7 @@ struct KeyLessThanWrapper {
     be_global->header_ <<
       "/// This structure supports use of std::map with one or more keys.\n"
       "struct " << be_global->export_macro() << ' ' <<
-      name->last_component()->get_string() << "_OpenDDS_KeyLessThan {\n";
+      local_name_ << "_OpenDDS_KeyLessThan {\n";
   }
 
   void
@@ -65,10 +100,35 @@ struct KeyLessThanWrapper {
       "    if (v2." << member << " < v1." << member << ") return false;\n";
   }
 
+  /// Add member to the KeyHash, which has to agree with the KeyLessThan:
+  /// strings are hashed by content, everything else by value.
+  void
+  key_hash(const string& member, AST_Type* type)
+  {
+    if (type && (AstTypeClassification::classify(type) & AstTypeClassification::CL_STRING)) {
+      key_hash_ <<
+        "    OpenDDS::DCPS::hash_key_string(seed, v." << member <<
+        (use_cxx11_ ? ".c_str()" : ".in()") << ");\n";
+    } else {
+      key_hash_ <<
+        "    OpenDDS::DCPS::hash_key_value(seed, v." << member << ");\n";
+    }
+  }
+
   ~KeyLessThanWrapper()
   {
     be_global->header_ <<
       "    return false;\n"
+      "  }\n};\n\n"
+      "/// This structure supports use of hash tables with one or more keys.\n"
+      "struct " << be_global->export_macro() << ' ' <<
+      local_name_ << "_OpenDDS_KeyHash {\n"
+      "  size_t operator()(const " << cxx_name_ << "&" <<
+      (key_hash_.str().empty() ? "" : " v") << ") const\n"
+      "  {\n"
+      "    size_t seed = 0;\n" <<
+      key_hash_.str() <<
+      "    return seed;\n"
       "  }\n};\n";
 
     for (size_t i = 0; i < n_; ++i) {
@@ -114,19 +174,25 @@ bool keys_generator::gen_struct(AST_Structure* node, UTL_ScopedName* name,
           if (use_cxx11) {
             fname = insert_cxx11_accessor_parens(fname, false);
           }
+          AST_Type* type = 0;
           if (i.root_type() == TopicKeys::UnionType) {
             fname += "._d()";
+          } else {
+            type = AstTypeClassification::resolveActualType(i.get_ast_type());
           }
           wrapper.key_compare(fname);
+          wrapper.key_hash(fname, type);
         }
       } else if (info) {
         IDL_GlobalData::DCPS_Data_Type_Info_Iter iter(info->key_list_);
         for (ACE_TString* kp = 0; iter.next(kp) != 0; iter.advance()) {
           string fname = ACE_TEXT_ALWAYS_CHAR(kp->c_str());
+          AST_Type* const type = pragma_key_type(node, fname);
           if (use_cxx11) {
             fname = insert_cxx11_accessor_parens(fname, false);
           }
           wrapper.key_compare(fname);
+          wrapper.key_hash(fname, type);
         }
       }
     } else {
@@ -146,6 +212,7 @@ bool keys_generator::gen_union(
     if (be_global->union_discriminator_is_key(node)) {
       wrapper.has_keys_signature();
       wrapper.key_compare("_d()");
+      wrapper.key_hash("_d()", 0);
     } else {
       wrapper.has_no_keys_signature();
     }
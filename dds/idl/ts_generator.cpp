@@ -224,6 +224,7 @@ bool ts_generator::generate_ts(AST_Type* node, UTL_ScopedName* name)
     "  typedef " << full_name_from_tsch << "DataWriter DataWriterType;\n"
     "  typedef " << full_name_from_tsch << "DataReader DataReaderType;\n"
     "  typedef " << full_cxx_name << "_OpenDDS_KeyLessThan LessThanType;\n"
+    "  typedef " << full_cxx_name << "_OpenDDS_KeyHash HashType;\n"
     "  typedef OpenDDS::DCPS::KeyOnly<const " << full_cxx_name << "> KeyOnlyType;\n"
     "  typedef " << xtag << " XtagType;\n"
     "\n"
@@ -0,0 +1,71 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/DisjointSequence.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Get_Opt.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+
+using namespace OpenDDS::DCPS;
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int samples = 1000000;
+  int loss = 97;
+  int repair_delay = 500;
+  int heartbeat = 64;
+  ACE_Get_Opt opts(argc, argv, ACE_TEXT("n:l:r:h:"));
+  int c;
+  while ((c = opts()) != -1) {
+    switch (c) {
+    case 'n':
+      samples = ACE_OS::atoi(opts.opt_arg());
+      break;
+    case 'l':
+      loss = ACE_OS::atoi(opts.opt_arg());
+      break;
+    case 'r':
+      repair_delay = ACE_OS::atoi(opts.opt_arg());
+      break;
+    case 'h':
+      heartbeat = ACE_OS::atoi(opts.opt_arg());
+      break;
+    default:
+      ACE_ERROR_RETURN((LM_ERROR, "usage: %s [-n samples] [-l loss] [-r repair_delay] [-h heartbeat]\n",
+                        argv[0]), 1);
+    }
+  }
+  if (loss < 2 || heartbeat < 1) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: loss has to be at least 2 and heartbeat at least 1\n"), 1);
+  }
+
+  DisjointSequence sequence;
+  ACE_CDR::Long bitmap[8];
+  ACE_CDR::ULong num_bits = 0, cumulative_bits_added = 0;
+  size_t missing_count = 0;
+
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (int i = 1; i <= samples; ++i) {
+    if (i % loss) {
+      sequence.insert(i);
+    }
+    if (i > repair_delay && (i - repair_delay) % loss == 0) {
+      sequence.insert(i - repair_delay);
+    }
+    if (i % heartbeat == 0) {
+      missing_count += sequence.missing_sequence_ranges().size();
+      sequence.to_bitmap(bitmap, 8, num_bits, cumulative_bits_added, true);
+      sequence.cumulative_ack();
+    }
+  }
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+
+  ACE_DEBUG((LM_INFO, "%d samples, 1 in %d lost and repaired %d later, "
+             "%B missing ranges reported every %d samples: %C s\n",
+             samples, loss, repair_delay, missing_count, heartbeat, elapsed.sec_str(6).c_str()));
+  return 0;
+}
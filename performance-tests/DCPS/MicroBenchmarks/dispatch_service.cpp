@@ -0,0 +1,76 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/DispatchService.h>
+#include <dds/DCPS/TimeTypes.h>
+
+#include <ace/Get_Opt.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+struct Timer {
+  void operator()() {}
+};
+
+/// Cancel and reschedule timers the way heartbeats and deadlines do while
+/// many others are pending.
+void measure(bool timer_wheel, long pending, long rounds)
+{
+  Timer timer;
+  DispatchService dispatcher(1, timer_wheel);
+
+  const MonotonicTimePoint now = MonotonicTimePoint::now();
+  OPENDDS_VECTOR(long) ids;
+  ids.reserve(pending);
+  for (long i = 0; i < pending; ++i) {
+    ids.push_back(dispatcher.schedule(timer, now + TimeDuration(3600 + i % 3600, i % 1000)));
+  }
+
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  for (long i = 0; i < rounds; ++i) {
+    const size_t idx = static_cast<size_t>((i * 7919) % pending);
+    dispatcher.cancel(ids[idx]);
+    ids[idx] = dispatcher.schedule(timer, now + TimeDuration(3600 + i % 1800));
+  }
+  const TimeDuration elapsed = MonotonicTimePoint::now() - start;
+
+  ACE_DEBUG((LM_INFO, "%-16C %10d %10d %12C\n", timer_wheel ? "timer wheel" : "time-ordered map",
+             pending, rounds, elapsed.sec_str(6).c_str()));
+  dispatcher.shutdown(true);
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  long pending = 1000000;
+  long rounds = 100000;
+  ACE_Get_Opt opts(argc, argv, ACE_TEXT("p:r:"));
+  int c;
+  while ((c = opts()) != -1) {
+    switch (c) {
+    case 'p':
+      pending = ACE_OS::atoi(opts.opt_arg());
+      break;
+    case 'r':
+      rounds = ACE_OS::atoi(opts.opt_arg());
+      break;
+    default:
+      ACE_ERROR_RETURN((LM_ERROR, "usage: %s [-p pending] [-r rounds]\n", argv[0]), 1);
+    }
+  }
+  if (pending < 1) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: there has to be at least 1 pending timer\n"), 1);
+  }
+
+  ACE_DEBUG((LM_INFO, "%-16C %10C %10C %12C\n", "timers", "pending", "rounds", "seconds"));
+  measure(false, pending, rounds);
+  measure(true, pending, rounds);
+  return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include "WideStructTypeSupportImpl.h"
+
+#include <dds/DCPS/TimeTypes.h>
+#include <dds/DCPS/XTypes/TypeLookupService.h>
+#include <dds/DCPS/XTypes/DynamicDataImpl.h>
+#include <dds/DCPS/XTypes/DynamicDataXcdrReadImpl.h>
+
+#include <ace/Get_Opt.h>
+#include <ace/Log_Msg.h>
+#include <ace/OS_NS_stdlib.h>
+
+using namespace OpenDDS;
+
+namespace {
+
+/// Read every member of a serialized wide struct with a new
+/// DynamicDataXcdrReadImpl per member and with one per sample.
+template<typename XTag>
+bool measure(const char* name, const DCPS::Encoding& encoding, int samples)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<XTag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<XTag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  if (it == type_map.end()) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: %C: type is not in its type map\n", name), false);
+  }
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  if (!dt) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: %C: complete_to_dynamic failed\n", name), false);
+  }
+
+  const ACE_CDR::ULong count = dt->get_member_count();
+  XTypes::DynamicDataImpl sample(dt);
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    const DDS::MemberId id = sample.get_member_id_at_index(i);
+    if (i % 2 == 0) {
+      sample.set_string_value(id, DCPS::String(i, 'x').c_str());
+    } else {
+      sample.set_int32_value(id, static_cast<ACE_CDR::Long>(i));
+    }
+  }
+  size_t size = 0;
+  DCPS::serialized_size(encoding, size, &sample);
+  ACE_Message_Block msg(size);
+  DCPS::Serializer ser(&msg, encoding);
+  if (!(ser << &sample)) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: %C: serialization failed\n", name), false);
+  }
+
+  // Members are read last to first so that the object that is reused has to
+  // go back to positions it has already found.
+  bool ok = true;
+  const DCPS::MonotonicTimePoint start = DCPS::MonotonicTimePoint::now();
+  for (int s = 0; s < samples; ++s) {
+    for (ACE_CDR::ULong i = count; i-- > 0;) {
+      XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+      ACE_CDR::Long value = 0;
+      ok &= i % 2 == 0 || data.get_int32_value(value, i) == DDS::RETCODE_OK;
+    }
+  }
+  const DCPS::MonotonicTimePoint middle = DCPS::MonotonicTimePoint::now();
+  for (int s = 0; s < samples; ++s) {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+    for (ACE_CDR::ULong i = count; i-- > 0;) {
+      ACE_CDR::Long value = 0;
+      ok &= i % 2 == 0 || data.get_int32_value(value, i) == DDS::RETCODE_OK;
+    }
+  }
+  const DCPS::MonotonicTimePoint end = DCPS::MonotonicTimePoint::now();
+  if (!ok) {
+    ACE_ERROR_RETURN((LM_ERROR, "ERROR: %C: get_int32_value failed\n", name), false);
+  }
+
+  ACE_DEBUG((LM_INFO, "%-12C %8u %10d %12C %12C\n", name, count, samples,
+             (middle - start).sec_str(6).c_str(), (end - middle).sec_str(6).c_str()));
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int samples = 10000;
+  ACE_Get_Opt opts(argc, argv, ACE_TEXT("n:"));
+  int c;
+  while ((c = opts()) != -1) {
+    switch (c) {
+    case 'n':
+      samples = ACE_OS::atoi(opts.opt_arg());
+      break;
+    default:
+      ACE_ERROR_RETURN((LM_ERROR, "usage: %s [-n samples]\n", argv[0]), 1);
+    }
+  }
+
+  const DCPS::Encoding xcdr1(DCPS::Encoding::KIND_XCDR1);
+  const DCPS::Encoding xcdr2(DCPS::Encoding::KIND_XCDR2);
+  ACE_DEBUG((LM_INFO, "%-12C %8C %10C %12C %12C\n",
+             "struct", "members", "samples", "per member", "per sample"));
+  const bool ok = measure<DCPS::FinalWideStruct_xtag>("final XCDR1", xcdr1, samples)
+    && measure<DCPS::FinalWideStruct_xtag>("final", xcdr2, samples)
+    && measure<DCPS::MutableWideStruct_xtag>("mutable", xcdr2, samples);
+  return ok ? 0 : 1;
+}
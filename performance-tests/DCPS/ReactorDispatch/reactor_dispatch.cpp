@@ -0,0 +1,207 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/ReactorTask.h>
+#include <dds/DCPS/Service_Participant.h>
+
+#include <ace/ACE.h>
+#include <ace/Condition_Thread_Mutex.h>
+#include <ace/Get_Opt.h>
+#include <ace/High_Res_Timer.h>
+#include <ace/INET_Addr.h>
+#include <ace/OS_NS_stdlib.h>
+#include <ace/Reactor.h>
+#include <ace/SOCK_Dgram.h>
+#include <ace/Thread_Mutex.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+
+/// Handed from the reactor thread to the main thread after each datagram.
+class Latency {
+public:
+  Latency()
+    : condition_(mutex_)
+    , done_(false)
+    , latency_(0)
+  {}
+
+  void set(ACE_hrtime_t latency)
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    latency_ = latency;
+    done_ = true;
+    condition_.signal();
+  }
+
+  ACE_hrtime_t wait()
+  {
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    while (!done_) {
+      condition_.wait();
+    }
+    done_ = false;
+    return latency_;
+  }
+
+private:
+  ACE_Thread_Mutex mutex_;
+  ACE_Condition_Thread_Mutex condition_;
+  bool done_;
+  ACE_hrtime_t latency_;
+};
+
+class Receiver : public ACE_Event_Handler {
+public:
+  explicit Receiver(Latency& latency)
+    : latency_(latency)
+  {}
+
+  bool open()
+  {
+    return socket_.open(ACE_INET_Addr(static_cast<u_short>(0), "127.0.0.1")) == 0
+      && socket_.get_local_addr(address_) == 0;
+  }
+
+  void close() { socket_.close(); }
+
+  const ACE_INET_Addr& address() const { return address_; }
+
+  ACE_HANDLE get_handle() const { return socket_.get_handle(); }
+
+  int handle_input(ACE_HANDLE)
+  {
+    ACE_hrtime_t sent;
+    ACE_INET_Addr from;
+    if (socket_.recv(&sent, sizeof sent, from) == static_cast<ssize_t>(sizeof sent)) {
+      latency_.set(ACE_OS::gethrtime() - sent);
+    }
+    return 0;
+  }
+
+private:
+  Latency& latency_;
+  ACE_SOCK_Dgram socket_;
+  ACE_INET_Addr address_;
+};
+
+double to_usec(ACE_hrtime_t t)
+{
+  ACE_Time_Value tv;
+  ACE_High_Res_Timer::hrtime_to_tv(tv, t);
+  return tv.sec() * 1e6 + tv.usec();
+}
+
+/// Returns false if the reactor doesn't take this many sockets.
+bool measure(ReactorTask::ReactorType type, size_t sockets, size_t iterations)
+{
+  const ReactorTask_rch task = make_rch<ReactorTask>();
+  task->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), "reactor_dispatch",
+                          ReactorTask::make_reactor(type));
+  ACE_Reactor* const reactor = task->get_reactor();
+
+  Latency latency;
+  std::vector<Receiver*> receivers;
+  bool ok = true;
+  for (size_t i = 0; ok && i < sockets; ++i) {
+    Receiver* const receiver = new Receiver(latency);
+    receivers.push_back(receiver);
+    ok = receiver->open() && reactor->register_handler(receiver, ACE_Event_Handler::READ_MASK) == 0;
+  }
+
+  ACE_SOCK_Dgram sender;
+  ok = ok && sender.open(ACE_INET_Addr(static_cast<u_short>(0), "127.0.0.1")) == 0;
+
+  std::vector<ACE_hrtime_t> results;
+  if (ok) {
+    const size_t warmup = iterations / 10;
+    results.reserve(iterations);
+    for (size_t i = 0; i < warmup + iterations; ++i) {
+      // Spread the traffic over the sockets.
+      const Receiver& receiver = *receivers[(i * 7919) % sockets];
+      const ACE_hrtime_t now = ACE_OS::gethrtime();
+      if (sender.send(&now, sizeof now, receiver.address()) != static_cast<ssize_t>(sizeof now)) {
+        ok = false;
+        break;
+      }
+      const ACE_hrtime_t result = latency.wait();
+      if (i >= warmup) {
+        results.push_back(result);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < receivers.size(); ++i) {
+    reactor->remove_handler(receivers[i], ACE_Event_Handler::READ_MASK | ACE_Event_Handler::DONT_CALL);
+  }
+  task->stop();
+  for (size_t i = 0; i < receivers.size(); ++i) {
+    receivers[i]->close();
+    delete receivers[i];
+  }
+  sender.close();
+
+  if (!ok || results.empty()) {
+    return false;
+  }
+
+  std::sort(results.begin(), results.end());
+  double total = 0;
+  for (size_t i = 0; i < results.size(); ++i) {
+    total += to_usec(results[i]);
+  }
+  ACE_DEBUG((LM_INFO, "%-8C %8B %10.1f %10.1f %10.1f\n",
+             type == ReactorTask::REACTOR_EPOLL ? "Epoll" : "Select", sockets,
+             to_usec(results[results.size() / 2]),
+             total / results.size(),
+             to_usec(results[results.size() * 99 / 100])));
+  return true;
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+
+  size_t max_sockets = 4096;
+  size_t iterations = 2000;
+  ACE_Get_Opt opts(argc, argv, ACE_TEXT("s:i:"));
+  int c;
+  while ((c = opts()) != -1) {
+    switch (c) {
+    case 's':
+      max_sockets = static_cast<size_t>(ACE_OS::atoi(opts.opt_arg()));
+      break;
+    case 'i':
+      iterations = static_cast<size_t>(ACE_OS::atoi(opts.opt_arg()));
+      break;
+    default:
+      ACE_ERROR_RETURN((LM_ERROR, "usage: %s [-s max_sockets] [-i iterations]\n", argv[0]), 1);
+    }
+  }
+
+  // Raise the open file limit as far as it goes.
+  ACE::set_handle_limit(-1, 1);
+
+  ACE_DEBUG((LM_INFO, "%-8C %8C %10C %10C %10C\n", "reactor", "sockets", "median_us", "mean_us", "p99_us"));
+  const ReactorTask::ReactorType types[] = { ReactorTask::REACTOR_SELECT, ReactorTask::REACTOR_EPOLL };
+  for (size_t t = 0; t < sizeof types / sizeof types[0]; ++t) {
+    for (size_t sockets = 1; sockets <= max_sockets; sockets *= 4) {
+      if (!measure(types[t], sockets, iterations)) {
+        ACE_DEBUG((LM_INFO, "%-8C %8B %10C\n",
+                   types[t] == ReactorTask::REACTOR_EPOLL ? "Epoll" : "Select", sockets, "n/a"));
+        break;
+      }
+    }
+  }
+
+  TheServiceParticipant->shutdown();
+  return 0;
+}
@@ -4,11 +4,13 @@
 #include "FilterStructTypeSupportImpl.h"
 #include "FilterStructDynamicTypeSupport.h"
 
+#include "dds/DCPS/ContentFilterIndex.h"
 #include "dds/DCPS/Definitions.h"
 #include "dds/DCPS/EncapsulationHeader.h"
 #include "dds/DCPS/FilterExpressionGrammar.h"
 #include "dds/DCPS/yard/yard_parser.hpp"
 #include "dds/DCPS/FilterEvaluator.h"
+#include "dds/DCPS/Sample.h"
 
 #include "dds/DCPS/XTypes/DynamicDataFactory.h"
 #include "dds/DCPS/XTypes/DynamicSample.h"
@@ -20,6 +22,8 @@
 #include <cstring>
 #include <cstdio>
 #include <iostream>
+#include <set>
+#include <vector>
 
 DDS::DynamicData_var copy(const TBTD& sample, DDS::DynamicType* type)
 {
@@ -140,7 +144,10 @@ bool testEval() {
                                          "durability_service.history_depth > %0",
                                          "durability_service.service_cleanup_delay.sec = 0 AND durability_service.service_cleanup_delay.nanosec >= 10",
                                          "durability_service.service_cleanup_delay.sec < durability_service.service_cleanup_delay.nanosec",
-                                         "MOD(durability_service.history_depth,3) = 0"
+                                         "MOD(durability_service.history_depth,3) = 0",
+                                         "NOT name = 'Bob' AND (durability_service.history_depth = 15 OR name = 'Bob')",
+                                         "durability_service.history_depth BETWEEN 10 AND 20 AND durability_service.history_depth <> 14",
+                                         "durability_service.history_depth NOT BETWEEN 16 AND 20 OR name = 'Bob'"
     };
 
     static const char* filters_fail[] = {"name LIKE 'ZZ%'",
@@ -148,7 +155,10 @@ bool testEval() {
                                          "durability_service.history_depth < %0",
                                          "durability_service.service_cleanup_delay.sec = 0 AND durability_service.service_cleanup_delay.nanosec BETWEEN 3 AND 5",
                                          "durability_service.service_cleanup_delay.sec = durability_service.service_cleanup_delay.nanosec",
-                                         "MOD(durability_service.history_depth,4) = 0"};
+                                         "MOD(durability_service.history_depth,4) = 0",
+                                         "name = 'Adam' AND NOT durability_service.history_depth = 15",
+                                         "name = 'Bob' OR durability_service.history_depth BETWEEN 16 AND 20",
+                                         "durability_service.history_depth = 'fifteen'"};
 
     std::cout << std::boolalpha;
     TBTDTypeSupportImpl tsStat;
@@ -163,6 +173,91 @@ bool testEval() {
 
 }
 
+typedef std::set<OpenDDS::DCPS::GUID_t, OpenDDS::DCPS::GUID_tKeyLessThan> GuidSet;
+
+GuidSet toSet(const OpenDDS::DCPS::GUIDSeq& seq)
+{
+  GuidSet set;
+  for (CORBA::ULong i = 0; i < seq.length(); ++i) {
+    set.insert(seq[i]);
+  }
+  return set;
+}
+
+struct FilterParams {
+  const char* filter;
+  const char* params[4];
+};
+
+bool testIndex()
+{
+  using namespace OpenDDS::DCPS;
+
+  TBTD sample;
+  sample.name = "Adam";
+  sample.durability_service.history_depth = 15;
+
+  static const FilterParams filters[] = {
+    {"durability_service.history_depth = %0", {"14", "15", "015", "16"}},
+    {"%0 < durability_service.history_depth", {"14", "15", "015", "16"}},
+    {"durability_service.history_depth >= %0", {"14", "15", "015", "16"}},
+    {"name <> %0", {"Adam", "Bob", "Adam", "Bob"}},
+    {"durability_service.history_depth > %0 AND name = %1", {"14", "15", "015", "16"}}
+  };
+
+  ContentFilterIndex index;
+  std::vector<GUID_t> readers;
+  GuidSet expected;
+  GUID_t reader = GUID_UNKNOWN;
+  for (size_t f = 0; f < sizeof filters / sizeof filters[0]; ++f) {
+    const RcHandle<FilterEvaluator> eval = make_rch<FilterEvaluator>(filters[f].filter, false);
+    for (size_t p = 0; p < 4; ++p) {
+      DDS::StringSeq params;
+      params.length(2);
+      params[0] = filters[f].params[p];
+      params[1] = "Adam";
+      const bool pass = eval->eval(sample, params);
+      // Two readers for each so that they share a group
+      for (int i = 0; i < 2; ++i) {
+        ++reader.entityId.entityKey[2];
+        index.insert(reader, eval, params);
+        readers.push_back(reader);
+        if (!pass) {
+          expected.insert(reader);
+        }
+      }
+    }
+  }
+
+  static const Encoding enc_xcdr2(Encoding::KIND_XCDR2);
+  TBTDTypeSupportImpl ts;
+  bool ok = true;
+  for (int round = 0; round < 2; ++round) {
+    const Sample_T<TBTD> typed(sample);
+    GUIDSeq excluded;
+    index.filter_out(typed, excluded);
+    if (excluded.length() != expected.size() || toSet(excluded) != expected) {
+      std::cout << "ContentFilterIndex: wrong readers filtered out of sample" << std::endl;
+      ok = false;
+    }
+
+    Message_Block_Ptr serialized(serialize(enc_xcdr2, sample));
+    GUIDSeq excluded_serialized;
+    index.filter_out(serialized.get(), enc_xcdr2, ts, excluded_serialized);
+    if (toSet(excluded_serialized) != expected) {
+      std::cout << "ContentFilterIndex: wrong readers filtered out of serialized sample" << std::endl;
+      ok = false;
+    }
+
+    // Check again without every other reader
+    for (size_t i = static_cast<size_t>(round); i < readers.size(); i += 2) {
+      index.remove(readers[i]);
+      expected.erase(readers[i]);
+    }
+  }
+  return ok;
+}
+
 // parsing test helpers
 namespace yard_test {
 
@@ -321,6 +416,7 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
 
   bool ok = testParsing();
   ok &= testEval();
+  ok &= testIndex();
 
   return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
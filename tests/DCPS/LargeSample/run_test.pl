@@ -40,6 +40,12 @@ elsif ($test->flag('rtps')) {
     "-DCPSConfigFile", "rtps.ini",
   );
 }
+elsif ($test->flag('rtps_offload')) {
+  $is_rtps = 1;
+  push(@common_opts,
+    "-DCPSConfigFile", "rtps_offload.ini",
+  );
+}
 elsif ($test->flag('rtps_disc_sec')) {
   $is_rtps = 1;
   push(@common_opts,
@@ -0,0 +1,178 @@
+#include <tests/DCPS/ConsolidatedMessengerIdl/MessengerTypeSupportImpl.h>
+#include <tests/Utils/StatusMatching.h>
+#include <tests/DCPS/common/TestSupport.h>
+
+#include <dds/DCPS/Marked_Default_Qos.h>
+#include <dds/DCPS/WaitSet.h>
+
+#include <cstring>
+
+#ifdef ACE_AS_STATIC_LIBS
+#include <dds/DCPS/RTPS/RtpsDiscovery.h>
+#include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
+#endif
+
+using namespace OpenDDS::DCPS;
+
+typedef DataWriterImpl_T<Messenger::Message> MessageWriterImpl;
+
+namespace {
+
+ACE_Message_Block* loan(MessageWriterImpl& writer, const Messenger::Message& message)
+{
+  const Encoding& encoding = writer.loaned_sample_encoding();
+  ACE_Message_Block* const mb = writer.loan_sample(serialized_size(encoding, message));
+  TEST_ASSERT(mb);
+  Serializer ser(mb, encoding);
+  TEST_ASSERT(ser << message);
+  return mb;
+}
+
+void check_instance(const Messenger::MessageSeq& data, CORBA::Long subject_id,
+                    const char* first, const char* second)
+{
+  const char* const expected[] = {first, second};
+  CORBA::ULong found = 0;
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    if (data[i].subject_id == subject_id) {
+      TEST_ASSERT(found < 2);
+      TEST_ASSERT(std::strcmp(data[i].text.in(), expected[found]) == 0);
+      ++found;
+    }
+  }
+  TEST_ASSERT(found == 2);
+}
+
+}
+
+int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
+{
+  int status = 0;
+  try {
+    DDS::DomainParticipantFactory_var dpf = TheParticipantFactoryWithArgs(argc, argv);
+    DDS::DomainParticipant_var participant = dpf->create_participant(1066,
+                                                                     PARTICIPANT_QOS_DEFAULT,
+                                                                     DDS::DomainParticipantListener::_nil(),
+                                                                     DEFAULT_STATUS_MASK);
+    TEST_ASSERT(participant);
+    Messenger::MessageTypeSupport_var ts(new Messenger::MessageTypeSupportImpl);
+    TEST_ASSERT(ts->register_type(participant.in(), "") == DDS::RETCODE_OK);
+    CORBA::String_var type_name = ts->get_type_name();
+    DDS::Topic_var topic = participant->create_topic("LoanedSample",
+                                                     type_name.in(),
+                                                     TOPIC_QOS_DEFAULT,
+                                                     DDS::TopicListener::_nil(),
+                                                     DEFAULT_STATUS_MASK);
+    TEST_ASSERT(topic);
+
+    DDS::Publisher_var publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT,
+                                                                 DDS::PublisherListener::_nil(),
+                                                                 DEFAULT_STATUS_MASK);
+    DDS::DataWriterQos writer_qos;
+    publisher->get_default_datawriter_qos(writer_qos);
+    writer_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    DDS::DataWriter_var dw = publisher->create_datawriter(topic,
+                                                          writer_qos,
+                                                          DDS::DataWriterListener::_nil(),
+                                                          DEFAULT_STATUS_MASK);
+    Messenger::MessageDataWriter_var writer = Messenger::MessageDataWriter::_narrow(dw);
+    MessageWriterImpl* const writer_impl = dynamic_cast<MessageWriterImpl*>(dw.ptr());
+    TEST_ASSERT(writer_impl);
+
+    DDS::Subscriber_var subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT,
+                                                                    DDS::SubscriberListener::_nil(),
+                                                                    DEFAULT_STATUS_MASK);
+    DDS::DataReaderQos reader_qos;
+    subscriber->get_default_datareader_qos(reader_qos);
+    reader_qos.reliability.kind = DDS::RELIABLE_RELIABILITY_QOS;
+    reader_qos.history.kind = DDS::KEEP_ALL_HISTORY_QOS;
+    DDS::DataReader_var dr = subscriber->create_datareader(topic,
+                                                           reader_qos,
+                                                           DDS::DataReaderListener::_nil(),
+                                                           DEFAULT_STATUS_MASK);
+    Messenger::MessageDataReader_var reader = Messenger::MessageDataReader::_narrow(dr);
+    TEST_ASSERT(reader);
+
+    TEST_ASSERT(Utils::wait_match(dw, 1) == 0);
+    TEST_ASSERT(Utils::wait_match(dr, 1) == 0);
+
+    //Message{"from", "subject", @key subject_id, "text", count, ull, source_pid}
+    Messenger::Message message1 = {"", "LoanedSample", 1, "", 0, 0, 0};
+    Messenger::Message message2 = {"", "LoanedSample", 2, "", 0, 0, 0};
+    const DDS::InstanceHandle_t handle1 = writer->register_instance(message1);
+    const DDS::InstanceHandle_t handle2 = writer->register_instance(message2);
+    TEST_ASSERT(handle1 != DDS::HANDLE_NIL && handle2 != DDS::HANDLE_NIL && handle1 != handle2);
+
+    // Loan and write.
+    message1.text = "written";
+    TEST_ASSERT(writer_impl->write_loaned(loan(*writer_impl, message1), handle1) == DDS::RETCODE_OK);
+
+    // Handles that aren't the instance of the loaned sample.
+    message1.text = "wrong handle";
+    TEST_ASSERT(writer_impl->write_loaned(loan(*writer_impl, message1), handle2) ==
+                DDS::RETCODE_PRECONDITION_NOT_MET);
+    TEST_ASSERT(writer_impl->write_loaned(loan(*writer_impl, message1), DDS::HANDLE_NIL) ==
+                DDS::RETCODE_PRECONDITION_NOT_MET);
+    Messenger::Message unregistered = {"", "LoanedSample", 3, "unregistered", 0, 0, 0};
+    TEST_ASSERT(writer_impl->write_loaned(loan(*writer_impl, unregistered), handle1) ==
+                DDS::RETCODE_PRECONDITION_NOT_MET);
+    TEST_ASSERT(writer_impl->write_loaned(0, handle1) == DDS::RETCODE_BAD_PARAMETER);
+
+    // Write the same loan twice.  write_loaned takes ownership, so the first
+    // write gets a duplicate.
+    message2.text = "twice";
+    ACE_Message_Block* const twice = loan(*writer_impl, message2);
+    TEST_ASSERT(writer_impl->write_loaned(twice->duplicate(), handle2) == DDS::RETCODE_OK);
+    TEST_ASSERT(writer_impl->write_loaned(twice, handle2) == DDS::RETCODE_OK);
+
+    // Return a loan without writing it, then loan and write again.
+    message1.text = "returned";
+    ACE_Message_Block::release(loan(*writer_impl, message1));
+    message1.text = "after return";
+    TEST_ASSERT(writer_impl->write_loaned(loan(*writer_impl, message1), handle1) == DDS::RETCODE_OK);
+
+    // The reader gets the written samples and nothing else.
+    Messenger::MessageSeq received;
+    DDS::ReadCondition_var rc = dr->create_readcondition(DDS::NOT_READ_SAMPLE_STATE,
+                                                         DDS::ANY_VIEW_STATE,
+                                                         DDS::ALIVE_INSTANCE_STATE);
+    DDS::WaitSet_var ws = new DDS::WaitSet;
+    ws->attach_condition(rc);
+    while (received.length() < 4) {
+      DDS::ConditionSeq active;
+      const DDS::Duration_t max_wait = {10, 0};
+      TEST_ASSERT(ws->wait(active, max_wait) == DDS::RETCODE_OK);
+      Messenger::MessageSeq data;
+      DDS::SampleInfoSeq info;
+      while (reader->take_w_condition(data, info, DDS::LENGTH_UNLIMITED, rc) == DDS::RETCODE_OK) {
+        for (CORBA::ULong i = 0; i < data.length(); ++i) {
+          if (info[i].valid_data) {
+            const CORBA::ULong n = received.length();
+            received.length(n + 1);
+            received[n] = data[i];
+          }
+        }
+        reader->return_loan(data, info);
+      }
+    }
+    {
+      // Nothing else arrives.
+      DDS::ConditionSeq active;
+      const DDS::Duration_t max_wait = {1, 0};
+      TEST_ASSERT(ws->wait(active, max_wait) == DDS::RETCODE_TIMEOUT);
+    }
+    ws->detach_condition(rc);
+    dr->delete_readcondition(rc);
+
+    TEST_ASSERT(received.length() == 4);
+    check_instance(received, 1, "written", "after return");
+    check_instance(received, 2, "twice", "twice");
+
+    participant->delete_contained_entities();
+    dpf->delete_participant(participant);
+  } catch (const char*) {
+    status = 1;
+  }
+  TheServiceParticipant->shutdown();
+  return status;
+}
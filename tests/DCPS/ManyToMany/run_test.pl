@@ -30,6 +30,12 @@ if ($test->flag('udp')) {
 elsif ($test->flag('multicast_async')) {
   $config_opts .= "-DCPSConfigFile pub_multicast_async.ini ";
 }
+elsif ($test->flag('shmem_ring')) {
+  $config_opts .= "-DCPSConfigFile shmem_ring.ini ";
+}
+elsif ($test->flag('shmem_share_payloads')) {
+  $config_opts .= "-DCPSConfigFile shmem_share_payloads.ini ";
+}
 
 $config_opts .= '-reliable ' if $reliable;
 
@@ -40,6 +46,9 @@ sub generate_rtps_config {
   if ($test->flag('rtps_disc')) {
     $config_file = "rtps_disc.ini";
   }
+  elsif ($test->flag('rtps_disc_io_batch')) {
+    $config_file = "rtps_disc_io_batch.ini";
+  }
   elsif ($test->flag('rtps')) {
     $config_file = "rtps.ini";
   }
@@ -55,6 +64,7 @@ sub generate_rtps_config {
   open MYFILE, '+<', $gen_conf_file or die "Open failed: $!";
   my $transport_type_line;
   my $use_multicast_line;
+  my $batch_size_line = "";
   while(<MYFILE>)  {
     chomp;
     if ($_ =~ /use_multicast=/) {
@@ -63,6 +73,9 @@ sub generate_rtps_config {
     if ($_ =~ /transport_type=/) {
       $transport_type_line = $_;
     }
+    if ($_ =~ /IoBatchSize=/) {
+      $batch_size_line = "\n$_";
+    }
   }
   seek MYFILE, 0, 2;
   print MYFILE "\n#START GENERATED TRANSPORT CONFIG";
@@ -71,7 +84,7 @@ sub generate_rtps_config {
     print MYFILE "\n\n[config\/domain_part_$part_num]\n";
     print MYFILE "transports=rtps_transport_$part_num\n";
     print MYFILE "\n[transport\/rtps_transport_$part_num]\n";
-    print MYFILE "$transport_type_line\n$use_multicast_line";
+    print MYFILE "$transport_type_line\n$use_multicast_line$batch_size_line";
   }
   close MYFILE;
   $config_opts .= "-DCPSConfigFile $gen_conf_file ";
@@ -244,7 +257,8 @@ elsif ($config_opts !~ /-sample_size/) {
     $config_opts .= '-sample_size 10 ';
 }
 
-if (($test->flag('rtps_disc') || $test->flag('rtps')) &&
+if (($test->flag('rtps_disc') || $test->flag('rtps') ||
+     $test->flag('rtps_disc_io_batch')) &&
     ($sub_part > 1 || $pub_part > 1))
 {
   #need to generate proper .ini files for multiple participants in a process
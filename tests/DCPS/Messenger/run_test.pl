@@ -101,6 +101,16 @@ elsif ($test->flag('rtps_disc_sec')) {
     $sub_opts .= " -DCPSConfigFile rtps_disc_sec.ini";
     $is_rtps_disc = 1;
 }
+elsif ($test->flag('rtps_disc_receive_threads')) {
+    $pub_opts .= " -DCPSConfigFile rtps_disc_receive_threads.ini";
+    $sub_opts .= " -DCPSConfigFile rtps_disc_receive_threads.ini";
+    $is_rtps_disc = 1;
+}
+elsif ($test->flag('rtps_disc_concurrent_demarshal')) {
+    $pub_opts .= " -DCPSConfigFile rtps_disc_concurrent_demarshal.ini";
+    $sub_opts .= " -DCPSConfigFile rtps_disc_concurrent_demarshal.ini";
+    $is_rtps_disc = 1;
+}
 elsif ($test->flag('rtps_disc_tcp')) {
     $pub_opts .= " -DCPSConfigFile rtps_disc_tcp.ini";
     $sub_opts .= " -DCPSConfigFile rtps_disc_tcp.ini";
@@ -124,7 +134,9 @@ elsif ($test->flag('all')) {
     @original_ARGV = grep { $_ ne 'all' } @original_ARGV;
     my @tests = ('', qw/udp multicast default_tcp default_udp default_multicast
                         nobits stack shmem
-                        rtps rtps_disc rtps_unicast rtps_disc_tcp/);
+                        rtps rtps_disc rtps_unicast rtps_disc_tcp
+                        rtps_disc_receive_threads
+                        rtps_disc_concurrent_demarshal/);
     push(@tests, 'ipv6') if new PerlACE::ConfigList->check_config('IPV6');
     for my $test (@tests) {
         $status += system($^X, $0, @original_ARGV, $test);
@@ -7,6 +7,8 @@
 #include <dds/DCPS/JsonValueWriter.h>
 #include <dds/DCPS/Marked_Default_Qos.h>
 
+#include <cstring>
+
 #ifdef ACE_AS_STATIC_LIBS
 #include <dds/DCPS/RTPS/RtpsDiscovery.h>
 #include <dds/DCPS/transport/rtps_udp/RtpsUdp.h>
@@ -84,9 +86,11 @@ public:
 
   void on_sample_sent(DDS::DataWriter_ptr, const Sample& s)
   {
-    ACE_UNUSED_ARG(s);
     static size_t count = 0;
     dcs_->post(actor_, String(__func__) + "_" + to_dds_string(count++));
+    if (s.data) {
+      dcs_->post(actor_, String(__func__) + "_" + static_cast<const Messenger::Message*>(s.data)->text.in());
+    }
 #if OPENDDS_HAS_JSON_VALUE_WRITER
     std::cout << OpenDDS::DCPS::to_json(s) << std::endl;
 #endif
@@ -272,6 +276,26 @@ int ACE_TMAIN(int argc, ACE_TCHAR* argv[])
     dcs->wait_for(DRIVER, READER, "on_sample_read_0");
     reader->take(datas, infos, DDS::LENGTH_UNLIMITED, DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
     dcs->wait_for(DRIVER, READER, "on_sample_taken_0");
+    dcs->wait_for(DRIVER, WRITER, "on_sample_sent_test");
+
+    // Write a loaned sample.  Observers still see its value.
+    typedef DataWriterImpl_T<Messenger::Message> MessageWriterImpl;
+    MessageWriterImpl* writer_impl = dynamic_cast<MessageWriterImpl*>(dw.ptr());
+    TEST_ASSERT(writer_impl);
+    Messenger::Message loaned_message = {"", "Observer", 1, "loaned", 2, 0, 0};
+    const DDS::InstanceHandle_t handle = writer->register_instance(loaned_message);
+    const Encoding& encoding = writer_impl->loaned_sample_encoding();
+    ACE_Message_Block* loan = writer_impl->loan_sample(serialized_size(encoding, loaned_message));
+    TEST_ASSERT(loan);
+    Serializer ser(loan, encoding);
+    TEST_ASSERT(ser << loaned_message);
+    TEST_ASSERT(writer_impl->write_loaned(loan, handle) == DDS::RETCODE_OK);
+    dcs->wait_for(DRIVER, WRITER, "on_sample_sent_1");
+    dcs->wait_for(DRIVER, WRITER, "on_sample_sent_loaned");
+    dcs->wait_for(DRIVER, READER, "on_sample_received_1");
+    reader->take(datas, infos, DDS::LENGTH_UNLIMITED, DDS::ANY_SAMPLE_STATE, DDS::ANY_VIEW_STATE, DDS::ANY_INSTANCE_STATE);
+    dcs->wait_for(DRIVER, READER, "on_sample_taken_1");
+    TEST_ASSERT(datas.length() == 1 && std::strcmp(datas[0].text.in(), "loaned") == 0);
 
     // Checking dispose and unrgister.
     // auto disposed is turned on.
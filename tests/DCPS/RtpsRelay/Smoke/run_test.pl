@@ -57,6 +57,8 @@ elsif ($test->flag('partition_same_relay')) {
 sub get_relay_args {
     my $n = shift;
     my $port_digit = 3 + $n;
+    my @shard_args = $test->flag('sharded') ?
+        ("-HandlerShards 4", "-ForwardingSnapshots 1", "-PartitionIndexSnapshots 1") : ();
     return join(' ',
         "-Id relay${n}",
         "-UserData relay${n}",
@@ -72,7 +74,8 @@ sub get_relay_args {
         "-HorizontalAddress 127.0.0.1:11${port_digit}44",
         "-MetaDiscoveryAddress 127.0.0.1:808${n}",
         "-ORBVerboseLogging 1",
-        "-SynchronousOutput 1"
+        "-SynchronousOutput 1",
+        @shard_args
     );
 }
 
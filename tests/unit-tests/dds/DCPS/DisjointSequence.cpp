@@ -9,6 +9,8 @@
 
 #include "dds/DCPS/DisjointSequence.h"
 
+#include <algorithm>
+
 using namespace OpenDDS::DCPS;
 
 TEST(dds_DCPS_DisjointSequence, maintest)
@@ -1125,3 +1127,97 @@ TEST(dds_DCPS_DisjointSequence, OrderedRanges_add_overflow)
     EXPECT_TRUE(r.has(0, 255));
   }
 }
+
+TEST(dds_DCPS_DisjointSequence, far_apart_ranges)
+{
+  // Ranges further apart than the internal window
+  DisjointSequence sequence;
+  EXPECT_TRUE(sequence.insert(SequenceRange(1, 10)));
+  EXPECT_TRUE(sequence.insert(SequenceRange(1000, 1100)));
+  EXPECT_TRUE(sequence.insert(SequenceRange(100000, 100001)));
+  EXPECT_TRUE(sequence.insert(500));
+  EXPECT_EQ(SequenceNumber(10), sequence.cumulative_ack());
+  EXPECT_EQ(SequenceNumber(100000), sequence.last_ack());
+  EXPECT_EQ(SequenceNumber(1), sequence.low());
+  EXPECT_EQ(SequenceNumber(100001), sequence.high());
+  EXPECT_TRUE(sequence.contains(500));
+  EXPECT_FALSE(sequence.contains(501));
+  EXPECT_TRUE(sequence.contains_any(SequenceRange(11, 500)));
+  EXPECT_FALSE(sequence.contains_any(SequenceRange(1101, 99999)));
+
+  OPENDDS_VECTOR(SequenceRange) missing = sequence.missing_sequence_ranges();
+  ASSERT_EQ(3u, missing.size());
+  EXPECT_EQ(SequenceRange(11, 499), missing[0]);
+  EXPECT_EQ(SequenceRange(501, 999), missing[1]);
+  EXPECT_EQ(SequenceRange(1101, 99999), missing[2]);
+
+  // Filling in the gaps joins the ranges
+  OPENDDS_VECTOR(SequenceRange) added;
+  EXPECT_TRUE(sequence.insert(SequenceRange(5, 100000), added));
+  ASSERT_EQ(3u, added.size());
+  EXPECT_EQ(SequenceRange(11, 499), added[0]);
+  EXPECT_EQ(SequenceRange(501, 999), added[1]);
+  EXPECT_EQ(SequenceRange(1101, 99999), added[2]);
+  EXPECT_FALSE(sequence.disjoint());
+  EXPECT_EQ(SequenceNumber(100001), sequence.cumulative_ack());
+  EXPECT_EQ(SequenceNumber(1), sequence.last_ack());
+}
+
+TEST(dds_DCPS_DisjointSequence, lost_sample_stays_missing)
+{
+  // Receiving in order with one sample that never arrives
+  DisjointSequence sequence;
+  for (int i = 1; i <= 5000; ++i) {
+    if (i != 3) {
+      EXPECT_TRUE(sequence.insert(i));
+    }
+  }
+  EXPECT_EQ(SequenceNumber(2), sequence.cumulative_ack());
+  EXPECT_EQ(SequenceNumber(4), sequence.last_ack());
+  EXPECT_EQ(SequenceNumber(5000), sequence.high());
+  OPENDDS_VECTOR(SequenceRange) missing = sequence.missing_sequence_ranges();
+  ASSERT_EQ(1u, missing.size());
+  EXPECT_EQ(SequenceRange(3, 3), missing[0]);
+
+  ACE_CDR::Long bitmap[8];
+  ACE_CDR::ULong num_bits = 0, cumulative_bits_added = 0;
+  EXPECT_TRUE(sequence.to_bitmap(bitmap, 8, num_bits, cumulative_bits_added, true));
+  EXPECT_EQ(1u, num_bits);
+  EXPECT_EQ(ACE_CDR::Long(0x80000000), bitmap[0]);
+
+  EXPECT_TRUE(sequence.insert(3));
+  EXPECT_FALSE(sequence.disjoint());
+  EXPECT_EQ(SequenceNumber(5000), sequence.cumulative_ack());
+}
+
+TEST(dds_DCPS_DisjointSequence, lossy_stream)
+{
+  // One in every 97 samples is lost and repaired 500 samples later, which
+  // keeps several gaps in and below the window.  What's missing is checked
+  // every 64 samples like a heartbeat response.
+  static const int samples = 20000;
+  static const int loss = 97, repair_delay = 500, heartbeat = 64;
+
+  DisjointSequence sequence;
+  for (int i = 1; i <= samples; ++i) {
+    if (i % loss) {
+      sequence.insert(i);
+    }
+    if (i > repair_delay && (i - repair_delay) % loss == 0) {
+      sequence.insert(i - repair_delay);
+    }
+    if (i % heartbeat == 0) {
+      OPENDDS_VECTOR(SequenceRange) expected;
+      for (int j = (std::max)(loss, (i - repair_delay + loss) / loss * loss); j < i; j += loss) {
+        expected.push_back(SequenceRange(j, j));
+      }
+      const OPENDDS_VECTOR(SequenceRange) missing = sequence.missing_sequence_ranges();
+      ASSERT_EQ(expected.size(), missing.size()) << "at " << i;
+      for (size_t j = 0; j < missing.size(); ++j) {
+        EXPECT_EQ(expected[j], missing[j]) << "at " << i;
+      }
+      EXPECT_EQ(SequenceNumber(expected.empty() ? i : expected[0].first.getValue() - 1),
+                sequence.cumulative_ack()) << "at " << i;
+    }
+  }
+}
@@ -226,6 +226,66 @@ TEST(dds_DCPS_DispatchService, RecursiveDispatchGamma_ImmediateShutdown)
   EXPECT_GE(test_obj.call_count(), 1000u);
 }
 
+TEST(dds_DCPS_DispatchService, SimpleDispatchWorkStealing)
+{
+  SimpleTestObj test_obj;
+  OpenDDS::DCPS::DispatchService dispatcher(8, false, true);
+  for (size_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(dispatcher.dispatch(test_obj));
+  }
+
+  test_obj.wait(1000u);
+  EXPECT_EQ(test_obj.call_count(), 1000u);
+}
+
+TEST(dds_DCPS_DispatchService, RecursiveDispatchWorkStealing)
+{
+  OpenDDS::DCPS::DispatchService dispatcher(8, false, true);
+  RecursiveTestObjTwo test_obj(dispatcher, 2);
+
+  dispatcher.dispatch(test_obj);
+
+  test_obj.wait(1000u);
+  test_obj.dispatch_scale_ = 0;
+  dispatcher.shutdown();
+
+  EXPECT_GE(test_obj.call_count(), 1000u);
+  EXPECT_EQ(dispatcher.queue_size(), 0u);
+}
+
+TEST(dds_DCPS_DispatchService, RecursiveDispatchWorkStealing_ImmediateShutdown)
+{
+  OpenDDS::DCPS::DispatchService dispatcher(8, false, true);
+  RecursiveTestObjTwo test_obj(dispatcher, 2);
+
+  dispatcher.dispatch(test_obj);
+
+  test_obj.wait(1000u);
+  OpenDDS::DCPS::DispatchService::EventQueue temp;
+  dispatcher.shutdown(true, &temp);
+  test_obj.dispatch_scale_ = 0;
+
+  EXPECT_GE(test_obj.call_count(), 1000u);
+  EXPECT_GT(temp.size(), 0u);
+  for (OpenDDS::DCPS::DispatchService::EventQueue::iterator it = temp.begin(); it != temp.end(); ++it) {
+    EXPECT_EQ(it->second, &test_obj);
+  }
+  EXPECT_EQ(dispatcher.dispatch(test_obj), false);
+}
+
+TEST(dds_DCPS_DispatchService, ShutdownDrainsWorkStealing)
+{
+  SimpleTestObj test_obj;
+  OpenDDS::DCPS::DispatchService dispatcher(4, false, true);
+  for (size_t i = 0; i < 1000; ++i) {
+    dispatcher.dispatch(test_obj);
+  }
+  dispatcher.shutdown();
+
+  EXPECT_EQ(test_obj.call_count(), 1000u);
+  EXPECT_EQ(dispatcher.dispatch(test_obj), false);
+}
+
 TEST(dds_DCPS_DispatchService, InternalShutdown)
 {
   OpenDDS::DCPS::DispatchService dispatcher;
@@ -422,3 +482,93 @@ TEST(dds_DCPS_DispatchService, CancelDispatchSingleThreaded)
   OpenDDS::DCPS::DispatchService dispatcher(1);
   cancel_dispatch_common(dispatcher);
 }
+
+TEST(dds_DCPS_DispatchService, CancelDispatchTimerWheel)
+{
+  OpenDDS::DCPS::DispatchService dispatcher(4, true);
+  cancel_dispatch_common(dispatcher);
+}
+
+TEST(dds_DCPS_DispatchService, CancelDispatchTimerWheelSingleThreaded)
+{
+  OpenDDS::DCPS::DispatchService dispatcher(1, true);
+  cancel_dispatch_common(dispatcher);
+}
+
+TEST(dds_DCPS_DispatchService, CancelDispatchWorkStealing)
+{
+  OpenDDS::DCPS::DispatchService dispatcher(4, false, true);
+  cancel_dispatch_common(dispatcher);
+}
+
+TEST(dds_DCPS_DispatchService, TimedDispatchTimerWheel)
+{
+  SimpleTestObj test_obj;
+  OpenDDS::DCPS::DispatchService dispatcher(4, true);
+
+  const OpenDDS::DCPS::MonotonicTimePoint now = OpenDDS::DCPS::MonotonicTimePoint::now();
+
+  dispatcher.schedule(test_obj, now + OpenDDS::DCPS::TimeDuration::from_double(0.06));
+  dispatcher.schedule(test_obj, now + OpenDDS::DCPS::TimeDuration::from_double(0.04));
+  dispatcher.schedule(test_obj, now + OpenDDS::DCPS::TimeDuration::from_double(0.05));
+  dispatcher.schedule(test_obj, now - OpenDDS::DCPS::TimeDuration::from_double(0.01));
+
+  test_obj.wait(1u);
+  const OpenDDS::DCPS::MonotonicTimePoint after1 = OpenDDS::DCPS::MonotonicTimePoint::now();
+
+  test_obj.wait(2u);
+  const OpenDDS::DCPS::MonotonicTimePoint after2 = OpenDDS::DCPS::MonotonicTimePoint::now();
+
+  test_obj.wait(3u);
+  const OpenDDS::DCPS::MonotonicTimePoint after3 = OpenDDS::DCPS::MonotonicTimePoint::now();
+
+  test_obj.wait(4u);
+  const OpenDDS::DCPS::MonotonicTimePoint after4 = OpenDDS::DCPS::MonotonicTimePoint::now();
+
+  EXPECT_LT(after1, now + OpenDDS::DCPS::TimeDuration::from_double(0.04));
+  EXPECT_GE(after2, now + OpenDDS::DCPS::TimeDuration::from_double(0.04));
+  EXPECT_GE(after3, now + OpenDDS::DCPS::TimeDuration::from_double(0.05));
+  EXPECT_GE(after4, now + OpenDDS::DCPS::TimeDuration::from_double(0.06));
+}
+
+namespace {
+
+void schedule_cancel_common(bool timer_wheel)
+{
+  static const long pending = 10000;
+  static const long rounds = 1000;
+
+  SimpleTestObj test_obj;
+  OpenDDS::DCPS::DispatchService dispatcher(1, timer_wheel);
+
+  const OpenDDS::DCPS::MonotonicTimePoint now = OpenDDS::DCPS::MonotonicTimePoint::now();
+  OPENDDS_VECTOR(long) ids;
+  ids.reserve(pending);
+  for (long i = 0; i < pending; ++i) {
+    ids.push_back(dispatcher.schedule(test_obj, now + OpenDDS::DCPS::TimeDuration(3600 + i % 3600, i % 1000)));
+  }
+
+  // Reschedule timers the way heartbeats and deadlines do, with many others
+  // pending.  Each id is still valid until it's canceled.
+  for (long i = 0; i < rounds; ++i) {
+    const size_t idx = static_cast<size_t>((i * 7919) % pending);
+    EXPECT_EQ(dispatcher.cancel(ids[idx]), 1u);
+    EXPECT_EQ(dispatcher.cancel(ids[idx]), 0u);
+    ids[idx] = dispatcher.schedule(test_obj, now + OpenDDS::DCPS::TimeDuration(3600 + i % 1800));
+  }
+
+  EXPECT_EQ(dispatcher.cancel(test_obj), static_cast<size_t>(pending));
+  EXPECT_EQ(test_obj.call_count(), 0u);
+}
+
+}
+
+TEST(dds_DCPS_DispatchService, ScheduleCancel)
+{
+  schedule_cancel_common(false);
+}
+
+TEST(dds_DCPS_DispatchService, ScheduleCancelTimerWheel)
+{
+  schedule_cancel_common(true);
+}
@@ -0,0 +1,284 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#ifndef OPENDDS_NO_PERSISTENCE_PROFILE
+
+#include <dds/DCPS/DurableDataLog.h>
+
+#include <dds/DCPS/DirentWrapper.h>
+#include <dds/DCPS/SafetyProfileStreams.h>
+
+#include <ace/OS_NS_unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  typedef DurableDataLog::QueueList QueueList;
+
+  class Dir {
+  public:
+    explicit Dir(const char* name)
+      : name_(name)
+    {
+      remove();
+    }
+
+    ~Dir()
+    {
+      remove();
+    }
+
+    const char* name() const { return name_.c_str(); }
+
+  private:
+    void remove()
+    {
+      ACE_Dirent dir;
+      if (dir.open(ACE_TEXT_CHAR_TO_TCHAR(name_.c_str())) == -1) {
+        return;
+      }
+      while (ACE_DIRENT* const entry = dir.read()) {
+        const String file(ACE_TEXT_ALWAYS_CHAR(entry->d_name));
+        if (file != "." && file != "..") {
+          ACE_OS::unlink(ACE_TEXT_CHAR_TO_TCHAR((name_ + "/" + file).c_str()));
+        }
+      }
+      dir.close();
+      ACE_OS::rmdir(ACE_TEXT_CHAR_TO_TCHAR(name_.c_str()));
+    }
+
+    const String name_;
+  };
+
+  DDS::Time_t timestamp(int sec)
+  {
+    DDS::Time_t t = { sec, 0 };
+    return t;
+  }
+
+  DurableDataLog::QueueId insert(DurableDataLog& log, const char* topic, int first, int count)
+  {
+    const DurableDataLog::QueueId id = log.begin_queue(7, topic, "Type", count);
+    EXPECT_NE(0u, id);
+    for (int i = first; i != first + count; ++i) {
+      const String data = to_dds_string(i);
+      EXPECT_TRUE(log.append(id, timestamp(i), data.c_str(), data.size()));
+    }
+    EXPECT_TRUE(log.commit());
+    return id;
+  }
+
+  String samples(const DurableDataLog::Queue& queue)
+  {
+    String result;
+    for (size_t i = 0; i != queue.samples.size(); ++i) {
+      const DurableDataLog::Sample& sample = queue.samples[i];
+      EXPECT_EQ(to_dds_string(sample.timestamp.sec), String(sample.data, sample.length));
+      result += (i ? " " : "") + String(sample.data, sample.length);
+    }
+    return result;
+  }
+}
+
+TEST(dds_DCPS_DurableDataLog, reopen)
+{
+  Dir dir("DurableDataLog-reopen");
+  {
+    DurableDataLog log(dir.name(), 4096, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+    EXPECT_TRUE(queues.empty());
+    insert(log, "A", 1, 3);
+    insert(log, "B", 10, 2);
+    log.begin_queue(7, "Empty", "Type", 0);
+  }
+
+  DurableDataLog log(dir.name(), 4096, true);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+  ASSERT_EQ(3u, queues.size());
+  EXPECT_EQ(7, queues[0].domain_id);
+  EXPECT_EQ("A", queues[0].topic_name);
+  EXPECT_EQ("Type", queues[0].type_name);
+  EXPECT_EQ("1 2 3", samples(queues[0]));
+  EXPECT_EQ("B", queues[1].topic_name);
+  EXPECT_EQ("10 11", samples(queues[1]));
+  EXPECT_EQ("Empty", queues[2].topic_name);
+  EXPECT_TRUE(queues[2].samples.empty());
+
+  // New queues don't reuse ids.
+  const DurableDataLog::QueueId id = log.begin_queue(7, "C", "Type", 0);
+  EXPECT_GT(id, queues[0].id);
+  EXPECT_GT(id, queues[1].id);
+  EXPECT_GT(id, queues[2].id);
+}
+
+TEST(dds_DCPS_DurableDataLog, drop)
+{
+  Dir dir("DurableDataLog-drop");
+  {
+    DurableDataLog log(dir.name(), 4096, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+    const DurableDataLog::QueueId a = insert(log, "A", 1, 3);
+    insert(log, "B", 10, 2);
+    EXPECT_TRUE(log.drop(a));
+    EXPECT_FALSE(log.drop(a));
+  }
+
+  DurableDataLog log(dir.name(), 4096, true);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+  ASSERT_EQ(1u, queues.size());
+  EXPECT_EQ("B", queues[0].topic_name);
+  EXPECT_EQ("10 11", samples(queues[0]));
+}
+
+TEST(dds_DCPS_DurableDataLog, delete_dropped_segments)
+{
+  Dir dir("DurableDataLog-delete");
+  DurableDataLog log(dir.name(), 256, false);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+
+  OPENDDS_VECTOR(DurableDataLog::QueueId) ids;
+  for (int i = 0; i != 20; ++i) {
+    ids.push_back(insert(log, "A", i * 10, 5));
+  }
+  const size_t segments = log.segment_count();
+  EXPECT_GT(segments, 5u);
+
+  for (size_t i = 0; i + 1 < ids.size(); ++i) {
+    EXPECT_TRUE(log.drop(ids[i]));
+  }
+  EXPECT_LT(log.segment_count(), segments / 2);
+
+  DurableDataLog reopened(dir.name(), 256, false);
+  ASSERT_TRUE(reopened.open(queues));
+  ASSERT_EQ(1u, queues.size());
+  EXPECT_EQ("190 191 192 193 194", samples(queues[0]));
+}
+
+TEST(dds_DCPS_DurableDataLog, compact)
+{
+  Dir dir("DurableDataLog-compact");
+  OPENDDS_VECTOR(DurableDataLog::QueueId) ids;
+  {
+    DurableDataLog log(dir.name(), 512, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+
+    for (int i = 0; i != 40; ++i) {
+      ids.push_back(insert(log, i % 4 ? "Dropped" : "Kept", i * 10, 3));
+    }
+    for (size_t i = 0; i != ids.size(); ++i) {
+      if (i % 4) {
+        EXPECT_TRUE(log.drop(ids[i]));
+      }
+    }
+    const size_t segments = log.segment_count();
+    EXPECT_TRUE(log.compaction_needed());
+    log.compact();
+    EXPECT_LT(log.segment_count(), segments / 2);
+  }
+
+  DurableDataLog log(dir.name(), 512, true);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+  ASSERT_EQ(10u, queues.size());
+  for (size_t i = 0; i != queues.size(); ++i) {
+    EXPECT_EQ(ids[i * 4], queues[i].id);
+    EXPECT_EQ("Kept", queues[i].topic_name);
+    const int first = static_cast<int>(i) * 40;
+    EXPECT_EQ(to_dds_string(first) + " " + to_dds_string(first + 1) + " " + to_dds_string(first + 2),
+              samples(queues[i]));
+  }
+}
+
+TEST(dds_DCPS_DurableDataLog, partial_record)
+{
+  Dir dir("DurableDataLog-partial");
+  {
+    DurableDataLog log(dir.name(), 4096, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+    const DurableDataLog::QueueId id = log.begin_queue(7, "A", "Type", 2);
+    EXPECT_TRUE(log.append(id, timestamp(1), "first", 5));
+    EXPECT_TRUE(log.append(id, timestamp(2), "second", 6));
+    EXPECT_TRUE(log.commit());
+  }
+
+  // Damage the last sample like a write that didn't finish.
+  const String segment = String(dir.name()) + "/_segment.00000001";
+  String contents;
+  {
+    std::ifstream in(segment.c_str(), std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const size_t pos = contents.find("second");
+  ASSERT_NE(String::npos, pos);
+  {
+    std::fstream out(segment.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(static_cast<std::streamoff>(pos));
+    out.put('S');
+  }
+
+  // The queue is missing a sample, so it wasn't committed.
+  DurableDataLog log(dir.name(), 4096, true);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+  EXPECT_TRUE(queues.empty());
+}
+
+TEST(dds_DCPS_DurableDataLog, truncated_segment)
+{
+  Dir dir("DurableDataLog-truncated");
+  {
+    DurableDataLog log(dir.name(), 4096, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+    insert(log, "A", 1, 2);
+    insert(log, "B", 10, 3);
+  }
+
+  // Cut the segment off in the middle of the last sample of B like pages
+  // that were never written back.
+  const String segment = String(dir.name()) + "/_segment.00000001";
+  String contents;
+  {
+    std::ifstream in(segment.c_str(), std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const size_t pos = contents.rfind("12");
+  ASSERT_NE(String::npos, pos);
+  ASSERT_EQ(0, ACE_OS::truncate(ACE_TEXT_CHAR_TO_TCHAR(segment.c_str()),
+                                static_cast<ACE_OFF_T>(pos + 1)));
+
+  {
+    DurableDataLog log(dir.name(), 4096, true);
+    QueueList queues;
+    ASSERT_TRUE(log.open(queues));
+    ASSERT_EQ(1u, queues.size());
+    EXPECT_EQ("A", queues[0].topic_name);
+    EXPECT_EQ("1 2", samples(queues[0]));
+    insert(log, "C", 20, 1);
+  }
+
+  // B stays ignored and queues written after it are kept.
+  DurableDataLog log(dir.name(), 4096, true);
+  QueueList queues;
+  ASSERT_TRUE(log.open(queues));
+  ASSERT_EQ(2u, queues.size());
+  EXPECT_EQ("A", queues[0].topic_name);
+  EXPECT_EQ("C", queues[1].topic_name);
+  EXPECT_EQ("20", samples(queues[1]));
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include "dds/DCPS/HashedInstanceIndex_T.h"
+#include "dds/DCPS/Hash.h"
+
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  struct Sample {
+    int id;
+    std::string name;
+    double value; // not a key
+  };
+
+  struct SampleLessThan {
+    bool operator()(const Sample& a, const Sample& b) const
+    {
+      if (a.id < b.id) return true;
+      if (b.id < a.id) return false;
+      if (a.name < b.name) return true;
+      if (b.name < a.name) return false;
+      return false;
+    }
+  };
+
+  struct SampleHash {
+    size_t operator()(const Sample& v) const
+    {
+      size_t seed = 0;
+      hash_key_value(seed, v.id);
+      hash_key_string(seed, v.name.c_str());
+      return seed;
+    }
+  };
+
+  typedef OPENDDS_MAP_CMP(Sample, int, SampleLessThan) Map;
+
+  Sample make(int id, const char* name, double value = 0)
+  {
+    Sample s;
+    s.id = id;
+    s.name = name;
+    s.value = value;
+    return s;
+  }
+
+  template <typename Index>
+  void exercise(Map& map, Index& index)
+  {
+    for (int i = 0; i < 100; ++i) {
+      const std::pair<Map::iterator, bool> res =
+        map.insert(Map::value_type(make(i, i % 2 ? "odd" : "even"), i));
+      ASSERT_TRUE(res.second);
+      index.insert(res.first);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+      const Map::iterator it = index.find(make(i, i % 2 ? "odd" : "even", 1.5));
+      ASSERT_NE(it, map.end());
+      EXPECT_EQ(it->second, i);
+    }
+    EXPECT_EQ(index.find(make(1, "even")), map.end());
+    EXPECT_EQ(index.find(make(100, "even")), map.end());
+
+    const Map::iterator it = index.find(make(42, "even"));
+    ASSERT_NE(it, map.end());
+    index.erase(it);
+    map.erase(it);
+    EXPECT_EQ(index.find(make(42, "even")), map.end());
+    EXPECT_NE(index.find(make(43, "odd")), map.end());
+  }
+}
+
+TEST(dds_DCPS_HashedInstanceIndex_T, hash_key_value)
+{
+  size_t a = 0, b = 0;
+  hash_key_value(a, 0.0);
+  hash_key_value(b, -0.0);
+  EXPECT_EQ(a, b);
+
+  a = b = 0;
+  hash_key_string(a, "key");
+  hash_key_string(b, std::string("key").c_str());
+  EXPECT_EQ(a, b);
+
+  a = b = 0;
+  hash_key_string(a, static_cast<const char*>(0));
+  hash_key_string(b, "");
+  EXPECT_EQ(a, b);
+}
+
+TEST(dds_DCPS_HashedInstanceIndex_T, enabled)
+{
+  Map map;
+  HashedInstanceIndex<Map, SampleHash, SampleLessThan> index(map, true);
+#ifdef ACE_HAS_CPP11
+  EXPECT_TRUE(index.enabled());
+#endif
+  exercise(map, index);
+}
+
+TEST(dds_DCPS_HashedInstanceIndex_T, disabled)
+{
+  Map map;
+  HashedInstanceIndex<Map, SampleHash, SampleLessThan> index(map, false);
+  EXPECT_FALSE(index.enabled());
+  exercise(map, index);
+}
+
+TEST(dds_DCPS_HashedInstanceIndex_T, no_hash)
+{
+  Map map;
+  HashedInstanceIndex<Map, void, SampleLessThan> index(map, true);
+  EXPECT_FALSE(index.enabled());
+  exercise(map, index);
+}
@@ -0,0 +1,179 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/TimerWheel_T.h>
+
+#include <gtest/gtest.h>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  typedef TimerWheel<int> Wheel;
+  typedef OPENDDS_VECTOR(int) Values;
+
+  TimeDuration msec(ACE_UINT64 ms)
+  {
+    return TimeDuration::from_msec(ms);
+  }
+
+  struct Even {
+    bool operator()(int x) const { return x % 2 == 0; }
+  };
+}
+
+TEST(dds_DCPS_TimerWheel_T, expire_in_order)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(1), start);
+  EXPECT_TRUE(wheel.empty());
+
+  wheel.insert(start + msec(30), 3);
+  wheel.insert(start + msec(10), 1);
+  wheel.insert(start + msec(20), 2);
+  wheel.insert(start + msec(10), 4);
+  EXPECT_EQ(4u, wheel.size());
+
+  MonotonicTimePoint deadline;
+  ASSERT_TRUE(wheel.next_deadline(deadline));
+  EXPECT_LE(deadline, start + msec(10));
+
+  Values expired;
+  wheel.expire(start + msec(9), expired);
+  EXPECT_TRUE(expired.empty());
+
+  wheel.expire(start + msec(25), expired);
+  ASSERT_EQ(3u, expired.size());
+  EXPECT_EQ(1, expired[0]);
+  EXPECT_EQ(4, expired[1]);
+  EXPECT_EQ(2, expired[2]);
+
+  expired.clear();
+  wheel.expire(start + msec(1000), expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(3, expired[0]);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_FALSE(wheel.next_deadline(deadline));
+}
+
+TEST(dds_DCPS_TimerWheel_T, never_early)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(10), start);
+  const MonotonicTimePoint expiration = start + TimeDuration(0, 12345);
+  wheel.insert(expiration, 1);
+
+  Values expired;
+  wheel.expire(expiration - TimeDuration(0, 1), expired);
+  EXPECT_TRUE(expired.empty());
+
+  MonotonicTimePoint deadline;
+  ASSERT_TRUE(wheel.next_deadline(deadline));
+  EXPECT_GE(deadline, expiration);
+  wheel.expire(deadline, expired);
+  EXPECT_EQ(1u, expired.size());
+}
+
+TEST(dds_DCPS_TimerWheel_T, erase)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(1), start);
+  const Wheel::Handle a = wheel.insert(start + msec(5), 1);
+  const Wheel::Handle b = wheel.insert(start + msec(5), 2);
+  const Wheel::Handle c = wheel.insert(start + TimeDuration(100000), 3);
+  EXPECT_EQ(2, wheel.value(b));
+  EXPECT_EQ(start + msec(5), wheel.expiration(b));
+
+  wheel.erase(b);
+  wheel.erase(c);
+  EXPECT_EQ(1u, wheel.size());
+
+  Values expired;
+  wheel.expire(start + TimeDuration(200000), expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(1, expired[0]);
+
+  // Handles of erased timers are reused
+  const Wheel::Handle d = wheel.insert(start + TimeDuration(300000), 4);
+  EXPECT_TRUE(d == a || d == b || d == c);
+}
+
+TEST(dds_DCPS_TimerWheel_T, far_and_past_expirations)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(1), start);
+
+  // Further out than the top level goes
+  wheel.insert(start + TimeDuration(100 * 24 * 3600), 3);
+  wheel.insert(start + TimeDuration(2000 * 24 * 3600), 4);
+  wheel.insert(start + TimeDuration(3600), 2);
+  // Already expired
+  wheel.insert(start - msec(5), 1);
+
+  Values expired;
+  wheel.expire(start, expired);
+  ASSERT_EQ(1u, expired.size());
+  EXPECT_EQ(1, expired[0]);
+
+  for (int days = 1; days <= 2001; days += 7) {
+    wheel.expire(start + TimeDuration(days * 24 * 3600), expired);
+  }
+  wheel.expire(start + TimeDuration(2001 * 24 * 3600), expired);
+  ASSERT_EQ(4u, expired.size());
+  EXPECT_EQ(2, expired[1]);
+  EXPECT_EQ(3, expired[2]);
+  EXPECT_EQ(4, expired[3]);
+}
+
+TEST(dds_DCPS_TimerWheel_T, matches_sorted_order)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(1), start);
+  OPENDDS_MULTIMAP(MonotonicTimePoint, int) expected;
+
+  unsigned seed = 7;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    const MonotonicTimePoint expiration = start + TimeDuration(0, suseconds_t(seed % 900000)) +
+      TimeDuration(time_t((seed >> 8) % 100000));
+    wheel.insert(expiration, i);
+    expected.insert(std::make_pair(expiration, i));
+  }
+
+  Values expired;
+  MonotonicTimePoint now = start;
+  MonotonicTimePoint deadline;
+  while (wheel.next_deadline(deadline)) {
+    now = deadline;
+    const size_t before = expired.size();
+    wheel.expire(now, expired);
+    for (size_t i = before; i < expired.size(); ++i) {
+      EXPECT_GE(now, expected.begin()->first);
+      EXPECT_EQ(expected.begin()->second, expired[i]);
+      expected.erase(expected.begin());
+    }
+  }
+  EXPECT_TRUE(expected.empty());
+}
+
+TEST(dds_DCPS_TimerWheel_T, clear_and_erase_if)
+{
+  const MonotonicTimePoint start = MonotonicTimePoint::now();
+  Wheel wheel(msec(1), start);
+  for (int i = 0; i < 10; ++i) {
+    wheel.insert(start + msec(10 - i), i);
+  }
+
+  Values erased;
+  wheel.erase_if(Even(), erased);
+  EXPECT_EQ(5u, erased.size());
+  EXPECT_EQ(5u, wheel.size());
+
+  Values remaining;
+  wheel.clear(&remaining);
+  EXPECT_TRUE(wheel.empty());
+  ASSERT_EQ(5u, remaining.size());
+  EXPECT_EQ(9, remaining[0]);
+  EXPECT_EQ(1, remaining[4]);
+}
@@ -6,6 +6,7 @@
 
 #include <dds/DCPS/XTypes/TypeLookupService.h>
 #include <dds/DCPS/XTypes/DynamicTypeImpl.h>
+#include <dds/DCPS/XTypes/DynamicDataImpl.h>
 #include <dds/DCPS/XTypes/DynamicDataXcdrReadImpl.h>
 
 #include <gtest/gtest.h>
@@ -3361,4 +3362,113 @@ TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Enum_As_String)
   EXPECT_EQ(DDS::RETCODE_OK, data.get_string_value(strVal, MID_my_enum));
   EXPECT_STREQ("E_UINT64", strVal.in());
 }
+
+namespace {
+
+// Members alternate between strings and longs, so none of them are at a
+// fixed offset.  Even members are strings of i 'x's and odd members are i.
+void check_wide_member(XTypes::DynamicDataXcdrReadImpl& data, ACE_CDR::ULong i)
+{
+  if (i % 2 == 0) {
+    DDS::String8_var value;
+    ASSERT_RC_OK(data.get_string_value(value, i));
+    EXPECT_STREQ(DCPS::String(i, 'x').c_str(), value.in());
+  } else {
+    ACE_CDR::Long value = 0;
+    ASSERT_RC_OK(data.get_int32_value(value, i));
+    EXPECT_EQ(static_cast<ACE_CDR::Long>(i), value);
+  }
+}
+
+template<typename XTag>
+void read_wide_struct(const DCPS::Encoding& encoding)
+{
+  const XTypes::TypeIdentifier& ti = DCPS::getCompleteTypeIdentifier<XTag>();
+  const XTypes::TypeMap& type_map = DCPS::getCompleteTypeMap<XTag>();
+  const XTypes::TypeMap::const_iterator it = type_map.find(ti);
+  ASSERT_TRUE(it != type_map.end());
+  XTypes::TypeLookupService tls;
+  tls.add(type_map.begin(), type_map.end());
+  DDS::DynamicType_var dt = tls.complete_to_dynamic(it->second.complete, DCPS::GUID_t());
+  ASSERT_TRUE(dt);
+
+  const ACE_CDR::ULong count = dt->get_member_count();
+  XTypes::DynamicDataImpl sample(dt);
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    const DDS::MemberId id = sample.get_member_id_at_index(i);
+    if (i % 2 == 0) {
+      const DCPS::String value(i, 'x');
+      ASSERT_RC_OK(sample.set_string_value(id, value.c_str()));
+    } else {
+      ASSERT_RC_OK(sample.set_int32_value(id, static_cast<ACE_CDR::Long>(i)));
+    }
+  }
+  size_t size = 0;
+  ASSERT_TRUE(DCPS::serialized_size(encoding, size, &sample));
+  ACE_Message_Block msg(size);
+  DCPS::Serializer ser(&msg, encoding);
+  ASSERT_TRUE(ser << &sample);
+
+  // Each member read from a new object, so nothing is cached.
+  for (ACE_CDR::ULong i = 0; i < count; ++i) {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+    check_wide_member(data, i);
+  }
+
+  // First to last from one object, which caches each position as it goes,
+  // then last to first from the cached positions.
+  {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+    for (ACE_CDR::ULong i = 0; i < count; ++i) {
+      check_wide_member(data, i);
+    }
+    for (ACE_CDR::ULong i = count; i-- > 0;) {
+      check_wide_member(data, i);
+    }
+  }
+
+  // Last to first from one object, so the first read caches every position
+  // and the rest go back to them, then first to last again.
+  {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+    for (ACE_CDR::ULong i = count; i-- > 0;) {
+      check_wide_member(data, i);
+    }
+    for (ACE_CDR::ULong i = 0; i < count; ++i) {
+      check_wide_member(data, i);
+    }
+  }
+
+  // Every other member from the middle out, so reads land both before and
+  // after the furthest cached position.
+  {
+    XTypes::DynamicDataXcdrReadImpl data(&msg, encoding, dt);
+    for (ACE_CDR::ULong i = count / 2; i < count; i += 2) {
+      check_wide_member(data, i);
+    }
+    for (ACE_CDR::ULong i = 1; i < count; i += 2) {
+      check_wide_member(data, i);
+    }
+    for (ACE_CDR::ULong i = 0; i < count / 2; i += 2) {
+      check_wide_member(data, i);
+    }
+  }
+}
+
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_ReadWideStruct)
+{
+  read_wide_struct<DCPS::FinalWideStruct_xtag>(xcdr2);
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Final_ReadWideStructXCDR1)
+{
+  read_wide_struct<DCPS::FinalWideStruct_xtag>(xcdr1);
+}
+
+TEST(dds_DCPS_XTypes_DynamicDataXcdrReadImpl, Mutable_ReadWideStruct)
+{
+  read_wide_struct<DCPS::MutableWideStruct_xtag>(xcdr2);
+}
 #endif // OPENDDS_SAFETY_PROFILE
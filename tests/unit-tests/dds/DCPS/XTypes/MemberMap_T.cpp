@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <dds/DCPS/XTypes/MemberMap_T.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace OpenDDS::XTypes;
+
+namespace {
+  typedef MemberMap<ACE_CDR::ULong, std::string> Map;
+}
+
+TEST(dds_DCPS_XTypes_MemberMap_T, insert_in_order)
+{
+  Map map(4);
+  EXPECT_TRUE(map.empty());
+  for (ACE_CDR::ULong i = 0; i < 10; ++i) {
+    EXPECT_TRUE(map.insert(std::make_pair(i, std::string(1, char('a' + i)))).second);
+  }
+  EXPECT_EQ(10u, map.size());
+  for (ACE_CDR::ULong i = 0; i < 10; ++i) {
+    const Map::const_iterator pos = map.find(i);
+    ASSERT_NE(map.end(), pos);
+    EXPECT_EQ(i, pos->first);
+    EXPECT_EQ(std::string(1, char('a' + i)), pos->second);
+  }
+  EXPECT_EQ(map.end(), map.find(10));
+  EXPECT_EQ(9u, map.rbegin()->first);
+}
+
+TEST(dds_DCPS_XTypes_MemberMap_T, insert_out_of_order)
+{
+  Map map;
+  EXPECT_TRUE(map.insert(std::make_pair(30u, std::string("c"))).second);
+  EXPECT_TRUE(map.insert(std::make_pair(10u, std::string("a"))).second);
+  EXPECT_TRUE(map.insert(std::make_pair(20u, std::string("b"))).second);
+  EXPECT_TRUE(map.insert(std::make_pair(1u, std::string("z"))).second);
+
+  // Existing values are not replaced.
+  const std::pair<Map::iterator, bool> result = map.insert(std::make_pair(20u, std::string("x")));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("b", result.first->second);
+
+  ASSERT_EQ(4u, map.size());
+  Map::const_iterator pos = map.begin();
+  EXPECT_EQ(1u, pos->first);
+  EXPECT_EQ(10u, (++pos)->first);
+  EXPECT_EQ(20u, (++pos)->first);
+  EXPECT_EQ(30u, (++pos)->first);
+  EXPECT_EQ(map.end(), ++pos);
+
+  // 1 is at position 0 but 0 isn't in the map.
+  EXPECT_EQ(map.end(), map.find(0));
+  EXPECT_EQ("z", map.find(1)->second);
+  EXPECT_EQ(map.end(), map.find(2));
+  EXPECT_EQ("c", map.find(30)->second);
+}
+
+TEST(dds_DCPS_XTypes_MemberMap_T, erase)
+{
+  Map map;
+  for (ACE_CDR::ULong i = 0; i < 5; ++i) {
+    map.insert(std::make_pair(i, std::string(1, char('a' + i))));
+  }
+  EXPECT_EQ(1u, map.erase(2));
+  EXPECT_EQ(0u, map.erase(2));
+  EXPECT_EQ(map.end(), map.find(2));
+  // 3 and 4 are no longer at their positions.
+  EXPECT_EQ("d", map.find(3)->second);
+  EXPECT_EQ("e", map.find(4)->second);
+  EXPECT_EQ("a", map.find(0)->second);
+
+  map.erase(map.find(0));
+  EXPECT_EQ(3u, map.size());
+  EXPECT_EQ(1u, map.begin()->first);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.end(), map.find(1));
+}
+
+TEST(dds_DCPS_XTypes_MemberMap_T, swap)
+{
+  Map a;
+  Map b;
+  a.insert(std::make_pair(1u, std::string("a")));
+  b.insert(std::make_pair(2u, std::string("b")));
+  b.insert(std::make_pair(3u, std::string("c")));
+  a.swap(b);
+  EXPECT_EQ(2u, a.size());
+  EXPECT_EQ(1u, b.size());
+  EXPECT_EQ("c", a.find(3)->second);
+  EXPECT_EQ("a", b.find(1)->second);
+}
+
+TEST(dds_DCPS_XTypes_MemberMap_T, member_slots)
+{
+  // Hashed ids like those of @autoid(HASH) members.
+  const ACE_CDR::ULong ids[] = {0x0e2a5f31u, 7u, 0x7c1d9b02u, 0x01b3e4c5u};
+  MemberSlots slots;
+  for (size_t i = 0; i < sizeof ids / sizeof ids[0]; ++i) {
+    slots.add(ids[i]);
+  }
+  slots.add(7u);
+  EXPECT_EQ(4u, slots.count());
+  EXPECT_EQ(0u, slots.slot(0x0e2a5f31u));
+  EXPECT_EQ(1u, slots.slot(7u));
+  EXPECT_EQ(3u, slots.slot(0x01b3e4c5u));
+  EXPECT_EQ(no_member_slot, slots.slot(8u));
+
+  Map map;
+  map.insert(std::make_pair(0x7c1d9b02u, std::string("c")));
+  map.member_slots(&slots);
+  map.insert(std::make_pair(0x0e2a5f31u, std::string("a")));
+  map.insert(std::make_pair(7u, std::string("b")));
+  // 8 has no slot.
+  map.insert(std::make_pair(8u, std::string("x")));
+  ASSERT_EQ(4u, map.size());
+  EXPECT_EQ(7u, map.begin()->first);
+  EXPECT_EQ("a", map.find(0x0e2a5f31u)->second);
+  EXPECT_EQ("b", map.find(7u)->second);
+  EXPECT_EQ("c", map.find(0x7c1d9b02u)->second);
+  EXPECT_EQ("x", map.find(8u)->second);
+  EXPECT_EQ(map.end(), map.find(0x01b3e4c5u));
+
+  EXPECT_EQ(1u, map.erase(7u));
+  EXPECT_EQ(map.end(), map.find(7u));
+  EXPECT_EQ("a", map.find(0x0e2a5f31u)->second);
+  EXPECT_EQ("c", map.find(0x7c1d9b02u)->second);
+  EXPECT_EQ("x", map.find(8u)->second);
+
+  Map other;
+  other.swap(map);
+  EXPECT_EQ("c", other.find(0x7c1d9b02u)->second);
+  other.clear();
+  EXPECT_EQ(map.end(), map.find(0x7c1d9b02u));
+  EXPECT_EQ(other.end(), other.find(0x7c1d9b02u));
+}
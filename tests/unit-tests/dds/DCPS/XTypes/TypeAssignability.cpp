@@ -3743,6 +3743,52 @@ TEST(dds_DCPS_XTypes_TypeAssignability, StructTypeTest_PreventTypeWidening)
   EXPECT_TRUE(test.assignable(TypeObject(MinimalTypeObject(b)), TypeObject(MinimalTypeObject(a))));
 }
 
+TEST(dds_DCPS_XTypes_TypeAssignability, TypeInformationCache)
+{
+  const TypeLookupService_rch tls = make_rch<TypeLookupService>();
+  TypeAssignability test(tls);
+
+  MinimalStructType a, b;
+  a.struct_flags = IS_APPENDABLE;
+  b.struct_flags = IS_APPENDABLE;
+  a.member_seq.append(MinimalStructMember(CommonStructMember(1, StructMemberFlag(),
+                                                             TypeIdentifier(TK_INT32)),
+                                          MinimalMemberDetail("m1")));
+  a.member_seq.append(MinimalStructMember(CommonStructMember(2, StructMemberFlag(),
+                                                             TypeIdentifier(TK_INT32)),
+                                          MinimalMemberDetail("m2")));
+  b.member_seq.append(MinimalStructMember(CommonStructMember(1, StructMemberFlag(),
+                                                             TypeIdentifier(TK_INT32)),
+                                          MinimalMemberDetail("m1")));
+  const TypeObject to_a = TypeObject(MinimalTypeObject(a));
+  const TypeObject to_b = TypeObject(MinimalTypeObject(b));
+
+  TypeInformation info_a, info_b;
+  info_a.minimal.typeid_with_size.type_id = makeTypeIdentifier(to_a);
+  info_b.minimal.typeid_with_size.type_id = makeTypeIdentifier(to_b);
+
+  // b isn't known yet.
+  test.insert_entry(info_a.minimal.typeid_with_size.type_id, to_a);
+  EXPECT_FALSE(test.assignable(info_a, info_b));
+  EXPECT_FALSE(test.assignable(info_a, info_b));
+  EXPECT_EQ(1u, tls->assignability_cache_misses());
+  EXPECT_EQ(1u, tls->assignability_cache_hits());
+
+  // Learning about b invalidates the cached result.
+  test.insert_entry(info_b.minimal.typeid_with_size.type_id, to_b);
+  EXPECT_TRUE(test.assignable(info_a, info_b));
+  EXPECT_TRUE(test.assignable(info_a, info_b));
+  EXPECT_EQ(2u, tls->assignability_cache_misses());
+  EXPECT_EQ(2u, tls->assignability_cache_hits());
+
+  // Results are cached separately for each direction and consistency policy.
+  EXPECT_TRUE(test.assignable(info_b, info_a));
+  test.set_prevent_type_widening(true);
+  EXPECT_FALSE(test.assignable(info_a, info_b));
+  EXPECT_EQ(4u, tls->assignability_cache_misses());
+  EXPECT_EQ(2u, tls->assignability_cache_hits());
+}
+
 TEST(dds_DCPS_XTypes_TypeAssignability, StructTypeTest_NotAssignable)
 {
   expect_false_different_extensibilities();
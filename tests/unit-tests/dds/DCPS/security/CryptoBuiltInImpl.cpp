@@ -3,6 +3,8 @@
 #if OPENDDS_CONFIG_SECURITY
 
 #include "dds/DCPS/LocalObject.h"
+#include "dds/DCPS/Message_Block_Ptr.h"
+#include "dds/DCPS/RTPS/MessageTypes.h"
 #include "dds/DCPS/security/CryptoBuiltInImpl.h"
 #include "dds/DdsDcpsInfrastructureC.h"
 #include "dds/DdsSecurityCoreC.h"
@@ -1101,4 +1103,108 @@ TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, decode_serialize
   EXPECT_EQ(get_buffer(), output);
 }
 
+TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, encode_batch_DataWriterSubmessage)
+{
+  using namespace DDS::Security;
+  CryptoKeyFactory& kef = dynamic_cast<CryptoKeyFactory&>(get_inst());
+  CryptoKeyExchange& kex = dynamic_cast<CryptoKeyExchange&>(get_inst());
+  BatchCryptoTransform& batch = test_class_;
+
+  DDS::PropertySeq no_properties;
+  EndpointSecurityAttributes esa = {{false, false, false, false}, true, false, false,
+    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_SUBMESSAGE_ENCRYPTED, no_properties};
+  SecurityException ex;
+  const DatawriterCryptoHandle local_dwch = kef.register_local_datawriter(0, no_properties, esa, ex);
+  const DatareaderCryptoHandle drch = kef.register_local_datareader(0, no_properties, esa, ex);
+  const ParticipantCryptoHandle rpch = kef.register_matched_remote_participant(0, 1, 2, &shared_secret_, ex);
+  const DatawriterCryptoHandle remote_dwch = kef.register_matched_remote_datawriter(drch, rpch, &shared_secret_, ex);
+
+  DatawriterCryptoTokenSeq dwct;
+  ASSERT_TRUE(kex.create_local_datawriter_crypto_tokens(dwct, local_dwch, 99, ex));
+  ASSERT_TRUE(kex.set_remote_datawriter_crypto_tokens(drch, remote_dwch, dwct, ex));
+
+  // RTPS Header followed by a 32 byte big-endian submessage
+  static const CORBA::ULong sm_len = 32;
+  init_buffer(OpenDDS::RTPS::RTPSHDR_SZ + sm_len, 5);
+  DDS::OctetSeq& plain = get_buffer();
+  plain[OpenDDS::RTPS::RTPSHDR_SZ + 1] = 0;
+  plain[OpenDDS::RTPS::RTPSHDR_SZ + 2] = 0;
+  plain[OpenDDS::RTPS::RTPSHDR_SZ + 3] = sm_len - OpenDDS::RTPS::SMHDR_SZ;
+
+  BatchCryptoTransform::SubmessageSeq submessages;
+  const BatchCryptoTransform::Submessage sm = {OpenDDS::RTPS::RTPSHDR_SZ, sm_len, true, local_dwch, DDS::HANDLE_NIL};
+  submessages.push_back(sm);
+
+  const OpenDDS::DCPS::Message_Block_Ptr encoded(
+    batch.encode_batch(reinterpret_cast<const char*>(plain.get_buffer()), plain.length(),
+                       submessages, DDS::HANDLE_NIL, ex));
+  ASSERT_TRUE(encoded);
+  ASSERT_GT(encoded->length(), plain.length());
+  EXPECT_EQ(0, std::memcmp(encoded->rd_ptr(), plain.get_buffer(), OpenDDS::RTPS::RTPSHDR_SZ));
+  EXPECT_EQ(static_cast<char>(OpenDDS::RTPS::SEC_PREFIX), encoded->rd_ptr()[OpenDDS::RTPS::RTPSHDR_SZ]);
+
+  const CORBA::ULong encoded_sm_len = static_cast<CORBA::ULong>(encoded->length() - OpenDDS::RTPS::RTPSHDR_SZ);
+  DDS::OctetSeq encoded_sm(encoded_sm_len);
+  encoded_sm.length(encoded_sm_len);
+  std::memcpy(encoded_sm.get_buffer(), encoded->rd_ptr() + OpenDDS::RTPS::RTPSHDR_SZ, encoded_sm_len);
+
+  DDS::OctetSeq decoded;
+  ASSERT_TRUE(get_inst().decode_datawriter_submessage(decoded, encoded_sm, drch, remote_dwch, ex));
+  ASSERT_EQ(sm_len, decoded.length());
+  EXPECT_EQ(0, std::memcmp(decoded.get_buffer(), plain.get_buffer() + OpenDDS::RTPS::RTPSHDR_SZ, sm_len));
+}
+
+TEST_F(dds_DCPS_security_CryptoBuiltInImpl_CryptoTransformTest, serialized_payload_CachedCipherContexts)
+{
+  using namespace DDS::Security;
+  CryptoKeyFactory& kef = dynamic_cast<CryptoKeyFactory&>(get_inst());
+  CryptoKeyExchange& kex = dynamic_cast<CryptoKeyExchange&>(get_inst());
+
+  DDS::PropertySeq no_properties;
+  EndpointSecurityAttributes esa = {{false, false, false, false}, false, true, false,
+    PLUGIN_ENDPOINT_SECURITY_ATTRIBUTES_FLAG_IS_PAYLOAD_ENCRYPTED, no_properties};
+  SecurityException ex;
+  const DatawriterCryptoHandle local_dwch = kef.register_local_datawriter(0, no_properties, esa, ex);
+  const DatareaderCryptoHandle drch = kef.register_local_datareader(0, no_properties, esa, ex);
+  const ParticipantCryptoHandle rpch = kef.register_matched_remote_participant(0, 1, 2, &shared_secret_, ex);
+  const DatawriterCryptoHandle remote_dwch = kef.register_matched_remote_datawriter(drch, rpch, &shared_secret_, ex);
+
+  DatawriterCryptoTokenSeq dwct;
+  ASSERT_TRUE(kex.create_local_datawriter_crypto_tokens(dwct, local_dwch, 99, ex));
+  ASSERT_TRUE(kex.set_remote_datawriter_crypto_tokens(drch, remote_dwch, dwct, ex));
+
+  // Each 1024 byte payload uses 64 AES blocks, so the writer moves to a new
+  // session every 16 samples.  Both sides then derive a new session key,
+  // which has to replace the one in the cached contexts.
+  static const CORBA::ULong session_id_offset = 8;
+  const DDS::OctetSeq inline_qos;
+  DDS::OctetSeq session_id;
+  int sessions = 0;
+  for (int i = 0; i < 64; ++i) {
+    // Alternate between encoding with the cached contexts and decoding with
+    // per-call ones and the reverse, so each side's cached context is left
+    // behind while the other kind is used.
+    const bool encode_cached = i % 2 == 0;
+    init_buffer(1024, static_cast<CORBA::Octet>(i + 1));
+
+    DDS::OctetSeq encoded;
+    test_class_.reuse_cipher_contexts(encode_cached);
+    ASSERT_TRUE(get_inst().encode_serialized_payload(encoded, inline_qos, get_buffer(), local_dwch, ex));
+    ASSERT_GT(encoded.length(), session_id_offset + 4);
+    EXPECT_NE(get_buffer(), encoded);
+    if (session_id.length() == 0 ||
+        std::memcmp(session_id.get_buffer(), encoded.get_buffer() + session_id_offset, 4) != 0) {
+      session_id.length(4);
+      std::memcpy(session_id.get_buffer(), encoded.get_buffer() + session_id_offset, 4);
+      ++sessions;
+    }
+
+    DDS::OctetSeq decoded;
+    test_class_.reuse_cipher_contexts(!encode_cached);
+    ASSERT_TRUE(get_inst().decode_serialized_payload(decoded, encoded, inline_qos, drch, remote_dwch, ex));
+    EXPECT_EQ(get_buffer(), decoded);
+  }
+  EXPECT_GE(sessions, 4);
+}
+
 #endif
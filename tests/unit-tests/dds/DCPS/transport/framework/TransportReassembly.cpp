@@ -1188,3 +1188,121 @@ TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Fill_Overlapping_Inp
   EXPECT_EQ(0u, base);
   EXPECT_EQ(0u, gaps.result_bits);
 }
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Out_Of_Order)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024, 1024 * 1024);
+  Gaps gaps;
+  SequenceNumber msg_seq(5);
+  GUID_t pub_id = create_pub_id();
+  const size_t sample_size = 1024 * 4 + 100;
+  Sample data1(pub_id, msg_seq, true, 1024, 'a');
+  Sample data2(pub_id, msg_seq, true, 1024, 'b');
+  Sample data3(pub_id, msg_seq, true, 1024, 'c');
+  Sample data3_dup(pub_id, msg_seq, true, 1024, 'c');
+  Sample data4(pub_id, msg_seq, true, 1024, 'd');
+  // The last fragment is followed by submessage padding
+  Sample data5(pub_id, msg_seq, false, 104, 'e');
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(3, 3), data3.sample, 5, sample_size)); // 3
+  EXPECT_EQ(sample_size, tr.contiguous_size());
+  EXPECT_FALSE(tr.reassemble(FragmentRange(5, 5), data5.sample, 5, sample_size)); // 3,5
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), data1.sample, 5, sample_size)); // 1,3,5
+
+  CORBA::ULong base = gaps.get(tr, msg_seq, pub_id);
+  EXPECT_EQ(2u, base);
+  EXPECT_EQ(3u, gaps.result_bits);
+  EXPECT_TRUE(gaps.check_gap(2));
+  EXPECT_FALSE(gaps.check_gap(3));
+  EXPECT_TRUE(gaps.check_gap(4));
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(4, 4), data4.sample, 5, sample_size)); // 1,3-5
+  EXPECT_FALSE(tr.reassemble(FragmentRange(3, 3), data3_dup.sample, 5, sample_size)); // duplicate
+  EXPECT_TRUE(tr.reassemble(FragmentRange(2, 2), data2.sample, 5, sample_size)); // 1-5
+  EXPECT_FALSE(tr.has_frags(msg_seq, pub_id));
+  EXPECT_EQ(0u, tr.contiguous_size());
+
+  DDS::OctetSeq data = data2.sample.copy_data();
+  ASSERT_EQ(sample_size, data.length());
+  EXPECT_EQ(sample_size, data2.sample.header_.message_length_);
+  EXPECT_FALSE(data2.sample.header_.more_fragments_);
+  for (CORBA::ULong i = 0; i < data.length(); ++i) {
+    ASSERT_EQ('a' + i / 1024, data[i]);
+  }
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Gaps_To_End)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024, 1024 * 1024);
+  Gaps gaps;
+  SequenceNumber msg_seq(6);
+  GUID_t pub_id = create_pub_id();
+  Sample data(pub_id, msg_seq, true, 1024 * 2, 'a');
+
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 2), data.sample, 5, 1024 * 5)); // 1-2
+  CORBA::ULong base = gaps.get(tr, msg_seq, pub_id);
+  EXPECT_EQ(3u, base);
+  EXPECT_EQ(3u, gaps.result_bits);
+  EXPECT_TRUE(gaps.check_gap(3));
+  EXPECT_TRUE(gaps.check_gap(4));
+  EXPECT_TRUE(gaps.check_gap(5));
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Small_Fragments)
+{
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024, 1024 * 1024);
+  SequenceNumber msg_seq(8);
+  GUID_t pub_id = create_pub_id();
+  const ACE_UINT32 fragment_size = TransportReassembly::MIN_CONTIGUOUS_FRAGMENT_SIZE - 1;
+  Sample data1(pub_id, msg_seq, true, fragment_size, 'a');
+  Sample data2(pub_id, msg_seq, false, fragment_size, 'b');
+  data1.sample.fragment_size_ = data2.sample.fragment_size_ = fragment_size;
+
+  // Fragments this small use the list
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), data1.sample, 2, fragment_size * 2));
+  EXPECT_EQ(0u, tr.contiguous_size());
+  EXPECT_TRUE(tr.reassemble(FragmentRange(2, 2), data2.sample, 2, fragment_size * 2));
+  EXPECT_EQ(fragment_size * 2, data2.sample.data_length());
+}
+
+TEST(dds_DCPS_transport_framework_TransportReassembly, Test_Contiguous_Writer_Limit)
+{
+  const size_t sample_size = 1024 * 2;
+  TransportReassembly tr(TimeDuration(300), 1024 * 1024, sample_size * 2);
+  GUID_t pub_id = create_pub_id();
+  GUID_t other_pub_id = create_pub_id();
+  const GUID_t pub_ids[] = { pub_id, pub_id, pub_id, other_pub_id };
+  Sample_rch first[4];
+  Sample_rch last[4];
+  for (CORBA::ULong i = 0; i < 4; ++i) {
+    const SequenceNumber seq(i + 1);
+    first[i] = make_rch<Sample>(pub_ids[i], seq, true, 1024, static_cast<unsigned char>('a' + i));
+    last[i] = make_rch<Sample>(pub_ids[i], seq, false, 1024, static_cast<unsigned char>('a' + i));
+  }
+
+  // The third sample from the writer is over its limit and uses the list
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), first[0]->sample, 2, sample_size));
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), first[1]->sample, 2, sample_size));
+  EXPECT_EQ(sample_size * 2, tr.contiguous_size());
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), first[2]->sample, 2, sample_size));
+  EXPECT_EQ(sample_size * 2, tr.contiguous_size());
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), first[3]->sample, 2, sample_size));
+  EXPECT_EQ(sample_size * 3, tr.contiguous_size());
+
+  for (CORBA::ULong i = 0; i < 4; ++i) {
+    EXPECT_TRUE(tr.reassemble(FragmentRange(2, 2), last[i]->sample, 2, sample_size));
+    DDS::OctetSeq data = last[i]->sample.copy_data();
+    ASSERT_EQ(sample_size, data.length());
+    EXPECT_EQ('a' + i, data[0]);
+    EXPECT_EQ('a' + i, data[sample_size - 1]);
+  }
+  EXPECT_EQ(0u, tr.contiguous_size());
+
+  // Once the writer's samples are complete it can use the buffer again
+  const SequenceNumber next_seq(5);
+  Sample next(pub_id, next_seq, true, 1024, 'e');
+  EXPECT_FALSE(tr.reassemble(FragmentRange(1, 1), next.sample, 2, sample_size));
+  EXPECT_EQ(sample_size, tr.contiguous_size());
+  tr.data_unavailable(next_seq, pub_id);
+  EXPECT_EQ(0u, tr.contiguous_size());
+}
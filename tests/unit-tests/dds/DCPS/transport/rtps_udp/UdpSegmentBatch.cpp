@@ -0,0 +1,171 @@
+/*
+ * Distributed under the OpenDDS License.
+ * See: http://www.opendds.org/license.html
+ */
+
+#include <gtest/gtest.h>
+
+#include <dds/DCPS/transport/rtps_udp/UdpSegmentBatch.h>
+
+#include <cstring>
+#include <string>
+
+using namespace OpenDDS::DCPS;
+
+namespace {
+  class TestSender : public UdpSegmentBatch::Sender {
+  public:
+    TestSender()
+      : segments_result(0)
+      , datagram_result(0)
+      , segment_calls(0)
+    {}
+
+    ssize_t send_segments(const NetworkAddress& addr, const UdpSegmentBatch& batch)
+    {
+      ++segment_calls;
+      if (segments_result >= 0) {
+        segments[addr] = std::string(batch.data(), batch.length());
+      }
+      return segments_result;
+    }
+
+    ssize_t send_datagram(const iovec& iov, const NetworkAddressSet& addrs)
+    {
+      const std::string datagram(static_cast<const char*>(iov.iov_base), iov.iov_len);
+      for (NetworkAddressSet::const_iterator it = addrs.begin(); it != addrs.end(); ++it) {
+        datagrams[*it].push_back(datagram);
+      }
+      return datagram_result;
+    }
+
+    ssize_t segments_result;
+    ssize_t datagram_result;
+    int segment_calls;
+    OPENDDS_MAP(NetworkAddress, std::string) segments;
+    OPENDDS_MAP(NetworkAddress, OPENDDS_VECTOR(std::string)) datagrams;
+  };
+
+  void append(UdpSegmentBatch& batch, const char* data, const NetworkAddressSet& addrs)
+  {
+    iovec iov[2];
+    const size_t length = std::strlen(data);
+    iov[0].iov_base = const_cast<char*>(data);
+    iov[0].iov_len = length / 2;
+    iov[1].iov_base = const_cast<char*>(data) + length / 2;
+    iov[1].iov_len = length - length / 2;
+    batch.append(iov, 2, addrs);
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_UdpSegmentBatch, append)
+{
+  const NetworkAddress addr1("127.0.0.1:1234");
+  const NetworkAddress addr2("127.0.0.1:1235");
+  NetworkAddressSet addrs;
+  addrs.insert(addr1);
+  UdpSegmentBatch batch(16);
+  EXPECT_TRUE(batch.empty());
+  EXPECT_FALSE(batch.needs_flush(addrs, 4));
+
+  append(batch, "abcd", addrs);
+  EXPECT_EQ(batch.segments(), 1u);
+  EXPECT_EQ(batch.segment_size(), 4u);
+  EXPECT_FALSE(batch.complete(4, true));
+  EXPECT_TRUE(batch.complete(4, false));
+  EXPECT_TRUE(batch.complete(3, true));
+
+  EXPECT_FALSE(batch.needs_flush(addrs, 4));
+  EXPECT_TRUE(batch.needs_flush(addrs, 5));
+  NetworkAddressSet other;
+  other.insert(addr2);
+  EXPECT_TRUE(batch.needs_flush(other, 4));
+
+  append(batch, "efgh", addrs);
+  append(batch, "ijkl", addrs);
+  append(batch, "mn", addrs);
+  EXPECT_EQ(batch.length(), 14u);
+  EXPECT_EQ(std::string(batch.data(), batch.length()), "abcdefghijklmn");
+  EXPECT_TRUE(batch.needs_flush(addrs, 4));
+}
+
+TEST(dds_DCPS_transport_rtps_udp_UdpSegmentBatch, flush)
+{
+  const NetworkAddress addr1("127.0.0.1:1234");
+  const NetworkAddress addr2("127.0.0.1:1235");
+  NetworkAddressSet addrs;
+  addrs.insert(addr1);
+  addrs.insert(addr2);
+  UdpSegmentBatch batch(16);
+  append(batch, "abcd", addrs);
+  append(batch, "efg", addrs);
+
+  TestSender sender;
+  EXPECT_TRUE(batch.flush(sender));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(sender.segment_calls, 2);
+  EXPECT_EQ(sender.segments[addr1], "abcdefg");
+  EXPECT_EQ(sender.segments[addr2], "abcdefg");
+  EXPECT_TRUE(sender.datagrams.empty());
+}
+
+TEST(dds_DCPS_transport_rtps_udp_UdpSegmentBatch, flush_one_segment)
+{
+  const NetworkAddress addr1("127.0.0.1:1234");
+  NetworkAddressSet addrs;
+  addrs.insert(addr1);
+  UdpSegmentBatch batch(16);
+  append(batch, "abcd", addrs);
+
+  TestSender sender;
+  EXPECT_TRUE(batch.flush(sender));
+  EXPECT_EQ(sender.segment_calls, 0);
+  ASSERT_EQ(sender.datagrams[addr1].size(), 1u);
+  EXPECT_EQ(sender.datagrams[addr1][0], "abcd");
+}
+
+TEST(dds_DCPS_transport_rtps_udp_UdpSegmentBatch, flush_fallback)
+{
+  const NetworkAddress addr1("127.0.0.1:1234");
+  const NetworkAddress addr2("127.0.0.1:1235");
+  NetworkAddressSet addrs;
+  addrs.insert(addr1);
+  addrs.insert(addr2);
+  UdpSegmentBatch batch(16);
+  append(batch, "abcd", addrs);
+  append(batch, "efgh", addrs);
+  append(batch, "ij", addrs);
+
+  // Segmentation fails, so each segment is sent on its own.
+  TestSender sender;
+  sender.segments_result = -1;
+  EXPECT_TRUE(batch.flush(sender));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(sender.segment_calls, 2);
+  EXPECT_TRUE(sender.segments.empty());
+  for (int i = 0; i < 2; ++i) {
+    const OPENDDS_VECTOR(std::string)& datagrams = sender.datagrams[i ? addr2 : addr1];
+    ASSERT_EQ(datagrams.size(), 3u);
+    EXPECT_EQ(datagrams[0], "abcd");
+    EXPECT_EQ(datagrams[1], "efgh");
+    EXPECT_EQ(datagrams[2], "ij");
+  }
+}
+
+TEST(dds_DCPS_transport_rtps_udp_UdpSegmentBatch, flush_error)
+{
+  const NetworkAddress addr1("127.0.0.1:1234");
+  NetworkAddressSet addrs;
+  addrs.insert(addr1);
+  UdpSegmentBatch batch(16);
+  append(batch, "abcd", addrs);
+  append(batch, "ef", addrs);
+
+  // Nothing was sent, so the batch isn't reported as sent.
+  TestSender sender;
+  sender.segments_result = -1;
+  sender.datagram_result = -1;
+  EXPECT_FALSE(batch.flush(sender));
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(sender.datagrams[addr1].size(), 2u);
+}
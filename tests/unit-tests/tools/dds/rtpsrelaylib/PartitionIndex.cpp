@@ -200,6 +200,49 @@ TEST(tools_dds_rtpsrelaylib_PartitionIndex, maintest)
   }
 }
 
+TEST(tools_dds_rtpsrelaylib_PartitionIndex, Snapshot)
+{
+  PartitionIndex<StringSet, Identity> pi;
+  pi.insert("", "empty");
+  pi.insert("apple", "a");
+  pi.insert("avocado", "a");
+  pi.insert("orange", "o");
+  pi.insert("*a*e*", "glob");
+  pi.insert("?pp[lmnop][!i]", "class");
+  pi.insert("\\*x", "escaped");
+  pi.insert("banana", "b");
+  pi.remove("banana", "b");
+
+  PartitionIndexSnapshot<StringSet, Identity> snapshot(pi, 3);
+  EXPECT_EQ(3u, snapshot.version());
+  EXPECT_EQ(pi.size(), snapshot.size());
+
+  const char* const names[] = {
+    "", "*", "apple", "avocado", "orange", "banana", "*a*e*", "?pp[lmnop][!i]",
+    "[ab]pple", "a*", "**e", "\\*x", "*x", "appl", "grape"
+  };
+  StringSet limits;
+  limits.insert("a");
+  limits.insert("glob");
+
+  for (int expanded = 0; expanded != 2; ++expanded) {
+    for (const auto name : names) {
+      StringSet expected;
+      pi.lookup(name, expected);
+      StringSet actual;
+      snapshot.lookup(name, actual);
+      EXPECT_EQ(expected, actual) << name;
+
+      expected.clear();
+      pi.lookup(name, expected, &limits);
+      actual.clear();
+      snapshot.lookup(name, actual, &limits);
+      EXPECT_EQ(expected, actual) << name;
+    }
+    snapshot.expand();
+  }
+}
+
 TEST(tools_dds_rtpsrelaylib_PartitionIndex, Identity)
 {
   Identity id;
@@ -4,7 +4,13 @@
 #include "Name.h"
 #include "Utility.h"
 
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace RtpsRelay {
 
@@ -23,6 +29,9 @@ struct Identity {
 };
 
 
+template <typename T, typename Transformer>
+class PartitionIndexSnapshot;
+
 template<typename T, typename Transformer>
 class TrieNode {
 public:
@@ -68,6 +77,8 @@ public:
   }
 
 private:
+  friend class PartitionIndexSnapshot<T, Transformer>;
+
   using ChildrenType = std::unordered_map<Atom, NodePtr, AtomHash>;
   ChildrenType children_;
   T guids_;
@@ -278,12 +289,292 @@ public:
   };
 
 private:
+  friend class PartitionIndexSnapshot<T, Transformer>;
+
   typename TrieNodeT::NodePtr root_;
   size_t size_;
   using Cache = std::unordered_map<std::string, T>;
   mutable Cache cache_;
 };
 
+/// Immutable copy of a PartitionIndex for lookups that don't lock or
+/// allocate (other than to insert into the output).
+///
+/// The trie is stored in flat arrays: the children of a node are a
+/// contiguous range of edges, the values of a node are a contiguous range of
+/// values, and each distinct character class is stored once as a bitset.  The
+/// result of looking up each name that was inserted into the index is
+/// computed by expand() so lookups of those names are a single hash lookup.
+template <typename T, typename Transformer>
+class PartitionIndexSnapshot {
+public:
+  using Index = PartitionIndex<T, Transformer>;
+  using Value = typename T::value_type;
+
+  /// Flatten index, which must not change during the call.  version
+  /// identifies the state of index for the caller.
+  PartitionIndexSnapshot(const Index& index, size_t version)
+    : version_(version)
+    , expanded_(false)
+  {
+    std::unordered_map<std::string, std::uint32_t> classes;
+    nodes_.push_back(Node());
+    flatten(index.root_, 0, "", classes);
+  }
+
+  size_t version() const { return version_; }
+
+  /// Number of trie nodes
+  size_t size() const { return nodes_.size(); }
+
+  /// Compute the results of looking up each name that was inserted.  This
+  /// only reads the snapshot, so it doesn't need the lock that protects the
+  /// original index.
+  void expand()
+  {
+    if (expanded_) {
+      return;
+    }
+    expansions_.reserve(names_.size());
+    for (const auto& name : names_) {
+      T result;
+      Output out(result, nullptr);
+      lookup_trie(name, out);
+      const auto begin = static_cast<std::uint32_t>(expansion_values_.size());
+      expansion_values_.insert(expansion_values_.end(), result.begin(), result.end());
+      expansions_[name] = Range(begin, static_cast<std::uint32_t>(expansion_values_.size()));
+    }
+    std::vector<std::string>().swap(names_);
+    expanded_ = true;
+  }
+
+  /// Same as PartitionIndex::lookup
+  void lookup(const std::string& name, T& guids, const T* allowed = nullptr) const
+  {
+    Output out(guids, allowed);
+    const auto pos = expansions_.find(name);
+    if (pos != expansions_.end()) {
+      out.insert(expansion_values_, pos->second);
+      return;
+    }
+    lookup_trie(name, out);
+  }
+
+private:
+  using Range = std::pair<std::uint32_t, std::uint32_t>;
+
+  struct Node {
+    Range edges;
+    Range values;
+  };
+
+  struct Edge {
+    Atom::Kind kind;
+    char character;     // For CHARACTER.
+    std::uint32_t set;  // Index in classes_ for CHARACTER_CLASS and NEGATED_CHARACTER_CLASS.
+    std::uint32_t node;
+  };
+
+  using CharacterClass = std::bitset<256>;
+
+  class Output {
+  public:
+    Output(T& output, const T* limits)
+      : output_(output)
+      , limits_(limits)
+    {}
+
+    void insert(const std::vector<Value>& values, const Range& range)
+    {
+      if (limits_) {
+        for (auto idx = range.first; idx != range.second; ++idx) {
+          if (limits_->count(values[idx])) {
+            output_.insert(values[idx]);
+          }
+        }
+      } else {
+        output_.insert(values.begin() + range.first, values.begin() + range.second);
+      }
+    }
+
+  private:
+    T& output_;
+    const T* limits_;
+  };
+
+  const size_t version_;
+  bool expanded_;
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+  std::vector<Value> values_;
+  std::vector<CharacterClass> classes_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, Range> expansions_;
+  std::vector<Value> expansion_values_;
+
+  static unsigned char to_index(char c) { return static_cast<unsigned char>(c); }
+  static char character(char c) { return c; }
+  static char character(const Atom& atom) { return atom.character(); }
+
+  bool matches(const Edge& edge, char c) const
+  {
+    switch (edge.kind) {
+    case Atom::CHARACTER:
+      return edge.character == c;
+    case Atom::CHARACTER_CLASS:
+      return classes_[edge.set][to_index(c)];
+    case Atom::NEGATED_CHARACTER_CLASS:
+      return !classes_[edge.set][to_index(c)];
+    default:
+      return true;
+    }
+  }
+
+  void flatten(const typename Index::TrieNodeT::NodePtr& trie_node,
+               std::uint32_t node,
+               const std::string& name,
+               std::unordered_map<std::string, std::uint32_t>& classes)
+  {
+    const auto values_begin = static_cast<std::uint32_t>(values_.size());
+    std::transform(trie_node->guids_.begin(), trie_node->guids_.end(), std::back_inserter(values_), Transformer());
+    nodes_[node].values = Range(values_begin, static_cast<std::uint32_t>(values_.size()));
+    if (!trie_node->guids_.empty()) {
+      names_.push_back(name);
+    }
+
+    // Reserve the edges first so that they are contiguous.
+    const auto edges_begin = static_cast<std::uint32_t>(edges_.size());
+    nodes_[node].edges = Range(edges_begin, edges_begin + static_cast<std::uint32_t>(trie_node->children_.size()));
+    edges_.resize(nodes_[node].edges.second);
+
+    auto edge = edges_begin;
+    for (const auto& child : trie_node->children_) {
+      const Atom& atom = child.first;
+      std::ostringstream atom_str;
+      atom_str << atom;
+
+      Edge e = { atom.kind(), atom.character(), 0, static_cast<std::uint32_t>(nodes_.size()) };
+      if (atom.kind() == Atom::CHARACTER_CLASS || atom.kind() == Atom::NEGATED_CHARACTER_CLASS) {
+        const auto r = classes.insert(std::make_pair(atom_str.str(), static_cast<std::uint32_t>(classes_.size())));
+        if (r.second) {
+          CharacterClass cc;
+          for (const auto c : atom.characters()) {
+            cc.set(to_index(c));
+          }
+          classes_.push_back(cc);
+        }
+        e.set = r.first->second;
+      }
+      edges_[edge++] = e;
+      nodes_.push_back(Node());
+      flatten(child.second, e.node, name + atom_str.str(), classes);
+    }
+  }
+
+  void lookup_trie(const std::string& name, Output& out) const
+  {
+    // Most names are literals without escapes, so they don't need to be parsed.
+    if (name.find_first_of("*?[\\") == std::string::npos) {
+      lookup_literal(0, name.begin(), name.end(), false, out);
+      return;
+    }
+
+    const Name parsed(name);
+    if (parsed.is_literal()) {
+      lookup_literal(0, parsed.begin(), parsed.end(), false, out);
+    } else {
+      lookup_pattern(0, parsed.begin(), parsed.end(), out);
+    }
+  }
+
+  // The following mirror the functions of the same names in TrieNode.
+
+  template <typename Iter>
+  void lookup_literal(std::uint32_t node, Iter begin, Iter end, bool glob_only, Output& out) const
+  {
+    const Node& n = nodes_[node];
+    if (begin == end) {
+      out.insert(values_, n.values);
+      lookup_globs(node, out);
+      return;
+    }
+
+    const char c = character(*begin);
+
+    for (auto idx = n.edges.first; idx != n.edges.second; ++idx) {
+      const Edge& edge = edges_[idx];
+      if (edge.kind == Atom::GLOB) {
+        // Glob consumes character and remains.
+        lookup_literal(node, std::next(begin), end, true, out);
+        // Glob matches no characters.
+        lookup_literal(edge.node, begin, end, false, out);
+      } else if (!glob_only && matches(edge, c)) {
+        lookup_literal(edge.node, std::next(begin), end, false, out);
+      }
+    }
+  }
+
+  void lookup_globs(std::uint32_t node, Output& out) const
+  {
+    const Node& n = nodes_[node];
+    for (auto idx = n.edges.first; idx != n.edges.second; ++idx) {
+      const Edge& edge = edges_[idx];
+      if (edge.kind == Atom::GLOB) {
+        out.insert(values_, nodes_[edge.node].values);
+        lookup_globs(edge.node, out);
+      }
+    }
+  }
+
+  void lookup_pattern(std::uint32_t node, Name::const_iterator begin, Name::const_iterator end, Output& out) const
+  {
+    const Node& n = nodes_[node];
+    if (begin == end) {
+      out.insert(values_, n.values);
+      return;
+    }
+
+    const auto& atom = *begin;
+
+    if (atom.kind() == Atom::GLOB) {
+      // Glob consumes character and remains.
+      for (auto idx = n.edges.first; idx != n.edges.second; ++idx) {
+        if (edges_[idx].kind == Atom::CHARACTER) {
+          lookup_pattern(edges_[idx].node, begin, end, out);
+        }
+      }
+      // Glob matches no characters.
+      lookup_pattern(node, std::next(begin), end, out);
+      return;
+    }
+
+    for (auto idx = n.edges.first; idx != n.edges.second; ++idx) {
+      const Edge& edge = edges_[idx];
+      if (edge.kind != Atom::CHARACTER) {
+        continue;
+      }
+      bool match = false;
+      switch (atom.kind()) {
+      case Atom::CHARACTER:
+        match = atom.character() == edge.character;
+        break;
+      case Atom::CHARACTER_CLASS:
+        match = atom.characters().count(edge.character) != 0;
+        break;
+      case Atom::NEGATED_CHARACTER_CLASS:
+        match = atom.characters().count(edge.character) == 0;
+        break;
+      default:
+        match = true;
+        break;
+      }
+      if (match) {
+        lookup_pattern(edge.node, std::next(begin), end, out);
+      }
+    }
+  }
+};
+
 }
 
 #endif // RTPSRELAY_PARTITION_INDEX_H_
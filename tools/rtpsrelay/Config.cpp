@@ -87,6 +87,18 @@ bool Config::from_arg(ACE_Arg_Shifter_T<char>& args)
   } else if ((arg = args.get_the_parameter("-HandlerThreads"))) {
     handler_threads(static_cast<size_t>(std::atoi(arg)));
     args.consume_arg();
+  } else if ((arg = args.get_the_parameter("-HandlerShards"))) {
+    handler_shards(static_cast<size_t>(std::atoi(arg)));
+    args.consume_arg();
+  } else if ((arg = args.get_the_parameter("-IoBatchSize"))) {
+    io_batch_size(static_cast<size_t>(std::atoi(arg)));
+    args.consume_arg();
+  } else if ((arg = args.get_the_parameter("-PartitionIndexSnapshots"))) {
+    partition_index_snapshots(ACE_OS::atoi(arg));
+    args.consume_arg();
+  } else if ((arg = args.get_the_parameter("-ForwardingSnapshots"))) {
+    forwarding_snapshots(ACE_OS::atoi(arg));
+    args.consume_arg();
   } else if ((arg = args.get_the_parameter("-SynchronousOutput"))) {
     synchronous_output(ACE_OS::atoi(arg));
     args.consume_arg();
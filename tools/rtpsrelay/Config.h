@@ -465,6 +465,46 @@ public:
     return handler_threads_;
   }
 
+  void handler_shards(size_t count)
+  {
+    handler_shards_ = count;
+  }
+
+  size_t handler_shards() const
+  {
+    return handler_shards_;
+  }
+
+  void io_batch_size(size_t count)
+  {
+    io_batch_size_ = count;
+  }
+
+  size_t io_batch_size() const
+  {
+    return io_batch_size_;
+  }
+
+  void partition_index_snapshots(bool flag)
+  {
+    partition_index_snapshots_ = flag;
+  }
+
+  bool partition_index_snapshots() const
+  {
+    return partition_index_snapshots_;
+  }
+
+  void forwarding_snapshots(bool flag)
+  {
+    forwarding_snapshots_ = flag;
+  }
+
+  bool forwarding_snapshots() const
+  {
+    return forwarding_snapshots_;
+  }
+
   void synchronous_output(bool flag)
   {
     synchronous_output_ = flag;
@@ -690,7 +730,11 @@ private:
   bool allow_empty_partition_ = true;
   OpenDDS::DCPS::TimeDuration run_time_;
   bool synchronous_output_ = false;
+  bool partition_index_snapshots_ = false;
+  bool forwarding_snapshots_ = false;
   size_t handler_threads_ = 1;
+  size_t handler_shards_ = 1;
+  size_t io_batch_size_ = 1;
 
   // User-provided pattern, e.g., "CN=([\d]+)-.*", to extract a component from dds.cert.sn
   // that will be used as the key into the partition cache for asynchronous discovery.
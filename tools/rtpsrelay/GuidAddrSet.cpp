@@ -7,6 +7,10 @@
 
 namespace RtpsRelay {
 
+namespace {
+  const OpenDDS::DCPS::TimeDuration CLIENT_SNAPSHOT_DELAY = OpenDDS::DCPS::TimeDuration::from_msec(100);
+}
+
 PortSet::PortToExpirationMap* PortSet::select(Port p)
 {
   switch (p) {
@@ -117,6 +121,9 @@ GuidAddrSet::~GuidAddrSet()
   if (drain_task_) {
     drain_task_->cancel();
   }
+  if (client_snapshot_task_) {
+    client_snapshot_task_->cancel();
+  }
 
   TheServiceParticipant->config_topic()->disconnect(config_reader_);
 }
@@ -131,6 +138,7 @@ GuidAddrSet::CreatedAddrSetStats GuidAddrSet::find_or_create(const OpenDDS::DCPS
       guid_addr_set_map_.insert(std::make_pair(guid, AddrSetStats(now, relay_stats_reporter_, total_ips_, total_ports_)));
     it = it_bool_pair.first;
     relay_stats_reporter_.local_active_participants(guid_addr_set_map_.size(), now);
+    clients_changed();
   }
   return {create, it->second};
 }
@@ -216,6 +224,7 @@ GuidAddrSet::record_activity(const AddrPort& remote_address,
                  admission_control_queue_.size()));
     }
     relay_stats_reporter_.new_address(now);
+    clients_changed();
     const GuidAddr ga(src_guid, remote_address);
     expiration_guid_addr_queue_.push_back(std::make_pair(expiration, ga));
     relay_stats_reporter_.expiration_queue_size(expiration_guid_addr_queue_.size(), now);
@@ -279,6 +288,7 @@ void GuidAddrSet::process_rejected_address_expiration(const OpenDDS::DCPS::Monot
     }
     rejected_address_map_.erase(reject);
     rejected_address_expiration_queue_.pop_front();
+    clients_changed();
     relay_stats_reporter_.rejected_address_map_size(static_cast<uint32_t>(rejected_address_map_.size()), now);
   }
   schedule_rejected_address_expiration();
@@ -358,6 +368,7 @@ void GuidAddrSet::process_expiration(const OpenDDS::DCPS::MonotonicTimePoint& no
       bool ip_now_unused = false;
       OpenDDS::DCPS::MonotonicTimePoint updated_expiration;
       if (addr_stats.remove_if_expired(ga.address, now, ip_now_unused, updated_expiration)) {
+        clients_changed();
         if (ip_now_unused) {
           const auto remote_iter = remote_map_.find(Remote(ga.address.addr, ga.guid));
           if (remote_iter != remote_map_.end() && OpenDDS::DCPS::equal_guid_prefixes(remote_iter->second, ga.guid)) {
@@ -439,6 +450,7 @@ bool GuidAddrSet::defer_client(bool from_application_participant,
 
   if (from_application_participant) {
     pos->second.allow_rtps = true;
+    clients_changed();
 
     if (config_.log_activity()) {
       ACE_DEBUG((LM_INFO, "(%P|%t) INFO: GuidAddrSet::defer_client: %C was admitted %C into session\n",
@@ -470,6 +482,7 @@ bool GuidAddrSet::defer_client(bool from_application_participant,
 
   pos->second.allow_rtps = true;
   admitted = true;
+  clients_changed();
 
   if (config_.log_activity()) {
     ACE_DEBUG((LM_INFO, "(%P|%t) INFO: GuidAddrSet::defer_client: %C was admitted %C into session\n",
@@ -502,6 +515,7 @@ void GuidAddrSet::remove(const OpenDDS::DCPS::GUID_t& guid,
 
   cleanup_peers_pending_recipients(it);
   guid_addr_set_map_.erase(it);
+  clients_changed();
   remove_cross_relay_pending_recipients(guid);
   relay_stats_reporter_.local_active_participants(guid_addr_set_map_.size(), now);
   check_participants_limit();
@@ -534,6 +548,7 @@ void GuidAddrSet::cleanup_peers_pending_recipients(const GuidAddrSetMap::iterato
       other_it->second.pending_recipients.erase(src_guid);
     }
   }
+  clients_changed();
 }
 
 void GuidAddrSet::reject_address(const ACE_INET_Addr& addr,
@@ -547,6 +562,7 @@ void GuidAddrSet::reject_address(const ACE_INET_Addr& addr,
                  OpenDDS::DCPS::LogAddr(addr).c_str()));
     }
     rejected_address_expiration_queue_.push_back(result.first);
+    clients_changed();
     if (rejected_address_expiration_queue_.size() == 1) {
       schedule_rejected_address_expiration();
     }
@@ -628,6 +644,55 @@ void GuidAddrSet::deny(const OpenDDS::DCPS::GUID_t& guid)
   }
 }
 
+void GuidAddrSet::clients_changed()
+{
+  ++client_snapshot_version_;
+
+  if (!config_.forwarding_snapshots()) {
+    return;
+  }
+
+  if (!client_snapshot_task_) {
+    client_snapshot_task_ =
+      OpenDDS::DCPS::make_rch<OpenDDS::DCPS::SporadicEvent>(TheServiceParticipant->event_dispatcher(),
+                                                            OpenDDS::DCPS::make_rch<GuidAddrSetEvent>(rchandle_from(this), &GuidAddrSet::update_client_snapshot));
+  }
+  // Wait a little so that a burst of changes results in one snapshot.
+  client_snapshot_task_->schedule(CLIENT_SNAPSHOT_DELAY);
+}
+
+void GuidAddrSet::update_client_snapshot(const OpenDDS::DCPS::MonotonicTimePoint&)
+{
+  std::shared_ptr<ClientSnapshot> snapshot;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+    snapshot = std::make_shared<ClientSnapshot>(client_snapshot_version_);
+    snapshot->clients.reserve(guid_addr_set_map_.size());
+    for (const auto& entry : guid_addr_set_map_) {
+      const AddrSetStats& stats = entry.second;
+      ClientSnapshot::Client& client = snapshot->clients[entry.first];
+      client.allow_rtps = stats.allow_rtps;
+      client.async_discovery = !stats.pending_recipients.empty() || !stats.pending_data_peer_relays.empty();
+      stats.foreach_addr(DATA,
+                         [&](const ACE_INET_Addr& addr) {
+                           client.data_addrs.push_back(addr);
+                         });
+    }
+    for (const auto& reject : rejected_address_map_) {
+      snapshot->rejected_addresses.insert(reject.first);
+    }
+  }
+
+  // Don't replace a newer snapshot from a concurrent update.
+  std::shared_ptr<const ClientSnapshot> current = std::atomic_load(&client_snapshot_);
+  while (!current || current->version < snapshot->version) {
+    if (std::atomic_compare_exchange_weak(&client_snapshot_, &current,
+                                          std::shared_ptr<const ClientSnapshot>(snapshot))) {
+      break;
+    }
+  }
+}
+
 void GuidAddrSet::ConfigReaderListener::on_data_available(InternalDataReader_rch reader)
 {
   using OpenDDS::DCPS::ConfigStoreImpl;
@@ -12,7 +12,11 @@
 
 #include <ace/INET_Addr.h>
 
+#include <atomic>
+#include <memory>
 #include <regex>
+#include <unordered_set>
+#include <vector>
 
 namespace RtpsRelay {
 
@@ -232,6 +236,27 @@ struct RemoteHash {
   }
 };
 
+// Immutable copy of the GuidAddrSet state that a DataHandler needs to forward
+// a message from an admitted client without taking the GuidAddrSet's lock.
+// See Config::forwarding_snapshots.
+struct ClientSnapshot {
+  struct Client {
+    bool allow_rtps = false;
+    // Messages from the client also go to pending recipients or peer relays.
+    bool async_discovery = false;
+    std::vector<ACE_INET_Addr> data_addrs;
+  };
+  using Clients = std::unordered_map<OpenDDS::DCPS::GUID_t, Client, GuidHash>;
+
+  explicit ClientSnapshot(size_t a_version)
+    : version(a_version)
+  {}
+
+  const size_t version;
+  Clients clients;
+  std::unordered_set<OpenDDS::DCPS::NetworkAddress> rejected_addresses;
+};
+
 class RelayHandler;
 class RelayParticipantStatusReporter;
 
@@ -281,6 +306,17 @@ public:
 
   ~GuidAddrSet();
 
+  // Returns the snapshot if Config::forwarding_snapshots is enabled and
+  // nothing in the snapshot has changed since it was made.
+  std::shared_ptr<const ClientSnapshot> client_snapshot() const
+  {
+    if (!config_.forwarding_snapshots()) {
+      return nullptr;
+    }
+    const auto snapshot = std::atomic_load(&client_snapshot_);
+    return snapshot && snapshot->version == client_snapshot_version_ ? snapshot : nullptr;
+  }
+
   using CreatedAddrSetStats = std::pair<bool, AddrSetStats&>;
 
   class Proxy {
@@ -439,6 +475,12 @@ public:
       gas_.remove_cross_relay_pending_recipients(guid);
     }
 
+    // Call after changing an entry's pending recipients or peer relays.
+    void clients_changed()
+    {
+      gas_.clients_changed();
+    }
+
   private:
     GuidAddrSet& gas_;
 
@@ -538,6 +580,11 @@ private:
 
   void remove_cross_relay_pending_recipients(const OpenDDS::DCPS::GUID_t& guid);
 
+  // Called with mutex_ held after a change that is visible in a ClientSnapshot.
+  void clients_changed();
+
+  void update_client_snapshot(const OpenDDS::DCPS::MonotonicTimePoint& now);
+
   struct AdmissionControlInfo {
     AdmissionControlInfo(const OpenDDS::DCPS::GuidPrefix_t& prefix, const OpenDDS::DCPS::MonotonicTimePoint& admitted)
      : admitted_(admitted)
@@ -606,6 +653,10 @@ private:
 
   using CrossRelayInitiatedAsyncDiscovery = std::unordered_map<OpenDDS::DCPS::GUID_t, StringSet, GuidHash>;
   CrossRelayInitiatedAsyncDiscovery initiated_async_discovery_with_;
+
+  std::shared_ptr<const ClientSnapshot> client_snapshot_;
+  std::atomic<size_t> client_snapshot_version_{0};
+  OpenDDS::DCPS::SporadicEvent_rch client_snapshot_task_;
 };
 
 }
@@ -6,6 +6,10 @@
 
 namespace RtpsRelay {
 
+namespace {
+  const OpenDDS::DCPS::TimeDuration PARTITION_INDEX_SNAPSHOT_DELAY = OpenDDS::DCPS::TimeDuration::from_msec(100);
+}
+
 GuidPartitionTable::~GuidPartitionTable()
 {
   if (denied_partitions_cleanup_task_) {
@@ -17,6 +21,9 @@ GuidPartitionTable::~GuidPartitionTable()
   if (remote_async_disc_cache_cleanup_task_) {
     remote_async_disc_cache_cleanup_task_->cancel();
   }
+  if (partition_index_snapshot_task_) {
+    partition_index_snapshot_task_->cancel();
+  }
 }
 
 GuidPartitionTable::Result GuidPartitionTable::insert(const OpenDDS::DCPS::GUID_t& guid,
@@ -77,6 +84,7 @@ GuidPartitionTable::Result GuidPartitionTable::insert(const OpenDDS::DCPS::GUID_
     if (x.empty()) {
       guid_to_partitions_.erase(r.first);
     }
+    partition_index_changed();
 
     add_new(relay_partitions, globally_new);
     relay_stats_reporter_.partition_index_nodes(partition_index_.size());
@@ -115,6 +123,7 @@ void GuidPartitionTable::remove(const OpenDDS::DCPS::GUID_t& guid)
       }
       guid_to_partitions_.erase(pos);
       remove_from_cache(guid);
+      partition_index_changed();
     }
 
     relay_stats_reporter_.partition_index_nodes(partition_index_.size());
@@ -131,11 +140,22 @@ void GuidPartitionTable::remove(const OpenDDS::DCPS::GUID_t& guid)
 
 void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID_t& from) const
 {
-  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
-
   // Match on the prefix.
   const auto prefix = make_unknown_guid(from);
 
+  // Use the snapshot instead of mutex_ if it's up to date.
+  const auto snapshot = config_.partition_index_snapshots() ?
+    std::atomic_load(&guid_to_partitions_snapshot_) : std::shared_ptr<const GuidToPartitionsSnapshot>();
+  if (snapshot && snapshot->version == partition_index_version_) {
+    const auto p = snapshot->partitions.find(prefix);
+    if (p != snapshot->partitions.end()) {
+      partitions.insert(p->second.begin(), p->second.end());
+    }
+    return;
+  }
+
+  ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+
   const auto p = guid_to_partitions_cache_.find(prefix);
   if (p != guid_to_partitions_cache_.end()) {
     partitions.insert(p->second.begin(), p->second.end());
@@ -175,6 +195,7 @@ void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID
           partitions_to_drain.insert(partition.first);
         }
       }
+      has_denied_partitions_ = !denied_partitions_.empty();
 
       if (!denied_partitions_.empty() && !denied_partitions_cleanup_task_) {
         const auto base = OpenDDS::DCPS::make_rch<GuidPartitionTableEvent>(rchandle_from(this), &GuidPartitionTable::cleanup_denied_partitions);
@@ -195,6 +216,60 @@ void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID
     }
   }
 
+  void GuidPartitionTable::partition_index_changed()
+  {
+    ++partition_index_version_;
+
+    if (!config_.partition_index_snapshots()) {
+      return;
+    }
+
+    if (!partition_index_snapshot_task_) {
+      const auto base = OpenDDS::DCPS::make_rch<GuidPartitionTableEvent>(rchandle_from(this), &GuidPartitionTable::update_partition_index_snapshot);
+      partition_index_snapshot_task_ = OpenDDS::DCPS::make_rch<OpenDDS::DCPS::SporadicEvent>(TheServiceParticipant->event_dispatcher(), base);
+    }
+    // Wait a little so that a burst of changes results in one snapshot.
+    partition_index_snapshot_task_->schedule(PARTITION_INDEX_SNAPSHOT_DELAY);
+  }
+
+  void GuidPartitionTable::update_partition_index_snapshot(const OpenDDS::DCPS::MonotonicTimePoint&)
+  {
+    std::shared_ptr<PartitionIndexSnapshotType> snapshot;
+    std::shared_ptr<GuidToPartitionsSnapshot> partitions_snapshot;
+    {
+      ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
+      snapshot = std::make_shared<PartitionIndexSnapshotType>(partition_index_, partition_index_version_);
+      partitions_snapshot = std::make_shared<GuidToPartitionsSnapshot>(partition_index_version_);
+      for (const auto& entry : guid_to_partitions_) {
+        auto& parts = partitions_snapshot->partitions[make_unknown_guid(entry.first)];
+        parts.insert(entry.second.begin(), entry.second.end());
+        if (!config_.allow_empty_partition()) {
+          parts.erase("");
+        }
+      }
+    }
+
+    std::shared_ptr<const GuidToPartitionsSnapshot> current_partitions = std::atomic_load(&guid_to_partitions_snapshot_);
+    while (!current_partitions || current_partitions->version < partitions_snapshot->version) {
+      if (std::atomic_compare_exchange_weak(&guid_to_partitions_snapshot_, &current_partitions,
+                                            std::shared_ptr<const GuidToPartitionsSnapshot>(partitions_snapshot))) {
+        break;
+      }
+    }
+
+    // Expanding the names takes most of the time and only uses the snapshot.
+    snapshot->expand();
+
+    // Don't replace a newer snapshot from a concurrent update.
+    std::shared_ptr<const PartitionIndexSnapshotType> current = std::atomic_load(&partition_index_snapshot_);
+    while (!current || current->version() < snapshot->version()) {
+      if (std::atomic_compare_exchange_weak(&partition_index_snapshot_, &current,
+                                            std::shared_ptr<const PartitionIndexSnapshotType>(snapshot))) {
+        break;
+      }
+    }
+  }
+
   void GuidPartitionTable::cleanup_denied_partitions(const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     ACE_GUARD(ACE_Thread_Mutex, g, denied_partitions_mutex_);
@@ -208,6 +283,7 @@ void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID
       }
     }
 
+    has_denied_partitions_ = !denied_partitions_.empty();
     if (!denied_partitions_.empty()) {
       denied_partitions_cleanup_task_->schedule(config_.denied_partitions_timeout());
     } else {
@@ -217,6 +293,10 @@ void GuidPartitionTable::lookup(StringSet& partitions, const OpenDDS::DCPS::GUID
 
   bool GuidPartitionTable::is_denied(const StringSet& partitions) const
   {
+    if (!has_denied_partitions_) {
+      return false;
+    }
+
     ACE_GUARD_RETURN(ACE_Thread_Mutex, g, denied_partitions_mutex_, false);
 
     for (const auto& partition : partitions) {
@@ -11,9 +11,13 @@
 
 #include <dds/DCPS/GuidConverter.h>
 #include <dds/DCPS/LogAddr.h>
+#include <dds/DCPS/SporadicEvent.h>
 
 #include <ace/Thread_Mutex.h>
 
+#include <atomic>
+#include <memory>
+
 namespace RtpsRelay {
 
 // FUTURE: Make this configurable, adaptive, etc.
@@ -62,6 +66,19 @@ public:
   void lookup(GuidSet& guids, const T& partitions, const GuidSet& allowed = GuidSet{}) const
   {
     const auto limits = allowed.empty() ? nullptr : &allowed;
+
+    // Use the snapshot instead of mutex_ if it's up to date.
+    const auto snapshot = config_.partition_index_snapshots() ?
+      std::atomic_load(&partition_index_snapshot_) : std::shared_ptr<const PartitionIndexSnapshotType>();
+    if (snapshot && snapshot->version() == partition_index_version_) {
+      for (const auto& part : partitions) {
+        if (config_.allow_empty_partition() || !part.empty()) {
+          snapshot->lookup(part, guids, limits);
+        }
+      }
+      return;
+    }
+
     ACE_GUARD(ACE_Thread_Mutex, g, mutex_);
 
     for (const auto& part : partitions) {
@@ -78,6 +95,8 @@ public:
 
   void cleanup_denied_partitions(const OpenDDS::DCPS::MonotonicTimePoint& now);
 
+  void update_partition_index_snapshot(const OpenDDS::DCPS::MonotonicTimePoint& now);
+
   bool is_denied(const StringSet& partitions) const;
 
   void update_cert_partitions_cache(const std::string& key, const StringSet& partitions, const OpenDDS::DCPS::GUID_t& guid);
@@ -90,6 +109,9 @@ public:
   void handle_async_disc_cache_prune(const StringSequence& keys, const std::string& from_relay);
 
 private:
+  // Called with mutex_ held after partition_index_ changes.
+  void partition_index_changed();
+
   void remove_from_cache(const OpenDDS::DCPS::GUID_t& guid)
   {
     // Invalidate the cache.
@@ -227,7 +249,26 @@ private:
   PartitionToGuid partition_to_guid_;
   PartitionIndex<GuidSet, GuidToParticipantGuid> partition_index_;
 
+  // See Config::partition_index_snapshots.
+  using PartitionIndexSnapshotType = PartitionIndexSnapshot<GuidSet, GuidToParticipantGuid>;
+  std::shared_ptr<const PartitionIndexSnapshotType> partition_index_snapshot_;
+  std::atomic<size_t> partition_index_version_{0};
+  OpenDDS::DCPS::SporadicEvent_rch partition_index_snapshot_task_;
+
+  // The partitions of each participant, made with the partition index snapshot.
+  struct GuidToPartitionsSnapshot {
+    explicit GuidToPartitionsSnapshot(size_t a_version)
+      : version(a_version)
+    {}
+
+    const size_t version;
+    GuidToPartitionsCache partitions;
+  };
+  std::shared_ptr<const GuidToPartitionsSnapshot> guid_to_partitions_snapshot_;
+
   DeniedPartitions denied_partitions_;
+  // Lets is_denied skip denied_partitions_mutex_ when nothing is denied.
+  std::atomic<bool> has_denied_partitions_{false};
 
   using GuidPartitionTableEvent = OpenDDS::DCPS::PmfNowEvent<GuidPartitionTable>;
   OpenDDS::DCPS::SporadicEvent_rch denied_partitions_cleanup_task_;
@@ -35,9 +35,10 @@ public:
                      MessageType type)
   {
     relay_statistics_reporter_.input_message(byte_count, time, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.input_message(log_handler_statistics_, byte_count, time, type);
     publish_helper_.input_message(publish_handler_statistics_, byte_count, time, type);
-    report(now);
+    report(guard, now);
   }
 
   void ignored_message(size_t byte_count,
@@ -45,9 +46,10 @@ public:
                        MessageType type)
   {
     relay_statistics_reporter_.ignored_message(byte_count, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.ignored_message(log_handler_statistics_, byte_count, type);
     publish_helper_.ignored_message(publish_handler_statistics_, byte_count, type);
-    report(now);
+    report(guard, now);
   }
 
   void output_message(size_t byte_count,
@@ -57,9 +59,10 @@ public:
                       MessageType type)
   {
     relay_statistics_reporter_.output_message(byte_count, time, queue_latency, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.output_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.output_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
-    report(now);
+    report(guard, now);
   }
 
   void dropped_message(size_t byte_count,
@@ -69,47 +72,53 @@ public:
                        MessageType type)
   {
     relay_statistics_reporter_.dropped_message(byte_count, time, queue_latency, now, type);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.dropped_message(log_handler_statistics_, byte_count, time, queue_latency, type);
     publish_helper_.dropped_message(publish_handler_statistics_, byte_count, time, queue_latency, type);
-    report(now);
+    report(guard, now);
   }
 
   void max_gain(size_t value, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.max_gain(value, now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.max_gain(log_handler_statistics_, value);
     publish_helper_.max_gain(publish_handler_statistics_, value);
-    report(now);
+    report(guard, now);
   }
 
   void error(const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.error(now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.error(log_handler_statistics_);
     publish_helper_.error(publish_handler_statistics_);
-    report(now);
+    report(guard, now);
   }
 
   void max_queue_size(size_t size, const OpenDDS::DCPS::MonotonicTimePoint& now)
   {
     relay_statistics_reporter_.max_queue_size(size, now);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
     log_helper_.max_queue_size(log_handler_statistics_, size);
     publish_helper_.max_queue_size(publish_handler_statistics_, size);
-    report(now);
+    report(guard, now);
   }
 
   void report()
   {
-    report(OpenDDS::DCPS::MonotonicTimePoint::now(), true);
+    ACE_Guard<ACE_Thread_Mutex> guard(mutex_);
+    report(guard, OpenDDS::DCPS::MonotonicTimePoint::now(), true);
   }
 
 private:
 
-  void report(const OpenDDS::DCPS::MonotonicTimePoint& now,
+  void report(ACE_Guard<ACE_Thread_Mutex>& guard,
+              const OpenDDS::DCPS::MonotonicTimePoint& now,
               bool force = false)
   {
     log_report(now, force);
-    publish_report(now, force);
+    publish_report(guard, now, force);
   }
 
   void log_report(const OpenDDS::DCPS::MonotonicTimePoint& now,
@@ -124,23 +133,29 @@ private:
     log_helper_.reset(log_handler_statistics_, now);
   }
 
-  void publish_report(const OpenDDS::DCPS::MonotonicTimePoint& now,
+  void publish_report(ACE_Guard<ACE_Thread_Mutex>& guard,
+                      const OpenDDS::DCPS::MonotonicTimePoint& now,
                       bool force)
   {
     if (!publish_helper_.prepare_report(publish_handler_statistics_, now, force, config_.publish_handler_statistics())) {
       return;
     }
 
-    const auto ret = writer_->write(publish_handler_statistics_, DDS::HANDLE_NIL);
+    const auto stats_copy = publish_handler_statistics_;
+    publish_helper_.reset(publish_handler_statistics_, now);
+
+    guard.release();
+
+    const auto ret = writer_->write(stats_copy, DDS::HANDLE_NIL);
     if (ret != DDS::RETCODE_OK) {
       ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: "
         "HandlerStatisticsReporter::report %C failed to write handler statistics\n",
-        publish_handler_statistics_.name().c_str()));
+        stats_copy.name().c_str()));
     }
-
-    publish_helper_.reset(publish_handler_statistics_, now);
   }
 
+  // Handlers that share a port (see Config::handler_shards) share a reporter.
+  mutable ACE_Thread_Mutex mutex_;
   const Config& config_;
 
   using Helper = CommonIoStatsReportHelper<HandlerStatistics>;
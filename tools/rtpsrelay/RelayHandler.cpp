@@ -11,8 +11,10 @@
 #include <dds/DdsDcpsGuidTypeSupportImpl.h>
 
 #include <ace/Global_Macros.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/Reactor.h>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <sstream>
@@ -29,6 +31,11 @@ namespace RtpsRelay {
 #define HANDLER_WARNING(X) { if (config_.log_warnings()) { ACE_ERROR (X); }; stats_reporter_.error(now); }
 
 namespace {
+  // Limits on how long and how many messages forwarded from a ClientSnapshot
+  // wait to be recorded in the GuidAddrSet.
+  const OpenDDS::DCPS::TimeDuration ACTIVITY_BATCH_PERIOD = OpenDDS::DCPS::TimeDuration::from_msec(100);
+  const size_t MAX_ACTIVITY_BATCH = 1024;
+
   OpenDDS::STUN::Message make_bad_request_error_response(const OpenDDS::STUN::Message& a_message,
                                                          const std::string& a_reason)
   {
@@ -58,6 +65,12 @@ RelayHandler::RelayHandler(const Config& config,
                            HandlerStatisticsReporter& stats_reporter,
                            OpenDDS::DCPS::Lockable_Message_Block_Ptr::Lock_Policy message_block_locking)
   : ACE_Event_Handler(reactor)
+#ifdef RTPSRELAY_HAS_MMSG
+  , io_batch_size_((std::max)(size_t(1), (std::min)(config.io_batch_size(), static_cast<size_t>(MAX_IO_BATCH_SIZE))))
+#else
+  , io_batch_size_(1)
+#endif
+  , receive_buffer_(io_batch_size_ > 1 ? io_batch_size_ * MAX_DATAGRAM_SIZE : 0)
   , config_(config)
   , name_(name)
   , port_(port)
@@ -66,9 +79,31 @@ RelayHandler::RelayHandler(const Config& config,
 {
 }
 
-int RelayHandler::open(const ACE_INET_Addr& address)
+int RelayHandler::open(const ACE_INET_Addr& address, bool reuse_port)
 {
-  if (socket_.open(address) != 0) {
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    // The option must be set before bind so that every handler bound to the
+    // address shares the incoming datagrams.
+    if (socket_.ACE_SOCK::open(SOCK_DGRAM, address.get_type(), 0, 0) != 0) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to create socket\n", name_.c_str()));
+      return -1;
+    }
+    int one = 1;
+    if (socket_.set_option(SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to set SO_REUSEPORT: %m\n", name_.c_str()));
+      return -1;
+    }
+    if (ACE_OS::bind(socket_.get_handle(), static_cast<sockaddr*>(address.get_addr()), address.get_size()) != 0) {
+      ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to bind socket to '%C': %m\n",
+                 name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
+      return -1;
+    }
+#else
+    ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C SO_REUSEPORT is not supported on this platform\n", name_.c_str()));
+    return -1;
+#endif
+  } else if (socket_.open(address) != 0) {
     ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::open %C failed to open socket on '%C'\n",
                name_.c_str(), OpenDDS::DCPS::LogAddr(address).c_str()));
     return -1;
@@ -110,6 +145,13 @@ int RelayHandler::handle_input(ACE_HANDLE handle)
 {
   OpenDDS::DCPS::ThreadStatusManager::Event ev(TheServiceParticipant->get_thread_status_manager(), READ_MASK, handle_to_int(handle));
 
+#ifdef RTPSRELAY_HAS_MMSG
+  if (io_batch_size_ > 1) {
+    handle_input_batch(handle);
+    return 0;
+  }
+#endif
+
   const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
 
   ACE_INET_Addr remote;
@@ -153,14 +195,74 @@ int RelayHandler::handle_input(ACE_HANDLE handle)
   }
 
   buffer->length(static_cast<size_t>(bytes));
+  process_input(remote, now, buffer);
+
+  return 0;
+}
+
+void RelayHandler::process_input(const ACE_INET_Addr& remote,
+                                 const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                 const OpenDDS::DCPS::Lockable_Message_Block_Ptr& buffer)
+{
+  const size_t bytes = buffer->length();
   MessageType type = MessageType::Unknown;
   const CORBA::ULong generated_messages = process_message(remote, now, buffer, type);
   stats_reporter_.max_gain(generated_messages, now);
-  stats_reporter_.input_message(static_cast<size_t>(bytes),
-    OpenDDS::DCPS::MonotonicTimePoint::now() - now, now, type);
+  stats_reporter_.input_message(bytes, OpenDDS::DCPS::MonotonicTimePoint::now() - now, now, type);
+}
 
-  return 0;
+#ifdef RTPSRELAY_HAS_MMSG
+void RelayHandler::handle_input_batch(ACE_HANDLE handle)
+{
+  mmsghdr msgs[MAX_IO_BATCH_SIZE];
+  iovec iovs[MAX_IO_BATCH_SIZE];
+  ACE_INET_Addr remotes[MAX_IO_BATCH_SIZE];
+
+  for (size_t i = 0; i < io_batch_size_; ++i) {
+    iovs[i].iov_base = &receive_buffer_[i * MAX_DATAGRAM_SIZE];
+    iovs[i].iov_len = MAX_DATAGRAM_SIZE;
+    std::memset(&msgs[i], 0, sizeof msgs[i]);
+    msgs[i].msg_hdr.msg_name = remotes[i].get_addr();
+    msgs[i].msg_hdr.msg_namelen = remotes[i].get_size();
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // The reactor only knows that the first datagram is ready, so don't wait
+  // for the rest of the batch.
+  const int count = ::recvmmsg(handle, msgs, static_cast<unsigned int>(io_batch_size_), MSG_DONTWAIT, 0);
+
+  if (count < 0) {
+    if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR || errno == ECONNRESET) {
+      // Sending to a non-existent client may result in an ICMP message that is delievered as connection reset.
+      return;
+    }
+
+    const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
+    HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_input_batch %C failed to recvmmsg: %m\n", name_.c_str()));
+    return;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    const auto now = OpenDDS::DCPS::MonotonicTimePoint::now();
+    ACE_INET_Addr& remote = remotes[i];
+    remote.set_size(static_cast<int>(msgs[i].msg_hdr.msg_namelen));
+    remote.set_type(static_cast<sockaddr*>(remote.get_addr())->sa_family);
+
+    const size_t bytes = msgs[i].msg_len;
+    if (bytes == 0) {
+      // Okay.  Empty datagram.
+      HANDLER_WARNING((LM_WARNING, "(%P|%t) WARNING: RelayHandler::handle_input_batch %C received an empty datagram from %C\n",
+                       name_.c_str(), OpenDDS::DCPS::LogAddr(remote).c_str()));
+      continue;
+    }
+
+    OpenDDS::DCPS::Lockable_Message_Block_Ptr buffer(new ACE_Message_Block(bytes), message_block_locking_);
+    buffer->copy(static_cast<const char*>(iovs[i].iov_base), bytes);
+    process_input(remote, now, buffer);
+  }
 }
+#endif
 
 int RelayHandler::handle_output(ACE_HANDLE handle)
 {
@@ -172,22 +274,13 @@ int RelayHandler::handle_output(ACE_HANDLE handle)
   ACE_GUARD_RETURN(ACE_Thread_Mutex, g, outgoing_mutex_, 0);
   OpenDDS::DCPS::ThreadStatusManager::Event evLocked(statusManager, WRITE_MASK | DONT_CALL, handle_to_int(handle));
 
-  if (!outgoing_.empty()) {
-    const auto& out = outgoing_.front();
-    size_t total_bytes;
-
-    if (send_i(out, total_bytes) < 0) {
-      HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::handle_output %C failed to send to %C: %m\n",
-                     name_.c_str(), OpenDDS::DCPS::LogAddr(out.address).c_str()));
-      const auto new_now = OpenDDS::DCPS::MonotonicTimePoint::now();
-      stats_reporter_.dropped_message(total_bytes, new_now - now, new_now - out.timestamp, now, out.type);
-    } else {
-      const auto new_now = OpenDDS::DCPS::MonotonicTimePoint::now();
-      stats_reporter_.output_message(total_bytes, new_now - now, new_now - out.timestamp, now, out.type);
-    }
-
-    outgoing_.pop();
+  const Element* elements[MAX_IO_BATCH_SIZE];
+  const size_t count = (std::min)(outgoing_.size(), io_batch_size_);
+  for (size_t i = 0; i < count; ++i) {
+    elements[i] = &outgoing_[i];
   }
+  send_elements(elements, count, now, true);
+  outgoing_.erase(outgoing_.begin(), outgoing_.begin() + count);
 
   if (outgoing_.empty()) {
     reactor()->remove_handler(this, WRITE_MASK);
@@ -203,14 +296,45 @@ void RelayHandler::enqueue_message(const ACE_INET_Addr& addr,
 {
   const Element out(addr, msg, now, type);
   if (config_.synchronous_output()) {
-    size_t total_bytes;
+    const Element* const elements[] = { &out };
+    send_elements(elements, 1, now, false);
 
-    if (send_i(out, total_bytes) < 0) {
-      HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::enqueue_message %C failed to send to %C: %m\n",
-                     name_.c_str(), OpenDDS::DCPS::LogAddr(out.address).c_str()));
-      stats_reporter_.dropped_message(total_bytes, OpenDDS::DCPS::TimeDuration::zero_value, OpenDDS::DCPS::TimeDuration::zero_value, now, out.type);
-    } else {
-      stats_reporter_.output_message(total_bytes, OpenDDS::DCPS::TimeDuration::zero_value, OpenDDS::DCPS::TimeDuration::zero_value, now, out.type);
+  } else {
+    ACE_GUARD(ACE_Thread_Mutex, g, outgoing_mutex_);
+
+    const auto empty = outgoing_.empty();
+
+    outgoing_.push_back(out);
+    stats_reporter_.max_queue_size(outgoing_.size(), now);
+    if (empty) {
+      reactor()->register_handler(this, WRITE_MASK);
+    }
+  }
+}
+
+void RelayHandler::enqueue_messages(const std::vector<ACE_INET_Addr>& addrs,
+                                    const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                                    const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                    MessageType type)
+{
+  if (addrs.empty()) {
+    return;
+  }
+
+  if (config_.synchronous_output()) {
+    std::vector<Element> out;
+    out.reserve(addrs.size());
+    for (const auto& addr : addrs) {
+      out.emplace_back(addr, msg, now, type);
+    }
+
+    const Element* elements[MAX_IO_BATCH_SIZE];
+    for (size_t offset = 0; offset < out.size(); offset += io_batch_size_) {
+      const size_t count = (std::min)(out.size() - offset, io_batch_size_);
+      for (size_t i = 0; i < count; ++i) {
+        elements[i] = &out[offset + i];
+      }
+      send_elements(elements, count, now, false);
     }
 
   } else {
@@ -218,7 +342,9 @@ void RelayHandler::enqueue_message(const ACE_INET_Addr& addr,
 
     const auto empty = outgoing_.empty();
 
-    outgoing_.push(out);
+    for (const auto& addr : addrs) {
+      outgoing_.emplace_back(addr, msg, now, type);
+    }
     stats_reporter_.max_queue_size(outgoing_.size(), now);
     if (empty) {
       reactor()->register_handler(this, WRITE_MASK);
@@ -226,11 +352,10 @@ void RelayHandler::enqueue_message(const ACE_INET_Addr& addr,
   }
 }
 
-ssize_t RelayHandler::send_i(const Element& out,
-                             size_t& total_bytes)
+int RelayHandler::fill_buffers(const Element& out,
+                               iovec buffers[BUFFERS_SIZE],
+                               size_t& total_bytes)
 {
-  const int BUFFERS_SIZE = 2;
-  iovec buffers[BUFFERS_SIZE];
   total_bytes = 0;
 
   int idx = 0;
@@ -249,9 +374,81 @@ ssize_t RelayHandler::send_i(const Element& out,
 #endif
   }
 
+  return idx;
+}
+
+ssize_t RelayHandler::send_i(const Element& out,
+                             size_t& total_bytes)
+{
+  iovec buffers[BUFFERS_SIZE];
+  const int idx = fill_buffers(out, buffers, total_bytes);
   return socket_.send(buffers, idx, out.address, 0);
 }
 
+void RelayHandler::send_elements(const Element* const elements[],
+                                 size_t count,
+                                 const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                 bool queued)
+{
+#ifdef RTPSRELAY_HAS_MMSG
+  if (count > 1) {
+    mmsghdr msgs[MAX_IO_BATCH_SIZE];
+    iovec buffers[MAX_IO_BATCH_SIZE][BUFFERS_SIZE];
+    size_t total_bytes[MAX_IO_BATCH_SIZE];
+
+    for (size_t i = 0; i < count; ++i) {
+      std::memset(&msgs[i], 0, sizeof msgs[i]);
+      msgs[i].msg_hdr.msg_name = elements[i]->address.get_addr();
+      msgs[i].msg_hdr.msg_namelen = elements[i]->address.get_size();
+      msgs[i].msg_hdr.msg_iov = buffers[i];
+      msgs[i].msg_hdr.msg_iovlen = fill_buffers(*elements[i], buffers[i], total_bytes[i]);
+    }
+
+    size_t offset = 0;
+    while (offset < count) {
+      const int sent = ::sendmmsg(socket_.get_handle(), msgs + offset, static_cast<unsigned int>(count - offset), 0);
+      if (sent <= 0) {
+        // sendmmsg stops at the first failure, which is reported in errno
+        // only when nothing was sent.
+        report_send(*elements[offset], -1, total_bytes[offset], now, queued);
+        ++offset;
+        continue;
+      }
+      for (int i = 0; i < sent; ++i, ++offset) {
+        report_send(*elements[offset], static_cast<ssize_t>(msgs[offset].msg_len), total_bytes[offset], now, queued);
+      }
+    }
+    return;
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    size_t total_bytes;
+    const ssize_t result = send_i(*elements[i], total_bytes);
+    report_send(*elements[i], result, total_bytes, now, queued);
+  }
+}
+
+void RelayHandler::report_send(const Element& out,
+                               ssize_t result,
+                               size_t total_bytes,
+                               const OpenDDS::DCPS::MonotonicTimePoint& now,
+                               bool queued)
+{
+  const auto new_now = queued ? OpenDDS::DCPS::MonotonicTimePoint::now() : now;
+  const auto time = new_now - now;
+  const auto queue_latency = queued ? new_now - out.timestamp : OpenDDS::DCPS::TimeDuration::zero_value;
+
+  if (result < 0) {
+    HANDLER_ERROR((LM_ERROR, "(%P|%t) ERROR: RelayHandler::%C %C failed to send to %C: %m\n",
+                   queued ? "handle_output" : "enqueue_message",
+                   name_.c_str(), OpenDDS::DCPS::LogAddr(out.address).c_str()));
+    stats_reporter_.dropped_message(total_bytes, time, queue_latency, now, out.type);
+  } else {
+    stats_reporter_.output_message(total_bytes, time, queue_latency, now, out.type);
+  }
+}
+
 VerticalHandler::VerticalHandler(const Config& config,
                                  const std::string& name,
                                  Port port,
@@ -294,6 +491,14 @@ void VerticalHandler::venqueue_message(const ACE_INET_Addr& addr,
   enqueue_message(addr, msg, now, type);
 }
 
+void VerticalHandler::venqueue_messages(const std::vector<ACE_INET_Addr>& addrs,
+                                        const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                                        const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                        MessageType type)
+{
+  enqueue_messages(addrs, msg, now, type);
+}
+
 CORBA::ULong VerticalHandler::process_message(const ACE_INET_Addr& remote_address,
                                               const OpenDDS::DCPS::MonotonicTimePoint& now,
                                               const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
@@ -302,7 +507,13 @@ CORBA::ULong VerticalHandler::process_message(const ACE_INET_Addr& remote_addres
   auto& statusManager = TheServiceParticipant->get_thread_status_manager();
   const auto handle_as_int = handle_to_int(get_handle());
   const auto msg_len = msg->length();
-  {
+  const auto client_snapshot = port() == DATA ? guid_addr_set_.client_snapshot() : nullptr;
+  if (client_snapshot) {
+    if (client_snapshot->rejected_addresses.count(OpenDDS::DCPS::NetworkAddress(remote_address))) {
+      stats_reporter_.ignored_message(msg_len, now, type);
+      return 0;
+    }
+  } else {
     GuidAddrSet::Proxy proxy(guid_addr_set_);
     OpenDDS::DCPS::ThreadStatusManager::Event evLocked(statusManager, READ_MASK | DONT_CALL, handle_as_int);
     proxy.maintain_admission_queue(now);
@@ -332,6 +543,11 @@ CORBA::ULong VerticalHandler::process_message(const ACE_INET_Addr& remote_addres
       (src_guid == config_.application_participant_guid());
 
     CORBA::ULong sent = 0;
+    if (client_snapshot && !from_application_participant &&
+        forward_from_snapshot(*client_snapshot, addr_port, src_guid, to, msg, now, sent)) {
+      return sent;
+    }
+
     bool send_to_application_participant = false;
     AddressSet horizontal_addrs;
     LocalClientAddresses local_clients;
@@ -687,6 +903,93 @@ bool VerticalHandler::parse_message(OpenDDS::RTPS::MessageParser& message_parser
   return true;
 }
 
+bool VerticalHandler::forward_from_snapshot(const ClientSnapshot& snapshot,
+                                            const AddrPort& remote_address,
+                                            const OpenDDS::DCPS::GUID_t& src_guid,
+                                            const GuidSet& to,
+                                            const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                                            const OpenDDS::DCPS::MonotonicTimePoint& now,
+                                            CORBA::ULong& sent)
+{
+  const auto client = snapshot.clients.find(src_guid);
+  if (client == snapshot.clients.end() || !client->second.allow_rtps || client->second.async_discovery) {
+    return false;
+  }
+  const auto& src_addrs = client->second.data_addrs;
+  if (std::find(src_addrs.begin(), src_addrs.end(), remote_address.addr) == src_addrs.end()) {
+    // New address, which record_activity has to add.
+    return false;
+  }
+
+  StringSet to_partitions;
+  guid_partition_table_.lookup(to_partitions, src_guid);
+  if ((to_partitions.empty() && config_.async_discovery_enabled()) ||
+      guid_partition_table_.is_denied(to_partitions)) {
+    return false;
+  }
+
+  defer_activity(remote_address, src_guid, now);
+
+  AddressSet address_set;
+  populate_address_set(address_set, to_partitions);
+
+  AddressSet horizontal_addrs;
+  LocalClientAddresses local_clients;
+  for (const auto& addr : address_set) {
+    if (addr != horizontal_address_) {
+      horizontal_addrs.insert(addr);
+      continue;
+    }
+
+    GuidSet guids;
+    guid_partition_table_.lookup(guids, to_partitions, to);
+    for (const auto& guid : guids) {
+      if (guid == src_guid) {
+        continue;
+      }
+      const auto p = snapshot.clients.find(guid);
+      if (p != snapshot.clients.end()) {
+        for (const auto& a : p->second.data_addrs) {
+          ACE_INET_Addr ip = a;
+          ip.set_port_number(0);
+          local_clients[ip].insert(a.get_port_number());
+        }
+      }
+    }
+  }
+
+  sent += send(horizontal_addrs, local_clients, to_partitions, to, false, msg, now);
+  return true;
+}
+
+void VerticalHandler::defer_activity(const AddrPort& remote_address,
+                                     const OpenDDS::DCPS::GUID_t& src_guid,
+                                     const OpenDDS::DCPS::MonotonicTimePoint& now)
+{
+  PendingActivity activity;
+  {
+    ACE_GUARD(ACE_Thread_Mutex, g, pending_activity_mutex_);
+    if (pending_activity_.empty()) {
+      pending_activity_start_ = now;
+    }
+    pending_activity_[GuidAddr(src_guid, remote_address)] = now;
+    if (now - pending_activity_start_ < ACTIVITY_BATCH_PERIOD && pending_activity_.size() < MAX_ACTIVITY_BATCH) {
+      return;
+    }
+    activity.swap(pending_activity_);
+  }
+
+  GuidAddrSet::Proxy proxy(guid_addr_set_);
+  OpenDDS::DCPS::ThreadStatusManager::Event evLocked(TheServiceParticipant->get_thread_status_manager(),
+    READ_MASK | SIGNAL_MASK, handle_to_int(get_handle()));
+  for (const auto& a : activity) {
+    // Don't bring back a client that was removed in the meantime.
+    if (proxy.find(a.first.guid) != proxy.end()) {
+      proxy.record_activity(a.first.address, a.second, a.first.guid, false, nullptr, *this);
+    }
+  }
+}
+
 void VerticalHandler::prepare_send(GuidAddrSet::Proxy& proxy,
                                    const OpenDDS::DCPS::GUID_t& src_guid,
                                    const StringSet& to_partitions,
@@ -778,6 +1081,9 @@ void VerticalHandler::prepare_send(GuidAddrSet::Proxy& proxy,
         if (iter != proxy.end()) {
           iter->second.initiated_async_discovery_with.insert(async_disc_targets.begin(), async_disc_targets.end());
         }
+        if (!async_disc_targets.empty()) {
+          proxy.clients_changed();
+        }
       }
     }
   }
@@ -799,19 +1105,21 @@ CORBA::ULong VerticalHandler::send(const AddressSet& horizontal_addrs,
     ++sent;
   }
 
+  std::vector<ACE_INET_Addr> addrs;
   for (const auto& ip : local_clients) {
     ACE_INET_Addr addr = ip.first;
     for (const auto& p : ip.second) {
       addr.set_port_number(p);
-      venqueue_message(addr, msg, now, type);
-      ++sent;
+      addrs.push_back(addr);
     }
   }
 
   if (send_to_application_participant) {
-    venqueue_message(application_participant_addr_, msg, now, type);
-    ++sent;
+    addrs.push_back(application_participant_addr_);
   }
+
+  enqueue_messages(addrs, msg, now, type);
+  sent += static_cast<CORBA::ULong>(addrs.size());
   return sent;
 }
 
@@ -922,7 +1230,12 @@ CORBA::ULong HorizontalHandler::process_message(const ACE_INET_Addr& remote,
         } else if (name() == HSEDP) {
           p->second.pending_sedp_peer_relays[remote] = now;
         } else if (name() == HDATA) {
-          p->second.pending_data_peer_relays[remote] = now;
+          const auto r = p->second.pending_data_peer_relays.insert(std::make_pair(remote, now));
+          if (r.second) {
+            proxy.clients_changed();
+          } else {
+            r.first->second = now;
+          }
         }
       }
     }
@@ -935,19 +1248,19 @@ CORBA::ULong HorizontalHandler::process_message(const ACE_INET_Addr& remote,
   OpenDDS::DCPS::ThreadStatusManager::Event evLocked(TheServiceParticipant->get_thread_status_manager(),
     READ_MASK | DONT_CALL, handle_to_int(get_handle()));
 
-  CORBA::ULong sent = 0;
+  std::vector<ACE_INET_Addr> addrs;
   for (const auto& guid : guids) {
     const auto p = proxy.find(guid);
     if (p != proxy.end()) {
       p->second.foreach_addr(port(),
                              [&](const ACE_INET_Addr& addr) {
-                               vertical_handler_->venqueue_message(addr, msg, now, type);
-                               ++sent;
+                               addrs.push_back(addr);
                              });
     }
   }
 
-  return sent;
+  vertical_handler_->venqueue_messages(addrs, msg, now, type);
+  return static_cast<CORBA::ULong>(addrs.size());
 }
 
 SpdpHandler::SpdpHandler(const Config& config,
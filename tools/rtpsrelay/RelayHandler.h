@@ -16,17 +16,26 @@
 #include <ace/Thread_Mutex.h>
 #include <ace/Time_Value.h>
 
+#include <deque>
 #include <map>
-#include <queue>
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
+
+#if defined ACE_LINUX && !defined ACE_LACKS_SENDMSG
+// sendmmsg(2) and recvmmsg(2) are used when Config::io_batch_size is more than 1
+#  define RTPSRELAY_HAS_MMSG
+#endif
 
 namespace RtpsRelay {
 
 class RelayHandler : public ACE_Event_Handler {
 public:
-  int open(const ACE_INET_Addr& address);
+  // Bind to address.  If reuse_port is true, other handlers opened with
+  // reuse_port may bind to the same address and the kernel spreads the
+  // incoming datagrams across them (SO_REUSEPORT).
+  int open(const ACE_INET_Addr& address, bool reuse_port = false);
 
   const std::string& name() const { return name_; }
 
@@ -50,6 +59,13 @@ protected:
                        const OpenDDS::DCPS::MonotonicTimePoint& now,
                        MessageType type);
 
+  // Send msg to every address in addrs.  The message block is shared by all
+  // of the destinations.
+  void enqueue_messages(const std::vector<ACE_INET_Addr>& addrs,
+                        const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                        const OpenDDS::DCPS::MonotonicTimePoint& now,
+                        MessageType type);
+
   virtual CORBA::ULong process_message(const ACE_INET_Addr& remote,
                                        const OpenDDS::DCPS::MonotonicTimePoint& now,
                                        const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
@@ -74,12 +90,42 @@ private:
       , type(a_type)
     {}
   };
+  static const size_t MAX_IO_BATCH_SIZE = 64;
+  static const size_t MAX_DATAGRAM_SIZE = 65536;
+  static const int BUFFERS_SIZE = 2;
+
+  static int fill_buffers(const Element& out,
+                          iovec buffers[BUFFERS_SIZE],
+                          size_t& total_bytes);
   ssize_t send_i(const Element& out,
                  size_t& total_bytes);
-  using OutgoingType = std::queue<Element>;
+  // Send count elements, using sendmmsg if io_batch_size_ allows, and update
+  // the statistics.  The queue latency is reported if queued is true.
+  void send_elements(const Element* const elements[],
+                     size_t count,
+                     const OpenDDS::DCPS::MonotonicTimePoint& now,
+                     bool queued);
+  void report_send(const Element& out,
+                   ssize_t result,
+                   size_t total_bytes,
+                   const OpenDDS::DCPS::MonotonicTimePoint& now,
+                   bool queued);
+
+  void process_input(const ACE_INET_Addr& remote,
+                     const OpenDDS::DCPS::MonotonicTimePoint& now,
+                     const OpenDDS::DCPS::Lockable_Message_Block_Ptr& buffer);
+#ifdef RTPSRELAY_HAS_MMSG
+  void handle_input_batch(ACE_HANDLE handle);
+#endif
+
+  using OutgoingType = std::deque<Element>;
   OutgoingType outgoing_;
   mutable ACE_Thread_Mutex outgoing_mutex_;
 
+  const size_t io_batch_size_;
+  // Datagrams are received here by recvmmsg and then copied to message blocks of the right size.
+  std::vector<char> receive_buffer_;
+
 protected:
   const Config& config_;
   const std::string name_;
@@ -121,6 +167,11 @@ public:
                         const OpenDDS::DCPS::MonotonicTimePoint& now,
                         MessageType type);
 
+  void venqueue_messages(const std::vector<ACE_INET_Addr>& addrs,
+                         const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                         const OpenDDS::DCPS::MonotonicTimePoint& now,
+                         MessageType type);
+
 protected:
   virtual void cache_message(GuidAddrSet::Proxy& /*proxy*/,
                              const OpenDDS::DCPS::GUID_t& /*src_guid*/,
@@ -179,6 +230,23 @@ private:
                      bool check_submessages,
                      const OpenDDS::DCPS::MonotonicTimePoint& now);
 
+  // Forward a data message from an admitted client at a known address using
+  // the client snapshot instead of locking the GuidAddrSet.  Returns false
+  // if the message needs the normal processing.
+  bool forward_from_snapshot(const ClientSnapshot& snapshot,
+                             const AddrPort& remote_address,
+                             const OpenDDS::DCPS::GUID_t& src_guid,
+                             const GuidSet& to,
+                             const OpenDDS::DCPS::Lockable_Message_Block_Ptr& msg,
+                             const OpenDDS::DCPS::MonotonicTimePoint& now,
+                             CORBA::ULong& sent);
+
+  // Messages forwarded by forward_from_snapshot are recorded in the
+  // GuidAddrSet in batches so that the lock is taken once per batch.
+  void defer_activity(const AddrPort& remote_address,
+                      const OpenDDS::DCPS::GUID_t& src_guid,
+                      const OpenDDS::DCPS::MonotonicTimePoint& now);
+
   void prepare_send(GuidAddrSet::Proxy& proxy,
                     const OpenDDS::DCPS::GUID_t& src_guid,
                     const StringSet& to_partitions,
@@ -198,6 +266,11 @@ private:
   OpenDDS::RTPS::RtpsDiscovery_rch rtps_discovery_;
   const DDS::Security::CryptoTransform_var crypto_;
   const DDS::Security::ParticipantCryptoHandle application_participant_crypto_handle_;
+
+  using PendingActivity = std::map<GuidAddr, OpenDDS::DCPS::MonotonicTimePoint>;
+  PendingActivity pending_activity_;
+  OpenDDS::DCPS::MonotonicTimePoint pending_activity_start_;
+  ACE_Thread_Mutex pending_activity_mutex_;
 };
 
 // Sends to and receives from other relays.
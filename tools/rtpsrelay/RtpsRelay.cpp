@@ -46,6 +46,8 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 using namespace RtpsRelay;
 
@@ -112,6 +114,68 @@ namespace {
     RelayConfigDataWriter_var writer_;
     RelayConfig config_;
   };
+
+  // Vertical handlers beyond the first for each port.  Each shard has a
+  // reactor thread for its SPDP, SEDP, and data handlers.  The handlers and
+  // threads are stopped when this goes out of scope, including on errors.
+  class HandlerShards {
+  public:
+    ~HandlerShards()
+    {
+      stop();
+    }
+
+    // Start a reactor thread for a new shard.  Returns 0 on failure.
+    ACE_Reactor* add_shard(const std::string& name)
+    {
+      const auto reactor = new ACE_Reactor(new ACE_Select_Reactor, true); // deleted by ReactorTask
+      const auto task = OpenDDS::DCPS::make_rch<OpenDDS::DCPS::ReactorTask>();
+      if (task->open_reactor_task(&TheServiceParticipant->get_thread_status_manager(), name, reactor) != 0) {
+        ACE_ERROR((LM_ERROR, "(%P|%t) ERROR: failed to start reactor task for %C\n", name.c_str()));
+        return 0;
+      }
+      tasks_.push_back(task);
+      return reactor;
+    }
+
+    void add_handler(VerticalHandler* handler,
+                     HorizontalHandler& horizontal_handler,
+                     SpdpHandler* spdp_handler)
+    {
+      handlers_.emplace_back(handler);
+      handler->horizontal_handler(&horizontal_handler);
+      handler->spdp_handler(spdp_handler);
+    }
+
+    int open(const ACE_INET_Addr& spdp_addr, const ACE_INET_Addr& sedp_addr, const ACE_INET_Addr& data_addr)
+    {
+      for (const auto& handler : handlers_) {
+        const auto& addr = handler->port() == SPDP ? spdp_addr : handler->port() == SEDP ? sedp_addr : data_addr;
+        if (handler->open(addr, true) == -1) {
+          return -1;
+        }
+        ACE_DEBUG((LM_INFO, "(%P|%t) INFO: %C %d listening on %C\n",
+          handler->name().c_str(), handle_to_int(handler->get_handle()), OpenDDS::DCPS::LogAddr(addr).c_str()));
+      }
+      return 0;
+    }
+
+    void stop()
+    {
+      for (const auto& handler : handlers_) {
+        handler->stop();
+      }
+      for (const auto& task : tasks_) {
+        task->stop();
+      }
+      tasks_.clear();
+      handlers_.clear();
+    }
+
+  private:
+    std::vector<OpenDDS::DCPS::ReactorTask_rch> tasks_;
+    std::vector<std::unique_ptr<VerticalHandler>> handlers_;
+  };
 }
 
 int run(int argc, ACE_TCHAR* argv[])
@@ -766,6 +830,23 @@ int run(int argc, ACE_TCHAR* argv[])
   spdp_vertical_handler.spdp_handler(&spdp_vertical_handler);
   sedp_vertical_handler.spdp_handler(&spdp_vertical_handler);
 
+  // Additional vertical handlers, each with its own socket, that share the vertical ports.
+  // Messages from other relays continue to go out through the handlers above.
+  const bool sharded = config.handler_shards() > 1;
+  HandlerShards shards;
+  for (size_t i = 1; i < config.handler_shards(); ++i) {
+    ACE_Reactor* const shard_reactor = shards.add_shard("RtpsRelay Vertical shard " + std::to_string(i));
+    if (!shard_reactor) {
+      return EXIT_FAILURE;
+    }
+    shards.add_handler(new SpdpHandler(config, VSPDP, spdp_horizontal_addr, shard_reactor, guid_partition_table, relay_partition_table, *guid_addr_set, rtps_discovery, crypto, spdp, spdp_vertical_reporter),
+                       spdp_horizontal_handler, &spdp_vertical_handler);
+    shards.add_handler(new SedpHandler(config, VSEDP, sedp_horizontal_addr, shard_reactor, guid_partition_table, relay_partition_table, *guid_addr_set, rtps_discovery, crypto, sedp, sedp_vertical_reporter),
+                       sedp_horizontal_handler, &spdp_vertical_handler);
+    shards.add_handler(new DataHandler(config, VDATA, data_horizontal_addr, shard_reactor, guid_partition_table, relay_partition_table, *guid_addr_set, rtps_discovery, crypto, data_vertical_reporter),
+                       data_horizontal_handler, nullptr);
+  }
+
   DDS::Subscriber_var bit_subscriber = application_participant->get_builtin_subscriber();
 
   DDS::DataReader_var thread_status_reader_var = bit_subscriber->lookup_datareader(OpenDDS::DCPS::BUILT_IN_INTERNAL_THREAD_TOPIC);
@@ -877,9 +958,9 @@ int run(int argc, ACE_TCHAR* argv[])
   if (spdp_horizontal_handler.open(spdp_horizontal_addr) == -1 ||
       sedp_horizontal_handler.open(sedp_horizontal_addr) == -1 ||
       data_horizontal_handler.open(data_horizontal_addr) == -1 ||
-      spdp_vertical_handler.open(spdp_vertical_addr) == -1 ||
-      sedp_vertical_handler.open(sedp_vertical_addr) == -1 ||
-      data_vertical_handler.open(data_vertical_addr) == -1) {
+      spdp_vertical_handler.open(spdp_vertical_addr, sharded) == -1 ||
+      sedp_vertical_handler.open(sedp_vertical_addr, sharded) == -1 ||
+      data_vertical_handler.open(data_vertical_addr, sharded) == -1) {
     return EXIT_FAILURE;
   }
 
@@ -897,6 +978,9 @@ int run(int argc, ACE_TCHAR* argv[])
     handle_to_int(sedp_vertical_handler.get_handle()), OpenDDS::DCPS::LogAddr(sedp_vertical_addr).c_str()));
   ACE_DEBUG((LM_INFO, "(%P|%t) INFO: Data Vertical %d listening on %C\n",
     handle_to_int(data_vertical_handler.get_handle()), OpenDDS::DCPS::LogAddr(data_vertical_addr).c_str()));
+  if (shards.open(spdp_vertical_addr, sedp_vertical_addr, data_vertical_addr) == -1) {
+    return EXIT_FAILURE;
+  }
 
   // Write about the relay.
   DDS::DataWriterListener_var relay_address_writer_listener =
@@ -1035,6 +1119,9 @@ int run(int argc, ACE_TCHAR* argv[])
   }
 
   const auto status = reactor_task->run_reactor(config.handler_threads(), config.run_time());
+
+  shards.stop();
+
   if (status != EXIT_SUCCESS) {
     ACE_ERROR((LM_ERROR, "(%P:%t) ERROR: Failed to run reactor task: %m\n"));
     return EXIT_FAILURE;